@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*---------------------------------------------------------------------------*/
+/**
+ * \addtogroup arm
+ *
+ * Arm Cortex-M implementation of the Internet checksum, adding 32-bit
+ * words with an ADDS/ADCS carry chain. Enabled by defining
+ * UIP_ARCH_CHKSUM_DATA to 1 in the project configuration.
+ *
+ * @{
+ *
+ * \file
+ *  Internet checksum for Arm Cortex-M3 and Cortex-M4
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "net/ipv6/uip-arch.h"
+
+#include <stdint.h>
+/*---------------------------------------------------------------------------*/
+#if UIP_ARCH_CHKSUM_DATA
+#if !defined(__ARM_ARCH_7M__) && !defined(__ARM_ARCH_7EM__)
+#error "UIP_ARCH_CHKSUM_DATA requires an Armv7-M CPU (Cortex-M3/M4)"
+#endif
+/*---------------------------------------------------------------------------*/
+/*
+ * Armv7-M supports unaligned LDR, so words are loaded with
+ * __builtin_memcpy (which -fno-builtin does not affect). They are summed
+ * in little-endian order, which gives the byte-swapped one's complement
+ * sum (RFC 1071), so the sum is swapped at both ends.
+ */
+#define LOAD32(p, w) __builtin_memcpy(&(w), (p), 4)
+/*---------------------------------------------------------------------------*/
+uint16_t
+uip_arch_chksum_data(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+  uint32_t acc;
+  uint32_t a, b, c, d;
+
+  acc = UIP_HTONS(sum);
+
+  for(; len >= 16; data += 16, len -= 16) {
+    LOAD32(data, a);
+    LOAD32(data + 4, b);
+    LOAD32(data + 8, c);
+    LOAD32(data + 12, d);
+    __asm__ ("adds %[acc], %[acc], %[a]\n\t"
+             "adcs %[acc], %[acc], %[b]\n\t"
+             "adcs %[acc], %[acc], %[c]\n\t"
+             "adcs %[acc], %[acc], %[d]\n\t"
+             "adc  %[acc], %[acc], #0"
+             : [acc] "+r" (acc)
+             : [a] "r" (a), [b] "r" (b), [c] "r" (c), [d] "r" (d)
+             : "cc");
+  }
+
+  for(; len >= 4; data += 4, len -= 4) {
+    LOAD32(data, a);
+    __asm__ ("adds %[acc], %[acc], %[a]\n\t"
+             "adc  %[acc], %[acc], #0"
+             : [acc] "+r" (acc)
+             : [a] "r" (a)
+             : "cc");
+  }
+
+  /* At most three bytes left, added to the upper half without carry */
+  acc = (acc >> 16) + (acc & 0xffff);
+  if(len >= 2) {
+    acc += data[0] | ((uint32_t)data[1] << 8);
+    data += 2;
+    len -= 2;
+  }
+  if(len > 0) {
+    /* Odd trailing byte, padded with a zero byte */
+    acc += data[0];
+  }
+
+  acc = (acc >> 16) + (acc & 0xffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+
+  return UIP_HTONS((uint16_t)acc);
+}
+/*---------------------------------------------------------------------------*/
+#endif /* UIP_ARCH_CHKSUM_DATA */
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         AES-128 for the native platform, using the AES-NI instructions
+ *         on x86 CPUs that have them, selected at run time, and the
+ *         software implementation otherwise.
+ */
+
+#include "contiki.h"
+#include "lib/aes-128.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+static __m128i round_keys[11];
+static uint8_t use_aes_ni;
+static uint8_t selected;
+/*---------------------------------------------------------------------------*/
+static void
+select_implementation(void)
+{
+  __builtin_cpu_init();
+  use_aes_ni = __builtin_cpu_supports("aes") && __builtin_cpu_supports("sse2");
+  selected = 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Derives the next round key. The round constant of AESKEYGENASSIST must
+ * be an immediate, hence the macro. */
+#define EXPAND_KEY(i, rcon) \
+  round_keys[i] = expand_key_step(round_keys[i - 1], \
+                                  _mm_aeskeygenassist_si128(round_keys[i - 1], \
+                                                            rcon))
+
+__attribute__((target("aes,sse2")))
+static inline __m128i
+expand_key_step(__m128i key, __m128i assist)
+{
+  assist = _mm_shuffle_epi32(assist, 0xff);
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, assist);
+}
+/*---------------------------------------------------------------------------*/
+__attribute__((target("aes,sse2")))
+static void
+set_key_aes_ni(const uint8_t *key)
+{
+  round_keys[0] = _mm_loadu_si128((const __m128i *)key);
+  EXPAND_KEY(1, 0x01);
+  EXPAND_KEY(2, 0x02);
+  EXPAND_KEY(3, 0x04);
+  EXPAND_KEY(4, 0x08);
+  EXPAND_KEY(5, 0x10);
+  EXPAND_KEY(6, 0x20);
+  EXPAND_KEY(7, 0x40);
+  EXPAND_KEY(8, 0x80);
+  EXPAND_KEY(9, 0x1b);
+  EXPAND_KEY(10, 0x36);
+}
+/*---------------------------------------------------------------------------*/
+__attribute__((target("aes,sse2")))
+static void
+encrypt_aes_ni(uint8_t *state)
+{
+  __m128i s;
+  int round;
+
+  s = _mm_xor_si128(_mm_loadu_si128((const __m128i *)state), round_keys[0]);
+  for(round = 1; round < 10; round++) {
+    s = _mm_aesenc_si128(s, round_keys[round]);
+  }
+  s = _mm_aesenclast_si128(s, round_keys[10]);
+  _mm_storeu_si128((__m128i *)state, s);
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_key(const uint8_t *key)
+{
+  if(!selected) {
+    select_implementation();
+  }
+  if(use_aes_ni) {
+    set_key_aes_ni(key);
+  } else {
+    aes_128_driver.set_key(key);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+encrypt(uint8_t *plaintext_and_result)
+{
+  if(use_aes_ni) {
+    encrypt_aes_ni(plaintext_and_result);
+  } else {
+    aes_128_driver.encrypt(plaintext_and_result);
+  }
+}
+/*---------------------------------------------------------------------------*/
+const struct aes_128_driver native_aes_128_driver = {
+  set_key,
+  encrypt
+};
+/*---------------------------------------------------------------------------*/
+#endif /* defined(__x86_64__) || defined(__i386__) */
@@ -55,6 +55,15 @@
 #define LOG_MODULE "Tun6"
 #define LOG_LEVEL LOG_LEVEL_WARN
 
+/* The number of packets read from the tun device each time it becomes
+   readable. With more than one, the device is non-blocking and several
+   packets are handed to the stack before returning to the main loop. */
+#ifdef TUN6_NET_CONF_BATCH
+#define TUN6_NET_BATCH TUN6_NET_CONF_BATCH
+#else
+#define TUN6_NET_BATCH 1
+#endif
+
 #ifdef linux
 #include <linux/if.h>
 #include <linux/if_tun.h>
@@ -217,6 +226,12 @@ tun_init()
 
   LOG_INFO("Tun open:%d\n", tunfd);
 
+#if TUN6_NET_BATCH > 1
+  if(fcntl(tunfd, F_SETFL, fcntl(tunfd, F_GETFL) | O_NONBLOCK) == -1) {
+    err(1, "tun_init: fcntl");
+  }
+#endif /* TUN6_NET_BATCH > 1 */
+
   select_set_callback(tunfd, &tun_select_callback);
 
   fprintf(stderr, "opened %s device ``/dev/%s''\n",
@@ -252,6 +267,10 @@ tun_input(unsigned char *data, int maxlen)
   }
 
   if((size = read(tunfd, data, maxlen)) == -1) {
+    if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+      /* Drained */
+      return 0;
+    }
     err(1, "tun_input: read");
   }
   return size;
@@ -288,6 +307,7 @@ static void
 handle_fd(fd_set *rset, fd_set *wset)
 {
   int size;
+  int i;
 
   if(tunfd == -1) {
     /* tun is not open */
@@ -297,10 +317,17 @@ handle_fd(fd_set *rset, fd_set *wset)
   LOG_INFO("Tun6-handle FD\n");
 
   if(FD_ISSET(tunfd, rset)) {
-    size = tun_input(uip_buf, sizeof(uip_buf));
-    LOG_DBG("TUN data incoming read:%d\n", size);
-    uip_len = size;
-    tcpip_input();
+    /* Each packet is read straight into uip_buf and processed before
+       the next one is read */
+    for(i = 0; i < TUN6_NET_BATCH; i++) {
+      size = tun_input(uip_buf, sizeof(uip_buf));
+      LOG_DBG("TUN data incoming read:%d\n", size);
+      if(size <= 0) {
+        break;
+      }
+      uip_len = size;
+      tcpip_input();
+    }
   }
 }
 #endif /*  __CYGWIN_ */
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Internet checksum for the native platform, using SSE2 or AVX2
+ *         on x86 CPUs, selected at run time.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip-arch.h"
+
+#if UIP_ARCH_CHKSUM_DATA
+#if !defined(__x86_64__) && !defined(__i386__)
+#error "UIP_ARCH_CHKSUM_DATA is only supported on x86 for native"
+#endif
+
+#include <immintrin.h>
+#include <string.h>
+
+/* Allow the AVX2 path to be disabled, e.g. to test the SSE2 one */
+#ifdef NATIVE_CONF_CHKSUM_AVX2
+#define NATIVE_CHKSUM_AVX2 NATIVE_CONF_CHKSUM_AVX2
+#else
+#define NATIVE_CHKSUM_AVX2 1
+#endif
+
+/* Below this length the vector setup costs more than it saves */
+#define VECTOR_MIN_LEN 128
+
+/*
+ * The vector loops zero-extend 16-bit words into 32-bit lanes. Each lane
+ * then receives at most two words per 32 bytes, so that with len below
+ * 64 KiB it cannot overflow. Words are summed in host byte order, which
+ * gives the same one's complement sum, byte-swapped (RFC 1071).
+ */
+static uint64_t (*sum_blocks)(const uint8_t *data, uint16_t len);
+/*---------------------------------------------------------------------------*/
+__attribute__((target("sse2")))
+static uint64_t
+sum_blocks_sse2(const uint8_t *data, uint16_t len)
+{
+  const __m128i zero = _mm_setzero_si128();
+  __m128i acc0 = zero;
+  __m128i acc1 = zero;
+  __m128i v;
+  uint32_t lanes[4];
+
+  for(; len >= 32; data += 32, len -= 32) {
+    v = _mm_loadu_si128((const __m128i *)data);
+    acc0 = _mm_add_epi32(acc0, _mm_unpacklo_epi16(v, zero));
+    acc1 = _mm_add_epi32(acc1, _mm_unpackhi_epi16(v, zero));
+    v = _mm_loadu_si128((const __m128i *)(data + 16));
+    acc0 = _mm_add_epi32(acc0, _mm_unpacklo_epi16(v, zero));
+    acc1 = _mm_add_epi32(acc1, _mm_unpackhi_epi16(v, zero));
+  }
+
+  _mm_storeu_si128((__m128i *)lanes, _mm_add_epi32(acc0, acc1));
+  return (uint64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+/*---------------------------------------------------------------------------*/
+#if NATIVE_CHKSUM_AVX2
+__attribute__((target("avx2")))
+static uint64_t
+sum_blocks_avx2(const uint8_t *data, uint16_t len)
+{
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i acc0 = zero;
+  __m256i acc1 = zero;
+  __m256i v;
+  uint32_t lanes[8];
+  uint64_t sum;
+  int i;
+
+  for(; len >= 32; data += 32, len -= 32) {
+    v = _mm256_loadu_si256((const __m256i *)data);
+    acc0 = _mm256_add_epi32(acc0, _mm256_unpacklo_epi16(v, zero));
+    acc1 = _mm256_add_epi32(acc1, _mm256_unpackhi_epi16(v, zero));
+  }
+
+  _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi32(acc0, acc1));
+  sum = 0;
+  for(i = 0; i < 8; i++) {
+    sum += lanes[i];
+  }
+  return sum;
+}
+#endif /* NATIVE_CHKSUM_AVX2 */
+/*---------------------------------------------------------------------------*/
+static void
+select_sum_blocks(void)
+{
+  __builtin_cpu_init();
+#if NATIVE_CHKSUM_AVX2
+  if(__builtin_cpu_supports("avx2")) {
+    sum_blocks = sum_blocks_avx2;
+    return;
+  }
+#endif /* NATIVE_CHKSUM_AVX2 */
+#if defined(__i386__)
+  if(!__builtin_cpu_supports("sse2")) {
+    return;
+  }
+#endif /* defined(__i386__) */
+  sum_blocks = sum_blocks_sse2;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+uip_arch_chksum_data(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+  static uint8_t selected;
+  uint64_t acc;
+  uint32_t w;
+  uint16_t h;
+  uint16_t n;
+
+  if(!selected) {
+    select_sum_blocks();
+    selected = 1;
+  }
+
+  /* x86 is little-endian: sum words in host order, swap at both ends */
+  acc = UIP_HTONS(sum);
+
+  if(len >= VECTOR_MIN_LEN && sum_blocks != NULL) {
+    n = len & ~31;
+    acc += sum_blocks(data, n);
+    data += n;
+    len -= n;
+  }
+
+  for(; len >= 4; data += 4, len -= 4) {
+    memcpy(&w, data, 4);
+    acc += w;
+  }
+  if(len >= 2) {
+    memcpy(&h, data, 2);
+    acc += h;
+    data += 2;
+    len -= 2;
+  }
+  if(len > 0) {
+    /* Odd trailing byte, padded with a zero byte */
+    acc += data[0];
+  }
+
+  acc = (acc >> 32) + (acc & 0xffffffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+
+  return UIP_HTONS((uint16_t)acc);
+}
+/*---------------------------------------------------------------------------*/
+#endif /* UIP_ARCH_CHKSUM_DATA */
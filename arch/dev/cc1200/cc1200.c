@@ -2245,7 +2245,7 @@ addr_check_auto_ack(uint8_t *frame, uint16_t frame_len)
 
   frame802154_t info154;
 
-  if(frame802154_parse(frame, frame_len, &info154) != 0) {
+  if(frame802154_peek(frame, frame_len, &info154) != 0) {
 
     /* We received a valid 802.15.4 frame */
 
@@ -128,6 +128,16 @@ typedef unsigned long clock_time_t;
 
 #define UIP_ARCH_IPCHKSUM        1
 
+/* Motes run on the host CPU: use the table-driven software AES */
+#ifndef AES_128_CONF_WITH_TTABLE
+#define AES_128_CONF_WITH_TTABLE 1
+#endif /* AES_128_CONF_WITH_TTABLE */
+
+/* Flash is not scarce here: locate 802.15.4 header fields by table lookup */
+#ifndef FRAME802154_CONF_WITH_LAYOUT_TABLE
+#define FRAME802154_CONF_WITH_LAYOUT_TABLE 1
+#endif /* FRAME802154_CONF_WITH_LAYOUT_TABLE */
+
 #if MAC_CONF_WITH_TSCH
 /* A bug in cooja causes many EBs to be missed at scan. Increase EB
    frequency to shorten the join process */
@@ -528,7 +528,7 @@ is_packet_for_us(uint8_t *buf, int len, int do_send_ack)
 {
   frame802154_t frame;
   int result;
-  uint8_t parsed = frame802154_parse(buf, len, &frame);
+  uint8_t parsed = frame802154_peek(buf, len, &frame);
   if(parsed) {
     if(frame.fcf.dest_addr_mode) {
       int has_dest_panid;
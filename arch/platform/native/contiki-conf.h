@@ -51,6 +51,12 @@ struct select_callback {
 };
 int select_set_callback(int fd, const struct select_callback *callback);
 
+#if defined(SELECT_CONF_EPOLL) && SELECT_CONF_EPOLL
+/* Wake up the main loop if it sleeps in epoll_wait() */
+void select_wakeup(void);
+#define PROCESS_CONF_POLL_HOOK() select_wakeup()
+#endif /* defined(SELECT_CONF_EPOLL) && SELECT_CONF_EPOLL */
+
 #define CC_CONF_REGISTER_ARGS          1
 #define CC_CONF_FUNCTION_POINTER_ARGS  1
 #define CC_CONF_VA_ARGS                1
@@ -94,8 +100,39 @@ typedef unsigned int uip_stats_t;
 #define UIP_CONF_IPV6_QUEUE_PKT  1
 #define UIP_ARCH_IPCHKSUM        1
 
+/* Use the vectorized checksum on x86, and wide words elsewhere */
+#ifndef UIP_ARCH_CHKSUM_DATA
+#if defined(__x86_64__) || defined(__i386__)
+#define UIP_ARCH_CHKSUM_DATA     1
+#endif
+#endif /* UIP_ARCH_CHKSUM_DATA */
+#ifndef UIP_CONF_CHKSUM_WIDE
+#define UIP_CONF_CHKSUM_WIDE     1
+#endif /* UIP_CONF_CHKSUM_WIDE */
+
 #endif /* NETSTACK_CONF_WITH_IPV6 */
 
+/* Use AES-NI on x86 when the CPU has it, and the table-driven software
+ * AES otherwise */
+#ifndef AES_128_CONF
+#if defined(__x86_64__) || defined(__i386__)
+#define AES_128_CONF             native_aes_128_driver
+#endif
+#endif /* AES_128_CONF */
+#ifndef AES_128_CONF_WITH_TTABLE
+#define AES_128_CONF_WITH_TTABLE 1
+#endif /* AES_128_CONF_WITH_TTABLE */
+
+/* Flash is not scarce here: locate 802.15.4 header fields by table lookup */
+#ifndef FRAME802154_CONF_WITH_LAYOUT_TABLE
+#define FRAME802154_CONF_WITH_LAYOUT_TABLE 1
+#endif /* FRAME802154_CONF_WITH_LAYOUT_TABLE */
+
+/* stdout is unbuffered: write binary TSCH log records in one call */
+#ifndef TSCH_LOG_CONF_BINARY_WRITE
+#define TSCH_LOG_CONF_BINARY_WRITE(buf, len) fwrite((buf), 1, (len), stdout)
+#endif /* TSCH_LOG_CONF_BINARY_WRITE */
+
 #include <ctype.h>
 
 typedef unsigned long clock_time_t;
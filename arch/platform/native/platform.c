@@ -48,6 +48,22 @@
 #include <sys/select.h>
 #include <errno.h>
 
+#ifdef SELECT_CONF_EPOLL
+#define SELECT_EPOLL SELECT_CONF_EPOLL
+#else
+#define SELECT_EPOLL 0
+#endif
+
+#if SELECT_EPOLL
+#ifndef __linux__
+#error "SELECT_CONF_EPOLL requires Linux"
+#endif
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif /* SELECT_EPOLL */
+
 #ifdef __CYGWIN__
 #include "net/wpcap-drv.h"
 #endif /* __CYGWIN__ */
@@ -108,18 +124,98 @@
 #else
 #define SELECT_STDIN 1
 #endif
+
+/*
+ * With SELECT_CONF_EPOLL, the main loop waits in epoll_wait() until the
+ * next etimer expiration instead of polling with select(). This defines
+ * the longest time (in msec) it sleeps when no etimer is pending.
+ */
+#ifdef SELECT_CONF_EPOLL_MAX_WAIT
+#define SELECT_EPOLL_MAX_WAIT SELECT_CONF_EPOLL_MAX_WAIT
+#else
+#define SELECT_EPOLL_MAX_WAIT 1000
+#endif
 /** @} */
 /*---------------------------------------------------------------------------*/
 
 static const struct select_callback *select_callback[SELECT_MAX];
 static int select_max = 0;
 
+#if SELECT_EPOLL
+static int epoll_fd = -1;
+/* Written to by select_wakeup() while the main loop sleeps */
+static int wakeup_fd = -1;
+static volatile sig_atomic_t sleeping;
+/* The events each file descriptor is registered for */
+static uint32_t epoll_registered[SELECT_MAX];
+/* File descriptors that epoll does not support, such as regular files.
+   Like select() would, they are reported ready at every wakeup. */
+static fd_set epoll_unsupported;
+#endif /* SELECT_EPOLL */
+
 #ifdef PLATFORM_CONF_MAC_ADDR
 static uint8_t mac_addr[] = PLATFORM_CONF_MAC_ADDR;
 #else /* PLATFORM_CONF_MAC_ADDR */
 static uint8_t mac_addr[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
 #endif /* PLATFORM_CONF_MAC_ADDR */
 
+#if SELECT_EPOLL
+/*---------------------------------------------------------------------------*/
+static void
+epoll_update(int fd, uint32_t events)
+{
+  struct epoll_event ev;
+  int op;
+
+  if(events == epoll_registered[fd]) {
+    return;
+  }
+  if(epoll_fd < 0) {
+    return;
+  }
+  if(FD_ISSET(fd, &epoll_unsupported)) {
+    if(events == 0) {
+      FD_CLR(fd, &epoll_unsupported);
+    }
+    epoll_registered[fd] = events;
+    return;
+  }
+
+  if(epoll_registered[fd] == 0) {
+    op = EPOLL_CTL_ADD;
+  } else if(events == 0) {
+    op = EPOLL_CTL_DEL;
+  } else {
+    op = EPOLL_CTL_MOD;
+  }
+  memset(&ev, 0, sizeof(ev));
+  ev.events = events;
+  ev.data.fd = fd;
+  if(epoll_ctl(epoll_fd, op, fd, &ev) < 0) {
+    if(errno == EPERM) {
+      FD_SET(fd, &epoll_unsupported);
+    } else {
+      perror("epoll_ctl");
+      return;
+    }
+  }
+  epoll_registered[fd] = events;
+}
+/*---------------------------------------------------------------------------*/
+void
+select_wakeup(void)
+{
+  uint64_t one = 1;
+
+  /* Only needed when the main loop sleeps, i.e. when called from a signal
+     handler or another thread */
+  if(sleeping && wakeup_fd >= 0) {
+    if(write(wakeup_fd, &one, sizeof(one)) < 0) {
+      /* The counter is already non-zero, nothing to do */
+    }
+  }
+}
+#endif /* SELECT_EPOLL */
 /*---------------------------------------------------------------------------*/
 int
 select_set_callback(int fd, const struct select_callback *callback)
@@ -133,6 +229,11 @@ select_set_callback(int fd, const struct select_callback *callback)
     }
 
     select_callback[fd] = callback;
+#if SELECT_EPOLL
+    if(callback == NULL) {
+      epoll_update(fd, 0);
+    }
+#endif /* SELECT_EPOLL */
 
     /* Update fd max */
     if(callback != NULL) {
@@ -285,6 +386,126 @@ platform_init_stage_three()
   /* Make standard output unbuffered. */
   setvbuf(stdout, (char *)NULL, _IONBF, 0);
 }
+#if SELECT_EPOLL
+/*---------------------------------------------------------------------------*/
+/* The time (in msec) until the next etimer expires */
+static int
+etimer_wait(void)
+{
+  clock_time_t left;
+
+  if(!etimer_pending()) {
+    return SELECT_EPOLL_MAX_WAIT;
+  }
+
+  left = etimer_next_expiration_time() - clock_time();
+  if(left > (clock_time_t)-1 / 2) {
+    /* Already expired */
+    return 0;
+  }
+  left = left * 1000 / CLOCK_SECOND;
+  return left < SELECT_EPOLL_MAX_WAIT ? left : SELECT_EPOLL_MAX_WAIT;
+}
+/*---------------------------------------------------------------------------*/
+static void
+epoll_main_loop(void)
+{
+  struct epoll_event events[SELECT_MAX + 1];
+  struct epoll_event ev;
+  fd_set fdr;
+  fd_set fdw;
+  uint64_t count;
+  uint32_t interest;
+  int i;
+  int n;
+
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if(epoll_fd < 0 || wakeup_fd < 0) {
+    perror("epoll");
+    exit(1);
+  }
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.fd = -1;
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &ev);
+
+  while(1) {
+    process_run();
+
+    /* Register the file descriptors for the events the callbacks want.
+       This only calls epoll_ctl() when the interest of a file descriptor
+       changed, e.g. when the SLIP device has data to write. */
+    FD_ZERO(&fdr);
+    FD_ZERO(&fdw);
+    for(i = 0; i <= select_max; i++) {
+      if(select_callback[i] != NULL) {
+        select_callback[i]->set_fd(&fdr, &fdw);
+      }
+    }
+    for(i = 0; i <= select_max; i++) {
+      interest = (FD_ISSET(i, &fdr) ? EPOLLIN : 0) |
+        (FD_ISSET(i, &fdw) ? EPOLLOUT : 0);
+      epoll_update(i, interest);
+    }
+
+    /* Sleep until the next etimer expires, unless there are events to
+       process. A poll from a signal handler wakes us up through the
+       wakeup file descriptor. */
+    sleeping = 1;
+    n = epoll_wait(epoll_fd, events, SELECT_MAX + 1,
+                   process_nevents() > 0 ? 0 : etimer_wait());
+    sleeping = 0;
+    if(n < 0) {
+      if(errno != EINTR) {
+        perror("epoll_wait");
+      }
+      n = 0;
+    }
+
+    /* Hand the ready file descriptors to the callbacks */
+    FD_ZERO(&fdr);
+    FD_ZERO(&fdw);
+    for(i = 0; i < n; i++) {
+      if(events[i].data.fd < 0) {
+        if(read(wakeup_fd, &count, sizeof(count)) < 0) {
+          /* Already cleared */
+        }
+        continue;
+      }
+      if(events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        FD_SET(events[i].data.fd, &fdr);
+      }
+      if(events[i].events & (EPOLLOUT | EPOLLERR)) {
+        FD_SET(events[i].data.fd, &fdw);
+      }
+    }
+    for(i = 0; i <= select_max; i++) {
+      if(FD_ISSET(i, &epoll_unsupported)) {
+        if(epoll_registered[i] & EPOLLIN) {
+          FD_SET(i, &fdr);
+        }
+        if(epoll_registered[i] & EPOLLOUT) {
+          FD_SET(i, &fdw);
+        }
+        n++;
+      }
+    }
+    if(n > 0) {
+      for(i = 0; i <= select_max; i++) {
+        if(select_callback[i] != NULL) {
+          select_callback[i]->handle_fd(&fdr, &fdw);
+        }
+      }
+    }
+
+    /* Only poll the etimer process when a timer has expired */
+    if(etimer_pending() && etimer_wait() == 0) {
+      etimer_request_poll();
+    }
+  }
+}
+#endif /* SELECT_EPOLL */
 /*---------------------------------------------------------------------------*/
 void
 platform_main_loop()
@@ -292,6 +513,9 @@ platform_main_loop()
 #if SELECT_STDIN
   select_set_callback(STDIN_FILENO, &stdin_fd);
 #endif /* SELECT_STDIN */
+#if SELECT_EPOLL
+  epoll_main_loop();
+#else /* SELECT_EPOLL */
   while(1) {
     fd_set fdr;
     fd_set fdw;
@@ -330,6 +554,7 @@ platform_main_loop()
 
     etimer_request_poll();
   }
+#endif /* SELECT_EPOLL */
 
   return;
 }
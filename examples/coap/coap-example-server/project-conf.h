@@ -41,4 +41,11 @@
 
 #define LOG_LEVEL_APP LOG_LEVEL_DBG
 
+/* Dispatch requests through a hash index of the resource paths, for
+   servers with many resources. The index holds up to
+   COAP_CONF_RESOURCE_INDEX_SIZE resources (256 by default); beyond that,
+   dispatch falls back to walking the list of resources. */
+/* #define COAP_CONF_WITH_RESOURCE_INDEX 1
+   #define COAP_CONF_RESOURCE_INDEX_SIZE 256 */
+
 #endif /* PROJECT_CONF_H_ */
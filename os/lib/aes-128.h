@@ -69,4 +69,7 @@ struct aes_128_driver {
 
 extern const struct aes_128_driver AES_128;
 
+/* The software implementation, also usable as a fallback by others */
+extern const struct aes_128_driver aes_128_driver;
+
 #endif /* AES_128_H_ */
@@ -59,33 +59,22 @@ set_iv(uint8_t *iv,
   iv[15] = counter;
 }
 /*---------------------------------------------------------------------------*/
-/* XORs the block m[pos] ... m[pos + 15] with K_{counter} */
+/* Computes the key stream block K_{counter} */
 static void
-ctr_step(const uint8_t *nonce,
-    uint8_t pos,
-    uint8_t *m_and_result,
-    uint8_t m_len,
-    uint8_t counter)
+ctr_block(const uint8_t *nonce, uint8_t counter, uint8_t *s)
 {
-  uint8_t a[AES_128_BLOCK_SIZE];
-  uint8_t i;
-  
-  set_iv(a, CCM_STAR_ENCRYPTION_FLAGS, nonce, counter);
-  AES_128.encrypt(a);
-  
-  for(i = 0; (pos + i < m_len) && (i < AES_128_BLOCK_SIZE); i++) {
-    m_and_result[pos + i] ^= a[i];
-  }
+  set_iv(s, CCM_STAR_ENCRYPTION_FLAGS, nonce, counter);
+  AES_128.encrypt(s);
 }
 /*---------------------------------------------------------------------------*/
+/* Starts the CBC-MAC and authenticates the additional data */
 static void
-mic(const uint8_t *nonce,
-    const uint8_t *m, uint8_t m_len,
+mic_start(const uint8_t *nonce,
+    uint8_t m_len,
     const uint8_t *a, uint8_t a_len,
-    uint8_t *result,
+    uint8_t *x,
     uint8_t mic_len)
 {
-  uint8_t x[AES_128_BLOCK_SIZE];
   uint8_t pos;
   uint8_t i;
   
@@ -109,35 +98,6 @@ mic(const uint8_t *nonce,
       AES_128.encrypt(x);
     }
   }
-  
-  if(m_len) {
-    pos = 0;
-    while(pos < m_len) {
-      for(i = 0; (pos + i < m_len) && (i < AES_128_BLOCK_SIZE); i++) {
-        x[i] ^= m[pos + i];
-      }
-      pos += AES_128_BLOCK_SIZE;
-      AES_128.encrypt(x);
-    }
-  }
-  
-  ctr_step(nonce, 0, x, AES_128_BLOCK_SIZE, 0);
-  
-  memcpy(result, x, mic_len);
-}
-/*---------------------------------------------------------------------------*/
-static void
-ctr(const uint8_t *nonce, uint8_t *m, uint8_t m_len)
-{
-  uint8_t pos;
-  uint8_t counter;
-  
-  pos = 0;
-  counter = 1;
-  while(pos < m_len) {
-    ctr_step(nonce, pos, m, m_len, counter++);
-    pos += AES_128_BLOCK_SIZE;
-  }
 }
 /*---------------------------------------------------------------------------*/
 static void
@@ -153,20 +113,48 @@ aead(const uint8_t* nonce,
     uint8_t *result, uint8_t mic_len,
     int forward)
 {
-  if(!forward) {
-    /* decrypt */
-    ctr(nonce, m, m_len);
+  uint8_t x[AES_128_BLOCK_SIZE];
+  uint8_t s[AES_128_BLOCK_SIZE];
+  uint16_t pos;
+  uint8_t len;
+  uint8_t counter;
+  uint8_t i;
+  
+  if(mic_len) {
+    mic_start(nonce, m_len, a, a_len, x, mic_len);
   }
   
-  mic(nonce,
-    m, m_len,
-    a, a_len,
-    result,
-    mic_len);
+  /* Authenticate the plaintext and encrypt or decrypt it in a single
+   * pass, rather than walking the message once for each */
+  counter = 1;
+  for(pos = 0; pos < m_len; pos += AES_128_BLOCK_SIZE) {
+    len = MIN(AES_128_BLOCK_SIZE, m_len - pos);
+    ctr_block(nonce, counter++, s);
+    if(!forward) {
+      /* decrypt */
+      for(i = 0; i < len; i++) {
+        m[pos + i] ^= s[i];
+      }
+    }
+    if(mic_len) {
+      for(i = 0; i < len; i++) {
+        x[i] ^= m[pos + i];
+      }
+      AES_128.encrypt(x);
+    }
+    if(forward) {
+      /* encrypt */
+      for(i = 0; i < len; i++) {
+        m[pos + i] ^= s[i];
+      }
+    }
+  }
   
-  if(forward) {
-    /* encrypt */
-    ctr(nonce, m, m_len);
+  if(mic_len) {
+    ctr_block(nonce, 0, s);
+    for(i = 0; i < mic_len; i++) {
+      result[i] = x[i] ^ s[i];
+    }
   }
 }
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*---------------------------------------------------------------------------*/
+/**
+ * \addtogroup hash-index
+ * @{
+ *
+ * \file
+ *         Implementation of the hash index library
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "lib/hash-index.h"
+
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+/* The home slot of a hash. Keys often differ only in a few bytes, mix
+   all bits into the low bits used as index. */
+static unsigned
+home_slot(const struct hash_index *hi, uint32_t h)
+{
+  h ^= h >> 16;
+  h *= 0x45d9f3b;
+  h ^= h >> 16;
+  return h & hi->mask;
+}
+/*---------------------------------------------------------------------------*/
+void
+hash_index_clear(struct hash_index *hi)
+{
+  memset(hi->slots, 0, (hi->mask + 1) * sizeof(hi->slots[0]));
+}
+/*---------------------------------------------------------------------------*/
+void
+hash_index_add(struct hash_index *hi, uint32_t h, uint16_t pos)
+{
+  unsigned slot;
+
+  for(slot = home_slot(hi, h);
+      hi->slots[slot] != 0;
+      slot = (slot + 1) & hi->mask);
+  hi->slots[slot] = pos + 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+hash_index_remove(struct hash_index *hi, uint32_t h, uint16_t pos)
+{
+  unsigned slot;
+  unsigned next;
+  unsigned home;
+
+  for(slot = home_slot(hi, h);
+      hi->slots[slot] != pos + 1;
+      slot = (slot + 1) & hi->mask) {
+    if(hi->slots[slot] == 0) {
+      /* Not in the index */
+      return;
+    }
+  }
+
+  /* Shift back the entries that follow in the probe sequence, so that
+     no lookup stops at the freed slot while its entry is further on */
+  next = slot;
+  while(1) {
+    hi->slots[slot] = 0;
+    do {
+      next = (next + 1) & hi->mask;
+      if(hi->slots[next] == 0) {
+        return;
+      }
+      home = home_slot(hi, hi->hash(hi->slots[next] - 1));
+    } while(((next - home) & hi->mask) < ((next - slot) & hi->mask));
+    hi->slots[slot] = hi->slots[next];
+    slot = next;
+  }
+}
+/*---------------------------------------------------------------------------*/
+int
+hash_index_lookup(const struct hash_index *hi, uint32_t h,
+                  hash_index_match_t match, const void *key)
+{
+  unsigned slot;
+
+  for(slot = home_slot(hi, h);
+      hi->slots[slot] != 0;
+      slot = (slot + 1) & hi->mask) {
+    if(match(hi->slots[slot] - 1, key)) {
+      return hi->slots[slot] - 1;
+    }
+  }
+  return -1;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
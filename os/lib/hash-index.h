@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*---------------------------------------------------------------------------*/
+/** \addtogroup data
+ * @{
+ *
+ * \defgroup hash-index Hash index
+ *
+ * An open-addressing hash index over the entries of an array (or of a
+ * MEMB block), for lookups by key without walking all entries.
+ *
+ * The index does not hold the entries, only their position in the
+ * array: a slot holds the position of an entry plus one, or zero if it
+ * is empty. The number of slots is a power of two at least twice the
+ * number of entries, collisions are resolved by linear probing, and
+ * removal shifts back the entries that follow in the probe sequence, so
+ * that no tombstones are needed. The caller supplies the hash of the
+ * keys and the comparison of a key with an entry.
+ *
+ * This library is not safe to be used within an interrupt context.
+ * @{
+ */
+/*---------------------------------------------------------------------------*/
+#ifndef HASH_INDEX_H_
+#define HASH_INDEX_H_
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+
+#include <stdint.h>
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Get the hash of the key of an entry
+ * \param pos The position of the entry
+ * \return The hash of its key, as passed to hash_index_add()
+ */
+typedef uint32_t (*hash_index_hash_t)(uint16_t pos);
+
+/**
+ * \brief Compare a key with an entry
+ * \param pos The position of the entry
+ * \param key The key, as passed to hash_index_lookup()
+ * \return Non-zero if the entry has the key
+ */
+typedef int (*hash_index_match_t)(uint16_t pos, const void *key);
+
+struct hash_index {
+  uint16_t *slots;
+  uint16_t mask;
+  hash_index_hash_t hash;
+};
+
+/* Round x up to a power of two, for x up to 0xffff */
+#define HASH_INDEX_POW2_1(x) ((x) | ((x) >> 1))
+#define HASH_INDEX_POW2_2(x) (HASH_INDEX_POW2_1(x) | (HASH_INDEX_POW2_1(x) >> 2))
+#define HASH_INDEX_POW2_4(x) (HASH_INDEX_POW2_2(x) | (HASH_INDEX_POW2_2(x) >> 4))
+#define HASH_INDEX_POW2_8(x) (HASH_INDEX_POW2_4(x) | (HASH_INDEX_POW2_4(x) >> 8))
+
+/**
+ * \brief The number of slots of an index of up to n entries: the
+ * smallest power of two of at least 2 * n, and at least 4
+ */
+#define HASH_INDEX_SLOTS(n) \
+  (HASH_INDEX_POW2_8(((n) < 2 ? 2 : (n)) * 2 - 1) + 1)
+
+/**
+ * \brief Define a hash index
+ * \param name The name of the index
+ * \param entries The number of entries it can hold, up to 16384
+ * \param hash The hash_index_hash_t function of the entries. It may be
+ * NULL if no entry is ever removed other than with hash_index_clear().
+ *
+ * The index starts empty.
+ */
+#define HASH_INDEX(name, entries, hash) \
+  static uint16_t name##_slots[HASH_INDEX_SLOTS(entries)]; \
+  static struct hash_index name = \
+    { name##_slots, HASH_INDEX_SLOTS(entries) - 1, hash }
+
+/**
+ * \brief Remove all entries from an index
+ * \param hi The index
+ */
+void hash_index_clear(struct hash_index *hi);
+
+/**
+ * \brief Add an entry to an index
+ * \param hi The index
+ * \param h The hash of the key of the entry
+ * \param pos The position of the entry
+ *
+ * The index must not be full, i.e., hold fewer entries than it was
+ * defined for.
+ */
+void hash_index_add(struct hash_index *hi, uint32_t h, uint16_t pos);
+
+/**
+ * \brief Remove an entry from an index
+ * \param hi The index
+ * \param h The hash of the key of the entry
+ * \param pos The position of the entry
+ *
+ * Nothing is done if the entry is not in the index.
+ */
+void hash_index_remove(struct hash_index *hi, uint32_t h, uint16_t pos);
+
+/**
+ * \brief Look up an entry by key
+ * \param hi The index
+ * \param h The hash of the key
+ * \param match The comparison of the key with an entry
+ * \param key The key, passed on to match
+ * \return The position of the first entry that matches, or -1
+ *
+ * match is called on each entry of the index that may have the key, in
+ * probe order. A match function that collects the entries and returns
+ * zero sees all of them.
+ */
+int hash_index_lookup(const struct hash_index *hi, uint32_t h,
+                      hash_index_match_t match, const void *key);
+/*---------------------------------------------------------------------------*/
+#endif /* HASH_INDEX_H_ */
+/*---------------------------------------------------------------------------*/
+/**
+ * @}
+ * @}
+ */
@@ -47,54 +47,83 @@
 #include "contiki.h"
 #include "lib/memb.h"
 
+/*---------------------------------------------------------------------------*/
+/* Index of the least significant zero bit of a bitmap word that is
+   not all ones. */
+static unsigned
+first_zero_bit(memb_bitmap_t word)
+{
+#ifdef __GNUC__
+  return __builtin_ctz(~word);
+#else /* __GNUC__ */
+  unsigned bit;
+
+  for(bit = 0; word & 1; bit++) {
+    word >>= 1;
+  }
+  return bit;
+#endif /* __GNUC__ */
+}
 /*---------------------------------------------------------------------------*/
 void
 memb_init(struct memb *m)
 {
-  memset(m->used, 0, m->num);
+  memset(m->used, 0, MEMB_BITMAP_WORDS(m->num) * sizeof(memb_bitmap_t));
   memset(m->mem, 0, m->size * m->num);
+  m->count = 0;
 }
 /*---------------------------------------------------------------------------*/
 void *
 memb_alloc(struct memb *m)
 {
-  int i;
+  unsigned w;
+  unsigned i;
 
-  for(i = 0; i < m->num; ++i) {
-    if(m->used[i] == false) {
-      /* If this block was unused, we set the used flag on
-	 and return a pointer to the memory block. */
-      m->used[i] = true;
-      return (void *)((char *)m->mem + (i * m->size));
-    }
+  if(m->count >= m->num) {
+    /* No free block is left, so we return NULL to indicate failure
+       to allocate block. */
+    return NULL;
   }
 
-  /* No free block was found, so we return NULL to indicate failure to
-     allocate block. */
-  return NULL;
+  /* Skip the bitmap words in which every block is in use. As count is
+     below num, a word with a zero bit that maps to a real block is
+     always found. */
+  for(w = 0; m->used[w] == (memb_bitmap_t)~0; w++);
+
+  i = w * MEMB_BITMAP_BITS + first_zero_bit(m->used[w]);
+  m->used[w] |= (memb_bitmap_t)1 << (i % MEMB_BITMAP_BITS);
+  m->count++;
+  return (void *)((char *)m->mem + (i * m->size));
 }
 /*---------------------------------------------------------------------------*/
 int
 memb_free(struct memb *m, void *ptr)
 {
-  int i;
-  char *ptr2;
+  size_t offset;
+  unsigned i;
+  memb_bitmap_t mask;
 
-  /* Walk through the list of blocks and try to find the block to
-     which the pointer "ptr" points to. */
-  ptr2 = (char *)m->mem;
-  for(i = 0; i < m->num; ++i) {
-    if(ptr2 == (char *)ptr) {
-      /* We've found the block to which "ptr" points, so we check the allocation
-         status to detect the double-free error and free the block. */
-      if (m->used[i] == false)
-        return -1;
-      m->used[i] = false;
-      return 0;
-    }
-    ptr2 += m->size;
+  if(!memb_inmemb(m, ptr)) {
+    return -1;
   }
-  return -1;
+
+  /* Find the block index from the pointer offset and reject pointers
+     that are not at the beginning of a block. */
+  offset = (char *)ptr - (char *)m->mem;
+  if(offset % m->size != 0) {
+    return -1;
+  }
+  i = offset / m->size;
+
+  /* Check the allocation status to detect the double-free error and
+     free the block. */
+  mask = (memb_bitmap_t)1 << (i % MEMB_BITMAP_BITS);
+  if((m->used[i / MEMB_BITMAP_BITS] & mask) == 0) {
+    return -1;
+  }
+  m->used[i / MEMB_BITMAP_BITS] &= ~mask;
+  m->count--;
+  return 0;
 }
 /*---------------------------------------------------------------------------*/
 int
@@ -107,15 +136,6 @@ memb_inmemb(struct memb *m, void *ptr)
 int
 memb_numfree(struct memb *m)
 {
-  int i;
-  int num_free = 0;
-
-  for(i = 0; i < m->num; ++i) {
-    if(m->used[i] == false) {
-      ++num_free;
-    }
-  }
-
-  return num_free;
+  return m->num - m->count;
 }
 /** @} */
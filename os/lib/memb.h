@@ -48,6 +48,11 @@
  * memory by the memb_alloc() function, and are deallocated with the
  * memb_free() function.
  *
+ * The allocation status of the blocks is kept in a bitmap, so that
+ * memb_free() and memb_numfree() run in constant time and
+ * memb_alloc() only examines one bitmap word per
+ * MEMB_BITMAP_BITS blocks.
+ *
  * @{
  */
 
@@ -88,16 +93,31 @@ MEMB(connections, struct connection, 16);
  *
  */
 #define MEMB(name, structure, num) \
-        static bool CC_CONCAT(name,_memb_used)[num]; \
+        static memb_bitmap_t CC_CONCAT(name,_memb_used)[MEMB_BITMAP_WORDS(num)]; \
         static structure CC_CONCAT(name,_memb_mem)[num]; \
-        static struct memb name = {sizeof(structure), num, \
+        static struct memb name = {sizeof(structure), num, 0, \
                                           CC_CONCAT(name,_memb_used), \
                                           (void *)CC_CONCAT(name,_memb_mem)}
 
+/**
+ * The word type of the allocation bitmap. One bit per memory block
+ * is kept, set when the block is allocated. Using the native word
+ * size of the platform lets memb_alloc() skip a whole word of
+ * allocated blocks with a single comparison.
+ */
+typedef unsigned int memb_bitmap_t;
+
+/** Number of memory blocks tracked by one bitmap word. */
+#define MEMB_BITMAP_BITS (sizeof(memb_bitmap_t) * 8)
+
+/** Number of bitmap words needed to track \a num memory blocks. */
+#define MEMB_BITMAP_WORDS(num) (((num) + MEMB_BITMAP_BITS - 1) / MEMB_BITMAP_BITS)
+
 struct memb {
   unsigned short size;
   unsigned short num;
-  bool *used;
+  unsigned short count;
+  memb_bitmap_t *used;
   void *mem;
 };
 
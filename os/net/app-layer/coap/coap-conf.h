@@ -112,5 +112,22 @@
 #define COAP_OBSERVER_URL_LEN 20
 #endif
 
+/* Dispatch requests through a hash index of the resource paths instead of
+   walking the list of resources */
+#ifdef COAP_CONF_WITH_RESOURCE_INDEX
+#define COAP_WITH_RESOURCE_INDEX COAP_CONF_WITH_RESOURCE_INDEX
+#else
+#define COAP_WITH_RESOURCE_INDEX 0
+#endif /* COAP_CONF_WITH_RESOURCE_INDEX */
+
+/* Number of resources the index can hold, at about 10 bytes of RAM
+   each. Dispatch falls back to the list, with a warning, once more
+   resources are activated. */
+#ifdef COAP_CONF_RESOURCE_INDEX_SIZE
+#define COAP_RESOURCE_INDEX_SIZE COAP_CONF_RESOURCE_INDEX_SIZE
+#else
+#define COAP_RESOURCE_INDEX_SIZE 256
+#endif /* COAP_CONF_RESOURCE_INDEX_SIZE */
+
 #endif /* COAP_CONF_H_ */
 /** @} */
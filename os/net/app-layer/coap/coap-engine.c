@@ -44,6 +44,7 @@
 #include "coap-engine.h"
 #include "sys/cc.h"
 #include "lib/list.h"
+#include "lib/hash-index.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <inttypes.h>
@@ -72,6 +73,120 @@ LIST(coap_handlers);
 LIST(coap_resource_services);
 static uint8_t is_initialized = 0;
 
+#if COAP_WITH_RESOURCE_INDEX
+/* Hash index of the resources, keyed by URI path. The resources are
+   kept in list order in indexed_resources, and are only removed by
+   rebuilding the index. */
+HASH_INDEX(resource_hash, COAP_RESOURCE_INDEX_SIZE, NULL);
+
+static coap_resource_t *indexed_resources[COAP_RESOURCE_INDEX_SIZE];
+static uint16_t indexed_url_len[COAP_RESOURCE_INDEX_SIZE];
+static uint16_t indexed_count;
+/* Set when a resource did not fit in the index */
+static uint8_t index_overflow;
+
+/* A URI path, or a prefix of it, to look up */
+struct resource_key {
+  const char *url;
+  int url_len;
+  int len;
+  int *best;
+};
+/*---------------------------------------------------------------------------*/
+static uint32_t
+resource_hash_update(uint32_t h, char c)
+{
+  return h * 31 + (uint8_t)c;
+}
+/*---------------------------------------------------------------------------*/
+static void
+resource_index_add(coap_resource_t *resource)
+{
+  uint32_t h;
+  const char *c;
+
+  if(index_overflow) {
+    return;
+  }
+  if(indexed_count >= COAP_RESOURCE_INDEX_SIZE) {
+    LOG_WARN("Resource index full (%u), dispatching through the list\n",
+             COAP_RESOURCE_INDEX_SIZE);
+    index_overflow = 1;
+    return;
+  }
+
+  h = 0;
+  for(c = resource->url; *c != '\0'; c++) {
+    h = resource_hash_update(h, *c);
+  }
+  indexed_resources[indexed_count] = resource;
+  indexed_url_len[indexed_count] = c - resource->url;
+  hash_index_add(&resource_hash, h, indexed_count++);
+}
+/*---------------------------------------------------------------------------*/
+static void
+resource_index_rebuild(void)
+{
+  coap_resource_t *resource;
+
+  hash_index_clear(&resource_hash);
+  indexed_count = 0;
+  index_overflow = 0;
+  for(resource = list_head(coap_resource_services);
+      resource; resource = resource->next) {
+    resource_index_add(resource);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Keep the resource that comes first in the list of those that match
+   the prefix of the key */
+static int
+resource_index_match(uint16_t pos, const void *key)
+{
+  const struct resource_key *k = key;
+
+  if((*k->best < 0 || pos < *k->best)
+     && indexed_url_len[pos] == k->len
+     && (k->len == k->url_len
+         || (indexed_resources[pos]->flags & HAS_SUB_RESOURCES))
+     && (k->len == 0
+         || memcmp(indexed_resources[pos]->url, k->url, k->len) == 0)) {
+    *k->best = pos;
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * The URI path itself and each of its prefixes that ends before a '/'
+ * are looked up in the index as the path is hashed, so the cost depends
+ * on the length of the path rather than on the number of resources. Of
+ * all matches, the resource that comes first in the list wins, as with
+ * the list walk.
+ */
+static coap_resource_t *
+resource_index_find(const char *url, int url_len)
+{
+  struct resource_key key;
+  uint32_t h;
+  int best;
+
+  best = -1;
+  key.url = url;
+  key.url_len = url_len;
+  key.best = &best;
+  h = 0;
+  for(key.len = 0; key.len <= url_len; key.len++) {
+    if(key.len == url_len || url[key.len] == '/') {
+      hash_index_lookup(&resource_hash, h, resource_index_match, &key);
+    }
+    if(key.len < url_len) {
+      h = resource_hash_update(h, url[key.len]);
+    }
+  }
+  return best >= 0 ? indexed_resources[best] : NULL;
+}
+#endif /* COAP_WITH_RESOURCE_INDEX */
+
 /*---------------------------------------------------------------------------*/
 /*- CoAP service handlers---------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -379,6 +494,9 @@ coap_engine_init(void)
 
   list_init(coap_handlers);
   list_init(coap_resource_services);
+#if COAP_WITH_RESOURCE_INDEX
+  resource_index_rebuild();
+#endif /* COAP_WITH_RESOURCE_INDEX */
 
   coap_activate_resource(&res_well_known_core, ".well-known/core");
 
@@ -399,8 +517,19 @@ void
 coap_activate_resource(coap_resource_t *resource, const char *path)
 {
   coap_periodic_resource_t *periodic;
+#if COAP_WITH_RESOURCE_INDEX
+  /* A resource that is activated again moves to the end of the list */
+  uint8_t reactivated = resource->url != NULL;
+#endif /* COAP_WITH_RESOURCE_INDEX */
   resource->url = path;
   list_add(coap_resource_services, resource);
+#if COAP_WITH_RESOURCE_INDEX
+  if(reactivated) {
+    resource_index_rebuild();
+  } else {
+    resource_index_add(resource);
+  }
+#endif /* COAP_WITH_RESOURCE_INDEX */
 
   LOG_INFO("Activating: %s\n", resource->url);
 
@@ -432,19 +561,18 @@ coap_get_next_resource(coap_resource_t *resource)
   return list_item_next(resource);
 }
 /*---------------------------------------------------------------------------*/
-static int
-invoke_coap_resource_service(coap_message_t *request, coap_message_t *response,
-                             uint8_t *buffer, uint16_t buffer_size,
-                             int32_t *offset)
+static coap_resource_t *
+find_resource(const char *url, int url_len)
 {
-  uint8_t found = 0;
-  uint8_t allowed = 1;
+  coap_resource_t *resource;
+  int res_url_len;
 
-  coap_resource_t *resource = NULL;
-  const char *url = NULL;
-  int url_len, res_url_len;
+#if COAP_WITH_RESOURCE_INDEX
+  if(!index_overflow) {
+    return resource_index_find(url, url_len);
+  }
+#endif /* COAP_WITH_RESOURCE_INDEX */
 
-  url_len = coap_get_header_uri_path(request, &url);
   for(resource = list_head(coap_resource_services);
       resource; resource = resource->next) {
 
@@ -455,31 +583,50 @@ invoke_coap_resource_service(coap_message_t *request, coap_message_t *response,
             && (resource->flags & HAS_SUB_RESOURCES)
             && url[res_url_len] == '/'))
        && strncmp(resource->url, url, res_url_len) == 0) {
-      coap_resource_flags_t method = coap_get_method_type(request);
-      found = 1;
-
-      LOG_INFO("/%s, method %u, resource->flags %u\n", resource->url,
-               (uint16_t)method, resource->flags);
-
-      if((method & METHOD_GET) && resource->get_handler != NULL) {
-        /* call handler function */
-        resource->get_handler(request, response, buffer, buffer_size, offset);
-      } else if((method & METHOD_POST) && resource->post_handler != NULL) {
-        /* call handler function */
-        resource->post_handler(request, response, buffer, buffer_size,
+      return resource;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static int
+invoke_coap_resource_service(coap_message_t *request, coap_message_t *response,
+                             uint8_t *buffer, uint16_t buffer_size,
+                             int32_t *offset)
+{
+  uint8_t found = 0;
+  uint8_t allowed = 1;
+
+  coap_resource_t *resource = NULL;
+  const char *url = NULL;
+  int url_len;
+
+  url_len = coap_get_header_uri_path(request, &url);
+  resource = find_resource(url, url_len);
+  if(resource != NULL) {
+    coap_resource_flags_t method = coap_get_method_type(request);
+    found = 1;
+
+    LOG_INFO("/%s, method %u, resource->flags %u\n", resource->url,
+             (uint16_t)method, resource->flags);
+
+    if((method & METHOD_GET) && resource->get_handler != NULL) {
+      /* call handler function */
+      resource->get_handler(request, response, buffer, buffer_size, offset);
+    } else if((method & METHOD_POST) && resource->post_handler != NULL) {
+      /* call handler function */
+      resource->post_handler(request, response, buffer, buffer_size,
+                             offset);
+    } else if((method & METHOD_PUT) && resource->put_handler != NULL) {
+      /* call handler function */
+      resource->put_handler(request, response, buffer, buffer_size, offset);
+    } else if((method & METHOD_DELETE) && resource->delete_handler != NULL) {
+      /* call handler function */
+      resource->delete_handler(request, response, buffer, buffer_size,
                                offset);
-      } else if((method & METHOD_PUT) && resource->put_handler != NULL) {
-        /* call handler function */
-        resource->put_handler(request, response, buffer, buffer_size, offset);
-      } else if((method & METHOD_DELETE) && resource->delete_handler != NULL) {
-        /* call handler function */
-        resource->delete_handler(request, response, buffer, buffer_size,
-                                 offset);
-      } else {
-        allowed = 0;
-        coap_set_status_code(response, METHOD_NOT_ALLOWED_4_05);
-      }
-      break;
+    } else {
+      allowed = 0;
+      coap_set_status_code(response, METHOD_NOT_ALLOWED_4_05);
     }
   }
   if(!found) {
@@ -51,6 +51,7 @@
 #include "dev/watchdog.h"
 #include "os/lib/trickle-timer.h"
 #include "os/lib/list.h"
+#include "os/lib/hash-index.h"
 #include "sys/ctimer.h"
 #include <string.h>
 
@@ -201,6 +202,12 @@ struct mpl_msg {
 #define SEQ_VAL_ADD(s, n) (((s) + (n)) % 0x100)
 /*---------------------------------------------------------------------------*/
 /* Seed Set */
+#if MPL_WITH_SEED_WINDOW
+/* Bytes in a seed window, covering the whole sequence number space */
+#define SEED_WINDOW_LEN 32
+/* Largest encoded seed info: S=3 seed id and a full window */
+#define SEED_INFO_MAX_LEN (2 + 16 + SEED_WINDOW_LEN)
+#endif /* MPL_WITH_SEED_WINDOW */
 struct mpl_seed {
   seed_id_t seed_id;
   uint8_t min_seqno; /* Used when the seed set is empty */
@@ -208,6 +215,10 @@ struct mpl_seed {
   uint8_t count; /* Only used for determining largest msg set during reclaim */
   LIST_STRUCT(min_seq); /* Pointer to the first msg in this seed's set */
   struct mpl_domain *domain; /* The domain this seed belongs to */
+#if MPL_WITH_SEED_WINDOW
+  uint16_t window_bits; /* Offset of the last buffered message plus one */
+  uint8_t window[SEED_WINDOW_LEN]; /* Bit i set if min_seqno + i is buffered */
+#endif /* MPL_WITH_SEED_WINDOW */
 };
 /**
  * \brief Get the state of the used flag in the buffered message set entry
@@ -226,6 +237,13 @@ struct mpl_domain {
   uip_ip6addr_t ctrl_addr; /* Link-local scoped version of data address */
   struct trickle_timer tt;
   uint8_t e; /* Expiration count for trickle timer */
+#if MPL_WITH_SEED_WINDOW
+  uint8_t num_seeds; /* Number of seed sets in this domain */
+  uint8_t ctrl_valid; /* Whether ctrl_payload matches the seed sets */
+  uint16_t ctrl_len; /* Length of ctrl_payload */
+  uip_ip6addr_t ctrl_src; /* Source address ctrl_payload was encoded for */
+  uint8_t ctrl_payload[MPL_SEED_SET_SIZE * SEED_INFO_MAX_LEN];
+#endif /* MPL_WITH_SEED_WINDOW */
 };
 /**
  * \brief Get the state of the used flag in the buffered message set entry
@@ -465,6 +483,104 @@ extern uint16_t uip_slen;
 /*---------------------------------------------------------------------------*/
 static void icmp_in(void);
 UIP_ICMP6_HANDLER(mpl_icmp_handler, ICMP6_MPL, 0, icmp_in);
+#if MPL_WITH_SEED_WINDOW
+/*---------------------------------------------------------------------------*/
+/* Seed windows and the seed set hash index */
+/*---------------------------------------------------------------------------*/
+/* Hash index of the seed set, keyed by seed id and domain */
+struct seed_key {
+  const seed_id_t *seed_id;
+  const struct mpl_domain *domain;
+};
+
+static uint32_t seed_hash_entry(uint16_t pos);
+HASH_INDEX(seed_hash, MPL_SEED_SET_SIZE, seed_hash_entry);
+
+static uint32_t
+seed_key_hash(const seed_id_t *seed_id, const struct mpl_domain *domain)
+{
+  uint32_t w[4];
+
+  /* Fold the 128-bit seed id, shorter ids only use its first bytes */
+  memcpy(w, seed_id->id, sizeof(w));
+  return w[0] ^ (w[1] * 31) ^ (w[2] * 961) ^ (w[3] * 29791) ^ (domain - domain_set);
+}
+static uint32_t
+seed_hash_entry(uint16_t pos)
+{
+  return seed_key_hash(&seed_set[pos].seed_id, seed_set[pos].domain);
+}
+static int
+seed_hash_match(uint16_t pos, const void *key)
+{
+  const struct seed_key *k = key;
+
+  return seed_id_cmp(k->seed_id, &seed_set[pos].seed_id) &&
+         seed_set[pos].domain == k->domain;
+}
+static void
+seed_hash_insert(struct mpl_seed *s)
+{
+  hash_index_add(&seed_hash, seed_key_hash(&s->seed_id, s->domain), s - seed_set);
+}
+static void
+seed_hash_remove(struct mpl_seed *s)
+{
+  hash_index_remove(&seed_hash, seed_key_hash(&s->seed_id, s->domain), s - seed_set);
+}
+/**
+ * The seed window of a seed set has bit i set if the message with sequence
+ *  number min_seqno + i is buffered, using the same bit order as the bit
+ *  vectors of control messages. Every change to it makes the encoded control
+ *  message payload of the domain stale.
+ */
+static void
+seed_window_clear(struct mpl_seed *s)
+{
+  memset(s->window, 0, sizeof(s->window));
+  s->window_bits = 0;
+  s->domain->ctrl_valid = 0;
+}
+static void
+seed_window_set(struct mpl_seed *s, uint8_t seq)
+{
+  uint8_t offset = seq - s->min_seqno;
+
+  BIT_VECTOR_SET_BIT(s->window, offset);
+  if(offset >= s->window_bits) {
+    s->window_bits = offset + 1;
+  }
+  s->domain->ctrl_valid = 0;
+}
+static int
+seed_window_has(struct mpl_seed *s, uint8_t seq)
+{
+  uint8_t offset = seq - s->min_seqno;
+
+  return offset < s->window_bits && BIT_VECTOR_GET_BIT(s->window, offset);
+}
+/* Move the window forward by n sequence numbers, after min_seqno grew by n */
+static void
+seed_window_shift(struct mpl_seed *s, uint8_t n)
+{
+  uint8_t bytes = n / 8;
+  uint8_t bits = n % 8;
+  uint8_t i;
+
+  if(n >= s->window_bits) {
+    seed_window_clear(s);
+    return;
+  }
+  for(i = 0; i < SEED_WINDOW_LEN; i++) {
+    s->window[i] = i + bytes < SEED_WINDOW_LEN ? s->window[i + bytes] << bits : 0;
+    if(bits > 0 && i + bytes + 1 < SEED_WINDOW_LEN) {
+      s->window[i] |= s->window[i + bytes + 1] >> (8 - bits);
+    }
+  }
+  s->window_bits -= n;
+  s->domain->ctrl_valid = 0;
+}
+#endif /* MPL_WITH_SEED_WINDOW */
 
 static struct mpl_msg *
 buffer_allocate(void)
@@ -495,7 +611,7 @@ buffer_reclaim(void)
   /* Reclaim the message with min_seq in the largest seed set */
   largest = NULL;
   reclaim = NULL;
-  for(ssptr = &seed_set[MPL_SEED_SET_SIZE]; ssptr >= seed_set; ssptr--) {
+  for(ssptr = &seed_set[MPL_SEED_SET_SIZE - 1]; ssptr >= seed_set; ssptr--) {
     if(SEED_SET_IS_USED(ssptr) && (largest == NULL || ssptr->count > largest->count)) {
       largest = ssptr;
     }
@@ -512,6 +628,13 @@ buffer_reclaim(void)
     reclaim = list_pop(largest->min_seq);
     largest->min_seqno = list_item_next(reclaim) == NULL ? reclaim->seq : ((struct mpl_msg *)list_item_next(reclaim))->seq;
     largest->count--;
+#if MPL_WITH_SEED_WINDOW
+    if(list_head(largest->min_seq) == NULL) {
+      seed_window_clear(largest);
+    } else {
+      seed_window_shift(largest, largest->min_seqno - reclaim->seq);
+    }
+#endif /* MPL_WITH_SEED_WINDOW */
     trickle_timer_stop(&reclaim->tt);
     mpl_trickle_timer_reset(reclaim->seed->domain);
     memset(reclaim, 0, sizeof(struct mpl_msg));
@@ -573,12 +696,22 @@ domain_set_allocate(uip_ip6addr_t *address)
 static struct mpl_seed *
 seed_set_lookup(seed_id_t *seed_id, struct mpl_domain *domain)
 {
+#if MPL_WITH_SEED_WINDOW
+  struct seed_key key = { seed_id, domain };
+  int pos;
+
+  pos = hash_index_lookup(&seed_hash, seed_key_hash(seed_id, domain),
+                          seed_hash_match, &key);
+  locssptr = pos >= 0 ? &seed_set[pos] : NULL;
+  return locssptr;
+#else /* MPL_WITH_SEED_WINDOW */
   for(locssptr = &seed_set[MPL_SEED_SET_SIZE - 1]; locssptr >= seed_set; locssptr--) {
     if(SEED_SET_IS_USED(locssptr) && seed_id_cmp(seed_id, &locssptr->seed_id) && locssptr->domain == domain) {
       return locssptr;
     }
   }
   return NULL;
+#endif /* MPL_WITH_SEED_WINDOW */
 }
 static struct mpl_seed *
 seed_set_allocate(void)
@@ -598,6 +731,11 @@ seed_set_free(struct mpl_seed *s)
   while((locmmptr = list_pop(s->min_seq)) != NULL) {
     buffer_free(locmmptr);
   }
+#if MPL_WITH_SEED_WINDOW
+  seed_window_clear(s);
+  seed_hash_remove(s);
+  s->domain->num_seeds--;
+#endif /* MPL_WITH_SEED_WINDOW */
   SEED_SET_CLEAR_USED(s);
 }
 static struct mpl_domain *
@@ -618,7 +756,7 @@ domain_set_free(struct mpl_domain *domain)
 {
   uip_ds6_maddr_t *addr;
   /* Must include freeing seeds otherwise we leak memory */
-  for(locssptr = &seed_set[MPL_SEED_SET_SIZE]; locssptr >= seed_set; locssptr--) {
+  for(locssptr = &seed_set[MPL_SEED_SET_SIZE - 1]; locssptr >= seed_set; locssptr--) {
     if(SEED_SET_IS_USED(locssptr) && locssptr->domain == domain) {
       seed_set_free(locssptr);
     }
@@ -753,16 +891,74 @@ update_seed_id(void)
   LOG_DBG_SEED(local_seed_id);
   LOG_DBG_(" with S=%u\n", local_seed_id.s);
 }
+#if MPL_WITH_SEED_WINDOW
+/**
+ * Encode the seed info of all seed sets in the domain into its control
+ *  message payload, for the given source address. The bit vectors are
+ *  copied from the seed windows, so this is the same payload that walking
+ *  the buffered messages would give.
+ */
+static void
+ctrl_payload_encode(struct mpl_domain *dom, uip_ip6addr_t *src)
+{
+  struct seed_info *siptr;
+  struct mpl_seed *ssptr;
+  uint8_t vec_size;
+  size_t seed_info_len;
+
+  siptr = (struct seed_info *)dom->ctrl_payload;
+  dom->ctrl_len = 0;
+  for(ssptr = &seed_set[MPL_SEED_SET_SIZE - 1]; ssptr >= seed_set; ssptr--) {
+    if(SEED_SET_IS_USED(ssptr) && ssptr->domain == dom) {
+      siptr->min_seqno = ssptr->min_seqno;
+      siptr->bm_len_S = 0;
+
+      switch(ssptr->seed_id.s) {
+      case 0:
+        if(uip_ip6addr_cmp((uip_ip6addr_t *)&ssptr->seed_id.id, src)) {
+          seed_info_len = sizeof(struct seed_info);
+          break;
+        } /* Else fall down into the S = 3 case */
+      case 3:
+        seed_id_host_to_net(&((struct seed_info_s3 *)siptr)->seed_id, &ssptr->seed_id);
+        SEED_INFO_SET_S(siptr, 3);
+        seed_info_len = sizeof(struct seed_info_s3);
+        break;
+      case 1:
+        seed_id_host_to_net(&((struct seed_info_s1 *)siptr)->seed_id, &ssptr->seed_id);
+        SEED_INFO_SET_S(siptr, 1);
+        seed_info_len = sizeof(struct seed_info_s1);
+        break;
+      default:
+        seed_id_host_to_net(&((struct seed_info_s2 *)siptr)->seed_id, &ssptr->seed_id);
+        SEED_INFO_SET_S(siptr, 2);
+        seed_info_len = sizeof(struct seed_info_s2);
+        break;
+      }
+
+      vec_size = ssptr->window_bits == 0 ? 1 : (ssptr->window_bits - 1) / 8 + 1;
+      SEED_INFO_SET_LEN(siptr, vec_size);
+      memcpy(((uint8_t *)siptr) + seed_info_len, ssptr->window, vec_size);
+      siptr = (struct seed_info *)(((uint8_t *)siptr) + seed_info_len + vec_size);
+      dom->ctrl_len += seed_info_len + vec_size;
+    }
+  }
+  uip_ip6addr_copy(&dom->ctrl_src, src);
+  dom->ctrl_valid = 1;
+}
+#endif /* MPL_WITH_SEED_WINDOW */
 void
 icmp_out(struct mpl_domain *dom)
 {
+#if !MPL_WITH_SEED_WINDOW
   uint8_t vector[32];
   uint8_t vec_size;
   uint8_t vec_len;
   uint8_t cur_seq;
+  size_t seed_info_len;
+#endif /* !MPL_WITH_SEED_WINDOW */
   uint16_t payload_len;
   uip_ds6_addr_t *addr;
-  size_t seed_info_len;
 
   LOG_INFO("MPL Control Message Out\n");
 
@@ -779,6 +975,26 @@ icmp_out(struct mpl_domain *dom)
   uip_ip6addr_copy(&UIP_IP_BUF->destipaddr, &dom->ctrl_addr);
   uip_ds6_select_src(&UIP_IP_BUF->srcipaddr, &UIP_IP_BUF->destipaddr);
 
+#if MPL_WITH_SEED_WINDOW
+  if(dom->num_seeds > 0) {
+    /* Try setting our source address to global */
+    addr = uip_ds6_get_global(ADDR_PREFERRED);
+    if(addr) {
+      uip_ip6addr_copy(&UIP_IP_BUF->srcipaddr, &addr->ipaddr);
+    } else if(uip_is_addr_unspecified(&UIP_IP_BUF->srcipaddr)) {
+      LOG_ERR("icmp out: Cannot set src ip\n");
+      uipbuf_clear();
+      return;
+    }
+  }
+
+  /* Only encode the seed info again if it changed since the last time */
+  if(!dom->ctrl_valid || !uip_ip6addr_cmp(&dom->ctrl_src, &UIP_IP_BUF->srcipaddr)) {
+    ctrl_payload_encode(dom, &UIP_IP_BUF->srcipaddr);
+  }
+  payload_len = dom->ctrl_len;
+  memcpy(locsiptr, dom->ctrl_payload, payload_len);
+#else /* MPL_WITH_SEED_WINDOW */
   /* Iterate over seed set to create payload */
   for(locssptr = &seed_set[MPL_SEED_SET_SIZE - 1]; locssptr >= seed_set; locssptr--) {
     if(SEED_SET_IS_USED(locssptr) && locssptr->domain == dom) {
@@ -878,6 +1094,7 @@ icmp_out(struct mpl_domain *dom)
     }
     /* Now go to next seed in set */
   }
+#endif /* MPL_WITH_SEED_WINDOW */
   LOG_DBG("--- End of Messages --\n");
 
   /* Finish off construction of ICMP Packet */
@@ -1115,7 +1332,7 @@ icmp_in(void)
     locdsptr = domain_set_allocate(&UIP_IP_BUF->destipaddr);
     if(!locdsptr) {
       LOG_ERR("Couldn't allocate new domain. Dropping.\n");
-      UIP_MCAST6_STATS_ADD(icmp_bad);
+      MPL_STATS_ADD(icmp_bad);
       goto discard;
     }
     mpl_control_trickle_timer_start(locdsptr);
@@ -1509,7 +1726,12 @@ accept(uint8_t in)
       UIP_MCAST6_STATS_ADD(mcast_dropped);
       return UIP_MCAST6_DROP;
     }
+#if MPL_WITH_SEED_WINDOW
+    /* Only walk the message set when the window says we have this message */
+    if(seed_window_has(locssptr, seq_val)) {
+#else /* MPL_WITH_SEED_WINDOW */
     if(list_head(locssptr->min_seq) != NULL) {
+#endif /* MPL_WITH_SEED_WINDOW */
       for(locmmptr = list_head(locssptr->min_seq); locmmptr != NULL; locmmptr = list_item_next(locmmptr)) {
         if(SEQ_VAL_IS_EQ(seq_val, locmmptr->seq)) {
           /* Seen before , drop */
@@ -1541,6 +1763,11 @@ accept(uint8_t in)
     LIST_STRUCT_INIT(locssptr, min_seq);
     seed_id_cpy(&locssptr->seed_id, &seed_id);
     locssptr->domain = locdsptr;
+#if MPL_WITH_SEED_WINDOW
+    seed_hash_insert(locssptr);
+    locdsptr->num_seeds++;
+    locdsptr->ctrl_valid = 0;
+#endif /* MPL_WITH_SEED_WINDOW */
   }
 
   /* Allocate a buffer */
@@ -1592,6 +1819,9 @@ accept(uint8_t in)
   if(list_head(locssptr->min_seq) == NULL) {
     list_push(locssptr->min_seq, locmmptr);
     locssptr->min_seqno = locmmptr->seq;
+#if MPL_WITH_SEED_WINDOW
+    seed_window_clear(locssptr);
+#endif /* MPL_WITH_SEED_WINDOW */
   } else {
     for(mmiterptr = list_head(locssptr->min_seq); mmiterptr != NULL; mmiterptr = list_item_next(mmiterptr)) {
       if(list_item_next(mmiterptr) == NULL
@@ -1602,6 +1832,9 @@ accept(uint8_t in)
     }
   }
   locssptr->count++;
+#if MPL_WITH_SEED_WINDOW
+  seed_window_set(locssptr, locmmptr->seq);
+#endif /* MPL_WITH_SEED_WINDOW */
 
 #if MPL_PROACTIVE_FORWARDING
   /* Start Forwarding the message */
@@ -1772,6 +2005,9 @@ init(void)
   memset(domain_set, 0, sizeof(struct mpl_domain) * MPL_DOMAIN_SET_SIZE);
   memset(seed_set, 0, sizeof(struct mpl_seed) * MPL_SEED_SET_SIZE);
   memset(buffered_message_set, 0, sizeof(struct mpl_msg) * MPL_BUFFERED_MESSAGE_SET_SIZE);
+#if MPL_WITH_SEED_WINDOW
+  hash_index_clear(&seed_hash);
+#endif /* MPL_WITH_SEED_WINDOW */
 
   /* Register the ICMPv6 input handler */
   uip_icmp6_register_input_handler(&mpl_icmp_handler);
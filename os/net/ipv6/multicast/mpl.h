@@ -269,6 +269,23 @@
 #define MPL_CONTROL_MESSAGE_TIMER_EXPIRATIONS MPL_CONF_CONTROL_MESSAGE_TIMER_EXPIRATIONS
 #endif
 /*---------------------------------------------------------------------------*/
+/**
+ * Seed Windows
+ * With seed windows enabled, every seed set keeps the sequence numbers of
+ * its buffered messages as a bitmap relative to its minimum sequence
+ * number, and seed sets are found through a hash index. Duplicate
+ * messages are then detected without walking the message list, and the
+ * seed info of control messages is kept encoded per domain, only rebuilt
+ * when a seed set changes rather than on every trickle timer expiration.
+ * 1 - Indicates that seed windows be enabled
+ * 0 - Indicates that seed windows be disabled
+ */
+#ifndef MPL_CONF_WITH_SEED_WINDOW
+#define MPL_WITH_SEED_WINDOW                0
+#else
+#define MPL_WITH_SEED_WINDOW MPL_CONF_WITH_SEED_WINDOW
+#endif
+/*---------------------------------------------------------------------------*/
 /* Misc System Config */
 /*---------------------------------------------------------------------------*/
 
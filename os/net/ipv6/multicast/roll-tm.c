@@ -46,6 +46,7 @@
 #include "net/ipv6/uip-icmp6.h"
 #include "net/ipv6/multicast/uip-mcast6.h"
 #include "net/ipv6/multicast/roll-tm.h"
+#include "net/ipv6/multicast/uip-mcast6-dup.h"
 #include "dev/watchdog.h"
 #include <string.h>
 
@@ -609,6 +610,9 @@ handle_timer(void *ptr)
           PRINTF("\n");
           window_free(locmpptr->sw);
         }
+#if UIP_MCAST6_DUP_FILTER
+        uip_mcast6_dup_remove(locmpptr->sw, locmpptr->seq_val);
+#endif
         MCAST_PACKET_FREE(locmpptr);
       } else if(MCAST_PACKET_TTL(locmpptr) > 0) {
         /* Handle multicast transmissions */
@@ -765,6 +769,9 @@ buffer_reclaim()
        SEQ_VAL_IS_EQ(locmpptr->seq_val, largest->lower_bound)) {
       rv = locmpptr;
       PRINTF("ROLL TM: Reclaim seq. val %u\n", locmpptr->seq_val);
+#if UIP_MCAST6_DUP_FILTER
+      uip_mcast6_dup_remove(rv->sw, rv->seq_val);
+#endif
       MCAST_PACKET_FREE(rv);
       largest->count--;
       window_update_bounds();
@@ -972,6 +979,14 @@ accept(uint8_t in)
       UIP_MCAST6_STATS_ADD(mcast_dropped);
       return UIP_MCAST6_DROP;
     }
+#if UIP_MCAST6_DUP_FILTER
+    /* A hit is a buffered message, a miss still needs the scan below */
+    if(uip_mcast6_dup_check(locswptr, seq_val)) {
+      PRINTF("ROLL TM: Seen before\n");
+      UIP_MCAST6_STATS_ADD(mcast_dropped);
+      return UIP_MCAST6_DROP;
+    }
+#endif
     for(locmpptr = &buffered_msgs[ROLL_TM_BUFF_NUM - 1];
         locmpptr >= buffered_msgs; locmpptr--) {
       if(MCAST_PACKET_IS_USED(locmpptr) &&
@@ -1057,6 +1072,9 @@ accept(uint8_t in)
   locmpptr->buff_len = uip_len;
   locmpptr->seq_val = seq_val;
   MCAST_PACKET_USED_SET(locmpptr);
+#if UIP_MCAST6_DUP_FILTER
+  uip_mcast6_dup_add(locswptr, seq_val);
+#endif
 
   PRINTF("ROLL TM: Window for seed ");
   PRINT_SEED(&locswptr->seed_id);
@@ -1408,6 +1426,9 @@ init()
   memset(windows, 0, sizeof(windows));
   memset(buffered_msgs, 0, sizeof(buffered_msgs));
   memset(t, 0, sizeof(t));
+#if UIP_MCAST6_DUP_FILTER
+  uip_mcast6_dup_init();
+#endif
 
   ROLL_TM_STATS_INIT();
   UIP_MCAST6_STATS_INIT(&stats);
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * \addtogroup uip-multicast
+ * @{
+ */
+/**
+ * \file
+ *    Multicast duplicate filter
+ *
+ *    Every pair has two candidate entries, chosen by two hashes of the pair.
+ *    Lookups check both. Insertions use a free one or replace the older
+ *    of the two.
+ */
+#include "contiki.h"
+#include "net/ipv6/multicast/uip-mcast6-dup.h"
+#include "net/ipv6/multicast/uip-mcast6-stats.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if UIP_MCAST6_DUP_FILTER
+/*---------------------------------------------------------------------------*/
+#if UIP_MCAST6_DUP_FILTER_ENTRIES < 2 || \
+  (UIP_MCAST6_DUP_FILTER_ENTRIES & (UIP_MCAST6_DUP_FILTER_ENTRIES - 1)) != 0
+#error "UIP_MCAST6_CONF_DUP_FILTER_ENTRIES must be a power of two"
+#endif
+
+#define ENTRY_MASK (UIP_MCAST6_DUP_FILTER_ENTRIES - 1)
+
+struct dup_entry {
+  const void *origin; /* NULL if the entry is free */
+  uint16_t seq;
+  uint16_t stamp; /* Value of the insertion counter when added */
+};
+
+static struct dup_entry entries[UIP_MCAST6_DUP_FILTER_ENTRIES];
+static uint16_t insertions;
+/*---------------------------------------------------------------------------*/
+static uint32_t
+pair_hash(const void *origin, uint16_t seq)
+{
+  uint32_t h = (uint32_t)(uintptr_t)origin ^ ((uint32_t)seq << 16) ^ seq;
+
+  h ^= h >> 16;
+  h *= 0x45d9f3b;
+  h ^= h >> 16;
+  return h;
+}
+/*---------------------------------------------------------------------------*/
+static struct dup_entry *
+find(const void *origin, uint16_t seq, struct dup_entry **first,
+     struct dup_entry **second)
+{
+  uint32_t h = pair_hash(origin, seq);
+
+  *first = &entries[h & ENTRY_MASK];
+  *second = &entries[((h >> 16) ^ 1) & ENTRY_MASK];
+  if(*second == *first) {
+    *second = &entries[(h + 1) & ENTRY_MASK];
+  }
+  if((*first)->origin == origin && (*first)->seq == seq) {
+    return *first;
+  }
+  if((*second)->origin == origin && (*second)->seq == seq) {
+    return *second;
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_mcast6_dup_init(void)
+{
+  memset(entries, 0, sizeof(entries));
+  insertions = 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+uip_mcast6_dup_check(const void *origin, uint16_t seq)
+{
+  struct dup_entry *first;
+  struct dup_entry *second;
+
+  UIP_MCAST6_STATS_ADD(dup_lookups);
+  if(find(origin, seq, &first, &second) != NULL) {
+    UIP_MCAST6_STATS_ADD(dup_hits);
+    return 1;
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_mcast6_dup_add(const void *origin, uint16_t seq)
+{
+  struct dup_entry *first;
+  struct dup_entry *second;
+  struct dup_entry *e;
+
+  e = find(origin, seq, &first, &second);
+  if(e == NULL) {
+    if(first->origin == NULL) {
+      e = first;
+    } else if(second->origin == NULL) {
+      e = second;
+    } else {
+      /* Replace the older entry */
+      e = (int16_t)(first->stamp - second->stamp) < 0 ? first : second;
+    }
+  }
+  e->origin = origin;
+  e->seq = seq;
+  e->stamp = insertions++;
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_mcast6_dup_remove(const void *origin, uint16_t seq)
+{
+  struct dup_entry *first;
+  struct dup_entry *second;
+  struct dup_entry *e;
+
+  e = find(origin, seq, &first, &second);
+  if(e != NULL) {
+    e->origin = NULL;
+  }
+}
+/*---------------------------------------------------------------------------*/
+#endif /* UIP_MCAST6_DUP_FILTER */
+/** @} */
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * \addtogroup uip-multicast
+ * @{
+ */
+/**
+ * \file
+ *    Header file for the multicast duplicate filter
+ *
+ *    A small fixed-size table of (origin, sequence number) pairs that an
+ *    engine has buffered, so that duplicates of buffered datagrams can be
+ *    dropped without scanning the buffers. The origin is a pointer to the
+ *    engine's own per-seed state, e.g. a sliding window.
+ *
+ *    The table may forget pairs when it is full. A miss is therefore not
+ *    proof that a datagram is new and engines must still check their
+ *    buffers, while a hit always is a duplicate as long as engines remove
+ *    pairs when they free the corresponding buffers.
+ */
+#ifndef UIP_MCAST6_DUP_H_
+#define UIP_MCAST6_DUP_H_
+
+#include "contiki.h"
+
+#include <stdint.h>
+/*---------------------------------------------------------------------------*/
+/* Enable the duplicate filter in engines that support it */
+#ifdef UIP_MCAST6_CONF_DUP_FILTER
+#define UIP_MCAST6_DUP_FILTER UIP_MCAST6_CONF_DUP_FILTER
+#else
+#define UIP_MCAST6_DUP_FILTER 0
+#endif
+
+/* Number of entries in the filter, must be a power of two */
+#ifdef UIP_MCAST6_CONF_DUP_FILTER_ENTRIES
+#define UIP_MCAST6_DUP_FILTER_ENTRIES UIP_MCAST6_CONF_DUP_FILTER_ENTRIES
+#else
+#define UIP_MCAST6_DUP_FILTER_ENTRIES 16
+#endif
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Initialise the duplicate filter, forgetting all entries
+ */
+void uip_mcast6_dup_init(void);
+
+/**
+ * \brief Check whether a datagram is a known duplicate
+ * \param origin The engine's state for the seed of the datagram
+ * \param seq The sequence number of the datagram
+ * \return 1 if the datagram is buffered, 0 if it is unknown to the filter
+ */
+int uip_mcast6_dup_check(const void *origin, uint16_t seq);
+
+/**
+ * \brief Remember that a datagram is buffered
+ * \param origin The engine's state for the seed of the datagram
+ * \param seq The sequence number of the datagram
+ *
+ * When both candidate entries are in use, the older one is replaced.
+ */
+void uip_mcast6_dup_add(const void *origin, uint16_t seq);
+
+/**
+ * \brief Forget a datagram, after its buffer was freed
+ * \param origin The engine's state for the seed of the datagram
+ * \param seq The sequence number of the datagram
+ */
+void uip_mcast6_dup_remove(const void *origin, uint16_t seq);
+/*---------------------------------------------------------------------------*/
+#endif /* UIP_MCAST6_DUP_H_ */
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -41,10 +41,12 @@
  */
 
 #include "contiki.h"
+#include "lib/hash-index.h"
 #include "lib/list.h"
 #include "lib/memb.h"
 #include "net/ipv6/uip.h"
 #include "net/ipv6/multicast/uip-mcast6-route.h"
+#include "net/ipv6/multicast/uip-mcast6-stats.h"
 
 #include <stdint.h>
 #include <string.h>
@@ -56,32 +58,101 @@
 #else
 #define UIP_MCAST6_ROUTE_ROUTES 1
 #endif /* UIP_CONF_DS6_MCAST_ROUTES */
+
+/* Find routes through a hash index of the groups instead of the list */
+#ifdef UIP_MCAST6_ROUTE_CONF_WITH_HASH_INDEX
+#define UIP_MCAST6_ROUTE_WITH_HASH_INDEX UIP_MCAST6_ROUTE_CONF_WITH_HASH_INDEX
+#else
+#define UIP_MCAST6_ROUTE_WITH_HASH_INDEX 0
+#endif
 /*---------------------------------------------------------------------------*/
 LIST(mcast_route_list);
 MEMB(mcast_route_memb, uip_mcast6_route_t, UIP_MCAST6_ROUTE_ROUTES);
 
 static uip_mcast6_route_t *locmcastrt;
+
+#if UIP_MCAST6_ROUTE_WITH_HASH_INDEX
+/* Hash index of the routes in mcast_route_memb, keyed by group */
+static uint32_t route_hash_entry(uint16_t pos);
+HASH_INDEX(route_hash, UIP_MCAST6_ROUTE_ROUTES, route_hash_entry);
 /*---------------------------------------------------------------------------*/
-uip_mcast6_route_t *
-uip_mcast6_route_lookup(uip_ipaddr_t *group)
+static uint32_t
+group_hash(const uip_ipaddr_t *group)
 {
-  locmcastrt = NULL;
-  for(locmcastrt = list_head(mcast_route_list);
-      locmcastrt != NULL;
-      locmcastrt = list_item_next(locmcastrt)) {
-    if(uip_ipaddr_cmp(&locmcastrt->group, group)) {
-      return locmcastrt;
-    }
+  uint32_t h;
+
+  h = group->u16[0] ^ ((uint32_t)group->u16[1] << 16);
+  h = (h * 31) ^ (group->u16[2] ^ ((uint32_t)group->u16[3] << 16));
+  h = (h * 31) ^ (group->u16[4] ^ ((uint32_t)group->u16[5] << 16));
+  h = (h * 31) ^ (group->u16[6] ^ ((uint32_t)group->u16[7] << 16));
+  return h;
+}
+/*---------------------------------------------------------------------------*/
+static uip_mcast6_route_t *
+route_at(uint16_t pos)
+{
+  return (uip_mcast6_route_t *)mcast_route_memb.mem + pos;
+}
+/*---------------------------------------------------------------------------*/
+static uint16_t
+route_pos(const uip_mcast6_route_t *route)
+{
+  return route - (uip_mcast6_route_t *)mcast_route_memb.mem;
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+route_hash_entry(uint16_t pos)
+{
+  return group_hash(&route_at(pos)->group);
+}
+/*---------------------------------------------------------------------------*/
+static int
+route_hash_match(uint16_t pos, const void *group)
+{
+  return uip_ipaddr_cmp(&route_at(pos)->group, (const uip_ipaddr_t *)group);
+}
+#endif /* UIP_MCAST6_ROUTE_WITH_HASH_INDEX */
+/*---------------------------------------------------------------------------*/
+static uip_mcast6_route_t *
+route_find(const uip_ipaddr_t *group)
+{
+#if UIP_MCAST6_ROUTE_WITH_HASH_INDEX
+  int pos;
+
+  pos = hash_index_lookup(&route_hash, group_hash(group), route_hash_match,
+                          group);
+  if(pos >= 0) {
+    return route_at(pos);
   }
+#else /* UIP_MCAST6_ROUTE_WITH_HASH_INDEX */
+  uip_mcast6_route_t *r;
 
+  for(r = list_head(mcast_route_list); r != NULL; r = list_item_next(r)) {
+    if(uip_ipaddr_cmp(&r->group, group)) {
+      return r;
+    }
+  }
+#endif /* UIP_MCAST6_ROUTE_WITH_HASH_INDEX */
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
 uip_mcast6_route_t *
+uip_mcast6_route_lookup(uip_ipaddr_t *group)
+{
+  locmcastrt = route_find(group);
+
+  UIP_MCAST6_STATS_ADD(route_lookups);
+  if(locmcastrt != NULL) {
+    UIP_MCAST6_STATS_ADD(route_hits);
+  }
+  return locmcastrt;
+}
+/*---------------------------------------------------------------------------*/
+uip_mcast6_route_t *
 uip_mcast6_route_add(uip_ipaddr_t *group)
 {
-  /* _lookup must return NULL, i.e. the prefix does not exist in our table */
-  locmcastrt = uip_mcast6_route_lookup(group);
+  /* The group must not exist in our table yet */
+  locmcastrt = route_find(group);
   if(locmcastrt == NULL) {
     /* Allocate an entry and add the group to the list */
     locmcastrt = memb_alloc(&mcast_route_memb);
@@ -89,11 +160,13 @@ uip_mcast6_route_add(uip_ipaddr_t *group)
       return NULL;
     }
     list_add(mcast_route_list, locmcastrt);
+    uip_ipaddr_copy(&(locmcastrt->group), group);
+#if UIP_MCAST6_ROUTE_WITH_HASH_INDEX
+    hash_index_add(&route_hash, group_hash(group), route_pos(locmcastrt));
+#endif /* UIP_MCAST6_ROUTE_WITH_HASH_INDEX */
   }
 
-  /* Reaching here means we either found the prefix or allocated a new one */
-
-  uip_ipaddr_copy(&(locmcastrt->group), group);
+  /* Reaching here means we either found the group or allocated a new one */
 
   return locmcastrt;
 }
@@ -107,6 +180,10 @@ uip_mcast6_route_rm(uip_mcast6_route_t *route)
       locmcastrt = list_item_next(locmcastrt)) {
     if(locmcastrt == route) {
       list_remove(mcast_route_list, route);
+#if UIP_MCAST6_ROUTE_WITH_HASH_INDEX
+      hash_index_remove(&route_hash, group_hash(&route->group),
+                        route_pos(route));
+#endif /* UIP_MCAST6_ROUTE_WITH_HASH_INDEX */
       memb_free(&mcast_route_memb, route);
       return;
     }
@@ -130,6 +207,9 @@ uip_mcast6_route_init()
 {
   memb_init(&mcast_route_memb);
   list_init(mcast_route_list);
+#if UIP_MCAST6_ROUTE_WITH_HASH_INDEX
+  hash_index_clear(&route_hash);
+#endif /* UIP_MCAST6_ROUTE_WITH_HASH_INDEX */
 }
 /*---------------------------------------------------------------------------*/
 /** @} */
@@ -87,6 +87,18 @@ typedef struct uip_mcast6_stats {
   /** Count of multicast datagrams correclty formed but dropped by us */
   UIP_MCAST6_STATS_DATATYPE mcast_dropped;
 
+  /** Count of multicast routing table lookups */
+  UIP_MCAST6_STATS_DATATYPE route_lookups;
+
+  /** Count of multicast routing table lookups that found a route */
+  UIP_MCAST6_STATS_DATATYPE route_hits;
+
+  /** Count of duplicate filter lookups */
+  UIP_MCAST6_STATS_DATATYPE dup_lookups;
+
+  /** Count of duplicate filter lookups that found a duplicate */
+  UIP_MCAST6_STATS_DATATYPE dup_hits;
+
   /** Opaque pointer to an engine's additional stats */
   void *engine_stats;
 } uip_mcast6_stats_t;
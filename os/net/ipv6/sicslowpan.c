@@ -239,6 +239,48 @@ static uint16_t my_tag;
 /* Assuming that the worst growth for uncompression is 38 bytes */
 #define SICSLOWPAN_FIRST_FRAGMENT_SIZE (SICSLOWPAN_FRAGMENT_SIZE + 38)
 
+/* Index the reassembly contexts by sender and tag through a small hash
+ * table, and chain the fragment buffers of each context so that storing,
+ * reassembling and clearing only touch the buffers of that context. */
+#ifdef SICSLOWPAN_CONF_REASS_WITH_INDEX
+#define SICSLOWPAN_REASS_WITH_INDEX SICSLOWPAN_CONF_REASS_WITH_INDEX
+#else
+#define SICSLOWPAN_REASS_WITH_INDEX 0
+#endif
+
+/* Give each reassembly context a buffer for the whole IPv6 packet and
+ * write every fragment straight to its final offset on arrival. This
+ * uses UIP_BUFSIZE bytes per context instead of the shared fragment
+ * buffers, and completing a packet is then a single copy to uip_buf. */
+#ifdef SICSLOWPAN_CONF_REASS_DIRECT
+#define SICSLOWPAN_REASS_DIRECT SICSLOWPAN_CONF_REASS_DIRECT
+#else
+#define SICSLOWPAN_REASS_DIRECT 0
+#endif
+
+#if SICSLOWPAN_REASS_DIRECT
+#define SICSLOWPAN_REASS_BUF_SIZE UIP_BUFSIZE
+#else
+#define SICSLOWPAN_REASS_BUF_SIZE SICSLOWPAN_FIRST_FRAGMENT_SIZE
+#endif
+
+/* Fragment forwarding (RFC 8930 virtual reassembly buffers): a router
+ * decides where to send a datagram from the headers in its first
+ * fragment, and relays the following fragments under a new tag as they
+ * arrive instead of reassembling the whole packet at every hop. */
+#ifdef SICSLOWPAN_CONF_FRAG_FORWARDING
+#define SICSLOWPAN_FRAG_FORWARDING SICSLOWPAN_CONF_FRAG_FORWARDING
+#else
+#define SICSLOWPAN_FRAG_FORWARDING 0
+#endif
+
+/* Number of datagrams that can be forwarded fragment by fragment at once */
+#ifdef SICSLOWPAN_CONF_VRB_ENTRIES
+#define SICSLOWPAN_VRB_ENTRIES SICSLOWPAN_CONF_VRB_ENTRIES
+#else
+#define SICSLOWPAN_VRB_ENTRIES 4
+#endif
+
 /* all information needed for reassembly */
 struct sicslowpan_frag_info {
   /** When reassembling, the source address of the fragments being merged */
@@ -253,16 +295,26 @@ struct sicslowpan_frag_info {
   uint16_t reassembled_len;
   /** Reassembly %process %timer. */
   struct timer reass_timer;
+#if SICSLOWPAN_REASS_WITH_INDEX
+  /** Set while the context is in the hash table */
+  uint8_t indexed;
+#endif
+#if SICSLOWPAN_REASS_WITH_INDEX && !SICSLOWPAN_REASS_DIRECT
+  /** First fragment buffer of this context, plus one (0 if none) */
+  uint8_t frag_head;
+#endif
 
   /** Fragment size of first fragment */
   uint16_t first_frag_len;
   /** First fragment - needs a larger buffer since the size is uncompressed size
-   and we need to know total size to know when we have received last fragment. */
-  uint8_t first_frag[SICSLOWPAN_FIRST_FRAGMENT_SIZE];
+   and we need to know total size to know when we have received last fragment.
+   With SICSLOWPAN_REASS_DIRECT, this holds the whole packet. */
+  uint8_t first_frag[SICSLOWPAN_REASS_BUF_SIZE];
 };
 
 static struct sicslowpan_frag_info frag_info[SICSLOWPAN_REASS_CONTEXTS];
 
+#if !SICSLOWPAN_REASS_DIRECT
 struct sicslowpan_frag_buf {
   /* the index of the frag_info */
   uint8_t index;
@@ -270,18 +322,155 @@ struct sicslowpan_frag_buf {
   uint8_t offset;
   /* Length of this fragment (if zero this buffer is not allocated) */
   uint8_t len;
+#if SICSLOWPAN_REASS_WITH_INDEX
+  /* Next buffer of the same context or of the free list, plus one */
+  uint8_t next;
+#endif
   uint8_t data[SICSLOWPAN_FRAGMENT_SIZE];
 };
 
 static struct sicslowpan_frag_buf frag_buf[SICSLOWPAN_FRAGMENT_BUFFERS];
 
+#if SICSLOWPAN_REASS_WITH_INDEX
+#if SICSLOWPAN_FRAGMENT_BUFFERS > 255
+#error SICSLOWPAN_REASS_WITH_INDEX supports at most 255 fragment buffers
+#endif
+/* First free fragment buffer, plus one (0 if none) */
+static uint8_t frag_free;
+#endif /* SICSLOWPAN_REASS_WITH_INDEX */
+#endif /* !SICSLOWPAN_REASS_DIRECT */
+
+#if SICSLOWPAN_REASS_WITH_INDEX
+/*
+ * Open-addressing hash table over the reassembly contexts in use, keyed
+ * by sender and tag. Slots hold the context index plus one (0 is empty),
+ * and the table is at least twice as large as the number of contexts.
+ */
+#if SICSLOWPAN_REASS_CONTEXTS <= 2
+#define REASS_HASH_SLOTS 4
+#elif SICSLOWPAN_REASS_CONTEXTS <= 4
+#define REASS_HASH_SLOTS 8
+#elif SICSLOWPAN_REASS_CONTEXTS <= 8
+#define REASS_HASH_SLOTS 16
+#elif SICSLOWPAN_REASS_CONTEXTS <= 16
+#define REASS_HASH_SLOTS 32
+#elif SICSLOWPAN_REASS_CONTEXTS <= 32
+#define REASS_HASH_SLOTS 64
+#elif SICSLOWPAN_REASS_CONTEXTS <= 64
+#define REASS_HASH_SLOTS 128
+#else
+#define REASS_HASH_SLOTS 256
+#endif
+#define REASS_HASH_MASK (REASS_HASH_SLOTS - 1)
+
+static uint8_t reass_hash[REASS_HASH_SLOTS];
+/*---------------------------------------------------------------------------*/
+static uint8_t
+reass_hash_slot(const linkaddr_t *sender, uint16_t tag)
+{
+  uint16_t h;
+  int i;
+
+  h = tag;
+  for(i = 0; i < LINKADDR_SIZE; i++) {
+    h = h * 31 + sender->u8[i];
+  }
+  h ^= h >> 8;
+  return h & REASS_HASH_MASK;
+}
+/*---------------------------------------------------------------------------*/
+static void
+reass_hash_insert(uint8_t context)
+{
+  uint8_t slot;
+
+  slot = reass_hash_slot(&frag_info[context].sender, frag_info[context].tag);
+  while(reass_hash[slot] != 0) {
+    slot = (slot + 1) & REASS_HASH_MASK;
+  }
+  reass_hash[slot] = context + 1;
+  frag_info[context].indexed = 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+reass_hash_remove(uint8_t context)
+{
+  uint8_t slot;
+  uint8_t next;
+  uint8_t home;
+
+  frag_info[context].indexed = 0;
+  slot = reass_hash_slot(&frag_info[context].sender, frag_info[context].tag);
+  while(reass_hash[slot] != context + 1) {
+    if(reass_hash[slot] == 0) {
+      return;
+    }
+    slot = (slot + 1) & REASS_HASH_MASK;
+  }
+
+  /* Backward-shift deletion keeps the probe sequences unbroken */
+  next = slot;
+  for(;;) {
+    next = (next + 1) & REASS_HASH_MASK;
+    if(reass_hash[next] == 0) {
+      break;
+    }
+    home = reass_hash_slot(&frag_info[reass_hash[next] - 1].sender,
+                           frag_info[reass_hash[next] - 1].tag);
+    if(((next - home) & REASS_HASH_MASK) >= ((next - slot) & REASS_HASH_MASK)) {
+      reass_hash[slot] = reass_hash[next];
+      slot = next;
+    }
+  }
+  reass_hash[slot] = 0;
+}
+#endif /* SICSLOWPAN_REASS_WITH_INDEX */
+/*---------------------------------------------------------------------------*/
+static void
+init_fragments(void)
+{
+#if SICSLOWPAN_REASS_WITH_INDEX && !SICSLOWPAN_REASS_DIRECT
+  int i;
+
+  /* Chain all fragment buffers into the free list */
+  for(i = 0; i < SICSLOWPAN_FRAGMENT_BUFFERS; i++) {
+    frag_buf[i].len = 0;
+    frag_buf[i].next = i + 2;
+  }
+  frag_buf[SICSLOWPAN_FRAGMENT_BUFFERS - 1].next = 0;
+  frag_free = 1;
+#endif /* SICSLOWPAN_REASS_WITH_INDEX && !SICSLOWPAN_REASS_DIRECT */
+}
 /*---------------------------------------------------------------------------*/
 static int
 clear_fragments(uint8_t frag_info_index)
 {
-  int i, clear_count;
+  int clear_count;
+#if SICSLOWPAN_REASS_WITH_INDEX && !SICSLOWPAN_REASS_DIRECT
+  uint8_t b;
+  uint8_t next;
+#elif !SICSLOWPAN_REASS_DIRECT
+  int i;
+#endif
+
   clear_count = 0;
+#if SICSLOWPAN_REASS_WITH_INDEX
+  if(frag_info[frag_info_index].indexed) {
+    reass_hash_remove(frag_info_index);
+  }
+#endif /* SICSLOWPAN_REASS_WITH_INDEX */
   frag_info[frag_info_index].len = 0;
+#if SICSLOWPAN_REASS_WITH_INDEX && !SICSLOWPAN_REASS_DIRECT
+  /* Return the chain of this context to the free list */
+  for(b = frag_info[frag_info_index].frag_head; b != 0; b = next) {
+    next = frag_buf[b - 1].next;
+    frag_buf[b - 1].len = 0;
+    frag_buf[b - 1].next = frag_free;
+    frag_free = b;
+    clear_count++;
+  }
+  frag_info[frag_info_index].frag_head = 0;
+#elif !SICSLOWPAN_REASS_DIRECT
   for(i = 0; i < SICSLOWPAN_FRAGMENT_BUFFERS; i++) {
     if(frag_buf[i].len > 0 && frag_buf[i].index == frag_info_index) {
       /* deallocate the buffer */
@@ -289,9 +478,43 @@ clear_fragments(uint8_t frag_info_index)
       clear_count++;
     }
   }
+#endif
   return clear_count;
 }
 /*---------------------------------------------------------------------------*/
+/* Find the context reassembling the packet with the given tag from the
+   sender of the packet in packetbuf */
+static int8_t
+find_context(uint16_t tag)
+{
+  const linkaddr_t *sender = packetbuf_addr(PACKETBUF_ADDR_SENDER);
+#if SICSLOWPAN_REASS_WITH_INDEX
+  uint8_t slot;
+  uint8_t i;
+
+  for(slot = reass_hash_slot(sender, tag);
+      reass_hash[slot] != 0;
+      slot = (slot + 1) & REASS_HASH_MASK) {
+    i = reass_hash[slot] - 1;
+    if(frag_info[i].tag == tag && frag_info[i].len > 0 &&
+       linkaddr_cmp(&frag_info[i].sender, sender)) {
+      return i;
+    }
+  }
+#else /* SICSLOWPAN_REASS_WITH_INDEX */
+  int i;
+
+  for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
+    if(frag_info[i].tag == tag && frag_info[i].len > 0 &&
+       linkaddr_cmp(&frag_info[i].sender, sender)) {
+      /* Tag and Sender match - this must be the correct info to store in */
+      return i;
+    }
+  }
+#endif /* SICSLOWPAN_REASS_WITH_INDEX */
+  return -1;
+}
+/*---------------------------------------------------------------------------*/
 static int
 timeout_fragments(int not_context)
 {
@@ -310,7 +533,11 @@ timeout_fragments(int not_context)
 static int
 store_fragment(uint8_t index, uint8_t offset)
 {
+#if SICSLOWPAN_REASS_WITH_INDEX && !SICSLOWPAN_REASS_DIRECT
+  uint8_t b;
+#elif !SICSLOWPAN_REASS_DIRECT
   int i;
+#endif
   int len;
 
   len = packetbuf_datalen() - packetbuf_hdr_len;
@@ -320,6 +547,32 @@ store_fragment(uint8_t index, uint8_t offset)
     return -1;
   }
 
+#if SICSLOWPAN_REASS_DIRECT
+  if((offset << 3) + len > sizeof(frag_info[index].first_frag)) {
+    LOG_WARN("reassembly: invalid fragment offset\n");
+    clear_fragments(index);
+    return -1;
+  }
+  /* copy the data from packetbuf to its place in the packet */
+  memcpy(frag_info[index].first_frag + (offset << 3),
+         packetbuf_ptr + packetbuf_hdr_len, len);
+  return len;
+#elif SICSLOWPAN_REASS_WITH_INDEX
+  b = frag_free;
+  if(b == 0) {
+    /* failed */
+    return -1;
+  }
+  /* move the buffer from the free list to the chain of the context */
+  frag_free = frag_buf[b - 1].next;
+  frag_buf[b - 1].next = frag_info[index].frag_head;
+  frag_info[index].frag_head = b;
+  frag_buf[b - 1].offset = offset;
+  frag_buf[b - 1].len = len;
+  frag_buf[b - 1].index = index;
+  memcpy(frag_buf[b - 1].data, packetbuf_ptr + packetbuf_hdr_len, len);
+  return len;
+#else
   for(i = 0; i < SICSLOWPAN_FRAGMENT_BUFFERS; i++) {
     if(frag_buf[i].len == 0) {
       /* copy over the data from packetbuf into the fragment buffer,
@@ -334,6 +587,7 @@ store_fragment(uint8_t index, uint8_t offset)
   }
   /* failed */
   return -1;
+#endif
 }
 /*---------------------------------------------------------------------------*/
 /* add a new fragment to the buffer */
@@ -345,6 +599,21 @@ add_fragment(uint16_t tag, uint16_t frag_size, uint8_t offset)
   int8_t found = -1;
 
   if(offset == 0) {
+    /* A context with a zero length counts as free, so a datagram too
+       short for an IPv6 header must not open one */
+    if(frag_size < UIP_IPH_LEN) {
+      LOG_WARN("reassembly: invalid datagram size %u - tag: %d\n",
+               frag_size, tag);
+      return -1;
+    }
+
+    /* A first fragment with the tag of an ongoing reassembly restarts it */
+    found = find_context(tag);
+    if(found >= 0) {
+      clear_fragments(found);
+      found = -1;
+    }
+
     /* This is a first fragment - check if we can add this */
     for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
       /* clear all fragment info with expired timer to free all fragment buffers */
@@ -371,20 +640,23 @@ add_fragment(uint16_t tag, uint16_t frag_size, uint8_t offset)
     linkaddr_copy(&frag_info[found].sender,
                   packetbuf_addr(PACKETBUF_ADDR_SENDER));
     timer_set(&frag_info[found].reass_timer, SICSLOWPAN_REASS_MAXAGE * CLOCK_SECOND / 16);
+#if SICSLOWPAN_REASS_WITH_INDEX
+    reass_hash_insert(found);
+#endif /* SICSLOWPAN_REASS_WITH_INDEX */
+#if SICSLOWPAN_REASS_DIRECT
+    /* Ensure that no previous data is used for reassembly in case of
+       missing fragments. */
+    memset(frag_info[found].first_frag, 0,
+           MIN(frag_size, sizeof(frag_info[found].first_frag)));
+#endif /* SICSLOWPAN_REASS_DIRECT */
     /* first fragment can not be stored immediately but is moved into
        the buffer while uncompressing */
     return found;
   }
 
   /* This is a N-fragment - should find the info */
-  for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
-    if(frag_info[i].tag == tag && frag_info[i].len > 0 &&
-       linkaddr_cmp(&frag_info[i].sender, packetbuf_addr(PACKETBUF_ADDR_SENDER))) {
-      /* Tag and Sender match - this must be the correct info to store in */
-      found = i;
-      break;
-    }
-  }
+  found = find_context(tag);
+  i = found;
 
   if(found < 0) {
     /* no entry found for storing the new fragment */
@@ -394,7 +666,7 @@ add_fragment(uint16_t tag, uint16_t frag_size, uint8_t offset)
 
   /* i is the index of the reassembly context */
   len = store_fragment(i, offset);
-  if(len < 0 && timeout_fragments(i) > 0) {
+  if(len < 0 && !SICSLOWPAN_REASS_DIRECT && timeout_fragments(i) > 0) {
     len = store_fragment(i, offset);
   }
   if(len > 0) {
@@ -413,7 +685,11 @@ add_fragment(uint16_t tag, uint16_t frag_size, uint8_t offset)
 static bool
 copy_frags2uip(int context)
 {
+#if SICSLOWPAN_REASS_WITH_INDEX && !SICSLOWPAN_REASS_DIRECT
+  uint8_t b;
+#elif !SICSLOWPAN_REASS_DIRECT
   int i;
+#endif
 
   /* Check length fields before proceeding. */
   if(frag_info[context].len < frag_info[context].first_frag_len ||
@@ -423,6 +699,11 @@ copy_frags2uip(int context)
     return false;
   }
 
+#if SICSLOWPAN_REASS_DIRECT
+  /* The fragments are already in place: copy the whole packet at once */
+  memcpy((uint8_t *)UIP_IP_BUF, (uint8_t *)frag_info[context].first_frag,
+         frag_info[context].len);
+#else /* SICSLOWPAN_REASS_DIRECT */
   /* Copy from the fragment context info buffer first */
   memcpy((uint8_t *)UIP_IP_BUF, (uint8_t *)frag_info[context].first_frag,
          frag_info[context].first_frag_len);
@@ -431,6 +712,18 @@ copy_frags2uip(int context)
   memset((uint8_t *)UIP_IP_BUF + frag_info[context].first_frag_len, 0,
          frag_info[context].len - frag_info[context].first_frag_len);
 
+#if SICSLOWPAN_REASS_WITH_INDEX
+  /* And also copy the fragments of this context */
+  for(b = frag_info[context].frag_head; b != 0; b = frag_buf[b - 1].next) {
+    if((frag_buf[b - 1].offset << 3) + frag_buf[b - 1].len > sizeof(uip_buf)) {
+      LOG_WARN("input: invalid fragment offset\n");
+      clear_fragments(context);
+      return false;
+    }
+    memcpy((uint8_t *)UIP_IP_BUF + (uint16_t)(frag_buf[b - 1].offset << 3),
+           (uint8_t *)frag_buf[b - 1].data, frag_buf[b - 1].len);
+  }
+#else /* SICSLOWPAN_REASS_WITH_INDEX */
   for(i = 0; i < SICSLOWPAN_FRAGMENT_BUFFERS; i++) {
     /* And also copy all matching fragments */
     if(frag_buf[i].len > 0 && frag_buf[i].index == context) {
@@ -443,6 +736,8 @@ copy_frags2uip(int context)
              (uint8_t *)frag_buf[i].data, frag_buf[i].len);
     }
   }
+#endif /* SICSLOWPAN_REASS_WITH_INDEX */
+#endif /* SICSLOWPAN_REASS_DIRECT */
   /* deallocate all the fragments for this context */
   clear_fragments(context);
 
@@ -645,6 +940,172 @@ uncompress_addr(uip_ipaddr_t *ipaddr, uint8_t const prefix[],
   LOG_DBG_("\n");
 }
 
+/* Cache the compressed headers of recent flows, keyed by addresses,
+ * traffic class and flow label, next header and UDP ports. A hit copies
+ * the stored IPHC header and only patches the hop limit and the UDP
+ * checksum. Only packets without extension headers are cached. */
+#ifdef SICSLOWPAN_CONF_IPHC_CACHE_SIZE
+#define SICSLOWPAN_IPHC_CACHE_SIZE SICSLOWPAN_CONF_IPHC_CACHE_SIZE
+#else
+#define SICSLOWPAN_IPHC_CACHE_SIZE 0
+#endif
+
+static struct sicslowpan_iphc_cache_stats iphc_cache_stats;
+
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+/* Longest IPHC header without extension headers: dispatch, CID, TF,
+   next header, hop limit, both addresses inline and NHC UDP */
+#define IPHC_CACHE_MAX_LEN (3 + 4 + 1 + 1 + 16 + 16 + 7)
+
+struct iphc_cache_entry {
+  /** Version, traffic class and flow label of the IPv6 header */
+  uint8_t vtc_flow[4];
+  uip_ipaddr_t srcipaddr;
+  uip_ipaddr_t destipaddr;
+  linkaddr_t link_destaddr;
+  /** UDP source and destination ports, as in the UDP header */
+  uint8_t ports[4];
+  uint8_t proto;
+  /** Hop limit when elided, 0 when the hop limit is inline */
+  uint8_t ttl;
+  /** Offset of the inline hop limit in the template, 0 if elided */
+  uint8_t hlim_offset;
+  uint8_t uncomp_hdr_len;
+  /** Length of the template, 0 if the entry is unused */
+  uint8_t len;
+  uint32_t last_used;
+  uint8_t tpl[IPHC_CACHE_MAX_LEN];
+};
+
+static struct iphc_cache_entry iphc_cache[SICSLOWPAN_IPHC_CACHE_SIZE];
+static uint32_t iphc_cache_clock;
+/*--------------------------------------------------------------------*/
+static int
+iphc_cache_is_elided_ttl(uint8_t ttl)
+{
+  return ttl == 1 || ttl == 64 || ttl == 255;
+}
+/*--------------------------------------------------------------------*/
+static int
+iphc_cache_is_cacheable(void)
+{
+  return UIP_IP_BUF->proto == UIP_PROTO_UDP ||
+    !IS_COMPRESSABLE_PROTO(UIP_IP_BUF->proto);
+}
+/*--------------------------------------------------------------------*/
+static struct iphc_cache_entry *
+iphc_cache_lookup(const linkaddr_t *link_destaddr)
+{
+  struct iphc_cache_entry *e;
+  uint8_t ttl = UIP_IP_BUF->ttl;
+  int i;
+
+  for(i = 0; i < SICSLOWPAN_IPHC_CACHE_SIZE; i++) {
+    e = &iphc_cache[i];
+    if(e->len == 0 || e->proto != UIP_IP_BUF->proto ||
+       (e->hlim_offset ? iphc_cache_is_elided_ttl(ttl) : e->ttl != ttl) ||
+       memcmp(e->vtc_flow, UIP_IP_BUF, sizeof(e->vtc_flow)) != 0 ||
+       !uip_ipaddr_cmp(&e->destipaddr, &UIP_IP_BUF->destipaddr) ||
+       !uip_ipaddr_cmp(&e->srcipaddr, &UIP_IP_BUF->srcipaddr) ||
+       !linkaddr_cmp(&e->link_destaddr, link_destaddr)) {
+      continue;
+    }
+    if(e->proto == UIP_PROTO_UDP &&
+       memcmp(e->ports, &UIP_UDP_BUF_POS(0)->srcport, sizeof(e->ports)) != 0) {
+      continue;
+    }
+    return e;
+  }
+  return NULL;
+}
+/*--------------------------------------------------------------------*/
+/**
+ * \brief Write the compressed header of a cached flow to packetbuf
+ * \return 1 on a cache hit, else 0
+ */
+static int
+iphc_cache_compress(const linkaddr_t *link_destaddr)
+{
+  struct iphc_cache_entry *e;
+
+  e = iphc_cache_lookup(link_destaddr);
+  if(e == NULL || PACKETBUF_IPHC_BUF + e->len >= PACKETBUF_PAYLOAD_END) {
+    iphc_cache_stats.misses++;
+    return 0;
+  }
+
+  memcpy(PACKETBUF_IPHC_BUF, e->tpl, e->len);
+  if(e->hlim_offset != 0) {
+    PACKETBUF_IPHC_BUF[e->hlim_offset] = UIP_IP_BUF->ttl;
+  }
+  if(e->proto == UIP_PROTO_UDP) {
+    /* The checksum is always inline, at the end of the header */
+    memcpy(PACKETBUF_IPHC_BUF + e->len - 2, &UIP_UDP_BUF_POS(0)->udpchksum, 2);
+  }
+  uncomp_hdr_len = e->uncomp_hdr_len;
+  packetbuf_hdr_len += e->len;
+  e->last_used = ++iphc_cache_clock;
+  iphc_cache_stats.hits++;
+  return 1;
+}
+/*--------------------------------------------------------------------*/
+/**
+ * \brief Store the header just compressed in packetbuf, replacing the
+ * least recently used flow
+ * \param iphc The start of the compressed header
+ * \param hlim_offset Offset of the inline hop limit, 0 if elided
+ */
+static void
+iphc_cache_store(const linkaddr_t *link_destaddr, const uint8_t *iphc,
+                 uint8_t hlim_offset)
+{
+  struct iphc_cache_entry *e;
+  int len = hc06_ptr - iphc;
+  int i;
+
+  if(len > IPHC_CACHE_MAX_LEN) {
+    return;
+  }
+
+  e = &iphc_cache[0];
+  for(i = 1; i < SICSLOWPAN_IPHC_CACHE_SIZE && e->len != 0; i++) {
+    if(iphc_cache[i].len == 0 || iphc_cache[i].last_used < e->last_used) {
+      e = &iphc_cache[i];
+    }
+  }
+
+  memcpy(e->vtc_flow, UIP_IP_BUF, sizeof(e->vtc_flow));
+  uip_ipaddr_copy(&e->srcipaddr, &UIP_IP_BUF->srcipaddr);
+  uip_ipaddr_copy(&e->destipaddr, &UIP_IP_BUF->destipaddr);
+  linkaddr_copy(&e->link_destaddr, link_destaddr);
+  if(UIP_IP_BUF->proto == UIP_PROTO_UDP) {
+    memcpy(e->ports, &UIP_UDP_BUF_POS(0)->srcport, sizeof(e->ports));
+  }
+  e->proto = UIP_IP_BUF->proto;
+  e->ttl = hlim_offset ? 0 : UIP_IP_BUF->ttl;
+  e->hlim_offset = hlim_offset;
+  e->uncomp_hdr_len = uncomp_hdr_len;
+  e->len = len;
+  e->last_used = ++iphc_cache_clock;
+  memcpy(e->tpl, iphc, len);
+}
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+/*--------------------------------------------------------------------*/
+const struct sicslowpan_iphc_cache_stats *
+sicslowpan_iphc_cache_get_stats(void)
+{
+  return &iphc_cache_stats;
+}
+/*--------------------------------------------------------------------*/
+void
+sicslowpan_iphc_cache_flush(void)
+{
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  memset(iphc_cache, 0, sizeof(iphc_cache));
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+  memset(&iphc_cache_stats, 0, sizeof(iphc_cache_stats));
+}
+
 /*--------------------------------------------------------------------*/
 /**
  * \brief Compress IP/UDP header
@@ -687,6 +1148,9 @@ compress_hdr_iphc(linkaddr_t *link_destaddr)
   uint8_t tmp, iphc0, iphc1, *next_hdr, *next_nhc;
   int ext_hdr_len;
   struct uip_udp_hdr *udp_buf;
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  uint8_t hlim_offset = 0;
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
 
   if(LOG_DBG_ENABLED) {
     uint16_t ndx;
@@ -715,6 +1179,12 @@ compress_hdr_iphc(linkaddr_t *link_destaddr)
    * layer will be checked when they are compressed. */
   CHECK_BUFFER_SPACE(38);
 
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  if(iphc_cache_is_cacheable() && iphc_cache_compress(link_destaddr)) {
+    return 1;
+  }
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+
   /*
    * As we copy some bit-length fields, in the IPHC encoding bytes,
    * we sometimes use |=
@@ -819,6 +1289,9 @@ compress_hdr_iphc(linkaddr_t *link_destaddr)
       iphc0 |= SICSLOWPAN_IPHC_TTL_255;
       break;
     default:
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+      hlim_offset = hc06_ptr - PACKETBUF_IPHC_BUF;
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
       *hc06_ptr = UIP_IP_BUF->ttl;
       hc06_ptr += 1;
       break;
@@ -1045,6 +1518,12 @@ compress_hdr_iphc(linkaddr_t *link_destaddr)
     LOG_DBG_("\n");
   }
 
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  if(iphc_cache_is_cacheable()) {
+    iphc_cache_store(link_destaddr, PACKETBUF_IPHC_BUF, hlim_offset);
+  }
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+
   packetbuf_hdr_len = hc06_ptr - packetbuf_ptr;
 
   return 1;
@@ -1550,6 +2029,398 @@ fragment_copy_payload_and_send(uint16_t uip_offset, linkaddr_t *dest) {
   }
   return 1;
 }
+#if SICSLOWPAN_FRAG_FORWARDING
+#if SICSLOWPAN_COMPRESSION < SICSLOWPAN_COMPRESSION_IPHC
+#error SICSLOWPAN_FRAG_FORWARDING requires IPHC compression
+#endif
+/*--------------------------------------------------------------------*/
+/* Virtual reassembly buffers: datagrams being forwarded fragment by
+ * fragment, keyed by the link-layer sender and tag of the previous hop */
+struct sicslowpan_vrb {
+  /** Link-layer address of the previous hop */
+  linkaddr_t sender;
+  /** Link-layer address of the next hop */
+  linkaddr_t nexthop;
+  /** Tag of the fragments received from the previous hop */
+  uint16_t tag;
+  /** Tag of the fragments sent to the next hop */
+  uint16_t out_tag;
+  /** Total length of the datagram */
+  uint16_t len;
+  /** Number of bytes of the datagram relayed so far */
+  uint16_t forwarded_len;
+  /** Lifetime of this entry */
+  struct timer timer;
+  uint8_t in_use;
+};
+
+static struct sicslowpan_vrb vrb_table[SICSLOWPAN_VRB_ENTRIES];
+/*--------------------------------------------------------------------*/
+static struct sicslowpan_vrb *
+vrb_lookup(const linkaddr_t *sender, uint16_t tag)
+{
+  int i;
+
+  for(i = 0; i < SICSLOWPAN_VRB_ENTRIES; i++) {
+    if(vrb_table[i].in_use && vrb_table[i].tag == tag &&
+       linkaddr_cmp(&vrb_table[i].sender, sender)) {
+      if(timer_expired(&vrb_table[i].timer)) {
+        vrb_table[i].in_use = 0;
+        return NULL;
+      }
+      return &vrb_table[i];
+    }
+  }
+  return NULL;
+}
+/*--------------------------------------------------------------------*/
+static struct sicslowpan_vrb *
+vrb_alloc(void)
+{
+  int i;
+
+  for(i = 0; i < SICSLOWPAN_VRB_ENTRIES; i++) {
+    if(!vrb_table[i].in_use || timer_expired(&vrb_table[i].timer)) {
+      return &vrb_table[i];
+    }
+  }
+  return NULL;
+}
+/*--------------------------------------------------------------------*/
+static const uip_ipaddr_t *
+vrb_nexthop(uip_ipaddr_t *destipaddr)
+{
+  uip_ds6_route_t *route;
+
+  if(uip_ds6_is_addr_onlink(destipaddr)) {
+    return destipaddr;
+  }
+  route = uip_ds6_route_lookup(destipaddr);
+  if(route != NULL) {
+    return uip_ds6_route_nexthop(route);
+  }
+  return uip_ds6_defrt_choose();
+}
+/*--------------------------------------------------------------------*/
+static void
+vrb_set_packet_attrs(void)
+{
+  packetbuf_set_attr(PACKETBUF_ATTR_MAX_MAC_TRANSMISSIONS,
+                     uipbuf_get_attr(UIPBUF_ATTR_MAX_MAC_TRANSMISSIONS));
+#if LLSEC802154_USES_AUX_HEADER
+  packetbuf_set_attr(PACKETBUF_ATTR_SECURITY_LEVEL,
+    uipbuf_get_attr(UIPBUF_ATTR_LLSEC_LEVEL));
+#if LLSEC802154_USES_EXPLICIT_KEYS
+  packetbuf_set_attr(PACKETBUF_ATTR_KEY_INDEX,
+    uipbuf_get_attr(UIPBUF_ATTR_LLSEC_KEY_ID));
+#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
+#endif /*  LLSEC802154_USES_AUX_HEADER */
+}
+/*--------------------------------------------------------------------*/
+/* Check that the extension headers of a datagram, if any, are hop-by-hop
+   headers with only padding and RPL options, and lie entirely within
+   its first fragment. Anything else needs the full IPv6 input path. */
+static int
+vrb_headers_supported(const uint8_t *buf, uint16_t first_len)
+{
+  const struct uip_ext_hdr_opt *opt;
+  uint16_t offset;
+  uint16_t hdr_len;
+  uint16_t opt_offset;
+  uint8_t proto;
+
+  proto = SICSLOWPAN_IP_BUF(buf)->proto;
+  offset = UIP_IPH_LEN;
+  while(proto == UIP_PROTO_HBHO) {
+    if(offset + 2 > first_len) {
+      return 0;
+    }
+    hdr_len = (buf[offset + 1] << 3) + 8;
+    if(offset + hdr_len > first_len) {
+      return 0;
+    }
+    for(opt_offset = 2; opt_offset < hdr_len;) {
+      opt = (const struct uip_ext_hdr_opt *)(buf + offset + opt_offset);
+      if(opt->type == UIP_EXT_HDR_OPT_PAD1) {
+        opt_offset += 1;
+        continue;
+      }
+      if((opt->type != UIP_EXT_HDR_OPT_PADN &&
+          opt->type != UIP_EXT_HDR_OPT_RPL) ||
+         opt_offset + 2 > hdr_len ||
+         opt_offset + 2 + opt->len > hdr_len) {
+        return 0;
+      }
+      opt_offset += 2 + opt->len;
+    }
+    proto = buf[offset];
+    offset += hdr_len;
+  }
+  return proto == UIP_PROTO_UDP || proto == UIP_PROTO_TCP ||
+    proto == UIP_PROTO_ICMP6;
+}
+/*--------------------------------------------------------------------*/
+/* Let the routing protocol check the RPL options of the datagram in
+   uip_buf, as the IPv6 input path does. Returns 0 to drop it. */
+static int
+vrb_process_hbh(void)
+{
+  uint8_t *ext;
+  uint16_t hdr_len;
+  uint16_t opt_offset;
+  uint8_t proto;
+
+  proto = UIP_IP_BUF->proto;
+  ext = uip_buf + UIP_IPH_LEN;
+  while(proto == UIP_PROTO_HBHO) {
+    hdr_len = (ext[1] << 3) + 8;
+    for(opt_offset = 2; opt_offset < hdr_len;) {
+      if(ext[opt_offset] == UIP_EXT_HDR_OPT_PAD1) {
+        opt_offset += 1;
+        continue;
+      }
+      if(ext[opt_offset] == UIP_EXT_HDR_OPT_RPL &&
+         !NETSTACK_ROUTING.ext_header_hbh_update(ext, opt_offset)) {
+        LOG_ERR("input: RPL option error, dropping forwarded packet\n");
+        return 0;
+      }
+      opt_offset += 2 + ext[opt_offset + 1];
+    }
+    proto = ext[0];
+    ext += hdr_len;
+  }
+  return 1;
+}
+/*--------------------------------------------------------------------*/
+/**
+ * \brief Forward a first fragment towards the next hop of its datagram
+ * \param buf The uncompressed headers and payload of the first fragment
+ * \param frag_size The total length of the datagram
+ * \return 1 if the fragment was consumed (forwarded or dropped), 0 if
+ * the datagram must be reassembled locally instead
+ *
+ * Datagrams for this node, multicast and link-local traffic, datagrams
+ * with a hop limit that would expire here and everything handled at the
+ * root go through normal reassembly. So do datagrams with extension
+ * headers other than hop-by-hop headers carrying RPL options, and
+ * datagrams whose next hop has no link-layer address in the neighbor
+ * cache yet. All these decisions are taken before uip_buf is touched.
+ *
+ * The forwarded datagram then takes the checks of the IPv6 forwarding
+ * path: the IP input and output callbacks, the RPL hop-by-hop option
+ * checks and the routing extension header update. They only see the
+ * first fragment, while uip_len is the length of the whole datagram.
+ * A routing update that inserts or removes a header would move every
+ * later fragment, so such datagrams are left to normal reassembly as
+ * well, before the VRB entry is taken; buf is still intact then, and
+ * the reassembled datagram takes the same checks on the IPv6 path.
+ */
+static int
+vrb_forward_first(uint8_t *buf, uint16_t frag_size)
+{
+  struct uip_ip_hdr *ip = SICSLOWPAN_IP_BUF(buf);
+  uint16_t first_len = uncomp_hdr_len + packetbuf_payload_len;
+  const uip_ipaddr_t *nexthop;
+  const uip_lladdr_t *lladdr;
+  struct sicslowpan_vrb *vrb;
+  int frag1_payload;
+  int payload;
+
+  if(frag_size > UIP_BUFSIZE || first_len > frag_size ||
+     uip_is_addr_mcast(&ip->destipaddr) ||
+     uip_is_addr_linklocal(&ip->destipaddr) ||
+     uip_is_addr_loopback(&ip->destipaddr) ||
+     uip_is_addr_linklocal(&ip->srcipaddr) ||
+     uip_is_addr_unspecified(&ip->srcipaddr) ||
+     uip_ds6_is_my_addr(&ip->destipaddr) ||
+     uip_ds6_is_my_addr(&ip->srcipaddr) ||
+     ip->ttl <= 1 || !vrb_headers_supported(buf, first_len) ||
+     NETSTACK_ROUTING.node_is_root()) {
+    return 0;
+  }
+
+  /* The entry is only taken once in_use is set, after the checks */
+  vrb = vrb_alloc();
+  if(vrb == NULL) {
+    LOG_WARN("input: no free VRB entry, reassembling (len %u)\n", frag_size);
+    return 0;
+  }
+
+  nexthop = vrb_nexthop(&ip->destipaddr);
+  lladdr = nexthop != NULL ? uip_ds6_nbr_lladdr_from_ipaddr(nexthop) : NULL;
+  if(lladdr == NULL ||
+     linkaddr_cmp((const linkaddr_t *)lladdr,
+                  packetbuf_addr(PACKETBUF_ADDR_SENDER))) {
+    return 0;
+  }
+
+  /* From here on failures drop the datagram, except for a routing
+     update that changes its size. The checks, the routing update and
+     the recompression work on uip_buf. */
+  memcpy(UIP_IP_BUF, buf, first_len);
+  uip_len = frag_size;
+  uip_ext_len = 0;
+
+  if(netstack_process_ip_callback(NETSTACK_IP_INPUT, NULL) !=
+     NETSTACK_IP_PROCESS || !vrb_process_hbh()) {
+    UIP_STAT(++uip_stat.ip.drop);
+    uipbuf_clear();
+    return 1;
+  }
+
+  UIP_IP_BUF->ttl--;
+
+  if(!NETSTACK_ROUTING.ext_header_update()) {
+    LOG_ERR("input: routing extension header update error, dropping forwarded packet\n");
+    UIP_STAT(++uip_stat.ip.drop);
+    uipbuf_clear();
+    return 1;
+  }
+  if(uip_len != frag_size) {
+    LOG_INFO("input: routing header changes size, reassembling (len %u)\n",
+             frag_size);
+    uipbuf_clear();
+    return 0;
+  }
+  if(netstack_process_ip_callback(NETSTACK_IP_OUTPUT,
+                                  (const linkaddr_t *)lladdr) !=
+     NETSTACK_IP_PROCESS) {
+    uipbuf_clear();
+    return 1;
+  }
+
+  linkaddr_copy(&vrb->sender, packetbuf_addr(PACKETBUF_ADDR_SENDER));
+  linkaddr_copy(&vrb->nexthop, (const linkaddr_t *)lladdr);
+  vrb->tag = GET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_TAG);
+  vrb->out_tag = my_tag++;
+  vrb->len = frag_size;
+  vrb->forwarded_len = first_len;
+  vrb->in_use = 1;
+  timer_set(&vrb->timer, SICSLOWPAN_REASS_MAXAGE * CLOCK_SECOND);
+
+  uncomp_hdr_len = 0;
+  packetbuf_hdr_len = 0;
+  packetbuf_clear();
+  packetbuf_ptr = packetbuf_dataptr();
+  vrb_set_packet_attrs();
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &vrb->nexthop);
+
+  mac_max_payload = NETSTACK_MAC.max_payload();
+  if(mac_max_payload <= 0) {
+    LOG_WARN("input: failed to calculate payload size - dropping forwarded packet\n");
+    vrb->in_use = 0;
+    return 1;
+  }
+
+#if SICSLOWPAN_COMPRESSION == SICSLOWPAN_COMPRESSION_6LORH
+  add_paging_dispatch(1);
+  add_6lorh_hdr();
+#endif /* SICSLOWPAN_COMPRESSION == SICSLOWPAN_COMPRESSION_6LORH */
+  if(compress_hdr_iphc(&vrb->nexthop) == 0 || first_len < uncomp_hdr_len) {
+    vrb->in_use = 0;
+    return 1;
+  }
+
+  /* The headers may compress worse for the new link (e.g. the source IID
+     can no longer be elided). Whatever no longer fits the first fragment
+     is relayed as an extra FRAGN so that all offsets stay the same. */
+  payload = first_len - uncomp_hdr_len;
+  frag1_payload = (mac_max_payload - packetbuf_hdr_len - SICSLOWPAN_FRAG1_HDR_LEN) & 0xfffffff8;
+  if(frag1_payload > payload) {
+    frag1_payload = payload;
+  }
+  if(frag1_payload <= 0 ||
+     queuebuf_numfree() - 1 < (frag1_payload < payload ? 2 : 1)) {
+    LOG_WARN("input: cannot forward first fragment (tag %u)\n", vrb->tag);
+    vrb->in_use = 0;
+    return 1;
+  }
+
+  memmove(packetbuf_ptr + SICSLOWPAN_FRAG1_HDR_LEN, packetbuf_ptr, packetbuf_hdr_len);
+  packetbuf_hdr_len += SICSLOWPAN_FRAG1_HDR_LEN;
+  SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE,
+        ((SICSLOWPAN_DISPATCH_FRAG1 << 8) | frag_size));
+  SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_TAG, vrb->out_tag);
+  packetbuf_payload_len = frag1_payload;
+
+  LOG_INFO("input: forwarding first fragment (tag %u -> %u, len %u) to ",
+           vrb->tag, vrb->out_tag, frag_size);
+  LOG_INFO_LLADDR(&vrb->nexthop);
+  LOG_INFO_("\n");
+
+  last_tx_status = MAC_TX_OK;
+  if(fragment_copy_payload_and_send(uncomp_hdr_len, &vrb->nexthop) == 0) {
+    vrb->in_use = 0;
+    return 1;
+  }
+  UIP_STAT(++uip_stat.ip.forwarded);
+
+  if(frag1_payload < payload) {
+    packetbuf_hdr_len = SICSLOWPAN_FRAGN_HDR_LEN;
+    SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE,
+          ((SICSLOWPAN_DISPATCH_FRAGN << 8) | frag_size));
+    PACKETBUF_FRAG_PTR[PACKETBUF_FRAG_OFFSET] = (uncomp_hdr_len + frag1_payload) >> 3;
+    packetbuf_payload_len = payload - frag1_payload;
+    if(fragment_copy_payload_and_send(uncomp_hdr_len + frag1_payload,
+                                      &vrb->nexthop) == 0) {
+      vrb->in_use = 0;
+    }
+  }
+  return 1;
+}
+/*--------------------------------------------------------------------*/
+/**
+ * \brief Relay a subsequent fragment of a datagram being forwarded
+ * \param tag The tag of the received fragment
+ * \return 1 if the fragment belongs to a forwarded datagram, else 0
+ */
+static int
+vrb_forward_next(uint16_t tag)
+{
+  struct sicslowpan_vrb *vrb;
+  uint8_t *data;
+  uint16_t len;
+
+  vrb = vrb_lookup(packetbuf_addr(PACKETBUF_ADDR_SENDER), tag);
+  if(vrb == NULL) {
+    return 0;
+  }
+
+  data = packetbuf_dataptr();
+  len = packetbuf_datalen();
+  if(len <= SICSLOWPAN_FRAGN_HDR_LEN) {
+    return 1;
+  }
+  vrb->forwarded_len += len - SICSLOWPAN_FRAGN_HDR_LEN;
+
+  /* Move the fragment to the start of a fresh packetbuf, so that none of
+     the attributes of the received frame leak into the relayed one */
+  packetbuf_clear();
+  memmove(packetbuf_dataptr(), data, len);
+  packetbuf_set_datalen(len);
+  packetbuf_ptr = packetbuf_dataptr();
+  SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_TAG, vrb->out_tag);
+  vrb_set_packet_attrs();
+
+  LOG_INFO("input: forwarding fragment (tag %u -> %u, offset %u)\n",
+           tag, vrb->out_tag, PACKETBUF_FRAG_PTR[PACKETBUF_FRAG_OFFSET] << 3);
+  send_packet(&vrb->nexthop);
+
+  if(vrb->forwarded_len >= vrb->len) {
+    vrb->in_use = 0;
+  }
+  return 1;
+}
+/*--------------------------------------------------------------------*/
+static void
+vrb_remove(const linkaddr_t *sender, uint16_t tag)
+{
+  struct sicslowpan_vrb *vrb = vrb_lookup(sender, tag);
+  if(vrb != NULL) {
+    vrb->in_use = 0;
+  }
+}
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
 #endif /* SICSLOWPAN_CONF_FRAG */
 /*--------------------------------------------------------------------*/
 /** \brief Take an IP packet and format it to be sent on an 802.15.4
@@ -1859,6 +2730,11 @@ input(void)
       LOG_INFO("input: received first element of a fragmented packet (tag %d, len %d)\n",
              frag_tag, frag_size);
 
+#if SICSLOWPAN_FRAG_FORWARDING
+      /* A new datagram under a tag we were relaying restarts it */
+      vrb_remove(packetbuf_addr(PACKETBUF_ADDR_SENDER), frag_tag);
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+
       /* Add the fragment to the fragmentation context */
       frag_context = add_fragment(frag_tag, frag_size, frag_offset);
 
@@ -1879,6 +2755,12 @@ input(void)
       frag_size = GET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE) & 0x07ff;
       packetbuf_hdr_len += SICSLOWPAN_FRAGN_HDR_LEN;
 
+#if SICSLOWPAN_FRAG_FORWARDING
+      if(vrb_forward_next(frag_tag)) {
+        return;
+      }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+
       /* Add the fragment to the fragmentation context (this will also
          copy the payload) */
       frag_context = add_fragment(frag_tag, frag_size, frag_offset);
@@ -1987,6 +2869,15 @@ input(void)
     memcpy((uint8_t *)buffer + uncomp_hdr_len, packetbuf_ptr + packetbuf_hdr_len, packetbuf_payload_len);
   }
 
+#if SICSLOWPAN_FRAG_FORWARDING
+  if(first_fragment && vrb_forward_first(buffer, frag_size)) {
+    /* uip_buf only held the first fragment of the datagram */
+    clear_fragments(frag_context);
+    uipbuf_clear();
+    return;
+  }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+
   /* update processed_ip_in_len if fragment, sicslowpan_len otherwise */
 
 #if SICSLOWPAN_CONF_FRAG
@@ -2053,7 +2944,7 @@ input(void)
 #endif /* LLSEC802154_USES_EXPLICIT_KEYS */
 #endif /*  LLSEC802154_USES_AUX_HEADER */
 
-    tcpip_input();
+    tcpip_input_enqueue();
 #if SICSLOWPAN_CONF_FRAG
   }
 #endif /* SICSLOWPAN_CONF_FRAG */
@@ -2066,6 +2957,9 @@ input(void)
 void
 sicslowpan_init(void)
 {
+#if SICSLOWPAN_CONF_FRAG
+  init_fragments();
+#endif /* SICSLOWPAN_CONF_FRAG */
 
 #if SICSLOWPAN_COMPRESSION == SICSLOWPAN_COMPRESSION_IPHC
 /* Preinitialize any address contexts for better header compression
@@ -338,6 +338,23 @@ struct sicslowpan_nh_compressor {
 
 int sicslowpan_get_last_rssi(void);
 
+/** Counters of the IPHC compression cache (SICSLOWPAN_CONF_IPHC_CACHE_SIZE) */
+struct sicslowpan_iphc_cache_stats {
+  uint32_t hits;
+  uint32_t misses;
+};
+
+/**
+ * \brief Get the hit and miss counters of the IPHC compression cache
+ */
+const struct sicslowpan_iphc_cache_stats *sicslowpan_iphc_cache_get_stats(void);
+
+/**
+ * \brief Drop all cached compressed headers and reset the counters.
+ * Must be called when the address contexts change.
+ */
+void sicslowpan_iphc_cache_flush(void);
+
 extern const struct network_driver sicslowpan_driver;
 
 #endif /* SICSLOWPAN_H_ */
@@ -46,6 +46,8 @@
 #include "net/ipv6/uip-ds6.h"
 #include "net/ipv6/uip-ds6-nbr.h"
 #include "net/linkaddr.h"
+#include "net/packetbuf.h"
+#include "lib/list.h"
 #include "net/routing/routing.h"
 
 #include <string.h>
@@ -72,6 +74,11 @@ static struct etimer periodic;
 extern struct etimer uip_reass_timer;
 #endif
 
+#if UIPBUF_POOL_SIZE > 0
+/* Packets delivered with tcpip_input_enqueue(), oldest first */
+LIST(input_queue);
+#endif /* UIPBUF_POOL_SIZE > 0 */
+
 #if UIP_TCP
 /**
  * \internal Structure for holding a TCP port and a process ID.
@@ -187,6 +194,33 @@ packet_input(void)
   }
 }
 /*---------------------------------------------------------------------------*/
+#if UIPBUF_POOL_SIZE > 0
+static void
+input_queue_process(void)
+{
+  static struct packetbuf_attr attrs[PACKETBUF_NUM_ATTRS];
+  static struct packetbuf_addr addrs[PACKETBUF_NUM_ADDRS];
+  uipbuf_desc_t *desc;
+
+  /* Process the queued packets in order, each in uip_buf in turn. RPL,
+     multicast and link statistics read the link-layer sender, RSSI and
+     such of the packet from packetbuf: set the attributes the packet
+     was received with during processing, then put packetbuf back. */
+  packetbuf_attr_copyto(attrs, addrs);
+  while((desc = list_pop(input_queue)) != NULL) {
+    uipbuf_pool_restore(desc);
+    uipbuf_pool_restore_packetbuf_attrs(desc);
+    uipbuf_pool_free(desc);
+    if(netstack_process_ip_callback(NETSTACK_IP_INPUT, NULL) ==
+       NETSTACK_IP_PROCESS) {
+      packet_input();
+    }
+    uipbuf_clear();
+  }
+  packetbuf_attr_copyfrom(attrs, addrs);
+}
+#endif /* UIPBUF_POOL_SIZE > 0 */
+/*---------------------------------------------------------------------------*/
 #if UIP_TCP
 #if UIP_ACTIVE_OPEN
 struct uip_conn *
@@ -438,6 +472,11 @@ eventhandler(process_event_t ev, process_data_t data)
   case PACKET_INPUT:
     packet_input();
     break;
+#if UIPBUF_POOL_SIZE > 0
+  case PROCESS_EVENT_POLL:
+    input_queue_process();
+    break;
+#endif /* UIPBUF_POOL_SIZE > 0 */
   };
 }
 /*---------------------------------------------------------------------------*/
@@ -451,6 +490,28 @@ tcpip_input(void)
   uipbuf_clear();
 }
 /*---------------------------------------------------------------------------*/
+void
+tcpip_input_enqueue(void)
+{
+#if UIPBUF_POOL_SIZE > 0
+  uipbuf_desc_t *desc;
+
+  if(uip_len > 0) {
+    desc = uipbuf_pool_save();
+    if(desc == NULL) {
+      LOG_WARN("input: no free packet descriptor, dropping packet\n");
+      UIP_STAT(++uip_stat.ip.drop);
+    } else {
+      list_add(input_queue, desc);
+      process_poll(&tcpip_process);
+    }
+  }
+  uipbuf_clear();
+#else /* UIPBUF_POOL_SIZE > 0 */
+  tcpip_input();
+#endif /* UIPBUF_POOL_SIZE > 0 */
+}
+/*---------------------------------------------------------------------------*/
 static void
 output_fallback(void)
 {
@@ -810,6 +871,9 @@ PROCESS_THREAD(tcpip_process, ev, data)
 {
   PROCESS_BEGIN();
 
+  /* Let the events of the network stack overtake application events. */
+  process_set_priority(&tcpip_process, PROCESS_PRIORITY_HIGH);
+
 #if UIP_TCP
   memset(s.listenports, 0, UIP_LISTENPORTS*sizeof(*(s.listenports)));
   s.p = PROCESS_CURRENT();
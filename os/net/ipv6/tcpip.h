@@ -336,6 +336,19 @@ extern process_event_t tcpip_event;
  */
 void tcpip_input(void);
 
+/**
+ * \brief      Queue an incoming packet for the TCP/IP stack
+ *
+ *             Like tcpip_input(), but with a uipbuf pool the packet is
+ *             copied to a packet descriptor together with its link-layer
+ *             attributes and processed later by the TCP/IP process,
+ *             after the packets queued before it. This lets the caller
+ *             receive further packets into uip_buf right away. The
+ *             packet is dropped if the pool is exhausted. Without a
+ *             uipbuf pool, this is the same as tcpip_input().
+ */
+void tcpip_input_enqueue(void);
+
 /**
  * \brief Output packet to layer 2
  * The eventual parameter is the MAC address of the destination.
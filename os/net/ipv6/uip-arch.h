@@ -127,6 +127,25 @@ uint16_t uip_tcpchksum(void);
 
 uint16_t uip_udpchksum(void);
 
+/**
+ * Add a buffer to a running Internet checksum.
+ *
+ * Architectures that define UIP_ARCH_CHKSUM_DATA provide this
+ * function, and uIP then uses it for all checksum computations in
+ * place of its own byte-oriented loop.
+ *
+ * \param sum The one's complement sum so far, in host byte order.
+ *
+ * \param data A pointer to the buffer, which need not be aligned.
+ *
+ * \param len The length of the buffer. An odd trailing byte is added
+ * as if followed by a zero byte.
+ *
+ * \return The one's complement sum of sum and of all 16-bit words
+ * in the buffer, taken in network byte order, in host byte order.
+ */
+uint16_t uip_arch_chksum_data(uint16_t sum, const uint8_t *data, uint16_t len);
+
 /** @} */
 /** @} */
 
@@ -95,6 +95,37 @@ MEMB(routememb, uip_ds6_route_t, UIP_DS6_ROUTE_NB);
 static int num_routes = 0;
 static void rm_routelist_callback(nbr_table_item_t *ptr);
 
+#if UIP_DS6_ROUTE_WITH_HASH_INDEX
+/* Open-addressing hash index of the routes, keyed by prefix length and
+   prefix, with linear probing. A slot holds the index of the route in
+   routememb plus one, or zero if it is empty. The number of slots is a
+   power of two at least twice the number of routes. */
+#define ROUTE_HASH_SLOTS_MIN (2 * UIP_DS6_ROUTE_NB)
+#if ROUTE_HASH_SLOTS_MIN <= 16
+#define ROUTE_HASH_SLOTS 16
+#elif ROUTE_HASH_SLOTS_MIN <= 64
+#define ROUTE_HASH_SLOTS 64
+#elif ROUTE_HASH_SLOTS_MIN <= 256
+#define ROUTE_HASH_SLOTS 256
+#elif ROUTE_HASH_SLOTS_MIN <= 1024
+#define ROUTE_HASH_SLOTS 1024
+#elif ROUTE_HASH_SLOTS_MIN <= 4096
+#define ROUTE_HASH_SLOTS 4096
+#else
+#define ROUTE_HASH_SLOTS 16384
+#endif
+#define ROUTE_HASH_MASK (ROUTE_HASH_SLOTS - 1)
+
+static uint16_t route_hash[ROUTE_HASH_SLOTS];
+/* Number of routes per prefix length */
+static uint16_t length_count[129];
+/* The prefix lengths in use, longest first */
+static uint8_t lengths[129];
+static uint8_t num_lengths;
+/* The least recently used route, at the end of the routelist */
+static uip_ds6_route_t *routelist_last;
+#endif /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
+
 #endif /* (UIP_MAX_ROUTES != 0) */
 
 /* Default routes are held on the defaultrouterlist and their
@@ -178,6 +209,12 @@ uip_ds6_route_init(void)
 #if (UIP_MAX_ROUTES != 0)
   memb_init(&routememb);
   list_init(routelist);
+#if UIP_DS6_ROUTE_WITH_HASH_INDEX
+  memset(route_hash, 0, sizeof(route_hash));
+  memset(length_count, 0, sizeof(length_count));
+  num_lengths = 0;
+  routelist_last = NULL;
+#endif /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
   nbr_table_register(nbr_routes,
                      (nbr_table_callback *)rm_routelist_callback);
 #endif /* (UIP_MAX_ROUTES != 0) */
@@ -265,14 +302,183 @@ uip_ds6_route_num_routes(void)
   return 0;
 #endif /* (UIP_MAX_ROUTES != 0) */
 }
+#if (UIP_MAX_ROUTES != 0)
+/*---------------------------------------------------------------------------*/
+/* The routelist is kept ordered by how recently the routes were looked
+   up. With the hash index, the routes also have a pointer to their
+   predecessor, so that a route is moved to the front of the list or
+   removed from it without walking the list. */
+static void
+routelist_push(uip_ds6_route_t *r)
+{
+#if UIP_DS6_ROUTE_WITH_HASH_INDEX
+  r->prev = NULL;
+  r->next = list_head(routelist);
+  if(r->next != NULL) {
+    r->next->prev = r;
+  } else {
+    routelist_last = r;
+  }
+  *routelist = r;
+#else /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
+  list_push(routelist, r);
+#endif /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
+}
+/*---------------------------------------------------------------------------*/
+static void
+routelist_remove(uip_ds6_route_t *r)
+{
+#if UIP_DS6_ROUTE_WITH_HASH_INDEX
+  if(r->prev != NULL) {
+    r->prev->next = r->next;
+  } else if(list_head(routelist) == r) {
+    *routelist = r->next;
+  } else {
+    /* Not on the list */
+    return;
+  }
+  if(r->next != NULL) {
+    r->next->prev = r->prev;
+  } else {
+    routelist_last = r->prev;
+  }
+  r->next = NULL;
+  r->prev = NULL;
+#else /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
+  list_remove(routelist, r);
+#endif /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
+}
+#if UIP_DS6_ROUTE_REMOVE_LEAST_RECENTLY_USED
+/*---------------------------------------------------------------------------*/
+static uip_ds6_route_t *
+routelist_tail(void)
+{
+#if UIP_DS6_ROUTE_WITH_HASH_INDEX
+  return routelist_last;
+#else /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
+  return list_tail(routelist);
+#endif /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
+}
+#endif /* UIP_DS6_ROUTE_REMOVE_LEAST_RECENTLY_USED */
+#endif /* (UIP_MAX_ROUTES != 0) */
+#if (UIP_MAX_ROUTES != 0) && UIP_DS6_ROUTE_WITH_HASH_INDEX
+/*---------------------------------------------------------------------------*/
+static unsigned
+route_hash_prefix(const uip_ipaddr_t *addr, uint8_t length)
+{
+  unsigned h = 5381 + length;
+  int i;
+
+  /* Only whole bytes, as uip_ipaddr_prefixcmp() compares them */
+  for(i = 0; i < length >> 3; i++) {
+    h = (h * 33) ^ addr->u8[i];
+  }
+  return (h ^ (h >> 11)) & ROUTE_HASH_MASK;
+}
+/*---------------------------------------------------------------------------*/
+static uip_ds6_route_t *
+route_from_slot(unsigned slot)
+{
+  return (uip_ds6_route_t *)routememb.mem + route_hash[slot] - 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+route_hash_insert(uip_ds6_route_t *r)
+{
+  unsigned slot;
+  int i;
+
+  for(slot = route_hash_prefix(&r->ipaddr, r->length);
+      route_hash[slot] != 0;
+      slot = (slot + 1) & ROUTE_HASH_MASK);
+  route_hash[slot] = r - (uip_ds6_route_t *)routememb.mem + 1;
+
+  if(length_count[r->length]++ == 0) {
+    /* New prefix length, keep the lengths sorted longest first */
+    for(i = num_lengths; i > 0 && lengths[i - 1] < r->length; i--) {
+      lengths[i] = lengths[i - 1];
+    }
+    lengths[i] = r->length;
+    num_lengths++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+route_hash_remove(uip_ds6_route_t *r)
+{
+  unsigned slot;
+  unsigned next;
+  unsigned home;
+  uip_ds6_route_t *n;
+  int i;
+
+  for(slot = route_hash_prefix(&r->ipaddr, r->length);
+      route_from_slot(slot) != r;
+      slot = (slot + 1) & ROUTE_HASH_MASK) {
+    if(route_hash[slot] == 0) {
+      /* Not in the index */
+      return;
+    }
+  }
+
+  /* Shift back the entries that follow in the probe sequence, so that
+     no lookup stops at the freed slot while its route is further on */
+  next = slot;
+  while(1) {
+    route_hash[slot] = 0;
+    do {
+      next = (next + 1) & ROUTE_HASH_MASK;
+      if(route_hash[next] == 0) {
+        goto done;
+      }
+      n = route_from_slot(next);
+      home = route_hash_prefix(&n->ipaddr, n->length);
+    } while(((next - home) & ROUTE_HASH_MASK) < ((next - slot) & ROUTE_HASH_MASK));
+    route_hash[slot] = route_hash[next];
+    slot = next;
+  }
+
+done:
+  if(--length_count[r->length] == 0) {
+    for(i = 0; lengths[i] != r->length; i++);
+    for(num_lengths--; i < num_lengths; i++) {
+      lengths[i] = lengths[i + 1];
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uip_ds6_route_t *
+route_hash_lookup(const uip_ipaddr_t *addr)
+{
+  unsigned slot;
+  uip_ds6_route_t *r;
+  int i;
+
+  /* Try the prefix lengths in use, longest first */
+  for(i = 0; i < num_lengths; i++) {
+    for(slot = route_hash_prefix(addr, lengths[i]);
+        route_hash[slot] != 0;
+        slot = (slot + 1) & ROUTE_HASH_MASK) {
+      r = route_from_slot(slot);
+      if(r->length == lengths[i] &&
+         uip_ipaddr_prefixcmp(addr, &r->ipaddr, r->length)) {
+        return r;
+      }
+    }
+  }
+  return NULL;
+}
+#endif /* (UIP_MAX_ROUTES != 0) && UIP_DS6_ROUTE_WITH_HASH_INDEX */
 /*---------------------------------------------------------------------------*/
 uip_ds6_route_t *
 uip_ds6_route_lookup(const uip_ipaddr_t *addr)
 {
 #if (UIP_MAX_ROUTES != 0)
-  uip_ds6_route_t *r;
   uip_ds6_route_t *found_route;
+#if !UIP_DS6_ROUTE_WITH_HASH_INDEX
+  uip_ds6_route_t *r;
   uint8_t longestmatch;
+#endif /* !UIP_DS6_ROUTE_WITH_HASH_INDEX */
 
   LOG_INFO("Looking up route for ");
   LOG_INFO_6ADDR(addr);
@@ -282,6 +488,9 @@ uip_ds6_route_lookup(const uip_ipaddr_t *addr)
     return NULL;
   }
 
+#if UIP_DS6_ROUTE_WITH_HASH_INDEX
+  found_route = route_hash_lookup(addr);
+#else /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
   found_route = NULL;
   longestmatch = 0;
   for(r = uip_ds6_route_head();
@@ -297,6 +506,7 @@ uip_ds6_route_lookup(const uip_ipaddr_t *addr)
       }
     }
   }
+#endif /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
 
   if(found_route != NULL) {
     LOG_INFO("Found route: ");
@@ -314,8 +524,8 @@ uip_ds6_route_lookup(const uip_ipaddr_t *addr)
        the least recently used route will be at the end of the
        list - for fast lookups (assuming multiple packets to the same node). */
 
-    list_remove(routelist, found_route);
-    list_push(routelist, found_route);
+    routelist_remove(found_route);
+    routelist_push(found_route);
   }
 
   return found_route;
@@ -378,7 +588,7 @@ uip_ds6_route_add(const uip_ipaddr_t *ipaddr, uint8_t length,
 #if UIP_DS6_ROUTE_REMOVE_LEAST_RECENTLY_USED
       /* Removing the oldest route entry from the route table. The
          least recently used route is the first route on the list. */
-      oldest = list_tail(routelist);
+      oldest = routelist_tail();
 #endif
       if(oldest == NULL) {
         return NULL;
@@ -434,7 +644,7 @@ uip_ds6_route_add(const uip_ipaddr_t *ipaddr, uint8_t length,
 
     /* add new routes first - assuming that there is a reason to add this
        and that there is a packet coming soon. */
-    list_push(routelist, r);
+    routelist_push(r);
 
     nbrr = memb_alloc(&neighborroutememb);
     if(nbrr == NULL) {
@@ -459,6 +669,9 @@ uip_ds6_route_add(const uip_ipaddr_t *ipaddr, uint8_t length,
 
   uip_ipaddr_copy(&(r->ipaddr), ipaddr);
   r->length = length;
+#if UIP_DS6_ROUTE_WITH_HASH_INDEX
+  route_hash_insert(r);
+#endif /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
 
 #ifdef UIP_DS6_ROUTE_STATE_TYPE
   memset(&r->state, 0, sizeof(UIP_DS6_ROUTE_STATE_TYPE));
@@ -503,7 +716,10 @@ uip_ds6_route_rm(uip_ds6_route_t *route)
     LOG_INFO_("\n");
 
     /* Remove the route from the route list */
-    list_remove(routelist, route);
+    routelist_remove(route);
+#if UIP_DS6_ROUTE_WITH_HASH_INDEX
+    route_hash_remove(route);
+#endif /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
 
     /* Find the corresponding neighbor_route and remove it. */
     for(neighbor_route = list_head(route->neighbor_routes->route_list);
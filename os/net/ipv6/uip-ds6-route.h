@@ -114,6 +114,16 @@ void uip_ds6_notification_rm(struct uip_ds6_notification *n);
 #define UIP_DS6_ROUTE_NB 4
 #endif /* UIP_MAX_ROUTES */
 
+/** \brief Keep a hash index of the routes per prefix length, so that
+ *  uip_ds6_route_lookup() does not need to walk the whole routing
+ *  table. Meant for nodes with many routes, such as storing-mode RPL
+ *  roots, as it costs a few bytes of RAM per route. */
+#ifdef UIP_DS6_ROUTE_CONF_WITH_HASH_INDEX
+#define UIP_DS6_ROUTE_WITH_HASH_INDEX UIP_DS6_ROUTE_CONF_WITH_HASH_INDEX
+#else /* UIP_DS6_ROUTE_CONF_WITH_HASH_INDEX */
+#define UIP_DS6_ROUTE_WITH_HASH_INDEX 0
+#endif /* UIP_DS6_ROUTE_CONF_WITH_HASH_INDEX */
+
 /** \brief define some additional RPL related route state and
  *  neighbor callback for RPL - if not a DS6_ROUTE_STATE is already set */
 #ifndef UIP_DS6_ROUTE_STATE_TYPE
@@ -173,6 +183,9 @@ struct uip_ds6_route_neighbor_routes {
 /** \brief An entry in the routing table */
 typedef struct uip_ds6_route {
   struct uip_ds6_route *next;
+#if UIP_DS6_ROUTE_WITH_HASH_INDEX
+  struct uip_ds6_route *prev;
+#endif /* UIP_DS6_ROUTE_WITH_HASH_INDEX */
   /* Each route entry belongs to a specific neighbor. That neighbor
      holds a list of all routing entries that go through it. The
      routes field point to the uip_ds6_route_neighbor_routes that
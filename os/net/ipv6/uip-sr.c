@@ -43,6 +43,7 @@
 #include "net/ipv6/uip-sr.h"
 #include "net/ipv6/uiplib.h"
 #include "net/routing/routing.h"
+#include "lib/hash-index.h"
 #include "lib/list.h"
 #include "lib/memb.h"
 
@@ -54,10 +55,32 @@
 /* Total number of nodes */
 static int num_nodes;
 
+/* Incremented whenever a parent changes or a node is removed */
+static uint32_t topology_version;
+
 /* Every known node in the network */
 LIST(nodelist);
 MEMB(nodememb, uip_sr_node_t, UIP_SR_LINK_NUM);
 
+#if UIP_SR_WITH_HASH_INDEX
+/* Hash index of the nodes in nodememb, keyed by link identifier */
+static uint32_t node_hash_entry(uint16_t pos);
+HASH_INDEX(node_hash, UIP_SR_LINK_NUM, node_hash_entry);
+
+/* A node to look up */
+struct node_key {
+  void *graph;
+  const uip_ipaddr_t *addr;
+};
+
+/* Generation of the graph. Cached reachability is valid only for nodes
+   with the current generation, which changes whenever a parent changes
+   or a node is removed. Zero is never a current generation. */
+static uint16_t reach_gen;
+/* The root node that the cached reachability refers to */
+static uip_sr_node_t *reach_root;
+#endif /* UIP_SR_WITH_HASH_INDEX */
+
 /*---------------------------------------------------------------------------*/
 int
 uip_sr_num_nodes(void)
@@ -65,6 +88,18 @@ uip_sr_num_nodes(void)
   return num_nodes;
 }
 /*---------------------------------------------------------------------------*/
+uint32_t
+uip_sr_topology_version(void)
+{
+  return topology_version;
+}
+/*---------------------------------------------------------------------------*/
+int
+uip_sr_node_index(const uip_sr_node_t *node)
+{
+  return node - (uip_sr_node_t *)nodememb.mem;
+}
+/*---------------------------------------------------------------------------*/
 static int
 node_matches_address(void *graph, const uip_sr_node_t *node, const uip_ipaddr_t *addr)
 {
@@ -76,17 +111,108 @@ node_matches_address(void *graph, const uip_sr_node_t *node, const uip_ipaddr_t
     return uip_ipaddr_cmp(&node_ipaddr, addr);
   }
 }
+#if UIP_SR_WITH_HASH_INDEX
+/*---------------------------------------------------------------------------*/
+static uint32_t
+link_identifier_hash(const unsigned char *link_identifier)
+{
+  uint32_t h = 5381;
+  int i;
+
+  for(i = 0; i < 8; i++) {
+    h = (h * 33) ^ link_identifier[i];
+  }
+  return h;
+}
+/*---------------------------------------------------------------------------*/
+static uip_sr_node_t *
+node_at(uint16_t pos)
+{
+  return (uip_sr_node_t *)nodememb.mem + pos;
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+node_hash_entry(uint16_t pos)
+{
+  return link_identifier_hash(node_at(pos)->link_identifier);
+}
+/*---------------------------------------------------------------------------*/
+static int
+node_hash_match(uint16_t pos, const void *key)
+{
+  const struct node_key *k = key;
+
+  /* Compare node identifier first, then prefix */
+  return memcmp(node_at(pos)->link_identifier, &k->addr->u8[8], 8) == 0
+         && node_matches_address(k->graph, node_at(pos), k->addr);
+}
+/*---------------------------------------------------------------------------*/
+static void
+graph_changed(void)
+{
+  uip_sr_node_t *l;
+
+  if(++reach_gen == 0) {
+    /* Wrapped around, make sure no node has a current generation */
+    for(l = list_head(nodelist); l != NULL; l = list_item_next(l)) {
+      l->reach_gen = 0;
+    }
+    reach_gen = 1;
+  }
+}
+#endif /* UIP_SR_WITH_HASH_INDEX */
+/*---------------------------------------------------------------------------*/
+static void
+set_parent(uip_sr_node_t *node, uip_sr_node_t *parent)
+{
+  if(node->parent != parent) {
+    node->parent = parent;
+    topology_version++;
+#if UIP_SR_WITH_HASH_INDEX
+    graph_changed();
+#endif /* UIP_SR_WITH_HASH_INDEX */
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+remove_node(uip_sr_node_t *node)
+{
+  list_remove(nodelist, node);
+  topology_version++;
+#if UIP_SR_WITH_HASH_INDEX
+  hash_index_remove(&node_hash, link_identifier_hash(node->link_identifier),
+                    uip_sr_node_index(node));
+  graph_changed();
+#endif /* UIP_SR_WITH_HASH_INDEX */
+  memb_free(&nodememb, node);
+  num_nodes--;
+}
 /*---------------------------------------------------------------------------*/
 uip_sr_node_t *
 uip_sr_get_node(void *graph, const uip_ipaddr_t *addr)
 {
+#if UIP_SR_WITH_HASH_INDEX
+  struct node_key key = { graph, addr };
+  int pos;
+
+  if(addr == NULL) {
+    return NULL;
+  }
+  pos = hash_index_lookup(&node_hash, link_identifier_hash(&addr->u8[8]),
+                          node_hash_match, &key);
+  if(pos >= 0) {
+    return node_at(pos);
+  }
+#else /* UIP_SR_WITH_HASH_INDEX */
   uip_sr_node_t *l;
+
   for(l = list_head(nodelist); l != NULL; l = list_item_next(l)) {
     /* Compare prefix and node identifier */
     if(node_matches_address(graph, l, addr)) {
       return l;
     }
   }
+#endif /* UIP_SR_WITH_HASH_INDEX */
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
@@ -97,16 +223,49 @@ uip_sr_is_addr_reachable(void *graph, const uip_ipaddr_t *addr)
   uip_ipaddr_t root_ipaddr;
   uip_sr_node_t *node;
   uip_sr_node_t *root_node;
+#if UIP_SR_WITH_HASH_INDEX
+  uip_sr_node_t *l;
+  uint8_t reachable;
+#endif /* UIP_SR_WITH_HASH_INDEX */
 
   NETSTACK_ROUTING.get_root_ipaddr(&root_ipaddr);
   node = uip_sr_get_node(graph, addr);
   root_node = uip_sr_get_node(graph, &root_ipaddr);
 
+#if UIP_SR_WITH_HASH_INDEX
+  if(node == NULL || root_node == NULL) {
+    return 0;
+  }
+  if(root_node != reach_root) {
+    reach_root = root_node;
+    graph_changed();
+  }
+
+  /* Walk up until the root, or a node whose reachability is known */
+  for(l = node; l != NULL && l != root_node && l->reach_gen != reach_gen
+        && max_depth > 0; l = l->parent) {
+    max_depth--;
+  }
+  if(l != NULL && l != root_node && l->reach_gen == reach_gen) {
+    reachable = l->reachable;
+  } else {
+    reachable = l == root_node;
+  }
+
+  /* All nodes on the way share the same path, cache the result */
+  for(; node != l && node != NULL && node->reach_gen != reach_gen;
+      node = node->parent) {
+    node->reach_gen = reach_gen;
+    node->reachable = reachable;
+  }
+  return reachable;
+#else /* UIP_SR_WITH_HASH_INDEX */
   while(node != NULL && node != root_node && max_depth > 0) {
     node = node->parent;
     max_depth--;
   }
   return node != NULL && node == root_node;
+#endif /* UIP_SR_WITH_HASH_INDEX */
 }
 /*---------------------------------------------------------------------------*/
 void
@@ -148,6 +307,13 @@ uip_sr_update_node(void *graph, const uip_ipaddr_t *child, const uip_ipaddr_t *p
       return NULL;
     }
     child_node->parent = NULL;
+#if UIP_SR_WITH_HASH_INDEX
+    memcpy(child_node->link_identifier, ((const unsigned char *)child) + 8, 8);
+    child_node->reach_gen = 0;
+    hash_index_add(&node_hash,
+                   link_identifier_hash(child_node->link_identifier),
+                   uip_sr_node_index(child_node));
+#endif /* UIP_SR_WITH_HASH_INDEX */
     list_add(nodelist, child_node);
     num_nodes++;
   }
@@ -161,16 +327,16 @@ uip_sr_update_node(void *graph, const uip_ipaddr_t *child, const uip_ipaddr_t *p
   if(uip_sr_is_addr_reachable(graph, child)) {
     old_parent_node = child_node->parent;
     /* Update node */
-    child_node->parent = parent_node;
+    set_parent(child_node, parent_node);
     /* Has the node become unreachable? May happen if we create a loop. */
     if(!uip_sr_is_addr_reachable(graph, child)) {
       /* The new parent makes the node unreachable, restore old parent.
        * We will take the update next time, with chances we know more of
        * the topology and the loop is gone. */
-      child_node->parent = old_parent_node;
+      set_parent(child_node, old_parent_node);
     }
   } else {
-    child_node->parent = parent_node;
+    set_parent(child_node, parent_node);
   }
 
   LOG_INFO("NS: updating link, child ");
@@ -188,6 +354,11 @@ uip_sr_init(void)
   num_nodes = 0;
   memb_init(&nodememb);
   list_init(nodelist);
+#if UIP_SR_WITH_HASH_INDEX
+  hash_index_clear(&node_hash);
+  reach_gen = 1;
+  reach_root = NULL;
+#endif /* UIP_SR_WITH_HASH_INDEX */
 }
 /*---------------------------------------------------------------------------*/
 uip_sr_node_t *
@@ -226,9 +397,7 @@ uip_sr_periodic(unsigned seconds)
         LOG_INFO_("\n");
       }
       /* No child found, deallocate node */
-      list_remove(nodelist, l);
-      memb_free(&nodememb, l);
-      num_nodes--;
+      remove_node(l);
     } else if(l->lifetime != UIP_SR_INFINITE_LIFETIME) {
       l->lifetime = l->lifetime > seconds ? l->lifetime - seconds : 0;
     }
@@ -242,9 +411,7 @@ uip_sr_free_all(void)
   uip_sr_node_t *next;
   for(l = list_head(nodelist); l != NULL; l = next) {
     next = list_item_next(l);
-    list_remove(nodelist, l);
-    memb_free(&nodememb, l);
-    num_nodes--;
+    remove_node(l);
   }
 }
 /*---------------------------------------------------------------------------*/
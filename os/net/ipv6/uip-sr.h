@@ -85,6 +85,16 @@
 
 #define UIP_SR_INFINITE_LIFETIME           0xFFFFFFFF
 
+/* Keep a hash index of the nodes by link identifier, and cache whether
+ * each node is reachable from the root until the graph changes. Makes
+ * source route construction at the root independent of the network
+ * size. Costs two slots of RAM and three bytes per node. */
+#ifdef UIP_SR_CONF_WITH_HASH_INDEX
+#define UIP_SR_WITH_HASH_INDEX UIP_SR_CONF_WITH_HASH_INDEX
+#else /* UIP_SR_CONF_WITH_HASH_INDEX */
+#define UIP_SR_WITH_HASH_INDEX 0
+#endif /* UIP_SR_CONF_WITH_HASH_INDEX */
+
 /********** Data Structures  **********/
 
 /** \brief A node in a source routing graph, stored at the root and representing
@@ -98,6 +108,11 @@ typedef struct uip_sr_node {
   us with the prefix */
   unsigned char link_identifier[8];
   struct uip_sr_node *parent;
+#if UIP_SR_WITH_HASH_INDEX
+  /* Cached reachability, valid while reach_gen matches the graph */
+  uint16_t reach_gen;
+  uint8_t reachable;
+#endif /* UIP_SR_WITH_HASH_INDEX */
 } uip_sr_node_t;
 
 /********** Public functions **********/
@@ -109,6 +124,24 @@ typedef struct uip_sr_node {
 */
 int uip_sr_num_nodes(void);
 
+/**
+ * Tells the version of the graph topology, which changes whenever a
+ * parent changes or a node is removed. Used to invalidate state derived
+ * from the paths in the graph.
+ *
+ * \return The topology version
+*/
+uint32_t uip_sr_topology_version(void);
+
+/**
+ * Tells the index of a node in the node pool, which is stable for as long
+ * as the node exists
+ *
+ * \param node The node
+ * \return The index of the node, between 0 and UIP_SR_LINK_NUM - 1
+*/
+int uip_sr_node_index(const uip_sr_node_t *node);
+
 /**
  * Expires a given child-parent link
  *
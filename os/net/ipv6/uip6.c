@@ -278,6 +278,64 @@ uip_add32(uint8_t *op32, uint16_t op16)
 
 #if ! UIP_ARCH_CHKSUM
 /*---------------------------------------------------------------------------*/
+#if UIP_ARCH_CHKSUM_DATA
+#define chksum uip_arch_chksum_data
+#elif UIP_CHKSUM_WIDE
+static uint16_t
+chksum(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+  uint64_t acc;
+  uint32_t w;
+  uint16_t h;
+
+  /*
+   * Sum 32-bit words in host byte order. The one's complement sum is
+   * independent of byte order (RFC 1071), so only the initial and the
+   * final sum need to be swapped on little-endian CPUs.
+   */
+  acc = UIP_HTONS(sum);
+
+  while(len >= 16) {
+    memcpy(&w, data, 4);
+    acc += w;
+    memcpy(&w, data + 4, 4);
+    acc += w;
+    memcpy(&w, data + 8, 4);
+    acc += w;
+    memcpy(&w, data + 12, 4);
+    acc += w;
+    data += 16;
+    len -= 16;
+  }
+  while(len >= 4) {
+    memcpy(&w, data, 4);
+    acc += w;
+    data += 4;
+    len -= 4;
+  }
+  if(len >= 2) {
+    memcpy(&h, data, 2);
+    acc += h;
+    data += 2;
+    len -= 2;
+  }
+  if(len > 0) {
+    /* Odd trailing byte, padded with a zero byte */
+    uint8_t last[2] = { data[0], 0 };
+    memcpy(&h, last, 2);
+    acc += h;
+  }
+
+  /* Fold the carries back into 16 bits */
+  acc = (acc >> 32) + (acc & 0xffffffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+
+  /* Return sum in host byte order. */
+  return UIP_HTONS((uint16_t)acc);
+}
+#else /* UIP_CHKSUM_WIDE */
 static uint16_t
 chksum(uint16_t sum, const uint8_t *data, uint16_t len)
 {
@@ -308,6 +366,7 @@ chksum(uint16_t sum, const uint8_t *data, uint16_t len)
   /* Return sum in host byte order. */
   return sum;
 }
+#endif /* UIP_CHKSUM_WIDE */
 /*---------------------------------------------------------------------------*/
 uint16_t
 uip_chksum(uint16_t *data, uint16_t len)
@@ -32,6 +32,8 @@
 #include "contiki.h"
 #include "net/ipv6/uip.h"
 #include "net/ipv6/uipbuf.h"
+#include "net/packetbuf.h"
+#include "lib/memb.h"
 #include <string.h>
 
 /*---------------------------------------------------------------------------*/
@@ -39,6 +41,19 @@
 static uint16_t uipbuf_attrs[UIPBUF_ATTR_MAX];
 static uint16_t uipbuf_default_attrs[UIPBUF_ATTR_MAX];
 
+#if UIPBUF_POOL_SIZE > 0
+struct uipbuf_desc {
+  struct uipbuf_desc *next;
+  uint16_t len;
+  uint16_t attrs[UIPBUF_ATTR_MAX];
+  struct packetbuf_attr packetbuf_attrs[PACKETBUF_NUM_ATTRS];
+  struct packetbuf_addr packetbuf_addrs[PACKETBUF_NUM_ADDRS];
+  uint8_t data[UIP_BUFSIZE];
+};
+
+MEMB(uipbuf_pool, struct uipbuf_desc, UIPBUF_POOL_SIZE);
+#endif /* UIPBUF_POOL_SIZE > 0 */
+
 /*---------------------------------------------------------------------------*/
 void
 uipbuf_clear(void)
@@ -245,6 +260,65 @@ uipbuf_init(void)
      configure its default */
   uipbuf_set_default_attr(UIPBUF_ATTR_LLSEC_LEVEL,
                           UIPBUF_ATTR_LLSEC_LEVEL_MAC_DEFAULT);
+#if UIPBUF_POOL_SIZE > 0
+  memb_init(&uipbuf_pool);
+#endif /* UIPBUF_POOL_SIZE > 0 */
+}
+/*---------------------------------------------------------------------------*/
+uipbuf_desc_t *
+uipbuf_pool_save(void)
+{
+#if UIPBUF_POOL_SIZE > 0
+  struct uipbuf_desc *desc;
+
+  desc = memb_alloc(&uipbuf_pool);
+  if(desc != NULL) {
+    desc->len = uip_len;
+    memcpy(desc->data, uip_buf, uip_len);
+    memcpy(desc->attrs, uipbuf_attrs, sizeof(uipbuf_attrs));
+    packetbuf_attr_copyto(desc->packetbuf_attrs, desc->packetbuf_addrs);
+  }
+  return desc;
+#else /* UIPBUF_POOL_SIZE > 0 */
+  return NULL;
+#endif /* UIPBUF_POOL_SIZE > 0 */
+}
+/*---------------------------------------------------------------------------*/
+void
+uipbuf_pool_restore(uipbuf_desc_t *desc)
+{
+#if UIPBUF_POOL_SIZE > 0
+  uipbuf_clear();
+  uip_len = desc->len;
+  memcpy(uip_buf, desc->data, desc->len);
+  memcpy(uipbuf_attrs, desc->attrs, sizeof(uipbuf_attrs));
+#endif /* UIPBUF_POOL_SIZE > 0 */
+}
+/*---------------------------------------------------------------------------*/
+void
+uipbuf_pool_restore_packetbuf_attrs(uipbuf_desc_t *desc)
+{
+#if UIPBUF_POOL_SIZE > 0
+  packetbuf_attr_copyfrom(desc->packetbuf_attrs, desc->packetbuf_addrs);
+#endif /* UIPBUF_POOL_SIZE > 0 */
+}
+/*---------------------------------------------------------------------------*/
+void
+uipbuf_pool_free(uipbuf_desc_t *desc)
+{
+#if UIPBUF_POOL_SIZE > 0
+  memb_free(&uipbuf_pool, desc);
+#endif /* UIPBUF_POOL_SIZE > 0 */
+}
+/*---------------------------------------------------------------------------*/
+int
+uipbuf_pool_numfree(void)
+{
+#if UIPBUF_POOL_SIZE > 0
+  return memb_numfree(&uipbuf_pool);
+#else /* UIPBUF_POOL_SIZE > 0 */
+  return 0;
+#endif /* UIPBUF_POOL_SIZE > 0 */
 }
 
 /*---------------------------------------------------------------------------*/
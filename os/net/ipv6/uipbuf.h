@@ -204,4 +204,67 @@ enum {
   UIPBUF_ATTR_MAX
 };
 
+/**
+ * \brief The number of packet descriptors in the uipbuf pool. A
+ * descriptor holds a copy of a received packet, of its uipbuf attributes
+ * and of the packetbuf attributes and addresses it was received with, so
+ * that more packets than the single uip_buf can be in the stack at the
+ * same time. Zero disables the pool.
+ */
+#ifdef UIPBUF_CONF_POOL_SIZE
+#define UIPBUF_POOL_SIZE UIPBUF_CONF_POOL_SIZE
+#else /* UIPBUF_CONF_POOL_SIZE */
+#define UIPBUF_POOL_SIZE 0
+#endif /* UIPBUF_CONF_POOL_SIZE */
+
+/**
+ * \brief A packet descriptor from the uipbuf pool. It starts with a
+ * next pointer, so that descriptors can be kept on a list.
+ */
+typedef struct uipbuf_desc uipbuf_desc_t;
+
+/**
+ * \brief          Save the packet in uip_buf to a descriptor.
+ * \retval         A descriptor holding the packet, its uipbuf attributes
+ *                 and the attributes and addresses currently in
+ *                 packetbuf, or NULL if the pool is empty
+ *
+ *                 uip_buf is left unchanged.
+ */
+uipbuf_desc_t *uipbuf_pool_save(void);
+
+/**
+ * \brief          Restore a packet from a descriptor.
+ * \param desc     The descriptor, as returned by uipbuf_pool_save()
+ *
+ *                 This function copies the packet back to uip_buf and
+ *                 sets uip_len and the uipbuf attributes. packetbuf is
+ *                 left unchanged, and the descriptor must still be
+ *                 freed with uipbuf_pool_free().
+ */
+void uipbuf_pool_restore(uipbuf_desc_t *desc);
+
+/**
+ * \brief          Restore the packetbuf attributes of a saved packet.
+ * \param desc     The descriptor, as returned by uipbuf_pool_save()
+ *
+ *                 This function sets the packetbuf attributes and
+ *                 addresses (link-layer sender, RSSI, LQI, security
+ *                 level, key index, timestamp...) to those the packet
+ *                 was received with. The packetbuf data is unchanged.
+ */
+void uipbuf_pool_restore_packetbuf_attrs(uipbuf_desc_t *desc);
+
+/**
+ * \brief          Free a descriptor without restoring its packet.
+ * \param desc     The descriptor
+ */
+void uipbuf_pool_free(uipbuf_desc_t *desc);
+
+/**
+ * \brief          Get the number of free descriptors in the pool.
+ * \retval         The number of free descriptors
+ */
+int uipbuf_pool_numfree(void);
+
 #endif /* UIPBUF_H_ */
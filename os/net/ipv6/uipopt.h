@@ -294,6 +294,24 @@ void uip_log(char *msg);
 #define UIP_UDP_CHECKSUMS 1
 #endif
 
+/**
+ * Toggles word-at-a-time computation of the Internet checksum.
+ *
+ * When enabled, the checksum is accumulated 32 bits at a time in a
+ * 64-bit accumulator and folded to 16 bits at the end, instead of
+ * adding one 16-bit word at a time with an end-around carry. This is
+ * faster on 32- and 64-bit CPUs, but not on 8- and 16-bit ones.
+ * Architectures may instead provide their own implementation by
+ * defining UIP_ARCH_CHKSUM_DATA, see uip_arch_chksum_data().
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_CHKSUM_WIDE
+#define UIP_CHKSUM_WIDE (UIP_CONF_CHKSUM_WIDE)
+#else
+#define UIP_CHKSUM_WIDE 0
+#endif
+
 /**
  * The maximum amount of concurrent UDP connections.
  *
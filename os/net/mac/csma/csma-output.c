@@ -101,6 +101,12 @@ struct neighbor_queue {
   struct ctimer transmit_timer;
   uint8_t transmissions;
   uint8_t collisions;
+#if CSMA_BURST_MAX_LEN > 0
+  /* Frames sent in the current burst, before the one being sent */
+  uint8_t burst_count;
+  /* Whether the frame being sent has the frame pending bit set */
+  uint8_t burst_pending;
+#endif /* CSMA_BURST_MAX_LEN > 0 */
   LIST_STRUCT(packet_queue);
 };
 
@@ -174,6 +180,14 @@ send_one_packet(struct neighbor_queue *n, struct packet_queue *q)
   packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &linkaddr_node_addr);
   packetbuf_set_attr(PACKETBUF_ATTR_MAC_ACK, 1);
 
+#if CSMA_BURST_MAX_LEN > 0
+  /* Unicast. More packets in queue for the neighbor? */
+  n->burst_pending = !packetbuf_holds_broadcast()
+    && n->burst_count + 1 < CSMA_BURST_MAX_LEN
+    && list_item_next(q) != NULL;
+  packetbuf_set_attr(PACKETBUF_ATTR_MAC_PENDING, n->burst_pending);
+#endif /* CSMA_BURST_MAX_LEN > 0 */
+
 #if LLSEC802154_ENABLED
 #if LLSEC802154_USES_EXPLICIT_KEYS
   /* This should possibly be taken from upper layers in the future */
@@ -289,6 +303,10 @@ schedule_transmission(struct neighbor_queue *n)
 
   LOG_DBG("scheduling transmission in %u ticks, NB=%u, BE=%u\n",
       (unsigned)delay, n->collisions, backoff_exponent);
+#if CSMA_BURST_MAX_LEN > 0
+  /* Every backoff starts a new burst */
+  n->burst_count = 0;
+#endif /* CSMA_BURST_MAX_LEN > 0 */
   ctimer_set(&n->transmit_timer, delay, transmit_from_queue, n);
 }
 /*---------------------------------------------------------------------------*/
@@ -308,6 +326,14 @@ free_packet(struct neighbor_queue *n, struct packet_queue *p, int status)
       /* There is a next packet. We reset current tx information */
       n->transmissions = 0;
       n->collisions = 0;
+#if CSMA_BURST_MAX_LEN > 0
+      if(status == MAC_TX_OK && n->burst_pending) {
+        /* The receiver expects the next frame: send it without backoff */
+        n->burst_count++;
+        ctimer_set(&n->transmit_timer, 0, transmit_from_queue, n);
+        return;
+      }
+#endif /* CSMA_BURST_MAX_LEN > 0 */
       /* Schedule next transmissions */
       schedule_transmission(n);
     } else {
@@ -470,6 +496,10 @@ csma_output_packet(mac_callback_t sent, void *ptr)
       linkaddr_copy(&n->addr, addr);
       n->transmissions = 0;
       n->collisions = 0;
+#if CSMA_BURST_MAX_LEN > 0
+      n->burst_count = 0;
+      n->burst_pending = 0;
+#endif /* CSMA_BURST_MAX_LEN > 0 */
       /* Init packet queue for this neighbor */
       LIST_STRUCT_INIT(n, packet_queue);
       /* Add neighbor to the neighbor list */
@@ -43,12 +43,21 @@
 #include "net/mac/mac-sequence.h"
 #include "net/packetbuf.h"
 #include "net/netstack.h"
+#include "sys/ctimer.h"
 
 /* Log configuration */
 #include "sys/log.h"
 #define LOG_MODULE "CSMA"
 #define LOG_LEVEL LOG_LEVEL_MAC
 
+#if CSMA_BURST_MAX_LEN > 0
+/* Burst reception state: while a sender announces pending frames, requests
+ * to turn the radio off are deferred until the burst ends */
+static struct ctimer burst_rx_timer;
+static uint8_t burst_rx_active;
+static uint8_t off_requested;
+#endif /* CSMA_BURST_MAX_LEN > 0 */
+
 
 static void
 init_sec(void)
@@ -71,6 +80,30 @@ send_packet(mac_callback_t sent, void *ptr)
   csma_output_packet(sent, ptr);
 }
 /*---------------------------------------------------------------------------*/
+#if CSMA_BURST_MAX_LEN > 0
+static void
+burst_rx_end(void *ptr)
+{
+  burst_rx_active = 0;
+  ctimer_stop(&burst_rx_timer);
+  if(off_requested) {
+    off_requested = 0;
+    NETSTACK_RADIO.off();
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+burst_rx_update(void)
+{
+  if(packetbuf_attr(PACKETBUF_ATTR_MAC_PENDING)) {
+    burst_rx_active = 1;
+    ctimer_set(&burst_rx_timer, CSMA_BURST_RX_TIMEOUT, burst_rx_end, NULL);
+  } else if(burst_rx_active) {
+    burst_rx_end(NULL);
+  }
+}
+#endif /* CSMA_BURST_MAX_LEN > 0 */
+/*---------------------------------------------------------------------------*/
 static void
 input_packet(void)
 {
@@ -92,6 +125,12 @@ input_packet(void)
   } else {
     int duplicate = 0;
 
+#if CSMA_BURST_MAX_LEN > 0
+    if(!packetbuf_holds_broadcast()) {
+      burst_rx_update();
+    }
+#endif /* CSMA_BURST_MAX_LEN > 0 */
+
     /* Check for duplicate packet. */
     duplicate = mac_sequence_is_duplicate();
     if(duplicate) {
@@ -123,12 +162,22 @@ input_packet(void)
 static int
 on(void)
 {
+#if CSMA_BURST_MAX_LEN > 0
+  off_requested = 0;
+#endif /* CSMA_BURST_MAX_LEN > 0 */
   return NETSTACK_RADIO.on();
 }
 /*---------------------------------------------------------------------------*/
 static int
 off(void)
 {
+#if CSMA_BURST_MAX_LEN > 0
+  if(burst_rx_active) {
+    /* More frames are pending: turn off at the end of the burst */
+    off_requested = 1;
+    return 1;
+  }
+#endif /* CSMA_BURST_MAX_LEN > 0 */
   return NETSTACK_RADIO.off();
 }
 /*---------------------------------------------------------------------------*/
@@ -72,6 +72,25 @@
 #define CSMA_AFTER_ACK_DETECTED_WAIT_TIME       RTIMER_SECOND / 1500
 #endif /* CSMA_CONF_AFTER_ACK_DETECTED_WAIT_TIME */
 
+/* Maximum number of frames sent back-to-back to the same neighbor after a
+ * single backoff. Every frame of a burst but the last has the frame pending
+ * bit set, and the receiver defers turning its radio off until the burst
+ * ends. Set to 0 to never use the frame pending bit, i.e., to go through
+ * the backoff before every frame. */
+#ifdef CSMA_CONF_BURST_MAX_LEN
+#define CSMA_BURST_MAX_LEN CSMA_CONF_BURST_MAX_LEN
+#else /* CSMA_CONF_BURST_MAX_LEN */
+#define CSMA_BURST_MAX_LEN 0
+#endif /* CSMA_CONF_BURST_MAX_LEN */
+
+/* How long the receiver of a burst keeps the radio on after a frame with
+ * the frame pending bit set, waiting for the next frame of the burst */
+#ifdef CSMA_CONF_BURST_RX_TIMEOUT
+#define CSMA_BURST_RX_TIMEOUT CSMA_CONF_BURST_RX_TIMEOUT
+#else /* CSMA_CONF_BURST_RX_TIMEOUT */
+#define CSMA_BURST_RX_TIMEOUT (CLOCK_SECOND / 32)
+#endif /* CSMA_CONF_BURST_RX_TIMEOUT */
+
 #define CSMA_ACK_LEN 3
 
 /* just a default - with LLSEC, etc */
@@ -88,6 +88,158 @@ typedef struct {
   uint8_t aux_sec_len;     /**<  Length (in bytes) of aux security header field */
 } field_length_t;
 
+/**
+ *  \brief Structure that contains the offsets of the fields that precede the
+ *  aux security header in a received frame.  The FCF is at offset 0, so an
+ *  offset of 0 means that the field is absent.
+ */
+typedef struct {
+  uint8_t seq;             /**<  Offset of the sequence number */
+  uint8_t dest_pid;        /**<  Offset of the destination PAN ID */
+  uint8_t dest_addr;       /**<  Offset of the destination address */
+  uint8_t src_pid;         /**<  Offset of the source PAN ID */
+  uint8_t src_addr;        /**<  Offset of the source address */
+  uint8_t aux;             /**<  Offset of the aux security header or payload */
+} field_offset_t;
+
+#if FRAME802154_WITH_LAYOUT_TABLE
+/* Field offsets for every frame control field, indexed by layout_index().
+   Bit 0 of the index is PAN ID compression, bit 1 sequence number
+   suppression, bits 2-3 the destination and bits 4-5 the source address
+   mode. Bit 6 is set for frame version 2015 and bit 7 for ACK frames. The
+   entries follow the rules of frame802154_has_panid(). */
+static const field_offset_t layout_table[256] = {
+  /* 0x00 */ { 2, 0, 0, 0, 0, 3 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0x02 */ { 0, 0, 0, 0, 0, 2 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0x04 */ { 2, 3, 0, 0, 0, 5 }, { 2, 3, 0, 0, 0, 5 },
+  /* 0x06 */ { 0, 2, 0, 0, 0, 4 }, { 0, 2, 0, 0, 0, 4 },
+  /* 0x08 */ { 2, 3, 5, 0, 0, 7 }, { 2, 3, 5, 0, 0, 7 },
+  /* 0x0a */ { 0, 2, 4, 0, 0, 6 }, { 0, 2, 4, 0, 0, 6 },
+  /* 0x0c */ { 2, 3, 5, 0, 0, 13 }, { 2, 3, 5, 0, 0, 13 },
+  /* 0x0e */ { 0, 2, 4, 0, 0, 12 }, { 0, 2, 4, 0, 0, 12 },
+  /* 0x10 */ { 2, 0, 0, 3, 0, 5 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0x12 */ { 0, 0, 0, 2, 0, 4 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0x14 */ { 2, 3, 0, 5, 0, 7 }, { 2, 3, 0, 0, 0, 5 },
+  /* 0x16 */ { 0, 2, 0, 4, 0, 6 }, { 0, 2, 0, 0, 0, 4 },
+  /* 0x18 */ { 2, 3, 5, 7, 0, 9 }, { 2, 3, 5, 0, 0, 7 },
+  /* 0x1a */ { 0, 2, 4, 6, 0, 8 }, { 0, 2, 4, 0, 0, 6 },
+  /* 0x1c */ { 2, 3, 5, 13, 0, 15 }, { 2, 3, 5, 0, 0, 13 },
+  /* 0x1e */ { 0, 2, 4, 12, 0, 14 }, { 0, 2, 4, 0, 0, 12 },
+  /* 0x20 */ { 2, 0, 0, 3, 5, 7 }, { 2, 0, 0, 0, 3, 5 },
+  /* 0x22 */ { 0, 0, 0, 2, 4, 6 }, { 0, 0, 0, 0, 2, 4 },
+  /* 0x24 */ { 2, 3, 0, 5, 7, 9 }, { 2, 3, 0, 0, 5, 7 },
+  /* 0x26 */ { 0, 2, 0, 4, 6, 8 }, { 0, 2, 0, 0, 4, 6 },
+  /* 0x28 */ { 2, 3, 5, 7, 9, 11 }, { 2, 3, 5, 0, 7, 9 },
+  /* 0x2a */ { 0, 2, 4, 6, 8, 10 }, { 0, 2, 4, 0, 6, 8 },
+  /* 0x2c */ { 2, 3, 5, 13, 15, 17 }, { 2, 3, 5, 0, 13, 15 },
+  /* 0x2e */ { 0, 2, 4, 12, 14, 16 }, { 0, 2, 4, 0, 12, 14 },
+  /* 0x30 */ { 2, 0, 0, 3, 5, 13 }, { 2, 0, 0, 0, 3, 11 },
+  /* 0x32 */ { 0, 0, 0, 2, 4, 12 }, { 0, 0, 0, 0, 2, 10 },
+  /* 0x34 */ { 2, 3, 0, 5, 7, 15 }, { 2, 3, 0, 0, 5, 13 },
+  /* 0x36 */ { 0, 2, 0, 4, 6, 14 }, { 0, 2, 0, 0, 4, 12 },
+  /* 0x38 */ { 2, 3, 5, 7, 9, 17 }, { 2, 3, 5, 0, 7, 15 },
+  /* 0x3a */ { 0, 2, 4, 6, 8, 16 }, { 0, 2, 4, 0, 6, 14 },
+  /* 0x3c */ { 2, 3, 5, 13, 15, 23 }, { 2, 3, 5, 0, 13, 21 },
+  /* 0x3e */ { 0, 2, 4, 12, 14, 22 }, { 0, 2, 4, 0, 12, 20 },
+  /* 0x40 */ { 2, 0, 0, 0, 0, 3 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0x42 */ { 0, 0, 0, 0, 0, 2 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0x44 */ { 2, 3, 0, 0, 0, 5 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0x46 */ { 0, 2, 0, 0, 0, 4 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0x48 */ { 2, 3, 5, 0, 0, 7 }, { 2, 0, 3, 0, 0, 5 },
+  /* 0x4a */ { 0, 2, 4, 0, 0, 6 }, { 0, 0, 2, 0, 0, 4 },
+  /* 0x4c */ { 2, 3, 5, 0, 0, 13 }, { 2, 0, 3, 0, 0, 11 },
+  /* 0x4e */ { 0, 2, 4, 0, 0, 12 }, { 0, 0, 2, 0, 0, 10 },
+  /* 0x50 */ { 2, 0, 0, 0, 0, 3 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0x52 */ { 0, 0, 0, 0, 0, 2 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0x54 */ { 2, 0, 0, 0, 0, 3 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0x56 */ { 0, 0, 0, 0, 0, 2 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0x58 */ { 2, 3, 5, 0, 0, 7 }, { 2, 3, 5, 0, 0, 7 },
+  /* 0x5a */ { 0, 2, 4, 0, 0, 6 }, { 0, 2, 4, 0, 0, 6 },
+  /* 0x5c */ { 2, 0, 3, 0, 0, 11 }, { 2, 0, 3, 0, 0, 11 },
+  /* 0x5e */ { 0, 0, 2, 0, 0, 10 }, { 0, 0, 2, 0, 0, 10 },
+  /* 0x60 */ { 2, 0, 0, 3, 5, 7 }, { 2, 0, 0, 0, 3, 5 },
+  /* 0x62 */ { 0, 0, 0, 2, 4, 6 }, { 0, 0, 0, 0, 2, 4 },
+  /* 0x64 */ { 2, 3, 0, 0, 5, 7 }, { 2, 3, 0, 0, 5, 7 },
+  /* 0x66 */ { 0, 2, 0, 0, 4, 6 }, { 0, 2, 0, 0, 4, 6 },
+  /* 0x68 */ { 2, 3, 5, 7, 9, 11 }, { 2, 3, 5, 0, 7, 9 },
+  /* 0x6a */ { 0, 2, 4, 6, 8, 10 }, { 0, 2, 4, 0, 6, 8 },
+  /* 0x6c */ { 2, 3, 5, 13, 15, 17 }, { 2, 3, 5, 0, 13, 15 },
+  /* 0x6e */ { 0, 2, 4, 12, 14, 16 }, { 0, 2, 4, 0, 12, 14 },
+  /* 0x70 */ { 2, 0, 0, 3, 5, 13 }, { 2, 0, 0, 0, 3, 11 },
+  /* 0x72 */ { 0, 0, 0, 2, 4, 12 }, { 0, 0, 0, 0, 2, 10 },
+  /* 0x74 */ { 2, 0, 0, 0, 3, 11 }, { 2, 0, 0, 0, 3, 11 },
+  /* 0x76 */ { 0, 0, 0, 0, 2, 10 }, { 0, 0, 0, 0, 2, 10 },
+  /* 0x78 */ { 2, 3, 5, 7, 9, 17 }, { 2, 3, 5, 0, 7, 15 },
+  /* 0x7a */ { 0, 2, 4, 6, 8, 16 }, { 0, 2, 4, 0, 6, 14 },
+  /* 0x7c */ { 2, 3, 5, 0, 13, 21 }, { 2, 0, 3, 0, 11, 19 },
+  /* 0x7e */ { 0, 2, 4, 0, 12, 20 }, { 0, 0, 2, 0, 10, 18 },
+  /* 0x80 */ { 2, 0, 0, 0, 0, 3 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0x82 */ { 0, 0, 0, 0, 0, 2 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0x84 */ { 2, 0, 0, 0, 0, 3 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0x86 */ { 0, 0, 0, 0, 0, 2 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0x88 */ { 2, 0, 3, 0, 0, 5 }, { 2, 0, 3, 0, 0, 5 },
+  /* 0x8a */ { 0, 0, 2, 0, 0, 4 }, { 0, 0, 2, 0, 0, 4 },
+  /* 0x8c */ { 2, 0, 3, 0, 0, 11 }, { 2, 0, 3, 0, 0, 11 },
+  /* 0x8e */ { 0, 0, 2, 0, 0, 10 }, { 0, 0, 2, 0, 0, 10 },
+  /* 0x90 */ { 2, 0, 0, 0, 0, 3 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0x92 */ { 0, 0, 0, 0, 0, 2 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0x94 */ { 2, 0, 0, 0, 0, 3 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0x96 */ { 0, 0, 0, 0, 0, 2 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0x98 */ { 2, 0, 3, 0, 0, 5 }, { 2, 0, 3, 0, 0, 5 },
+  /* 0x9a */ { 0, 0, 2, 0, 0, 4 }, { 0, 0, 2, 0, 0, 4 },
+  /* 0x9c */ { 2, 0, 3, 0, 0, 11 }, { 2, 0, 3, 0, 0, 11 },
+  /* 0x9e */ { 0, 0, 2, 0, 0, 10 }, { 0, 0, 2, 0, 0, 10 },
+  /* 0xa0 */ { 2, 0, 0, 0, 3, 5 }, { 2, 0, 0, 0, 3, 5 },
+  /* 0xa2 */ { 0, 0, 0, 0, 2, 4 }, { 0, 0, 0, 0, 2, 4 },
+  /* 0xa4 */ { 2, 0, 0, 0, 3, 5 }, { 2, 0, 0, 0, 3, 5 },
+  /* 0xa6 */ { 0, 0, 0, 0, 2, 4 }, { 0, 0, 0, 0, 2, 4 },
+  /* 0xa8 */ { 2, 0, 3, 0, 5, 7 }, { 2, 0, 3, 0, 5, 7 },
+  /* 0xaa */ { 0, 0, 2, 0, 4, 6 }, { 0, 0, 2, 0, 4, 6 },
+  /* 0xac */ { 2, 0, 3, 0, 11, 13 }, { 2, 0, 3, 0, 11, 13 },
+  /* 0xae */ { 0, 0, 2, 0, 10, 12 }, { 0, 0, 2, 0, 10, 12 },
+  /* 0xb0 */ { 2, 0, 0, 0, 3, 11 }, { 2, 0, 0, 0, 3, 11 },
+  /* 0xb2 */ { 0, 0, 0, 0, 2, 10 }, { 0, 0, 0, 0, 2, 10 },
+  /* 0xb4 */ { 2, 0, 0, 0, 3, 11 }, { 2, 0, 0, 0, 3, 11 },
+  /* 0xb6 */ { 0, 0, 0, 0, 2, 10 }, { 0, 0, 0, 0, 2, 10 },
+  /* 0xb8 */ { 2, 0, 3, 0, 5, 13 }, { 2, 0, 3, 0, 5, 13 },
+  /* 0xba */ { 0, 0, 2, 0, 4, 12 }, { 0, 0, 2, 0, 4, 12 },
+  /* 0xbc */ { 2, 0, 3, 0, 11, 19 }, { 2, 0, 3, 0, 11, 19 },
+  /* 0xbe */ { 0, 0, 2, 0, 10, 18 }, { 0, 0, 2, 0, 10, 18 },
+  /* 0xc0 */ { 2, 0, 0, 0, 0, 3 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0xc2 */ { 0, 0, 0, 0, 0, 2 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0xc4 */ { 2, 3, 0, 0, 0, 5 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0xc6 */ { 0, 2, 0, 0, 0, 4 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0xc8 */ { 2, 3, 5, 0, 0, 7 }, { 2, 0, 3, 0, 0, 5 },
+  /* 0xca */ { 0, 2, 4, 0, 0, 6 }, { 0, 0, 2, 0, 0, 4 },
+  /* 0xcc */ { 2, 3, 5, 0, 0, 13 }, { 2, 0, 3, 0, 0, 11 },
+  /* 0xce */ { 0, 2, 4, 0, 0, 12 }, { 0, 0, 2, 0, 0, 10 },
+  /* 0xd0 */ { 2, 0, 0, 0, 0, 3 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0xd2 */ { 0, 0, 0, 0, 0, 2 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0xd4 */ { 2, 0, 0, 0, 0, 3 }, { 2, 0, 0, 0, 0, 3 },
+  /* 0xd6 */ { 0, 0, 0, 0, 0, 2 }, { 0, 0, 0, 0, 0, 2 },
+  /* 0xd8 */ { 2, 3, 5, 0, 0, 7 }, { 2, 3, 5, 0, 0, 7 },
+  /* 0xda */ { 0, 2, 4, 0, 0, 6 }, { 0, 2, 4, 0, 0, 6 },
+  /* 0xdc */ { 2, 0, 3, 0, 0, 11 }, { 2, 0, 3, 0, 0, 11 },
+  /* 0xde */ { 0, 0, 2, 0, 0, 10 }, { 0, 0, 2, 0, 0, 10 },
+  /* 0xe0 */ { 2, 0, 0, 3, 5, 7 }, { 2, 0, 0, 0, 3, 5 },
+  /* 0xe2 */ { 0, 0, 0, 2, 4, 6 }, { 0, 0, 0, 0, 2, 4 },
+  /* 0xe4 */ { 2, 3, 0, 0, 5, 7 }, { 2, 3, 0, 0, 5, 7 },
+  /* 0xe6 */ { 0, 2, 0, 0, 4, 6 }, { 0, 2, 0, 0, 4, 6 },
+  /* 0xe8 */ { 2, 3, 5, 7, 9, 11 }, { 2, 3, 5, 0, 7, 9 },
+  /* 0xea */ { 0, 2, 4, 6, 8, 10 }, { 0, 2, 4, 0, 6, 8 },
+  /* 0xec */ { 2, 3, 5, 13, 15, 17 }, { 2, 3, 5, 0, 13, 15 },
+  /* 0xee */ { 0, 2, 4, 12, 14, 16 }, { 0, 2, 4, 0, 12, 14 },
+  /* 0xf0 */ { 2, 0, 0, 3, 5, 13 }, { 2, 0, 0, 0, 3, 11 },
+  /* 0xf2 */ { 0, 0, 0, 2, 4, 12 }, { 0, 0, 0, 0, 2, 10 },
+  /* 0xf4 */ { 2, 0, 0, 0, 3, 11 }, { 2, 0, 0, 0, 3, 11 },
+  /* 0xf6 */ { 0, 0, 0, 0, 2, 10 }, { 0, 0, 0, 0, 2, 10 },
+  /* 0xf8 */ { 2, 3, 5, 7, 9, 17 }, { 2, 3, 5, 0, 7, 15 },
+  /* 0xfa */ { 0, 2, 4, 6, 8, 16 }, { 0, 2, 4, 0, 6, 14 },
+  /* 0xfc */ { 2, 3, 5, 0, 13, 21 }, { 2, 0, 3, 0, 11, 19 },
+  /* 0xfe */ { 0, 2, 4, 0, 12, 20 }, { 0, 0, 2, 0, 10, 18 }
+};
+#endif /* FRAME802154_WITH_LAYOUT_TABLE */
+
 /*----------------------------------------------------------------------------*/
 CC_INLINE static uint8_t
 addr_len(uint8_t mode)
@@ -487,114 +639,176 @@ frame802154_parse_fcf(uint8_t *data, frame802154_fcf_t *pfcf)
   memcpy(pfcf, &fcf, sizeof(frame802154_fcf_t));
 }
 /*----------------------------------------------------------------------------*/
+#if FRAME802154_WITH_LAYOUT_TABLE
+static uint8_t
+layout_index(const uint8_t *data)
+{
+  return ((data[0] >> 6) & 1) |
+    ((data[1] & 1) << 1) |
+    (data[1] & 0x0c) |
+    ((data[1] >> 2) & 0x30) |
+    ((((data[1] >> 4) & 3) == FRAME802154_IEEE802154_2015) << 6) |
+    (((data[0] & 7) == FRAME802154_ACKFRAME) << 7);
+}
+#else /* FRAME802154_WITH_LAYOUT_TABLE */
+static void
+field_offsets(frame802154_fcf_t *fcf, field_offset_t *off)
+{
+  int has_src_panid;
+  int has_dest_panid;
+  uint8_t pos;
+
+  memset(off, 0, sizeof(field_offset_t));
+  frame802154_has_panid(fcf, &has_src_panid, &has_dest_panid);
+  pos = 2;
+
+  if(fcf->sequence_number_suppression == 0) {
+    off->seq = pos++;
+  }
+
+  if(fcf->dest_addr_mode) {
+    if(has_dest_panid) {
+      off->dest_pid = pos;
+      pos += 2;
+    }
+    if(addr_len(fcf->dest_addr_mode)) {
+      off->dest_addr = pos;
+      pos += addr_len(fcf->dest_addr_mode);
+    }
+  }
+
+  if(fcf->src_addr_mode) {
+    if(has_src_panid) {
+      off->src_pid = pos;
+      pos += 2;
+    }
+    if(addr_len(fcf->src_addr_mode)) {
+      off->src_addr = pos;
+      pos += addr_len(fcf->src_addr_mode);
+    }
+  }
+
+  off->aux = pos;
+}
+#endif /* FRAME802154_WITH_LAYOUT_TABLE */
+/*----------------------------------------------------------------------------*/
+/* Copies an over-the-air address into its byte-reversed in-memory form */
+static void
+parse_addr(uint8_t *addr, const uint8_t *data, uint8_t offset, uint8_t mode)
+{
+  const uint8_t *p = data + offset;
+
+  if(offset == 0) {
+    memset(addr, 0, 8);
+  } else if(mode == FRAME802154_LONGADDRMODE) {
+    addr[0] = p[7];
+    addr[1] = p[6];
+    addr[2] = p[5];
+    addr[3] = p[4];
+    addr[4] = p[3];
+    addr[5] = p[2];
+    addr[6] = p[1];
+    addr[7] = p[0];
+  } else {
+    addr[0] = p[1];
+    addr[1] = p[0];
+    memset(addr + 2, 0, 6);
+  }
+}
+/*----------------------------------------------------------------------------*/
 /**
- *   \brief Parses an input frame.  Scans the input frame to find each
- *   section, and stores the information of each section in a
- *   frame802154_t structure.
+ *   \brief Parses the FCF, sequence number and addressing fields of an
+ *   input frame, leaving out the aux security header and the payload.
+ *   This is enough for address filtering, and cheaper than a full
+ *   frame802154_parse().
  *
  *   \param data The input data from the radio chip.
  *   \param len The size of the input data
- *   \param pf The frame802154_t struct to store the parsed frame information.
+ *   \param pf The frame802154_t struct to store the fields in.
+ *
+ *   \return The offset of the aux security header, or of the payload when
+ *   there is none. 0 if the frame is too short.
  */
 int
-frame802154_parse(uint8_t *data, int len, frame802154_t *pf)
+frame802154_peek(const uint8_t *data, int len, frame802154_t *pf)
 {
-  uint8_t *p;
-  frame802154_fcf_t fcf;
-  int c;
-  int has_src_panid;
-  int has_dest_panid;
-#if LLSEC802154_USES_EXPLICIT_KEYS
-  uint8_t key_id_mode;
-#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
+  const field_offset_t *off;
+#if !FRAME802154_WITH_LAYOUT_TABLE
+  field_offset_t offsets;
+#endif /* !FRAME802154_WITH_LAYOUT_TABLE */
 
   if(len < 2) {
     return 0;
   }
 
-  p = data;
-
   /* decode the FCF */
-  frame802154_parse_fcf(p, &fcf);
-  memcpy(&pf->fcf, &fcf, sizeof(frame802154_fcf_t));
-  p += 2;                             /* Skip first two bytes */
+  frame802154_parse_fcf((uint8_t *)data, &pf->fcf);
 
-  if(fcf.sequence_number_suppression == 0) {
-    pf->seq = p[0];
-    p++;
-  }
+#if FRAME802154_WITH_LAYOUT_TABLE
+  off = &layout_table[layout_index(data)];
+#else /* FRAME802154_WITH_LAYOUT_TABLE */
+  field_offsets(&pf->fcf, &offsets);
+  off = &offsets;
+#endif /* FRAME802154_WITH_LAYOUT_TABLE */
 
-  frame802154_has_panid(&fcf, &has_src_panid, &has_dest_panid);
+  if(off->aux > len) {
+    return 0;
+  }
 
-  /* Destination address, if any */
-  if(fcf.dest_addr_mode) {
-    if(has_dest_panid) {
-      /* Destination PAN */
-      pf->dest_pid = p[0] + (p[1] << 8);
-      p += 2;
-    } else {
-      pf->dest_pid = 0;
-    }
+  if(off->seq) {
+    pf->seq = data[off->seq];
+  }
 
-    /* Destination address */
-/*     l = addr_len(fcf.dest_addr_mode); */
-/*     for(c = 0; c < l; c++) { */
-/*       pf->dest_addr.u8[c] = p[l - c - 1]; */
-/*     } */
-/*     p += l; */
-    if(fcf.dest_addr_mode == FRAME802154_SHORTADDRMODE) {
-      linkaddr_copy((linkaddr_t *)&(pf->dest_addr), &linkaddr_null);
-      pf->dest_addr[0] = p[1];
-      pf->dest_addr[1] = p[0];
-      p += 2;
-    } else if(fcf.dest_addr_mode == FRAME802154_LONGADDRMODE) {
-      for(c = 0; c < 8; c++) {
-        pf->dest_addr[c] = p[7 - c];
-      }
-      p += 8;
-    }
+  /* Destination PAN and address, if any */
+  if(off->dest_pid) {
+    pf->dest_pid = data[off->dest_pid] + (data[off->dest_pid + 1] << 8);
   } else {
-    linkaddr_copy((linkaddr_t *)&(pf->dest_addr), &linkaddr_null);
     pf->dest_pid = 0;
   }
+  parse_addr(pf->dest_addr, data, off->dest_addr, pf->fcf.dest_addr_mode);
 
-  /* Source address, if any */
-  if(fcf.src_addr_mode) {
-    /* Source PAN */
-    if(has_src_panid) {
-      pf->src_pid = p[0] + (p[1] << 8);
-      p += 2;
-      if(!has_dest_panid) {
-        pf->dest_pid = pf->src_pid;
-      }
-    } else {
-      pf->src_pid = pf->dest_pid;
-    }
-
-    /* Source address */
-/*     l = addr_len(fcf.src_addr_mode); */
-/*     for(c = 0; c < l; c++) { */
-/*       pf->src_addr.u8[c] = p[l - c - 1]; */
-/*     } */
-/*     p += l; */
-    if(fcf.src_addr_mode == FRAME802154_SHORTADDRMODE) {
-      linkaddr_copy((linkaddr_t *)&(pf->src_addr), &linkaddr_null);
-      pf->src_addr[0] = p[1];
-      pf->src_addr[1] = p[0];
-      p += 2;
-    } else if(fcf.src_addr_mode == FRAME802154_LONGADDRMODE) {
-      for(c = 0; c < 8; c++) {
-        pf->src_addr[c] = p[7 - c];
-      }
-      p += 8;
+  /* Source PAN and address, if any */
+  if(off->src_pid) {
+    pf->src_pid = data[off->src_pid] + (data[off->src_pid + 1] << 8);
+    if(!off->dest_pid) {
+      pf->dest_pid = pf->src_pid;
     }
+  } else if(pf->fcf.src_addr_mode) {
+    pf->src_pid = pf->dest_pid;
   } else {
-    linkaddr_copy((linkaddr_t *)&(pf->src_addr), &linkaddr_null);
     pf->src_pid = 0;
   }
+  parse_addr(pf->src_addr, data, off->src_addr, pf->fcf.src_addr_mode);
+
+  return off->aux;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ *   \brief Parses an input frame.  Scans the input frame to find each
+ *   section, and stores the information of each section in a
+ *   frame802154_t structure.
+ *
+ *   \param data The input data from the radio chip.
+ *   \param len The size of the input data
+ *   \param pf The frame802154_t struct to store the parsed frame information.
+ */
+int
+frame802154_parse(uint8_t *data, int len, frame802154_t *pf)
+{
+  uint8_t *p;
+  int c;
+#if LLSEC802154_USES_EXPLICIT_KEYS
+  uint8_t key_id_mode;
+#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
+
+  c = frame802154_peek(data, len, pf);
+  if(c == 0) {
+    return 0;
+  }
+  p = data + c;
 
 #if LLSEC802154_USES_AUX_HEADER
-  if(fcf.security_enabled) {
+  if(pf->fcf.security_enabled) {
     pf->aux_hdr.security_control.security_level = p[0] & 7;
 #if LLSEC802154_USES_EXPLICIT_KEYS
     pf->aux_hdr.security_control.key_id_mode = (p[0] >> 3) & 3;
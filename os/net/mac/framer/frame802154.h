@@ -92,6 +92,16 @@ frame-filtering-friendly on some platforms) */
 #define FRAME802154_SUPPR_SEQNO 0
 #endif /* FRAME802154_CONF_SUPPR_SEQNO */
 
+/* Locate the addressing fields of received frames with a lookup in a
+   constant table indexed by the frame control field, instead of
+   evaluating the PAN ID compression rules for every frame. The table
+   takes 1.5 KiB of flash. */
+#ifdef FRAME802154_CONF_WITH_LAYOUT_TABLE
+#define FRAME802154_WITH_LAYOUT_TABLE FRAME802154_CONF_WITH_LAYOUT_TABLE
+#else /* FRAME802154_CONF_WITH_LAYOUT_TABLE */
+#define FRAME802154_WITH_LAYOUT_TABLE 0
+#endif /* FRAME802154_CONF_WITH_LAYOUT_TABLE */
+
 /* Macros & Defines */
 
 /** \brief These are some definitions of values used in the FCF.  See the 802.15.4 spec for details.
@@ -216,6 +226,7 @@ int frame802154_hdrlen(frame802154_t *p);
 void frame802154_create_fcf(frame802154_fcf_t *fcf, uint8_t *buf);
 int frame802154_create(frame802154_t *p, uint8_t *buf);
 int frame802154_parse(uint8_t *data, int length, frame802154_t *pf);
+int frame802154_peek(const uint8_t *data, int length, frame802154_t *pf);
 void frame802154_parse_fcf(uint8_t *data, frame802154_fcf_t *pfcf);
 
 /* Get current PAN ID */
@@ -139,7 +139,7 @@ framer_802154_setup_params(packetbuf_attr_t (*get_attr)(uint8_t type),
 
   /* Build the FCF. */
   params->fcf.frame_type = get_attr(PACKETBUF_ATTR_FRAME_TYPE);
-  params->fcf.frame_pending = 0;
+  params->fcf.frame_pending = get_attr(PACKETBUF_ATTR_MAC_PENDING) != 0;
   if(dest_is_broadcast) {
     params->fcf.ack_required = 0;
     /* Suppress seqno on broadcast if supported (frame v2 or more) */
@@ -241,6 +241,7 @@ parse(void)
   if(hdr_len && packetbuf_hdrreduce(hdr_len)) {
     packetbuf_set_attr(PACKETBUF_ATTR_FRAME_TYPE, frame.fcf.frame_type);
     packetbuf_set_attr(PACKETBUF_ATTR_MAC_ACK, frame.fcf.ack_required);
+    packetbuf_set_attr(PACKETBUF_ATTR_MAC_PENDING, frame.fcf.frame_pending);
 
     if(frame.fcf.dest_addr_mode) {
       if(frame.dest_pid != frame802154_get_pan_id() &&
@@ -308,6 +308,15 @@
 #define TSCH_QUEUE_MAX_NEIGHBOR_QUEUES ((NBR_TABLE_CONF_MAX_NEIGHBORS) + 2)
 #endif
 
+/* Keep the unicast neighbors that may transmit in a shared broadcast cell
+ * in a list, served round-robin, instead of scanning all neighbors from the
+ * head of the neighbor list at every shared cell */
+#ifdef TSCH_QUEUE_CONF_WITH_READY_LIST
+#define TSCH_QUEUE_WITH_READY_LIST TSCH_QUEUE_CONF_WITH_READY_LIST
+#else
+#define TSCH_QUEUE_WITH_READY_LIST 0
+#endif
+
 /******** Configuration: scheduling  *******/
 
 /* Initializes TSCH with a 6TiSCH minimal schedule */
@@ -347,6 +356,16 @@
 #define TSCH_SCHEDULE_MAX_LINKS 32
 #endif
 
+/* Keep all links in an array sorted by slotframe handle and timeslot, so
+ * that the next active link of each slotframe is found with a binary search
+ * instead of a scan of all its links. Costs one key and one pointer per
+ * link in TSCH_SCHEDULE_MAX_LINKS; worthwhile with large schedules. */
+#ifdef TSCH_SCHEDULE_CONF_WITH_LINK_INDEX
+#define TSCH_SCHEDULE_WITH_LINK_INDEX TSCH_SCHEDULE_CONF_WITH_LINK_INDEX
+#else
+#define TSCH_SCHEDULE_WITH_LINK_INDEX 0
+#endif
+
 /* To include Sixtop Implementation */
 #ifdef TSCH_CONF_WITH_SIXTOP
 #define TSCH_WITH_SIXTOP TSCH_CONF_WITH_SIXTOP
@@ -47,6 +47,7 @@
 
 #include "contiki.h"
 #include <stdio.h>
+#include <string.h>
 #include "net/mac/tsch/tsch.h"
 #include "lib/ringbufindex.h"
 #include "sys/log.h"
@@ -64,6 +65,193 @@ static struct tsch_log_t log_array[TSCH_LOG_QUEUE_LEN];
 static int log_dropped = 0;
 static int log_active = 0;
 
+uint16_t tsch_log_sampling[tsch_log_num_types] = {
+  TSCH_LOG_SAMPLING_TX, TSCH_LOG_SAMPLING_RX, TSCH_LOG_SAMPLING_MESSAGE
+};
+uint16_t tsch_log_unsampled[tsch_log_num_types];
+
+#if TSCH_LOG_BINARY
+/* SLIP special characters */
+#define SLIP_END     0300
+#define SLIP_ESC     0333
+#define SLIP_ESC_END 0334
+#define SLIP_ESC_ESC 0335
+
+/* Longest record: a message */
+#define BINARY_MAX_LEN (TSCH_LOG_BINARY_HDR_LEN + sizeof(log_array[0].message))
+
+#ifndef TSCH_LOG_BINARY_WRITE
+/*---------------------------------------------------------------------------*/
+static void
+binary_write(const uint8_t *buf, int len)
+{
+  int i;
+
+  for(i = 0; i < len; i++) {
+    putchar(buf[i]);
+  }
+}
+#define TSCH_LOG_BINARY_WRITE binary_write
+#endif /* TSCH_LOG_BINARY_WRITE */
+/*---------------------------------------------------------------------------*/
+/* Output a record as a SLIP frame */
+static void
+binary_output(const uint8_t *buf, int len)
+{
+  /* Room for every byte escaped, and the frame delimiters */
+  static uint8_t frame[2 * BINARY_MAX_LEN + 2];
+  int pos;
+  int i;
+
+  pos = 0;
+  frame[pos++] = SLIP_END;
+  for(i = 0; i < len; i++) {
+    if(buf[i] == SLIP_END) {
+      frame[pos++] = SLIP_ESC;
+      frame[pos++] = SLIP_ESC_END;
+    } else if(buf[i] == SLIP_ESC) {
+      frame[pos++] = SLIP_ESC;
+      frame[pos++] = SLIP_ESC_ESC;
+    } else {
+      frame[pos++] = buf[i];
+    }
+  }
+  frame[pos++] = SLIP_END;
+  TSCH_LOG_BINARY_WRITE(frame, pos);
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t *
+put_u16(uint8_t *p, uint16_t val)
+{
+  p[0] = val & 0xff;
+  p[1] = val >> 8;
+  return p + 2;
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t *
+put_addr(uint8_t *p, const linkaddr_t *addr)
+{
+  *p++ = LINKADDR_SIZE;
+  memcpy(p, addr, LINKADDR_SIZE);
+  return p + LINKADDR_SIZE;
+}
+/*---------------------------------------------------------------------------*/
+/* Fill in the record header. Returns a pointer past its end */
+static uint8_t *
+put_header(uint8_t *p, uint8_t type, const struct tsch_log_t *log)
+{
+  memset(p, 0, TSCH_LOG_BINARY_HDR_LEN);
+  p[0] = TSCH_LOG_BINARY_MAGIC;
+  p[1] = type;
+  if(log != NULL) {
+    p[2] = log->asn.ms1b;
+    put_u16(p + 3, log->asn.ls4b & 0xffff);
+    put_u16(p + 5, log->asn.ls4b >> 16);
+    if(log->link != NULL) {
+      struct tsch_slotframe *sf = tsch_schedule_get_slotframe_by_handle(log->link->slotframe_handle);
+      p[1] |= TSCH_LOG_BINARY_HAS_LINK;
+      put_u16(p + 7, log->link->slotframe_handle);
+      put_u16(p + 9, sf ? sf->size.val : 0);
+      put_u16(p + 11, log->link->timeslot + log->burst_count);
+      put_u16(p + 13, log->link->channel_offset);
+      p[15] = log->burst_count;
+      p[16] = log->channel;
+    }
+  }
+  return p + TSCH_LOG_BINARY_HDR_LEN;
+}
+/*---------------------------------------------------------------------------*/
+static void
+binary_output_log(const struct tsch_log_t *log)
+{
+  uint8_t buf[BINARY_MAX_LEN];
+  uint8_t *p;
+  int len;
+
+  p = put_header(buf, log->type, log);
+  switch(log->type) {
+    case tsch_log_tx:
+      p = put_addr(p, &log->tx.dest);
+      *p++ = log->tx.mac_tx_status;
+      *p++ = log->tx.num_tx;
+      *p++ = log->tx.datalen;
+      *p++ = (log->tx.is_data ? 1 : 0) | (log->tx.drift_used ? 2 : 0);
+      *p++ = log->tx.sec_level;
+      *p++ = log->tx.seqno;
+      p = put_u16(p, log->tx.drift);
+      break;
+    case tsch_log_rx:
+      p = put_addr(p, &log->rx.src);
+      *p++ = (log->rx.is_unicast ? 1 : 0) | (log->rx.is_data ? 2 : 0) |
+        (log->rx.drift_used ? 4 : 0);
+      *p++ = log->rx.sec_level;
+      *p++ = log->rx.datalen;
+      *p++ = log->rx.seqno;
+      p = put_u16(p, log->rx.drift);
+      p = put_u16(p, log->rx.estimated_drift);
+      break;
+    case tsch_log_message:
+      len = strnlen(log->message, sizeof(log->message));
+      memcpy(p, log->message, len);
+      p += len;
+      break;
+    default:
+      break;
+  }
+  binary_output(buf, p - buf);
+}
+#else /* TSCH_LOG_BINARY */
+/*---------------------------------------------------------------------------*/
+static void
+text_output_log(const struct tsch_log_t *log)
+{
+  if(log->link == NULL) {
+    printf("[INFO: TSCH-LOG  ] {asn %02x.%08lx link-NULL} ", log->asn.ms1b, (unsigned long)log->asn.ls4b);
+  } else {
+    struct tsch_slotframe *sf = tsch_schedule_get_slotframe_by_handle(log->link->slotframe_handle);
+    printf("[INFO: TSCH-LOG  ] {asn %02x.%08lx link %2u %3u %3u %2u %2u ch %2u} ",
+           log->asn.ms1b, (unsigned long)log->asn.ls4b,
+           log->link->slotframe_handle, sf ? sf->size.val : 0,
+           log->burst_count, log->link->timeslot + log->burst_count, log->link->channel_offset,
+           log->channel);
+  }
+  switch(log->type) {
+    case tsch_log_tx:
+      printf("%s-%u-%u tx ",
+              linkaddr_cmp(&log->tx.dest, &linkaddr_null) ? "bc" : "uc", log->tx.is_data, log->tx.sec_level);
+      log_lladdr_compact(&linkaddr_node_addr);
+      printf("->");
+      log_lladdr_compact(&log->tx.dest);
+      printf(", len %3u, seq %3u, st %d %2d",
+              log->tx.datalen, log->tx.seqno, log->tx.mac_tx_status, log->tx.num_tx);
+      if(log->tx.drift_used) {
+        printf(", dr %3d", log->tx.drift);
+      }
+      printf("\n");
+      break;
+    case tsch_log_rx:
+      printf("%s-%u-%u rx ",
+              log->rx.is_unicast == 0 ? "bc" : "uc", log->rx.is_data, log->rx.sec_level);
+      log_lladdr_compact(&log->rx.src);
+      printf("->");
+      log_lladdr_compact(log->rx.is_unicast ? &linkaddr_node_addr : NULL);
+      printf(", len %3u, seq %3u",
+              log->rx.datalen, log->rx.seqno);
+      printf(", edr %3d", (int)log->rx.estimated_drift);
+      if(log->rx.drift_used) {
+        printf(", dr %3d\n", log->rx.drift);
+      } else {
+        printf("\n");
+      }
+      break;
+    case tsch_log_message:
+      printf("%s\n", log->message);
+      break;
+    default:
+      break;
+  }
+}
+#endif /* TSCH_LOG_BINARY */
 /*---------------------------------------------------------------------------*/
 /* Process pending log messages */
 void
@@ -73,54 +261,21 @@ tsch_log_process_pending(void)
   int16_t log_index;
   /* Loop on accessing (without removing) a pending input packet */
   if(log_dropped != last_log_dropped) {
+#if TSCH_LOG_BINARY
+    uint8_t buf[TSCH_LOG_BINARY_HDR_LEN + 2];
+    put_u16(put_header(buf, TSCH_LOG_BINARY_DROPPED, NULL), log_dropped);
+    binary_output(buf, sizeof(buf));
+#else /* TSCH_LOG_BINARY */
     printf("[WARN: TSCH-LOG  ] logs dropped %u\n", log_dropped);
+#endif /* TSCH_LOG_BINARY */
     last_log_dropped = log_dropped;
   }
   while((log_index = ringbufindex_peek_get(&log_ringbuf)) != -1) {
-    struct tsch_log_t *log = &log_array[log_index];
-    if(log->link == NULL) {
-      printf("[INFO: TSCH-LOG  ] {asn %02x.%08lx link-NULL} ", log->asn.ms1b, log->asn.ls4b);
-    } else {
-      struct tsch_slotframe *sf = tsch_schedule_get_slotframe_by_handle(log->link->slotframe_handle);
-      printf("[INFO: TSCH-LOG  ] {asn %02x.%08lx link %2u %3u %3u %2u %2u ch %2u} ",
-             log->asn.ms1b, log->asn.ls4b,
-             log->link->slotframe_handle, sf ? sf->size.val : 0,
-             log->burst_count, log->link->timeslot + log->burst_count, log->link->channel_offset,
-             log->channel);
-    }
-    switch(log->type) {
-      case tsch_log_tx:
-        printf("%s-%u-%u tx ",
-                linkaddr_cmp(&log->tx.dest, &linkaddr_null) ? "bc" : "uc", log->tx.is_data, log->tx.sec_level);
-        log_lladdr_compact(&linkaddr_node_addr);
-        printf("->");
-        log_lladdr_compact(&log->tx.dest);
-        printf(", len %3u, seq %3u, st %d %2d",
-                log->tx.datalen, log->tx.seqno, log->tx.mac_tx_status, log->tx.num_tx);
-        if(log->tx.drift_used) {
-          printf(", dr %3d", log->tx.drift);
-        }
-        printf("\n");
-        break;
-      case tsch_log_rx:
-        printf("%s-%u-%u rx ",
-                log->rx.is_unicast == 0 ? "bc" : "uc", log->rx.is_data, log->rx.sec_level);
-        log_lladdr_compact(&log->rx.src);
-        printf("->");
-        log_lladdr_compact(log->rx.is_unicast ? &linkaddr_node_addr : NULL);
-        printf(", len %3u, seq %3u",
-                log->rx.datalen, log->rx.seqno);
-        printf(", edr %3d", (int)log->rx.estimated_drift);
-        if(log->rx.drift_used) {
-          printf(", dr %3d\n", log->rx.drift);
-        } else {
-          printf("\n");
-        }
-        break;
-      case tsch_log_message:
-        printf("%s\n", log->message);
-        break;
-    }
+#if TSCH_LOG_BINARY
+    binary_output_log(&log_array[log_index]);
+#else /* TSCH_LOG_BINARY */
+    text_output_log(&log_array[log_index]);
+#endif /* TSCH_LOG_BINARY */
     /* Remove input from ringbuf */
     ringbufindex_get(&log_ringbuf);
   }
@@ -162,6 +317,24 @@ tsch_log_init(void)
   if(log_active == 0) {
     ringbufindex_init(&log_ringbuf, TSCH_LOG_QUEUE_LEN);
     log_active = 1;
+#if TSCH_LOG_BINARY
+    {
+      /* Tell the decoder our address, the source of all tx logs */
+      uint8_t buf[TSCH_LOG_BINARY_HDR_LEN + 1 + LINKADDR_SIZE];
+      put_addr(put_header(buf, TSCH_LOG_BINARY_NODE, NULL), &linkaddr_node_addr);
+      binary_output(buf, sizeof(buf));
+    }
+#endif /* TSCH_LOG_BINARY */
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Set the sampling of a log type */
+void
+tsch_log_set_sampling(int type, uint16_t ratio)
+{
+  if(type >= 0 && type < tsch_log_num_types) {
+    tsch_log_sampling[type] = ratio;
+    tsch_log_unsampled[type] = 0;
   }
 }
 /*---------------------------------------------------------------------------*/
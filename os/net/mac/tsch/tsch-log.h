@@ -62,6 +62,76 @@
 #define TSCH_LOG_QUEUE_LEN 8
 #endif /* TSCH_LOG_CONF_QUEUE_LEN */
 
+/* Output the per-slot logs as SLIP-framed binary records instead of
+ * formatted text. tools/tsch-log decodes them back to text on the host. */
+#ifdef TSCH_LOG_CONF_BINARY
+#define TSCH_LOG_BINARY TSCH_LOG_CONF_BINARY
+#else /* TSCH_LOG_CONF_BINARY */
+#define TSCH_LOG_BINARY 0
+#endif /* TSCH_LOG_CONF_BINARY */
+
+/* The function that outputs a SLIP-framed binary record, as
+ * void f(const uint8_t *buf, int len). By default, the record is output
+ * with putchar(), byte by byte. */
+#ifdef TSCH_LOG_CONF_BINARY_WRITE
+#define TSCH_LOG_BINARY_WRITE TSCH_LOG_CONF_BINARY_WRITE
+#endif /* TSCH_LOG_CONF_BINARY_WRITE */
+
+/* Initial sampling of each log type: one event out of N is logged, none
+ * if N is 0. Can be changed at runtime with tsch_log_set_sampling(). */
+#ifdef TSCH_LOG_CONF_SAMPLING_TX
+#define TSCH_LOG_SAMPLING_TX TSCH_LOG_CONF_SAMPLING_TX
+#else /* TSCH_LOG_CONF_SAMPLING_TX */
+#define TSCH_LOG_SAMPLING_TX 1
+#endif /* TSCH_LOG_CONF_SAMPLING_TX */
+
+#ifdef TSCH_LOG_CONF_SAMPLING_RX
+#define TSCH_LOG_SAMPLING_RX TSCH_LOG_CONF_SAMPLING_RX
+#else /* TSCH_LOG_CONF_SAMPLING_RX */
+#define TSCH_LOG_SAMPLING_RX 1
+#endif /* TSCH_LOG_CONF_SAMPLING_RX */
+
+#ifdef TSCH_LOG_CONF_SAMPLING_MESSAGE
+#define TSCH_LOG_SAMPLING_MESSAGE TSCH_LOG_CONF_SAMPLING_MESSAGE
+#else /* TSCH_LOG_CONF_SAMPLING_MESSAGE */
+#define TSCH_LOG_SAMPLING_MESSAGE 1
+#endif /* TSCH_LOG_CONF_SAMPLING_MESSAGE */
+
+/*
+ * Binary record format. Each record is sent as a SLIP frame (RFC 1055):
+ * 0xc0, the record with 0xc0 and 0xdb escaped, 0xc0. Multi-byte fields
+ * are little-endian. Every record starts with a 17-byte header:
+ *
+ *  0      TSCH_LOG_BINARY_MAGIC
+ *  1      log type, ORed with TSCH_LOG_BINARY_HAS_LINK if there is a link
+ *  2      ASN, most significant byte
+ *  3-6    ASN, least significant 4 bytes
+ *  7-8    slotframe handle
+ *  9-10   slotframe size
+ *  11-12  timeslot, including the burst offset
+ *  13-14  channel offset
+ *  15     burst count
+ *  16     channel
+ *
+ * It is followed by, for each type:
+ *  tx       address length N, destination address (N bytes), MAC tx
+ *           status, number of transmissions, data length, flags (bit 0:
+ *           data frame, bit 1: drift used), security level, sequence
+ *           number, drift (2 bytes)
+ *  rx       address length N, source address (N bytes), flags (bit 0:
+ *           unicast, bit 1: data frame, bit 2: drift used), security
+ *           level, data length, sequence number, drift (2 bytes),
+ *           estimated drift (2 bytes)
+ *  message  the text of the message, without terminating NUL
+ *  dropped  total number of dropped logs (2 bytes)
+ *  node     address length N, address of the node (N bytes)
+ */
+#define TSCH_LOG_BINARY_MAGIC      0xa5
+#define TSCH_LOG_BINARY_HAS_LINK   0x80
+#define TSCH_LOG_BINARY_HDR_LEN    17
+#define TSCH_LOG_BINARY_DROPPED    3
+#define TSCH_LOG_BINARY_NODE       4
+
 #if (TSCH_LOG_PER_SLOT == 0)
 
 #define tsch_log_init()
@@ -76,7 +146,8 @@
 struct tsch_log_t {
   enum { tsch_log_tx,
          tsch_log_rx,
-         tsch_log_message
+         tsch_log_message,
+         tsch_log_num_types
   } type;
   struct tsch_asn_t asn;
   struct tsch_link *link;
@@ -132,17 +203,43 @@ void tsch_log_process_pending(void);
  * \brief Stop logging module
  */
 void tsch_log_stop(void);
+/**
+ * \brief Set the sampling of a log type
+ * \param type The log type: tsch_log_tx, tsch_log_rx or tsch_log_message
+ * \param ratio One event out of ratio is logged, none if ratio is 0
+ */
+void tsch_log_set_sampling(int type, uint16_t ratio);
+
+/* Sampling ratio and events since the last sample, per log type */
+extern uint16_t tsch_log_sampling[tsch_log_num_types];
+extern uint16_t tsch_log_unsampled[tsch_log_num_types];
+
+/**
+ * \brief Tell whether an event of the given type is to be logged, as per
+ * the sampling of its type
+ */
+static inline int
+tsch_log_sample(int type)
+{
+  if(++tsch_log_unsampled[type] < tsch_log_sampling[type]) {
+    return 0;
+  }
+  tsch_log_unsampled[type] = 0;
+  return tsch_log_sampling[type] != 0;
+}
 
 /************ Macros **********/
 
 /** \brief Use this macro to add a log to the queue (will be printed out
  * later, after leaving interrupt context) */
 #define TSCH_LOG_ADD(log_type, init_code) do { \
-    struct tsch_log_t *log = tsch_log_prepare_add(); \
-    if(log != NULL) { \
-      log->type = (log_type); \
-      init_code; \
-      tsch_log_commit(); \
+    if(tsch_log_sample(log_type)) { \
+      struct tsch_log_t *log = tsch_log_prepare_add(); \
+      if(log != NULL) { \
+        log->type = (log_type); \
+        init_code; \
+        tsch_log_commit(); \
+      } \
     } \
 } while(0);
 
@@ -74,6 +74,123 @@ LIST(neighbor_list);
 struct tsch_neighbor *n_broadcast;
 struct tsch_neighbor *n_eb;
 
+#if TSCH_QUEUE_WITH_READY_LIST
+/* Unicast neighbors that may transmit in shared broadcast cells, i.e.,
+ * without Tx link, with a non-empty queue and an expired backoff. The list
+ * is only modified from slot operation, or from outside slot operation with
+ * the TSCH lock held. Entries that no longer qualify are dropped when met
+ * at the head of the list. */
+static struct tsch_neighbor *ready_head;
+static struct tsch_neighbor *ready_tail;
+/* Wide enough for any TSCH_QUEUE_MAX_NEIGHBOR_QUEUES */
+static uint16_t ready_count;
+
+/* Neighbors that may have become ready outside of slot operation. Filled
+ * lock-free from process context and drained at the next shared cell */
+#define READY_NOTIFY_SIZE 16
+static struct tsch_neighbor *ready_notify_array[READY_NOTIFY_SIZE];
+static struct ringbufindex ready_notify_ringbuf;
+/* Set when the list must be rebuilt from the neighbor list */
+static volatile uint8_t ready_rebuild;
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
+
+
+#if TSCH_QUEUE_WITH_READY_LIST
+/*---------------------------------------------------------------------------*/
+/* Can the neighbor transmit in a shared broadcast cell? */
+static int
+ready_nbr_is_ready(const struct tsch_neighbor *n)
+{
+  return !n->is_broadcast && n->tx_links_count == 0
+    && !ringbufindex_empty(&n->tx_ringbuf)
+    && tsch_queue_backoff_expired(n);
+}
+/*---------------------------------------------------------------------------*/
+/* Add a neighbor at the tail of the ready list, if it qualifies and is
+ * not there yet. Call from slot operation or with the lock held only. */
+static void
+ready_add(struct tsch_neighbor *n)
+{
+  if(!n->is_ready && ready_nbr_is_ready(n)) {
+    n->is_ready = 1;
+    n->ready_next = NULL;
+    if(ready_tail != NULL) {
+      ready_tail->ready_next = n;
+    } else {
+      ready_head = n;
+    }
+    ready_tail = n;
+    ready_count++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Remove and return the head of the ready list */
+static struct tsch_neighbor *
+ready_pop(void)
+{
+  struct tsch_neighbor *n = ready_head;
+  if(n != NULL) {
+    ready_head = n->ready_next;
+    if(ready_head == NULL) {
+      ready_tail = NULL;
+    }
+    n->is_ready = 0;
+    ready_count--;
+  }
+  return n;
+}
+/*---------------------------------------------------------------------------*/
+/* Empty the ready list, and have it rebuilt at the next shared cell.
+ * Call with the lock held only. */
+static void
+ready_reset(void)
+{
+  while(ready_pop() != NULL);
+  ringbufindex_init(&ready_notify_ringbuf, READY_NOTIFY_SIZE);
+  ready_rebuild = 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Bring the ready list up to date with the notifications received outside
+ * of slot operation. Call from slot operation only. */
+static void
+ready_sync(void)
+{
+  int16_t get_index;
+
+  if(ready_rebuild) {
+    struct tsch_neighbor *n;
+    /* Clear the flag first so that requests made meanwhile are not lost */
+    ready_rebuild = 0;
+    while((get_index = ringbufindex_get(&ready_notify_ringbuf)) != -1);
+    for(n = list_head(neighbor_list); n != NULL; n = list_item_next(n)) {
+      ready_add(n);
+    }
+  } else {
+    while((get_index = ringbufindex_get(&ready_notify_ringbuf)) != -1) {
+      ready_add(ready_notify_array[get_index]);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Signal that a neighbor may have become ready, from outside of slot
+ * operation */
+void
+tsch_queue_notify_nbr_ready(struct tsch_neighbor *n)
+{
+  /* The ready flag is only cleared from slot operation, once the neighbor
+   * no longer qualifies: if it is still set, the neighbor will be met */
+  if(n != NULL && !n->is_ready) {
+    int16_t put_index = ringbufindex_peek_put(&ready_notify_ringbuf);
+    if(put_index != -1) {
+      ready_notify_array[put_index] = n;
+      ringbufindex_put(&ready_notify_ringbuf);
+    } else {
+      /* Too many notifications pending: rebuild from all neighbors */
+      ready_rebuild = 1;
+    }
+  }
+}
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
 /*---------------------------------------------------------------------------*/
 /* Add a TSCH neighbor */
 struct tsch_neighbor *
@@ -213,6 +330,10 @@ tsch_queue_remove_nbr(struct tsch_neighbor *n)
 
       /* Remove neighbor from list */
       list_remove(neighbor_list, n);
+#if TSCH_QUEUE_WITH_READY_LIST
+      /* The neighbor may be in the ready list or among notifications */
+      ready_reset();
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
 
       tsch_release_lock();
 
@@ -261,6 +382,9 @@ tsch_queue_add_packet(const linkaddr_t *addr, uint8_t max_transmissions,
             /* Add to ringbuf (actual add committed through atomic operation) */
             n->tx_array[put_index] = p;
             ringbufindex_put(&n->tx_ringbuf);
+#if TSCH_QUEUE_WITH_READY_LIST
+            tsch_queue_notify_nbr_ready(n);
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
             LOG_DBG("packet is added put_index %u, packet %p\n",
                    put_index, p);
             return p;
@@ -364,6 +488,11 @@ tsch_queue_packet_sent(struct tsch_neighbor *n, struct tsch_packet *p,
     }
   }
 
+#if TSCH_QUEUE_WITH_READY_LIST
+  /* The backoff may have been reset with packets left in queue */
+  ready_add(n);
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
+
   return in_queue;
 }
 /*---------------------------------------------------------------------------*/
@@ -456,8 +585,33 @@ struct tsch_packet *
 tsch_queue_get_unicast_packet_for_any(struct tsch_neighbor **n, struct tsch_link *link)
 {
   if(!tsch_is_locked()) {
-    struct tsch_neighbor *curr_nbr = list_head(neighbor_list);
+    struct tsch_neighbor *curr_nbr;
     struct tsch_packet *p = NULL;
+#if TSCH_QUEUE_WITH_READY_LIST
+    if(link != NULL && (link->link_options & LINK_OPTION_SHARED)) {
+      /* Serve ready neighbors round-robin. Each neighbor is visited at
+       * most once; those that no longer qualify are dropped. */
+      uint16_t count;
+      ready_sync();
+      count = ready_count;
+      while(count-- > 0 && (curr_nbr = ready_pop()) != NULL) {
+        if(ready_nbr_is_ready(curr_nbr)) {
+          /* Back to the tail: the neighbor is served again after all others */
+          ready_add(curr_nbr);
+          p = tsch_queue_get_packet_for_nbr(curr_nbr, link);
+          if(p != NULL) {
+            if(n != NULL) {
+              *n = curr_nbr;
+            }
+            return p;
+          }
+        }
+      }
+      return NULL;
+    }
+    /* Dedicated cell: backoffs do not apply, look at all neighbors */
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
+    curr_nbr = list_head(neighbor_list);
     while(curr_nbr != NULL) {
       if(!curr_nbr->is_broadcast && curr_nbr->tx_links_count == 0) {
         /* Only look up for non-broadcast neighbors we do not have a tx link to */
@@ -517,6 +671,11 @@ tsch_queue_update_all_backoff_windows(const linkaddr_t *dest_addr)
          && ((n->tx_links_count == 0 && is_broadcast)
              || (n->tx_links_count > 0 && linkaddr_cmp(dest_addr, &n->addr)))) {
         n->backoff_window--;
+#if TSCH_QUEUE_WITH_READY_LIST
+        if(n->backoff_window == 0) {
+          ready_add(n);
+        }
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
       }
       n = list_item_next(n);
     }
@@ -530,6 +689,13 @@ tsch_queue_init(void)
   list_init(neighbor_list);
   memb_init(&neighbor_memb);
   memb_init(&packet_memb);
+#if TSCH_QUEUE_WITH_READY_LIST
+  ready_head = NULL;
+  ready_tail = NULL;
+  ready_count = 0;
+  ringbufindex_init(&ready_notify_ringbuf, READY_NOTIFY_SIZE);
+  ready_rebuild = 0;
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
   /* Add virtual EB and the broadcast neighbors */
   n_eb = tsch_queue_add_nbr(&tsch_eb_address);
   n_broadcast = tsch_queue_add_nbr(&tsch_broadcast_address);
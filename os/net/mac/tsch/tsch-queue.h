@@ -159,6 +159,14 @@ struct tsch_packet *tsch_queue_get_unicast_packet_for_any(struct tsch_neighbor *
  * \return 1 if the backoff has expired (neighbor ready to transmit on a shared link), 0 otherwise
  */
 int tsch_queue_backoff_expired(const struct tsch_neighbor *n);
+/**
+ * \brief Signal that a neighbor may have become able to transmit in shared
+ * cells, e.g. after its last Tx link was removed. Packets added through
+ * tsch_queue_add_packet are signaled already. Only used with
+ * TSCH_QUEUE_WITH_READY_LIST.
+ * \param n The neighbor queue
+ */
+void tsch_queue_notify_nbr_ready(struct tsch_neighbor *n);
 /**
  * \brief Reset neighbor backoff
  * \param n The neighbor queue
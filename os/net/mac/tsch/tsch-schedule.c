@@ -67,6 +67,94 @@ MEMB(slotframe_memb, struct tsch_slotframe, TSCH_SCHEDULE_MAX_SLOTFRAMES);
 /* List of slotframes (each slotframe holds its own list of links) */
 LIST(slotframe_list);
 
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+/* Index of all links, sorted by slotframe handle then timeslot */
+struct link_index_entry {
+  uint32_t key;
+  struct tsch_link *link;
+};
+static struct link_index_entry link_index[TSCH_SCHEDULE_MAX_LINKS];
+static uint16_t link_index_count;
+
+#define LINK_INDEX_KEY(sf_handle, timeslot) \
+  (((uint32_t)(sf_handle) << 16) | (timeslot))
+
+/*---------------------------------------------------------------------------*/
+/* Returns the position of the first entry with key greater than or equal
+ * to that of (sf_handle, timeslot) */
+static uint16_t
+link_index_lower_bound(uint16_t sf_handle, uint16_t timeslot)
+{
+  uint32_t key = LINK_INDEX_KEY(sf_handle, timeslot);
+  uint16_t lo = 0;
+  uint16_t hi = link_index_count;
+  while(lo < hi) {
+    uint16_t mid = (lo + hi) / 2;
+    if(link_index[mid].key < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the link of slotframe sf_handle at timeslot, if any */
+static struct tsch_link *
+link_index_find(uint16_t sf_handle, uint16_t timeslot)
+{
+  uint16_t i = link_index_lower_bound(sf_handle, timeslot);
+  if(i < link_index_count
+     && link_index[i].key == LINK_INDEX_KEY(sf_handle, timeslot)) {
+    return link_index[i].link;
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the first link of a slotframe strictly after timeslot, wrapping
+ * around to the start of the slotframe (NULL if the slotframe is empty) */
+static struct tsch_link *
+link_index_next(uint16_t sf_handle, uint16_t timeslot)
+{
+  uint16_t i = link_index_lower_bound(sf_handle, timeslot + 1);
+  if(i < link_index_count && (link_index[i].key >> 16) == sf_handle) {
+    return link_index[i].link;
+  }
+  i = link_index_lower_bound(sf_handle, 0);
+  if(i < link_index_count && (link_index[i].key >> 16) == sf_handle) {
+    return link_index[i].link;
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+link_index_add(struct tsch_link *l)
+{
+  uint16_t i = link_index_lower_bound(l->slotframe_handle, l->timeslot);
+  memmove(&link_index[i + 1], &link_index[i],
+          (link_index_count - i) * sizeof(link_index[0]));
+  link_index[i].key = LINK_INDEX_KEY(l->slotframe_handle, l->timeslot);
+  link_index[i].link = l;
+  link_index_count++;
+}
+/*---------------------------------------------------------------------------*/
+static void
+link_index_remove(struct tsch_link *l)
+{
+  uint16_t i = link_index_lower_bound(l->slotframe_handle, l->timeslot);
+  /* Skip entries with the same key but a different link, if any */
+  while(i < link_index_count && link_index[i].link != l) {
+    i++;
+  }
+  if(i < link_index_count) {
+    link_index_count--;
+    memmove(&link_index[i], &link_index[i + 1],
+            (link_index_count - i) * sizeof(link_index[0]));
+  }
+}
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
+/*---------------------------------------------------------------------------*/
+
 /* Adds and returns a slotframe (NULL if failure) */
 struct tsch_slotframe *
 tsch_schedule_add_slotframe(uint16_t handle, uint16_t size)
@@ -253,6 +341,9 @@ tsch_schedule_add_link(struct tsch_slotframe *slotframe,
           address = &linkaddr_null;
         }
         linkaddr_copy(&l->addr, address);
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+        link_index_add(l);
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
 
         LOG_INFO("add_link sf=%u opt=%s type=%s ts=%u ch=%u addr=",
                  slotframe->handle,
@@ -305,6 +396,9 @@ tsch_schedule_remove_link(struct tsch_slotframe *slotframe, struct tsch_link *l)
       LOG_INFO_LLADDR(&l->addr);
       LOG_INFO_("\n");
 
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+      link_index_remove(l);
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
       list_remove(slotframe->links_list, l);
       memb_free(&link_memb, l);
 
@@ -319,6 +413,12 @@ tsch_schedule_remove_link(struct tsch_slotframe *slotframe, struct tsch_link *l)
           if(!(link_options & LINK_OPTION_SHARED)) {
             n->dedicated_tx_links_count--;
           }
+#if TSCH_QUEUE_WITH_READY_LIST
+          if(n->tx_links_count == 0) {
+            /* Queued packets may now go in shared cells */
+            tsch_queue_notify_nbr_ready(n);
+          }
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
         }
       }
 
@@ -344,6 +444,9 @@ tsch_schedule_get_link_by_timeslot(struct tsch_slotframe *slotframe, uint16_t ti
 {
   if(!tsch_is_locked()) {
     if(slotframe != NULL) {
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+      return link_index_find(slotframe->handle, timeslot);
+#else /* TSCH_SCHEDULE_WITH_LINK_INDEX */
       struct tsch_link *l = list_head(slotframe->links_list);
       /* Loop over all items. Assume there is max one link per timeslot */
       while(l != NULL) {
@@ -353,6 +456,7 @@ tsch_schedule_get_link_by_timeslot(struct tsch_slotframe *slotframe, uint16_t ti
         l = list_item_next(l);
       }
       return l;
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
     }
   }
   return NULL;
@@ -375,8 +479,15 @@ tsch_schedule_get_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset
     while(sf != NULL) {
       /* Get timeslot from ASN, given the slotframe length */
       uint16_t timeslot = TSCH_ASN_MOD(*asn, sf->size);
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+      /* With max one link per timeslot, the earliest link of the slotframe
+       * is the only candidate */
+      struct tsch_link *l = link_index_next(sf->handle, timeslot);
+      if(l != NULL) {
+#else /* TSCH_SCHEDULE_WITH_LINK_INDEX */
       struct tsch_link *l = list_head(sf->links_list);
       while(l != NULL) {
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
         uint16_t time_to_timeslot =
           l->timeslot > timeslot ?
           l->timeslot - timeslot :
@@ -419,7 +530,9 @@ tsch_schedule_get_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset
           }
         }
 
+#if !TSCH_SCHEDULE_WITH_LINK_INDEX
         l = list_item_next(l);
+#endif /* !TSCH_SCHEDULE_WITH_LINK_INDEX */
       }
       sf = list_item_next(sf);
     }
@@ -441,6 +554,9 @@ tsch_schedule_init(void)
     memb_init(&link_memb);
     memb_init(&slotframe_memb);
     list_init(slotframe_list);
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+    link_index_count = 0;
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
     tsch_release_lock();
     return 1;
   } else {
@@ -122,6 +122,11 @@ struct tsch_neighbor {
   struct tsch_packet *tx_array[TSCH_QUEUE_NUM_PER_NEIGHBOR];
   /* Circular buffer of pointers to packet. */
   struct ringbufindex tx_ringbuf;
+#if TSCH_QUEUE_WITH_READY_LIST
+  /* Next neighbor in the list of neighbors ready for shared cells */
+  struct tsch_neighbor *ready_next;
+  uint8_t is_ready; /* is the neighbor in the ready list? */
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
 };
 
 /** \brief TSCH timeslot timing elements. Used to index timeslot timing
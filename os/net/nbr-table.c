@@ -83,6 +83,36 @@ static unsigned num_tables;
 MEMB(neighbor_addr_mem, nbr_table_key_t, NBR_TABLE_MAX_NEIGHBORS);
 LIST(nbr_table_keys);
 
+#if NBR_TABLE_WITH_HASH_INDEX
+/* Open-addressing hash index of the keys, with linear probing. A slot
+ * holds the neighbor index plus one, or zero if it is empty. The number
+ * of slots is a power of two at least twice the number of neighbors,
+ * which keeps the probe sequences short. */
+#if NBR_TABLE_MAX_NEIGHBORS <= 32
+#define HASH_SLOTS 64
+#elif NBR_TABLE_MAX_NEIGHBORS <= 64
+#define HASH_SLOTS 128
+#elif NBR_TABLE_MAX_NEIGHBORS <= 127
+#define HASH_SLOTS 256
+#elif NBR_TABLE_MAX_NEIGHBORS <= 256
+#define HASH_SLOTS 512
+#elif NBR_TABLE_MAX_NEIGHBORS <= 512
+#define HASH_SLOTS 1024
+#elif NBR_TABLE_MAX_NEIGHBORS <= 1024
+#define HASH_SLOTS 2048
+#else
+#error "NBR_TABLE_WITH_HASH_INDEX supports up to 1024 neighbors"
+#endif
+#define HASH_MASK (HASH_SLOTS - 1)
+
+#if NBR_TABLE_MAX_NEIGHBORS < 255
+typedef uint8_t hash_slot_t;
+#else
+typedef uint16_t hash_slot_t;
+#endif
+static hash_slot_t hash_index[HASH_SLOTS];
+#endif /* NBR_TABLE_WITH_HASH_INDEX */
+
 /*---------------------------------------------------------------------------*/
 /* Get a key from a neighbor index */
 static nbr_table_key_t *
@@ -125,17 +155,92 @@ key_from_item(nbr_table_t *table, const nbr_table_item_t *item)
 {
   return key_from_index(index_from_item(table, item));
 }
+#if NBR_TABLE_WITH_HASH_INDEX
+/*---------------------------------------------------------------------------*/
+/* Get the home slot of a link-layer address in the hash index */
+static unsigned
+hash_lladdr(const linkaddr_t *lladdr)
+{
+  unsigned h = 5381;
+  int i;
+
+  for(i = 0; i < LINKADDR_SIZE; i++) {
+    h = (h * 33) ^ lladdr->u8[i];
+  }
+  return (h ^ (h >> 8)) & HASH_MASK;
+}
+/*---------------------------------------------------------------------------*/
+/* Add a key to the hash index */
+static void
+hash_insert(nbr_table_key_t *key)
+{
+  unsigned slot = hash_lladdr(&key->lladdr);
+
+  while(hash_index[slot] != 0) {
+    slot = (slot + 1) & HASH_MASK;
+  }
+  hash_index[slot] = index_from_key(key) + 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Remove a key from the hash index. The entries that follow in the
+ * probe sequence are shifted back, so that no lookup ever stops at the
+ * freed slot while its key is further on. */
+static void
+hash_remove(nbr_table_key_t *key)
+{
+  unsigned slot;
+  unsigned next;
+  unsigned home;
+  hash_slot_t value = index_from_key(key) + 1;
+
+  for(slot = hash_lladdr(&key->lladdr); hash_index[slot] != value;
+      slot = (slot + 1) & HASH_MASK) {
+    if(hash_index[slot] == 0) {
+      /* Not in the index */
+      return;
+    }
+  }
+
+  next = slot;
+  while(1) {
+    hash_index[slot] = 0;
+    do {
+      next = (next + 1) & HASH_MASK;
+      if(hash_index[next] == 0) {
+        return;
+      }
+      home = hash_lladdr(&key_from_index(hash_index[next] - 1)->lladdr);
+      /* Keep the entry where it is if its home slot lies cyclically
+       * within (slot, next] */
+    } while(((next - home) & HASH_MASK) < ((next - slot) & HASH_MASK));
+    hash_index[slot] = hash_index[next];
+    slot = next;
+  }
+}
+#endif /* NBR_TABLE_WITH_HASH_INDEX */
 /*---------------------------------------------------------------------------*/
 /* Get the index of a neighbor from its link-layer address */
 static int
 index_from_lladdr(const linkaddr_t *lladdr)
 {
   nbr_table_key_t *key;
+#if NBR_TABLE_WITH_HASH_INDEX
+  unsigned slot;
+#endif /* NBR_TABLE_WITH_HASH_INDEX */
   /* Allow lladdr-free insertion, useful e.g. for IPv6 ND.
    * Only one such entry is possible at a time, indexed by linkaddr_null. */
   if(lladdr == NULL) {
     lladdr = &linkaddr_null;
   }
+#if NBR_TABLE_WITH_HASH_INDEX
+  for(slot = hash_lladdr(lladdr); hash_index[slot] != 0;
+      slot = (slot + 1) & HASH_MASK) {
+    key = key_from_index(hash_index[slot] - 1);
+    if(linkaddr_cmp(lladdr, &key->lladdr)) {
+      return hash_index[slot] - 1;
+    }
+  }
+#else /* NBR_TABLE_WITH_HASH_INDEX */
   key = list_head(nbr_table_keys);
   while(key != NULL) {
     if(lladdr && linkaddr_cmp(lladdr, &key->lladdr)) {
@@ -143,6 +248,7 @@ index_from_lladdr(const linkaddr_t *lladdr)
     }
     key = list_item_next(key);
   }
+#endif /* NBR_TABLE_WITH_HASH_INDEX */
   return -1;
 }
 /*---------------------------------------------------------------------------*/
@@ -195,6 +301,9 @@ remove_key(nbr_table_key_t *least_used_key)
   used_map[index_from_key(least_used_key)] = 0;
   /* Remove neighbor from list */
   list_remove(nbr_table_keys, least_used_key);
+#if NBR_TABLE_WITH_HASH_INDEX
+  hash_remove(least_used_key);
+#endif /* NBR_TABLE_WITH_HASH_INDEX */
 }
 /*---------------------------------------------------------------------------*/
 static nbr_table_key_t *
@@ -381,6 +490,9 @@ nbr_table_add_lladdr(nbr_table_t *table, const linkaddr_t *lladdr, nbr_table_rea
 
     /* Set link-layer address */
     linkaddr_copy(&key->lladdr, lladdr);
+#if NBR_TABLE_WITH_HASH_INDEX
+    hash_insert(key);
+#endif /* NBR_TABLE_WITH_HASH_INDEX */
   }
 
   /* Get item in the current table */
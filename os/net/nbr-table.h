@@ -46,6 +46,15 @@
 #define NBR_TABLE_MAX_NEIGHBORS 8
 #endif /* NBR_TABLE_CONF_MAX_NEIGHBORS */
 
+/* Keep a hash index of the link-layer addresses, making lookups by
+ * address constant-time on average instead of linear in the number of
+ * neighbors. Costs two slots of RAM per neighbor. */
+#ifdef NBR_TABLE_CONF_WITH_HASH_INDEX
+#define NBR_TABLE_WITH_HASH_INDEX NBR_TABLE_CONF_WITH_HASH_INDEX
+#else /* NBR_TABLE_CONF_WITH_HASH_INDEX */
+#define NBR_TABLE_WITH_HASH_INDEX 0
+#endif /* NBR_TABLE_CONF_WITH_HASH_INDEX */
+
 /* An item in a neighbor table */
 typedef void nbr_table_item_t;
 
@@ -147,6 +147,86 @@
 #endif
 #endif /* RPL_CONF_TRICKLE_REFRESH_DAO_ROUTES */
 
+/*
+ * Keep the neighbors that the objective function accepts as parents in a
+ * list ordered by cached path cost, updated whenever the rank or link
+ * metric of a single neighbor changes. Parent selection then only runs the
+ * OF comparison on the cheapest candidates and the preferred parent, rather
+ * than on the whole neighbor table. This is only equivalent to a full scan
+ * for OFs that never pick a neighbor costlier than both the cheapest
+ * candidate and the preferred parent, which holds for OF0 and MRHOF.
+ */
+#ifdef RPL_CONF_WITH_PARENT_CACHE
+#define RPL_WITH_PARENT_CACHE RPL_CONF_WITH_PARENT_CACHE
+#else
+#define RPL_WITH_PARENT_CACHE 0
+#endif
+
+/*
+ * Root snapshot. When enabled, the root periodically saves its DAG ID,
+ * version and non-storing routing links to a CFS file, and reloads them
+ * when it starts again. The DAG then keeps its version and downward routes
+ * are available right away, while a DTSN increment has all nodes refresh
+ * them through new DAOs. Requires a CFS backend (cfs-posix on native, or
+ * MODULES += os/storage/cfs for cfs-coffee).
+ */
+#ifdef RPL_CONF_WITH_ROOT_SNAPSHOT
+#define RPL_WITH_ROOT_SNAPSHOT RPL_CONF_WITH_ROOT_SNAPSHOT
+#else
+#define RPL_WITH_ROOT_SNAPSHOT 0
+#endif
+
+/* Name of the CFS file holding the root snapshot */
+#ifdef RPL_CONF_ROOT_SNAPSHOT_FILE
+#define RPL_ROOT_SNAPSHOT_FILE RPL_CONF_ROOT_SNAPSHOT_FILE
+#else
+#define RPL_ROOT_SNAPSHOT_FILE "rpl-root.snap"
+#endif
+
+/* Interval between two checkpoints, in seconds. Unchanged snapshots
+ * are not rewritten. */
+#ifdef RPL_CONF_ROOT_SNAPSHOT_PERIOD
+#define RPL_ROOT_SNAPSHOT_PERIOD RPL_CONF_ROOT_SNAPSHOT_PERIOD
+#else
+#define RPL_ROOT_SNAPSHOT_PERIOD (5 * 60)
+#endif
+
+/* Lifetime of the links restored from a snapshot, in seconds. Links that
+ * are not refreshed by a DAO within this time are removed. */
+#ifdef RPL_CONF_ROOT_SNAPSHOT_LIFETIME
+#define RPL_ROOT_SNAPSHOT_LIFETIME RPL_CONF_ROOT_SNAPSHOT_LIFETIME
+#else
+#define RPL_ROOT_SNAPSHOT_LIFETIME (5 * 60)
+#endif
+
+/*
+ * SRH cache. When enabled, the root keeps the source routing header it
+ * built for each destination, and copies it as is into subsequent packets
+ * until the uip-sr topology changes. This saves the walk of the graph and
+ * the address compression per packet.
+ */
+#ifdef RPL_CONF_WITH_SRH_CACHE
+#define RPL_WITH_SRH_CACHE RPL_CONF_WITH_SRH_CACHE
+#else
+#define RPL_WITH_SRH_CACHE 0
+#endif
+
+/* Number of entries in the SRH cache. With fewer entries than uip-sr
+ * nodes, destinations share entries. */
+#ifdef RPL_CONF_SRH_CACHE_SIZE
+#define RPL_SRH_CACHE_SIZE RPL_CONF_SRH_CACHE_SIZE
+#else
+#define RPL_SRH_CACHE_SIZE UIP_SR_LINK_NUM
+#endif
+
+/* Maximum length of a cached SRH, in bytes. Longer headers are built
+ * for every packet. */
+#ifdef RPL_CONF_SRH_CACHE_MAX_LEN
+#define RPL_SRH_CACHE_MAX_LEN RPL_CONF_SRH_CACHE_MAX_LEN
+#else
+#define RPL_SRH_CACHE_MAX_LEN 64
+#endif
+
 /*
  * RPL probing. When enabled, probes will be sent periodically to keep
  * neighbor link estimates up to date. Further configurable
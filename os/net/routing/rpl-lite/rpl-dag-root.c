@@ -43,6 +43,10 @@
 #include "net/routing/rpl-lite/rpl.h"
 #include "net/ipv6/uip-ds6-route.h"
 #include "net/ipv6/uip-sr.h"
+#if RPL_WITH_ROOT_SNAPSHOT
+#include "cfs/cfs.h"
+#include "lib/crc16.h"
+#endif /* RPL_WITH_ROOT_SNAPSHOT */
 
 /* Log configuration */
 #include "sys/log.h"
@@ -119,6 +123,222 @@ rpl_dag_root_set_prefix(uip_ipaddr_t *prefix, uip_ipaddr_t *iid)
     initialized = 1;
   }
 }
+#if RPL_WITH_ROOT_SNAPSHOT
+/*---------------------------------------------------------------------------*/
+/*
+ * Snapshot layout, multi-byte fields in network byte order:
+ *   header:  magic (2), format (1), instance ID (1), DAG version (1),
+ *            DTSN (1), link count (2), DAG ID (16)
+ *   links:   child IID (8), parent IID (8)
+ *   trailer: CRC-16 of header and links (2)
+ */
+#define SNAPSHOT_MAGIC          0x5253
+#define SNAPSHOT_FORMAT         1
+#define SNAPSHOT_HEADER_LEN     24
+#define SNAPSHOT_LINK_LEN       16
+
+/* Set once the snapshot file and the current state are known to match,
+ * either because it was restored or written. Until then, every root start
+ * attempts a restore. */
+static uint8_t snapshot_synced;
+static unsigned short snapshot_crc;
+/*---------------------------------------------------------------------------*/
+static int
+link_is_saved(const uip_sr_node_t *link)
+{
+  /* Skip the root and links pending removal after a No-Path DAO */
+  return link->parent != NULL && link->lifetime > UIP_SR_REMOVAL_DELAY;
+}
+/*---------------------------------------------------------------------------*/
+static void
+snapshot_header(uint8_t *buf, uint16_t count)
+{
+  buf[0] = SNAPSHOT_MAGIC >> 8;
+  buf[1] = SNAPSHOT_MAGIC & 0xff;
+  buf[2] = SNAPSHOT_FORMAT;
+  buf[3] = curr_instance.instance_id;
+  buf[4] = curr_instance.dag.version;
+  buf[5] = curr_instance.dtsn_out;
+  buf[6] = count >> 8;
+  buf[7] = count & 0xff;
+  memcpy(&buf[8], &curr_instance.dag.dag_id, 16);
+}
+/*---------------------------------------------------------------------------*/
+static void
+snapshot_link(uint8_t *buf, const uip_sr_node_t *link)
+{
+  memcpy(&buf[0], link->link_identifier, 8);
+  memcpy(&buf[8], link->parent->link_identifier, 8);
+}
+/*---------------------------------------------------------------------------*/
+int
+rpl_dag_root_save_snapshot(void)
+{
+  uint8_t buf[SNAPSHOT_HEADER_LEN];
+  uip_sr_node_t *link;
+  unsigned short crc;
+  uint16_t count;
+  int fd;
+
+  if(!rpl_dag_root_is_root()) {
+    return -1;
+  }
+
+  count = 0;
+  for(link = uip_sr_node_head(); link != NULL; link = uip_sr_node_next(link)) {
+    count += link_is_saved(link);
+  }
+
+  /* Compute the CRC first, so that unchanged snapshots do not wear the
+   * flash */
+  snapshot_header(buf, count);
+  crc = crc16_data(buf, SNAPSHOT_HEADER_LEN, 0);
+  for(link = uip_sr_node_head(); link != NULL; link = uip_sr_node_next(link)) {
+    if(link_is_saved(link)) {
+      snapshot_link(buf, link);
+      crc = crc16_data(buf, SNAPSHOT_LINK_LEN, crc);
+    }
+  }
+  if(snapshot_synced && crc == snapshot_crc) {
+    return 0;
+  }
+
+  cfs_remove(RPL_ROOT_SNAPSHOT_FILE);
+  fd = cfs_open(RPL_ROOT_SNAPSHOT_FILE, CFS_WRITE);
+  if(fd < 0) {
+    LOG_ERR("snapshot: cannot open %s\n", RPL_ROOT_SNAPSHOT_FILE);
+    return -1;
+  }
+
+  snapshot_header(buf, count);
+  if(cfs_write(fd, buf, SNAPSHOT_HEADER_LEN) != SNAPSHOT_HEADER_LEN) {
+    goto error;
+  }
+  for(link = uip_sr_node_head(); link != NULL; link = uip_sr_node_next(link)) {
+    if(link_is_saved(link)) {
+      snapshot_link(buf, link);
+      if(cfs_write(fd, buf, SNAPSHOT_LINK_LEN) != SNAPSHOT_LINK_LEN) {
+        goto error;
+      }
+    }
+  }
+  buf[0] = crc >> 8;
+  buf[1] = crc & 0xff;
+  if(cfs_write(fd, buf, 2) != 2) {
+    goto error;
+  }
+  cfs_close(fd);
+
+  snapshot_synced = 1;
+  snapshot_crc = crc;
+  LOG_INFO("snapshot: saved version %u, %u links\n",
+           curr_instance.dag.version, count);
+  return 1;
+
+error:
+  cfs_close(fd);
+  cfs_remove(RPL_ROOT_SNAPSHOT_FILE);
+  LOG_ERR("snapshot: write failed\n");
+  return -1;
+}
+/*---------------------------------------------------------------------------*/
+int
+rpl_dag_root_load_snapshot(void)
+{
+  uint8_t buf[SNAPSHOT_HEADER_LEN];
+  uint8_t version;
+  uint8_t dtsn;
+  uip_ipaddr_t child;
+  uip_ipaddr_t parent;
+  unsigned short crc;
+  uint16_t count;
+  uint16_t i;
+  int restored;
+  int fd;
+
+  if(!rpl_dag_root_is_root()) {
+    return -1;
+  }
+
+  fd = cfs_open(RPL_ROOT_SNAPSHOT_FILE, CFS_READ);
+  if(fd < 0) {
+    return -1;
+  }
+
+  if(cfs_read(fd, buf, SNAPSHOT_HEADER_LEN) != SNAPSHOT_HEADER_LEN
+     || ((buf[0] << 8) | buf[1]) != SNAPSHOT_MAGIC
+     || buf[2] != SNAPSHOT_FORMAT
+     || buf[3] != curr_instance.instance_id
+     || memcmp(&buf[8], &curr_instance.dag.dag_id, 16) != 0) {
+    LOG_WARN("snapshot: not matching the current DAG, ignored\n");
+    cfs_close(fd);
+    return -1;
+  }
+  version = buf[4];
+  dtsn = buf[5];
+  count = (buf[6] << 8) | buf[7];
+
+  /* Check the whole file before touching the routing state */
+  crc = crc16_data(buf, SNAPSHOT_HEADER_LEN, 0);
+  for(i = 0; i < count; i++) {
+    if(cfs_read(fd, buf, SNAPSHOT_LINK_LEN) != SNAPSHOT_LINK_LEN) {
+      break;
+    }
+    crc = crc16_data(buf, SNAPSHOT_LINK_LEN, crc);
+  }
+  if(i < count || cfs_read(fd, buf, 2) != 2
+     || ((buf[0] << 8) | buf[1]) != crc) {
+    LOG_WARN("snapshot: corrupted, ignored\n");
+    cfs_close(fd);
+    return -1;
+  }
+
+  restored = 0;
+  memcpy(&child, &curr_instance.dag.dag_id, 8);
+  memcpy(&parent, &curr_instance.dag.dag_id, 8);
+  cfs_seek(fd, SNAPSHOT_HEADER_LEN, CFS_SEEK_SET);
+  for(i = 0; i < count; i++) {
+    if(cfs_read(fd, buf, SNAPSHOT_LINK_LEN) != SNAPSHOT_LINK_LEN) {
+      break;
+    }
+    memcpy(&child.u8[8], &buf[0], 8);
+    memcpy(&parent.u8[8], &buf[8], 8);
+    if(uip_sr_update_node(NULL, &child, &parent,
+                          RPL_ROOT_SNAPSHOT_LIFETIME) != NULL) {
+      restored++;
+    }
+  }
+  cfs_close(fd);
+
+  /* Keep the DAG version, and have all nodes send a DAO to refresh
+   * the restored links */
+  curr_instance.dag.version = version;
+  curr_instance.dtsn_out = dtsn;
+  rpl_refresh_routes("Snapshot restored");
+
+  snapshot_synced = 1;
+  snapshot_crc = crc;
+  LOG_INFO("snapshot: restored version %u, %d/%u links\n",
+           version, restored, count);
+  return restored;
+}
+#endif /* RPL_WITH_ROOT_SNAPSHOT */
+/*---------------------------------------------------------------------------*/
+void
+rpl_dag_root_periodic(unsigned seconds)
+{
+#if RPL_WITH_ROOT_SNAPSHOT
+  static unsigned elapsed;
+
+  if(rpl_dag_root_is_root()) {
+    elapsed += seconds;
+    if(elapsed >= RPL_ROOT_SNAPSHOT_PERIOD) {
+      elapsed = 0;
+      rpl_dag_root_save_snapshot();
+    }
+  }
+#endif /* RPL_WITH_ROOT_SNAPSHOT */
+}
 /*---------------------------------------------------------------------------*/
 int
 rpl_dag_root_start(void)
@@ -144,6 +364,11 @@ rpl_dag_root_start(void)
 
     rpl_dag_init_root(RPL_DEFAULT_INSTANCE, ipaddr,
       (uip_ipaddr_t *)rpl_get_global_address(), 64, UIP_ND6_RA_FLAG_AUTONOMOUS);
+#if RPL_WITH_ROOT_SNAPSHOT
+    if(!snapshot_synced) {
+      rpl_dag_root_load_snapshot();
+    }
+#endif /* RPL_WITH_ROOT_SNAPSHOT */
     rpl_dag_update_state();
 
     LOG_INFO("created a new RPL DAG\n");
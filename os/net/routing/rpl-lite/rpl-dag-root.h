@@ -69,6 +69,34 @@ int rpl_dag_root_is_root(void);
  * \param str A descriptive text on the caller
 */
 void rpl_dag_root_print_links(const char *str);
+/**
+ * Periodic processing of the root, called from the RPL periodic timer.
+ * Checkpoints the DAG to CFS every RPL_ROOT_SNAPSHOT_PERIOD seconds.
+ *
+ * \param seconds The number of seconds elapsed since the last call
+*/
+void rpl_dag_root_periodic(unsigned seconds);
+
+#if RPL_WITH_ROOT_SNAPSHOT
+/**
+ * Saves the DAG ID, version and routing links to RPL_ROOT_SNAPSHOT_FILE
+ *
+ * \return 1 if written, 0 if the saved snapshot was already up to date,
+ * -1 in case of error or if we are not root
+*/
+int rpl_dag_root_save_snapshot(void);
+
+/**
+ * Restores the DAG version and routing links from RPL_ROOT_SNAPSHOT_FILE,
+ * if it was saved for the current DAG. Restored links get lifetime
+ * RPL_ROOT_SNAPSHOT_LIFETIME, and the DTSN is incremented so that they
+ * get refreshed. Called from rpl_dag_root_start until a snapshot has been
+ * restored or saved.
+ *
+ * \return The number of restored links, -1 if nothing was restored
+*/
+int rpl_dag_root_load_snapshot(void);
+#endif /* RPL_WITH_ROOT_SNAPSHOT */
 
  /** @} */
 
@@ -161,6 +161,82 @@ count_matching_bytes(const void *p1, const void *p2, size_t n)
   }
   return n;
 }
+#if RPL_WITH_SRH_CACHE
+/*---------------------------------------------------------------------------*/
+/* A source routing header ready to be copied at the root, valid as long as
+ * the uip-sr topology has not changed since it was built. Entries are
+ * indexed by uip-sr node index. */
+struct srh_cache_entry {
+  const uip_sr_node_t *dest;
+  const uip_sr_node_t *next_hop;
+  uint32_t topology_version;
+  uint8_t len;
+  uint8_t hdr[RPL_SRH_CACHE_MAX_LEN];
+};
+static struct srh_cache_entry srh_cache[RPL_SRH_CACHE_SIZE];
+/*---------------------------------------------------------------------------*/
+static struct srh_cache_entry *
+srh_cache_lookup(const uip_sr_node_t *dest_node)
+{
+  struct srh_cache_entry *e;
+
+  e = &srh_cache[uip_sr_node_index(dest_node) % RPL_SRH_CACHE_SIZE];
+  if(e->dest == dest_node
+     && e->topology_version == uip_sr_topology_version()) {
+    return e;
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+srh_cache_store(const uip_sr_node_t *dest_node, const uip_sr_node_t *next_hop,
+                const uint8_t *hdr, uint8_t len)
+{
+  struct srh_cache_entry *e;
+
+  if(len > RPL_SRH_CACHE_MAX_LEN) {
+    return;
+  }
+  e = &srh_cache[uip_sr_node_index(dest_node) % RPL_SRH_CACHE_SIZE];
+  e->dest = dest_node;
+  e->next_hop = next_hop;
+  e->topology_version = uip_sr_topology_version();
+  e->len = len;
+  memcpy(e->hdr, hdr, len);
+}
+/*---------------------------------------------------------------------------*/
+/* Inserts a cached SRH as first extension header. Returns 1 on success,
+ * 0 on failure. */
+static int
+insert_cached_srh_header(const struct srh_cache_entry *e)
+{
+  struct uip_routing_hdr *rh_hdr = (struct uip_routing_hdr *)UIP_IP_PAYLOAD(0);
+
+  if(uip_len + e->len > UIP_LINK_MTU) {
+    LOG_ERR("packet too long: impossible to add source routing header (%u bytes)\n", e->len);
+    return 0;
+  }
+
+  LOG_INFO("SRH from cache, ext len %u\n", e->len);
+
+  /* Move existing ext headers and payload, and copy the cached header,
+   * padding included */
+  memmove(uip_buf + UIP_IPH_LEN + uip_ext_len + e->len,
+      uip_buf + UIP_IPH_LEN + uip_ext_len, uip_len - UIP_IPH_LEN);
+  memcpy(rh_hdr, e->hdr, e->len);
+
+  rh_hdr->next = UIP_IP_BUF->proto;
+  UIP_IP_BUF->proto = UIP_PROTO_ROUTING;
+
+  /* The next hop is placed as the current IPv6 destination */
+  NETSTACK_ROUTING.get_sr_node_ipaddr(&UIP_IP_BUF->destipaddr, e->next_hop);
+
+  uipbuf_add_ext_hdr(e->len);
+  uipbuf_set_len_field(UIP_IP_BUF, uip_len - UIP_IPH_LEN);
+
+  return 1;
+}
+#endif /* RPL_WITH_SRH_CACHE */
 /*---------------------------------------------------------------------------*/
 /* Used by rpl_ext_header_update to insert a RPL SRH extension header. This
  * is used at the root, to initiate downward routing. Returns 1 on success,
@@ -179,6 +255,9 @@ insert_srh_header(void)
   uip_sr_node_t *root_node;
   uip_sr_node_t *node;
   uip_ipaddr_t node_addr;
+#if RPL_WITH_SRH_CACHE
+  const struct srh_cache_entry *cached;
+#endif /* RPL_WITH_SRH_CACHE */
 
   /* Always insest SRH as first extension header */
   struct uip_routing_hdr *rh_hdr = (struct uip_routing_hdr *)UIP_IP_PAYLOAD(0);
@@ -205,6 +284,13 @@ insert_srh_header(void)
     return 1;
   }
 
+#if RPL_WITH_SRH_CACHE
+  cached = srh_cache_lookup(dest_node);
+  if(cached != NULL) {
+    return insert_cached_srh_header(cached);
+  }
+#endif /* RPL_WITH_SRH_CACHE */
+
   root_node = uip_sr_get_node(NULL, &curr_instance.dag.dag_id);
   if(root_node == NULL) {
     LOG_ERR("SRH root node not found\n");
@@ -295,6 +381,10 @@ insert_srh_header(void)
   NETSTACK_ROUTING.get_sr_node_ipaddr(&node_addr, node);
   uip_ipaddr_copy(&UIP_IP_BUF->destipaddr, &node_addr);
 
+#if RPL_WITH_SRH_CACHE
+  srh_cache_store(dest_node, node, (uint8_t *)rh_hdr, ext_len);
+#endif /* RPL_WITH_SRH_CACHE */
+
   /* Update the IPv6 length field */
   uipbuf_add_ext_hdr(ext_len);
   uipbuf_set_len_field(UIP_IP_BUF, uip_len - UIP_IPH_LEN);
@@ -64,6 +64,19 @@ static rpl_nbr_t * best_parent(int fresh_only);
 /* Per-neighbor RPL information */
 NBR_TABLE_GLOBAL(rpl_nbr_t, rpl_neighbors);
 
+#if RPL_WITH_PARENT_CACHE
+/* Neighbors accepted by the OF, ordered by increasing path cost */
+static rpl_nbr_t *candidates;
+/* The candidates passed to the OF in a selection, in table order */
+static rpl_nbr_t *selected[NBR_TABLE_MAX_NEIGHBORS];
+/* Instance parameters the cached costs were computed with */
+static rpl_of_t *cache_of;
+static uint16_t cache_min_hoprankinc;
+#if RPL_WITH_MC
+static uint8_t cache_mc_type;
+#endif /* RPL_WITH_MC */
+#endif /* RPL_WITH_PARENT_CACHE */
+
 /*---------------------------------------------------------------------------*/
 static int
 max_acceptable_rank(void)
@@ -190,6 +203,115 @@ rpl_get_ds6_nbr(rpl_nbr_t *nbr)
 }
 #endif /* UIP_ND6_SEND_NS */
 /*---------------------------------------------------------------------------*/
+#if RPL_WITH_PARENT_CACHE
+static void
+candidate_unlink(rpl_nbr_t *nbr)
+{
+  rpl_nbr_t **p;
+
+  if(!nbr->candidate) {
+    return;
+  }
+  for(p = &candidates; *p != NULL; p = &(*p)->next_candidate) {
+    if(*p == nbr) {
+      *p = nbr->next_candidate;
+      break;
+    }
+  }
+  nbr->next_candidate = NULL;
+  nbr->candidate = false;
+}
+/*---------------------------------------------------------------------------*/
+static void
+candidate_update(rpl_nbr_t *nbr)
+{
+  rpl_nbr_t **p;
+
+  candidate_unlink(nbr);
+  nbr->rank_via = rpl_neighbor_rank_via_nbr(nbr);
+  if(!curr_instance.of->nbr_is_acceptable_parent(nbr)) {
+    return;
+  }
+  nbr->path_cost = curr_instance.of->nbr_path_cost(nbr);
+
+  /* Insert after all candidates with the same or lower path cost */
+  for(p = &candidates; *p != NULL && (*p)->path_cost <= nbr->path_cost;
+      p = &(*p)->next_candidate);
+  nbr->next_candidate = *p;
+  *p = nbr;
+  nbr->candidate = true;
+}
+/*---------------------------------------------------------------------------*/
+/* Number the neighbors in table order. The table only appends new entries,
+ * so this is needed only when a neighbor is added. */
+static void
+update_order(void)
+{
+  rpl_nbr_t *nbr;
+  uint16_t order = 1;
+
+  for(nbr = nbr_table_head(rpl_neighbors); nbr != NULL;
+      nbr = nbr_table_next(rpl_neighbors, nbr)) {
+    nbr->order = order++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Were the cached costs computed with the current OF and parameters? */
+static int
+cache_is_current(void)
+{
+  return cache_of == curr_instance.of
+         && cache_min_hoprankinc == curr_instance.min_hoprankinc
+#if RPL_WITH_MC
+         && cache_mc_type == curr_instance.mc.type
+#endif /* RPL_WITH_MC */
+         ;
+}
+/*---------------------------------------------------------------------------*/
+/* Recompute every cached cost if the OF or its parameters changed */
+static void
+check_cache(void)
+{
+  rpl_nbr_t *nbr;
+
+  if(cache_is_current()) {
+    return;
+  }
+
+  cache_of = curr_instance.of;
+  cache_min_hoprankinc = curr_instance.min_hoprankinc;
+#if RPL_WITH_MC
+  cache_mc_type = curr_instance.mc.type;
+#endif /* RPL_WITH_MC */
+
+  candidates = NULL;
+  for(nbr = nbr_table_head(rpl_neighbors); nbr != NULL;
+      nbr = nbr_table_next(rpl_neighbors, nbr)) {
+    nbr->candidate = false;
+    candidate_update(nbr);
+  }
+  update_order();
+}
+#endif /* RPL_WITH_PARENT_CACHE */
+/*---------------------------------------------------------------------------*/
+void
+rpl_neighbor_update(rpl_nbr_t *nbr)
+{
+#if RPL_WITH_PARENT_CACHE
+  if(nbr == NULL || curr_instance.used == 0) {
+    return;
+  }
+  if(!cache_is_current()) {
+    /* Everything is recomputed at the next selection */
+    return;
+  }
+  if(nbr->order == 0) {
+    update_order();
+  }
+  candidate_update(nbr);
+#endif /* RPL_WITH_PARENT_CACHE */
+}
+/*---------------------------------------------------------------------------*/
 static void
 remove_neighbor(rpl_nbr_t *nbr)
 {
@@ -205,6 +327,9 @@ remove_neighbor(rpl_nbr_t *nbr)
   if(nbr == curr_instance.dag.unicast_dio_target) {
     curr_instance.dag.unicast_dio_target = NULL;
   }
+#if RPL_WITH_PARENT_CACHE
+  candidate_unlink(nbr);
+#endif /* RPL_WITH_PARENT_CACHE */
   nbr_table_remove(rpl_neighbors, nbr);
   rpl_timers_schedule_state_update(); /* Updating from here is unsafe; postpone */
 }
@@ -366,16 +491,79 @@ rpl_neighbor_get_from_index(int idx)
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
+/* Filters that do not depend on the OF */
+static int
+is_usable(rpl_nbr_t *nbr, int fresh_only)
+{
+  if(fresh_only && !rpl_neighbor_is_fresh(nbr)) {
+    /* Filter out non-fresh nerighbors if fresh_only is set */
+    return 0;
+  }
+
+#if UIP_ND6_SEND_NS
+  {
+  uip_ds6_nbr_t *ds6_nbr = rpl_get_ds6_nbr(nbr);
+  /* Exclude links to a neighbor that is not reachable at a NUD level */
+  if(ds6_nbr == NULL || ds6_nbr->state != NBR_REACHABLE) {
+    return 0;
+  }
+  }
+#endif /* UIP_ND6_SEND_NS */
+
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+#if RPL_WITH_PARENT_CACHE
+/* Select among the cached candidates. Neighbors costlier than both the
+ * cheapest usable candidate and the preferred parent can not win with OF0 or
+ * MRHOF, so only the others are passed to the OF, in table order, to keep
+ * tie-breaking and hysteresis as in a full scan. */
 static rpl_nbr_t *
-best_parent(int fresh_only)
+best_cached_parent(int fresh_only)
 {
-  rpl_nbr_t *nbr;
+  rpl_nbr_t *preferred = curr_instance.dag.preferred_parent;
   rpl_nbr_t *best = NULL;
+  rpl_nbr_t *nbr;
+  uint16_t threshold = 0;
+  int count = 0;
+  int i, j;
 
-  if(curr_instance.used == 0) {
-    return NULL;
+  check_cache();
+
+  if(preferred != NULL && preferred->candidate
+     && acceptable_rank(preferred->rank_via)
+     && is_usable(preferred, fresh_only)) {
+    threshold = preferred->path_cost;
+  }
+
+  for(nbr = candidates; nbr != NULL; nbr = nbr->next_candidate) {
+    if(count > 0 && nbr->path_cost > threshold) {
+      break;
+    }
+    if(!acceptable_rank(nbr->rank_via) || !is_usable(nbr, fresh_only)) {
+      continue;
+    }
+    threshold = MAX(threshold, nbr->path_cost);
+    /* Insertion sort by table order */
+    for(i = count++; i > 0 && selected[i - 1]->order > nbr->order; i--) {
+      selected[i] = selected[i - 1];
+    }
+    selected[i] = nbr;
   }
 
+  for(j = 0; j < count; j++) {
+    best = curr_instance.of->best_parent(best, selected[j]);
+  }
+  return best;
+}
+#else /* RPL_WITH_PARENT_CACHE */
+/*---------------------------------------------------------------------------*/
+static rpl_nbr_t *
+best_scanned_parent(int fresh_only)
+{
+  rpl_nbr_t *nbr;
+  rpl_nbr_t *best = NULL;
+
   /* Search for the best parent according to the OF */
   for(nbr = nbr_table_head(rpl_neighbors); nbr != NULL; nbr = nbr_table_next(rpl_neighbors, nbr)) {
 
@@ -385,20 +573,9 @@ best_parent(int fresh_only)
       continue;
     }
 
-    if(fresh_only && !rpl_neighbor_is_fresh(nbr)) {
-      /* Filter out non-fresh nerighbors if fresh_only is set */
-      continue;
-    }
-
-#if UIP_ND6_SEND_NS
-    {
-    uip_ds6_nbr_t *ds6_nbr = rpl_get_ds6_nbr(nbr);
-    /* Exclude links to a neighbor that is not reachable at a NUD level */
-    if(ds6_nbr == NULL || ds6_nbr->state != NBR_REACHABLE) {
+    if(!is_usable(nbr, fresh_only)) {
       continue;
     }
-    }
-#endif /* UIP_ND6_SEND_NS */
 
     /* Now we have an acceptable parent, check if it is the new best */
     best = curr_instance.of->best_parent(best, nbr);
@@ -406,6 +583,21 @@ best_parent(int fresh_only)
 
   return best;
 }
+#endif /* RPL_WITH_PARENT_CACHE */
+/*---------------------------------------------------------------------------*/
+static rpl_nbr_t *
+best_parent(int fresh_only)
+{
+  if(curr_instance.used == 0) {
+    return NULL;
+  }
+
+#if RPL_WITH_PARENT_CACHE
+  return best_cached_parent(fresh_only);
+#else /* RPL_WITH_PARENT_CACHE */
+  return best_scanned_parent(fresh_only);
+#endif /* RPL_WITH_PARENT_CACHE */
+}
 /*---------------------------------------------------------------------------*/
 rpl_nbr_t *
 rpl_neighbor_select_best(void)
@@ -71,6 +71,14 @@ NBR_TABLE_DECLARE(rpl_neighbors);
 */
 void rpl_neighbor_init(void);
 
+/**
+ * Updates the cached parent ranking after the rank or link metric of a
+ * neighbor has changed. Does nothing unless RPL_WITH_PARENT_CACHE is set.
+ *
+ * \param nbr The neighbor
+*/
+void rpl_neighbor_update(rpl_nbr_t *nbr);
+
 /**
  * Tells whether a neighbor is in the parent set.
  *
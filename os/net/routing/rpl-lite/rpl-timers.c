@@ -514,6 +514,7 @@ handle_periodic_timer(void *ptr)
   if(curr_instance.used) {
     rpl_dag_periodic(PERIODIC_DELAY_SECONDS);
     uip_sr_periodic(PERIODIC_DELAY_SECONDS);
+    rpl_dag_root_periodic(PERIODIC_DELAY_SECONDS);
   }
 
   if(!curr_instance.used ||
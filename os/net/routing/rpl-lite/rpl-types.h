@@ -145,6 +145,13 @@ struct rpl_nbr {
 #if RPL_WITH_MULTIPATH
   bool cn;
 #endif /* RPL_WITH_MULTIPATH */
+#if RPL_WITH_PARENT_CACHE
+  struct rpl_nbr *next_candidate; /* Next candidate by increasing path cost */
+  uint16_t path_cost; /* Cached OF path cost */
+  rpl_rank_t rank_via; /* Cached rank via this neighbor */
+  uint16_t order; /* Position in the neighbor table, from 1; 0 if new */
+  bool candidate; /* Accepted by the OF, in the candidate list */
+#endif /* RPL_WITH_PARENT_CACHE */
 };
 typedef struct rpl_nbr rpl_nbr_t;
 
@@ -479,6 +479,29 @@ PT_THREAD(cmd_macaddr(struct pt *pt, shell_output_func output, char *args))
 
   PT_END(pt);
 }
+#if PROCESS_CONF_STATS
+/*---------------------------------------------------------------------------*/
+static
+PT_THREAD(cmd_process_stats(struct pt *pt, shell_output_func output, char *args))
+{
+  int i;
+
+  PT_BEGIN(pt);
+
+  /* process_nevents() also counts a pending poll request */
+  SHELL_OUTPUT(output, "Event queues: %d events and polls waiting, max %u events\n",
+               process_nevents(), process_maxevents);
+  for(i = 0; i < PROCESS_NUM_PRIORITIES; i++) {
+    SHELL_OUTPUT(output, "-- %s priority: max %u/%u, dropped %lu\n",
+                 i == PROCESS_PRIORITY_HIGH ? "High" : "Normal",
+                 process_queue_stats[i].max_events,
+                 i == PROCESS_PRIORITY_HIGH ? PROCESS_CONF_NUMEVENTS_HIGH : PROCESS_CONF_NUMEVENTS,
+                 process_queue_stats[i].dropped);
+  }
+
+  PT_END(pt);
+}
+#endif /* PROCESS_CONF_STATS */
 #if NETSTACK_CONF_WITH_IPV6
 /*---------------------------------------------------------------------------*/
 static
@@ -981,6 +1004,9 @@ const struct shell_command_t builtin_shell_commands[] = {
   { "reboot",               cmd_reboot,               "'> reboot': Reboot the board by watchdog_reboot()" },
   { "log",                  cmd_log,                  "'> log module level': Sets log level (0--4) for a given module (or \"all\"). For module \"mac\", level 4 also enables per-slot logging." },
   { "mac-addr",             cmd_macaddr,               "'> mac-addr': Shows the node's MAC address" },
+#if PROCESS_CONF_STATS
+  { "process-stats",        cmd_process_stats,        "'> process-stats': Shows the event queue statistics" },
+#endif /* PROCESS_CONF_STATS */
 #if NETSTACK_CONF_WITH_IPV6
   { "ip-addr",              cmd_ipaddr,               "'> ip-addr': Shows all IPv6 addresses" },
   { "ip-nbr",               cmd_ip_neighbors,         "'> ip-nbr': Shows all IPv6 neighbors" },
@@ -92,6 +92,9 @@ ctimer_init(void)
 {
   initialized = 0;
   list_init(ctimer_list);
+  /* Most callback timers belong to the network stack, so their
+     expiration events are delivered before application events. */
+  process_set_priority(&ctimer_process, PROCESS_PRIORITY_HIGH);
   process_start(&ctimer_process, NULL);
 }
 /*---------------------------------------------------------------------------*/
@@ -49,95 +49,266 @@
 #include "sys/etimer.h"
 #include "sys/process.h"
 
+#include <stdbool.h>
+
 static struct etimer *timerlist;
-static clock_time_t next_expiration;
 
 PROCESS(etimer_process, "Event timer");
 /*---------------------------------------------------------------------------*/
+/* Check if timer a expires before timer b. Expired timers come
+   first, the most overdue one first. The comparison is made relative
+   to the current time, so it is not affected by wraps of the clock,
+   and the order between two timers stays the same as time passes. */
+static bool
+expires_before(struct etimer *a, struct etimer *b, clock_time_t now)
+{
+  clock_time_t elapsed_a = now - a->timer.start;
+  clock_time_t elapsed_b = now - b->timer.start;
+
+  if(elapsed_a >= a->timer.interval) {
+    return elapsed_b < b->timer.interval ||
+      elapsed_a - a->timer.interval > elapsed_b - b->timer.interval;
+  }
+  return elapsed_b < b->timer.interval &&
+    a->timer.interval - elapsed_a < b->timer.interval - elapsed_b;
+}
+/*---------------------------------------------------------------------------*/
+#if ETIMER_HEAP
+/*
+ * The pending timers are kept in a pairing heap ordered by expiration
+ * time. The root of the heap is timerlist. The next
+ * pointer links siblings, child points to the leftmost child, and
+ * prev points to the previous sibling or, for a leftmost child, to
+ * the parent.
+ */
+static struct etimer *
+meld(struct etimer *a, struct etimer *b, clock_time_t now)
+{
+  struct etimer *t;
+
+  if(a == NULL) {
+    return b;
+  }
+  if(b == NULL) {
+    return a;
+  }
+  if(expires_before(b, a, now)) {
+    t = a;
+    a = b;
+    b = t;
+  }
+  /* Make b the leftmost child of a. */
+  b->prev = a;
+  b->next = a->child;
+  if(a->child != NULL) {
+    a->child->prev = b;
+  }
+  a->child = b;
+  return a;
+}
+/*---------------------------------------------------------------------------*/
+/* Combine a list of sibling subtrees into a single heap, using the
+   standard two-pass pairing. */
+static struct etimer *
+merge_pairs(struct etimer *first, clock_time_t now)
+{
+  struct etimer *a, *b, *pairs, *heap;
+
+  /* First pass: meld the siblings pairwise from left to right, and
+     push the results onto a stack linked through the next pointer. */
+  pairs = NULL;
+  while(first != NULL) {
+    a = first;
+    b = a->next;
+    first = b != NULL ? b->next : NULL;
+    a->next = a->prev = NULL;
+    if(b != NULL) {
+      b->next = b->prev = NULL;
+    }
+    a = meld(a, b, now);
+    a->next = pairs;
+    pairs = a;
+  }
+
+  /* Second pass: meld the pairs from right to left. */
+  heap = NULL;
+  while(pairs != NULL) {
+    a = pairs;
+    pairs = a->next;
+    a->next = NULL;
+    heap = meld(heap, a, now);
+  }
+  return heap;
+}
+/*---------------------------------------------------------------------------*/
+static void
+timer_insert(struct etimer *timer)
+{
+  timer->next = timer->prev = timer->child = NULL;
+  timerlist = meld(timerlist, timer, clock_time());
+}
+/*---------------------------------------------------------------------------*/
+static void
+timer_remove(struct etimer *timer)
+{
+  clock_time_t now = clock_time();
+  struct etimer *sub;
+
+  if(timer != timerlist) {
+    /* Unlink the subtree rooted at the timer from its parent. */
+    if(timer->prev->child == timer) {
+      timer->prev->child = timer->next;
+    } else {
+      timer->prev->next = timer->next;
+    }
+    if(timer->next != NULL) {
+      timer->next->prev = timer->prev;
+    }
+    sub = merge_pairs(timer->child, now);
+    timerlist = meld(timerlist, sub, now);
+  } else {
+    timerlist = merge_pairs(timer->child, now);
+  }
+  timer->next = timer->prev = timer->child = NULL;
+}
+/*---------------------------------------------------------------------------*/
+static struct etimer *
+timer_parent(struct etimer *t)
+{
+  while(t->prev != NULL && t->prev->child != t) {
+    t = t->prev;
+  }
+  return t->prev;
+}
+/*---------------------------------------------------------------------------*/
+static void
+timer_remove_process(struct process *p)
+{
+  struct etimer *t;
+
+  /* Walk the heap in pre-order and start over from the root after
+     each removal, as removing a timer restructures the heap. */
+  t = timerlist;
+  while(t != NULL) {
+    if(t->p == p) {
+      timer_remove(t);
+      t->p = PROCESS_NONE;
+      t = timerlist;
+    } else if(t->child != NULL) {
+      t = t->child;
+    } else {
+      while(t != NULL && t->next == NULL) {
+        t = timer_parent(t);
+      }
+      if(t != NULL) {
+        t = t->next;
+      }
+    }
+  }
+}
+#else /* ETIMER_HEAP */
+/*
+ * The pending timers are kept in a list sorted by expiration time,
+ * with the next timer to expire first. Timers with the
+ * same expiration time are kept in the order they were added.
+ */
+static void
+timer_insert(struct etimer *timer)
+{
+  clock_time_t now = clock_time();
+  struct etimer *t;
+
+  if(timerlist == NULL || expires_before(timer, timerlist, now)) {
+    timer->next = timerlist;
+    timerlist = timer;
+    return;
+  }
+
+  for(t = timerlist;
+      t->next != NULL && !expires_before(timer, t->next, now);
+      t = t->next);
+  timer->next = t->next;
+  t->next = timer;
+}
+/*---------------------------------------------------------------------------*/
 static void
-update_time(void)
+timer_remove(struct etimer *timer)
 {
-  clock_time_t tdist;
-  clock_time_t now;
   struct etimer *t;
 
-  if (timerlist == NULL) {
-    next_expiration = 0;
+  /* First check if timer is the first event timer on the list. */
+  if(timer == timerlist) {
+    timerlist = timerlist->next;
   } else {
-    now = clock_time();
+    /* Else walk through the list and try to find the item before the
+       timer. */
+    for(t = timerlist; t != NULL && t->next != timer; t = t->next);
+
+    if(t != NULL) {
+      t->next = timer->next;
+    }
+  }
+  timer->next = NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+timer_remove_process(struct process *p)
+{
+  struct etimer *t;
+
+  while(timerlist != NULL && timerlist->p == p) {
+    timerlist->p = PROCESS_NONE;
+    timerlist = timerlist->next;
+  }
+
+  if(timerlist != NULL) {
     t = timerlist;
-    /* Must calculate distance to next time into account due to wraps */
-    tdist = t->timer.start + t->timer.interval - now;
-    for(t = t->next; t != NULL; t = t->next) {
-      if(t->timer.start + t->timer.interval - now < tdist) {
-	tdist = t->timer.start + t->timer.interval - now;
+    while(t->next != NULL) {
+      if(t->next->p == p) {
+        t->next->p = PROCESS_NONE;
+        t->next = t->next->next;
+      } else {
+        t = t->next;
       }
     }
-    next_expiration = now + tdist;
   }
 }
+#endif /* ETIMER_HEAP */
 /*---------------------------------------------------------------------------*/
 PROCESS_THREAD(etimer_process, ev, data)
 {
-  struct etimer *t, *u;
-	
+  struct etimer *t;
+
   PROCESS_BEGIN();
 
   timerlist = NULL;
-  
+
   while(1) {
     PROCESS_YIELD();
 
     if(ev == PROCESS_EVENT_EXITED) {
-      struct process *p = data;
-
-      while(timerlist != NULL && timerlist->p == p) {
-	timerlist = timerlist->next;
-      }
-
-      if(timerlist != NULL) {
-	t = timerlist;
-	while(t->next != NULL) {
-	  if(t->next->p == p) {
-	    t->next = t->next->next;
-	  } else
-	    t = t->next;
-	}
-      }
+      timer_remove_process(data);
       continue;
     } else if(ev != PROCESS_EVENT_POLL) {
       continue;
     }
 
-  again:
-    
-    u = NULL;
-    
-    for(t = timerlist; t != NULL; t = t->next) {
-      if(timer_expired(&t->timer)) {
-	if(process_post(t->p, PROCESS_EVENT_TIMER, t) == PROCESS_ERR_OK) {
-	  
-	  /* Reset the process ID of the event timer, to signal that the
-	     etimer has expired. This is later checked in the
-	     etimer_expired() function. */
-	  t->p = PROCESS_NONE;
-	  if(u != NULL) {
-	    u->next = t->next;
-	  } else {
-	    timerlist = t->next;
-	  }
-	  t->next = NULL;
-	  update_time();
-	  goto again;
-	} else {
-	  etimer_request_poll();
-	}
+    /* The timer that expires first is always at the head, so we are
+       done as soon as the head has not expired. */
+    while((t = timerlist) != NULL && timer_expired(&t->timer)) {
+      if(process_post(t->p, PROCESS_EVENT_TIMER, t) != PROCESS_ERR_OK) {
+        /* The event queue is full. Try again later. */
+        etimer_request_poll();
+        break;
       }
-      u = t;
+      timer_remove(t);
+      /* Reset the process ID of the event timer, to signal that the
+         etimer has expired. This is later checked in the
+         etimer_expired() function. */
+      t->p = PROCESS_NONE;
     }
-    
   }
-  
+
   PROCESS_END();
 }
 /*---------------------------------------------------------------------------*/
@@ -150,27 +321,16 @@ etimer_request_poll(void)
 static void
 add_timer(struct etimer *timer)
 {
-  struct etimer *t;
-
   etimer_request_poll();
 
   if(timer->p != PROCESS_NONE) {
-    for(t = timerlist; t != NULL; t = t->next) {
-      if(t == timer) {
-	/* Timer already on list, bail out. */
-        timer->p = PROCESS_CURRENT();
-	update_time();
-	return;
-      }
-    }
+    /* Timer possibly already on list. Remove it, since its position
+       depends on the new expiration time. */
+    timer_remove(timer);
   }
 
-  /* Timer not on list. */
   timer->p = PROCESS_CURRENT();
-  timer->next = timerlist;
-  timerlist = timer;
-
-  update_time();
+  timer_insert(timer);
 }
 /*---------------------------------------------------------------------------*/
 void
@@ -205,8 +365,13 @@ etimer_restart(struct etimer *et)
 void
 etimer_adjust(struct etimer *et, int timediff)
 {
-  et->timer.start += timediff;
-  update_time();
+  if(et->p != PROCESS_NONE) {
+    timer_remove(et);
+    et->timer.start += timediff;
+    timer_insert(et);
+  } else {
+    et->timer.start += timediff;
+  }
 }
 /*---------------------------------------------------------------------------*/
 int
@@ -236,31 +401,14 @@ etimer_pending(void)
 clock_time_t
 etimer_next_expiration_time(void)
 {
-  return etimer_pending() ? next_expiration : 0;
+  return etimer_pending() ? etimer_expiration_time(timerlist) : 0;
 }
 /*---------------------------------------------------------------------------*/
 void
 etimer_stop(struct etimer *et)
 {
-  struct etimer *t;
-
-  /* First check if et is the first event timer on the list. */
-  if(et == timerlist) {
-    timerlist = timerlist->next;
-    update_time();
-  } else {
-    /* Else walk through the list and try to find the item before the
-       et timer. */
-    for(t = timerlist; t != NULL && t->next != et; t = t->next);
-
-    if(t != NULL) {
-      /* We've found the item before the event timer that we are about
-	 to remove. We point the items next pointer to the event after
-	 the removed item. */
-      t->next = et->next;
-
-      update_time();
-    }
+  if(et->p != PROCESS_NONE) {
+    timer_remove(et);
   }
 
   /* Remove the next pointer from the item to be removed. */
@@ -57,6 +57,18 @@
  * \sa \ref clock "Clock library" (used by the timer library)
  *
  * It is \e not safe to manipulate event timers within an interrupt context.
+ *
+ * Pending event timers are kept ordered by expiration time, so that
+ * finding the next timer to expire takes constant time. By default
+ * they are kept in a sorted list. Setting ETIMER_CONF_HEAP to 1
+ * keeps them in a pairing heap instead, which makes setting and
+ * stopping a timer take logarithmic amortized time, at the cost of two
+ * more pointers per event timer. This is useful for systems with a
+ * large number of simultaneously running timers.
+ *
+ * \note With ETIMER_CONF_HEAP, an event timer must not be set or
+ * stopped before it has been zero-initialized, as is the case for
+ * statically allocated timers.
  * @{
  */
 
@@ -65,6 +77,12 @@
 
 #include "contiki.h"
 
+#ifdef ETIMER_CONF_HEAP
+#define ETIMER_HEAP ETIMER_CONF_HEAP
+#else /* ETIMER_CONF_HEAP */
+#define ETIMER_HEAP 0
+#endif /* ETIMER_CONF_HEAP */
+
 /**
  * A timer.
  *
@@ -76,6 +94,10 @@
 struct etimer {
   struct timer timer;
   struct etimer *next;
+#if ETIMER_HEAP
+  struct etimer *prev;
+  struct etimer *child;
+#endif /* ETIMER_HEAP */
   struct process *p;
 };
 
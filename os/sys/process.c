@@ -44,6 +44,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "contiki.h"
 #include "sys/process.h"
@@ -65,11 +66,33 @@ struct event_data {
   struct process *p;
 };
 
-static process_num_events_t nevents, fevent;
+/*
+ * A ring buffer of events of one priority.
+ */
+struct event_queue {
+  struct event_data *events;
+  process_num_events_t size;
+  process_num_events_t nevents, fevent;
+};
+
 static struct event_data events[PROCESS_CONF_NUMEVENTS];
+#if PROCESS_EVENT_PRIORITIES
+static struct event_data events_high[PROCESS_CONF_NUMEVENTS_HIGH];
+#endif /* PROCESS_EVENT_PRIORITIES */
+
+static struct event_queue queues[PROCESS_NUM_PRIORITIES] = {
+  { events, PROCESS_CONF_NUMEVENTS, 0, 0 },
+#if PROCESS_EVENT_PRIORITIES
+  { events_high, PROCESS_CONF_NUMEVENTS_HIGH, 0, 0 },
+#endif /* PROCESS_EVENT_PRIORITIES */
+};
+
+/* The total number of events in all queues. */
+static process_num_events_t nevents;
 
 #if PROCESS_CONF_STATS
 process_num_events_t process_maxevents;
+struct process_queue_stats process_queue_stats[PROCESS_NUM_PRIORITIES];
 #endif
 
 static volatile unsigned char poll_requested;
@@ -78,6 +101,14 @@ static volatile unsigned char poll_requested;
 #define PROCESS_STATE_RUNNING     1
 #define PROCESS_STATE_CALLED      2
 
+/* Lets a platform wake up its main loop when a process is polled, e.g.
+   from a signal handler while the loop is sleeping */
+#ifdef PROCESS_CONF_POLL_HOOK
+#define PROCESS_POLL_HOOK() PROCESS_CONF_POLL_HOOK()
+#else /* PROCESS_CONF_POLL_HOOK */
+#define PROCESS_POLL_HOOK()
+#endif /* PROCESS_CONF_POLL_HOOK */
+
 static void call_process(struct process *p, process_event_t ev, process_data_t data);
 
 #define DEBUG 0
@@ -207,11 +238,17 @@ process_exit(struct process *p)
 void
 process_init(void)
 {
+  int i;
+
   lastevent = PROCESS_EVENT_MAX;
 
-  nevents = fevent = 0;
+  nevents = 0;
+  for(i = 0; i < PROCESS_NUM_PRIORITIES; i++) {
+    queues[i].nevents = queues[i].fevent = 0;
+  }
 #if PROCESS_CONF_STATS
   process_maxevents = 0;
+  memset(process_queue_stats, 0, sizeof(process_queue_stats));
 #endif /* PROCESS_CONF_STATS */
 
   process_current = process_list = NULL;
@@ -249,6 +286,7 @@ do_event(void)
   process_data_t data;
   struct process *receiver;
   struct process *p;
+  struct event_queue *q;
 
   /*
    * If there are any events in the queue, take the first one and walk
@@ -260,15 +298,20 @@ do_event(void)
 
   if(nevents > 0) {
 
+    /* Take the event from the queue with the highest priority that
+       has events waiting. */
+    for(q = &queues[PROCESS_NUM_PRIORITIES - 1]; q->nevents == 0; q--);
+
     /* There are events that we should deliver. */
-    ev = events[fevent].ev;
+    ev = q->events[q->fevent].ev;
 
-    data = events[fevent].data;
-    receiver = events[fevent].p;
+    data = q->events[q->fevent].data;
+    receiver = q->events[q->fevent].p;
 
     /* Since we have seen the new event, we move pointer upwards
        and decrease the number of events. */
-    fevent = (fevent + 1) % PROCESS_CONF_NUMEVENTS;
+    q->fevent = (q->fevent + 1) % q->size;
+    --q->nevents;
     --nevents;
 
     /* If this is a broadcast event, we deliver it to all events, in
@@ -301,13 +344,21 @@ do_event(void)
 int
 process_run(void)
 {
-  /* Process poll events. */
-  if(poll_requested) {
-    do_poll();
-  }
+  int i;
+
+  for(i = 0; i < PROCESS_EVENT_BATCH; i++) {
+    /* Process poll events. */
+    if(poll_requested) {
+      do_poll();
+    }
 
-  /* Process one event from the queue */
-  do_event();
+    /* Process one event from the queue */
+    do_event();
+
+    if(nevents == 0) {
+      break;
+    }
+  }
 
   return nevents + poll_requested;
 }
@@ -322,6 +373,7 @@ int
 process_post(struct process *p, process_event_t ev, process_data_t data)
 {
   process_num_events_t snum;
+  struct event_queue *q;
 
   if(PROCESS_CURRENT() == NULL) {
     PRINTF("process_post: NULL process posts event %d to process '%s', nevents %d\n",
@@ -332,7 +384,13 @@ process_post(struct process *p, process_event_t ev, process_data_t data)
 	   p == PROCESS_BROADCAST? "<broadcast>": PROCESS_NAME_STRING(p), nevents);
   }
 
-  if(nevents == PROCESS_CONF_NUMEVENTS) {
+#if PROCESS_EVENT_PRIORITIES
+  q = &queues[p == PROCESS_BROADCAST ? PROCESS_PRIORITY_NORMAL : p->priority];
+#else /* PROCESS_EVENT_PRIORITIES */
+  q = &queues[PROCESS_PRIORITY_NORMAL];
+#endif /* PROCESS_EVENT_PRIORITIES */
+
+  if(q->nevents == q->size) {
 #if DEBUG
     if(p == PROCESS_BROADCAST) {
       printf("soft panic: event queue is full when broadcast event %d was posted from %s\n", ev, PROCESS_NAME_STRING(process_current));
@@ -340,19 +398,26 @@ process_post(struct process *p, process_event_t ev, process_data_t data)
       printf("soft panic: event queue is full when event %d was posted to %s from %s\n", ev, PROCESS_NAME_STRING(p), PROCESS_NAME_STRING(process_current));
     }
 #endif /* DEBUG */
+#if PROCESS_CONF_STATS
+    process_queue_stats[q - queues].dropped++;
+#endif /* PROCESS_CONF_STATS */
     return PROCESS_ERR_FULL;
   }
 
-  snum = (process_num_events_t)(fevent + nevents) % PROCESS_CONF_NUMEVENTS;
-  events[snum].ev = ev;
-  events[snum].data = data;
-  events[snum].p = p;
+  snum = (process_num_events_t)(q->fevent + q->nevents) % q->size;
+  q->events[snum].ev = ev;
+  q->events[snum].data = data;
+  q->events[snum].p = p;
+  ++q->nevents;
   ++nevents;
 
 #if PROCESS_CONF_STATS
   if(nevents > process_maxevents) {
     process_maxevents = nevents;
   }
+  if(q->nevents > process_queue_stats[q - queues].max_events) {
+    process_queue_stats[q - queues].max_events = q->nevents;
+  }
 #endif /* PROCESS_CONF_STATS */
 
   return PROCESS_ERR_OK;
@@ -375,6 +440,7 @@ process_poll(struct process *p)
        p->state == PROCESS_STATE_CALLED) {
       p->needspoll = 1;
       poll_requested = 1;
+      PROCESS_POLL_HOOK();
     }
   }
 }
@@ -88,6 +88,49 @@ typedef unsigned char process_num_events_t;
 #define PROCESS_CONF_NUMEVENTS 32
 #endif /* PROCESS_CONF_NUMEVENTS */
 
+/**
+ * \name Event priorities
+ *
+ * When PROCESS_CONF_EVENT_PRIORITIES is set, asynchronous events are
+ * queued in one of two event queues depending on the priority of the
+ * receiving process, set with process_set_priority(). Events in the
+ * high priority queue, typically those of the network stack, are
+ * always delivered before events in the normal priority queue, and a
+ * burst of application events cannot make them overflow. Broadcast
+ * events are always of normal priority.
+ * @{
+ */
+#ifdef PROCESS_CONF_EVENT_PRIORITIES
+#define PROCESS_EVENT_PRIORITIES PROCESS_CONF_EVENT_PRIORITIES
+#else /* PROCESS_CONF_EVENT_PRIORITIES */
+#define PROCESS_EVENT_PRIORITIES 0
+#endif /* PROCESS_CONF_EVENT_PRIORITIES */
+
+/** Size of the high priority event queue */
+#ifndef PROCESS_CONF_NUMEVENTS_HIGH
+#define PROCESS_CONF_NUMEVENTS_HIGH 16
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH */
+
+#define PROCESS_PRIORITY_NORMAL 0
+#define PROCESS_PRIORITY_HIGH   1
+
+#if PROCESS_EVENT_PRIORITIES
+#define PROCESS_NUM_PRIORITIES  2
+#else /* PROCESS_EVENT_PRIORITIES */
+#define PROCESS_NUM_PRIORITIES  1
+#endif /* PROCESS_EVENT_PRIORITIES */
+/** @} */
+
+/**
+ * The maximum number of events that process_run() delivers before it
+ * returns. The poll handlers are still called between each event.
+ */
+#ifdef PROCESS_CONF_EVENT_BATCH
+#define PROCESS_EVENT_BATCH PROCESS_CONF_EVENT_BATCH
+#else /* PROCESS_CONF_EVENT_BATCH */
+#define PROCESS_EVENT_BATCH 1
+#endif /* PROCESS_CONF_EVENT_BATCH */
+
 #define PROCESS_EVENT_NONE            0x80
 #define PROCESS_EVENT_INIT            0x81
 #define PROCESS_EVENT_POLL            0x82
@@ -323,8 +366,29 @@ struct process {
   PT_THREAD((* thread)(struct pt *, process_event_t, process_data_t));
   struct pt pt;
   unsigned char state, needspoll;
+#if PROCESS_EVENT_PRIORITIES
+  unsigned char priority;
+#endif /* PROCESS_EVENT_PRIORITIES */
 };
 
+#if PROCESS_CONF_STATS
+/**
+ * Statistics of an event queue.
+ */
+struct process_queue_stats {
+  /** The highest number of events that were waiting in the queue */
+  process_num_events_t max_events;
+  /** The number of events that could not be posted as the queue was full */
+  unsigned long dropped;
+};
+
+/** Statistics of the event queues, indexed by event priority */
+extern struct process_queue_stats process_queue_stats[PROCESS_NUM_PRIORITIES];
+
+/** The highest number of events that were waiting in all queues */
+extern process_num_events_t process_maxevents;
+#endif /* PROCESS_CONF_STATS */
+
 /**
  * \name Functions called from application programs
  * @{
@@ -389,6 +453,21 @@ void process_post_synch(struct process *p,
  */
 void process_exit(struct process *p);
 
+/**
+ * \brief      Set the priority of the events posted to a process
+ * \param p    The process
+ * \param prio PROCESS_PRIORITY_NORMAL or PROCESS_PRIORITY_HIGH
+ *
+ *             All asynchronous events that are posted to the process
+ *             after this call are queued with the given
+ *             priority. This has no effect unless
+ *             PROCESS_CONF_EVENT_PRIORITIES is set.
+ */
+#if PROCESS_EVENT_PRIORITIES
+#define process_set_priority(p, prio) ((p)->priority = (prio))
+#else /* PROCESS_EVENT_PRIORITIES */
+#define process_set_priority(p, prio)
+#endif /* PROCESS_EVENT_PRIORITIES */
 
 /**
  * Get a pointer to the currently running process.
@@ -485,11 +564,12 @@ void process_poll(struct process *p);
 void process_init(void);
 
 /**
- * Run the system once - call poll handlers and process one event.
+ * Run the system once - call poll handlers and process events.
  *
  * This function should be called repeatedly from the main() program
  * to actually run the Contiki system. It calls the necessary poll
- * handlers, and processes one event. The function returns the number
+ * handlers, and processes up to PROCESS_EVENT_BATCH events, high
+ * priority events first. The function returns the number
  * of events that are waiting in the event queue so that the caller
  * may choose to put the CPU to sleep when there are no pending
  * events.
@@ -515,7 +595,7 @@ int process_is_running(struct process *p);
  *  Number of events waiting to be processed.
  *
  * \return The number of events that are currently waiting to be
- * processed.
+ * processed, plus one if a process has requested to be polled.
  */
 int process_nevents(void);
 
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Micro-benchmark of memb_alloc()/memb_free() with pools of different
+ * sizes. Every pool is first filled up to a given occupancy, after
+ * which a block picked at random is repeatedly freed and allocated
+ * again. The allocation state is checked against a shadow copy on
+ * every iteration, so the benchmark doubles as a randomized test.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+
+#include <lib/memb.h>
+
+#define ITERATIONS 1000000
+
+typedef struct test_struct {
+  uint16_t id;
+  uint8_t data[30];
+} test_struct_t;
+
+MEMB(pool_8, test_struct_t, 8);
+MEMB(pool_64, test_struct_t, 64);
+MEMB(pool_256, test_struct_t, 256);
+MEMB(pool_1000, test_struct_t, 1000);
+
+static test_struct_t *blocks[1000];
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+static int
+run(struct memb *m)
+{
+  int i;
+  int n;
+  int filled;
+  uint64_t start;
+  uint64_t elapsed;
+
+  memb_init(m);
+  memset(blocks, 0, sizeof(blocks));
+
+  /* Fill the pool up to 90% to model a busy system, where most of
+     the blocks are in use. */
+  filled = m->num * 9 / 10;
+  for(i = 0; i < filled; i++) {
+    blocks[i] = memb_alloc(m);
+    if(blocks[i] == NULL) {
+      printf("test failed: pool of %u exhausted after %d blocks\n", m->num, i);
+      return -1;
+    }
+  }
+
+  start = now_ns();
+  for(n = 0; n < ITERATIONS; n++) {
+    i = rand() % m->num;
+    if(blocks[i] != NULL) {
+      if(memb_free(m, blocks[i]) != 0) {
+        printf("test failed: cannot free %p\n", blocks[i]);
+        return -1;
+      }
+      blocks[i] = NULL;
+      filled--;
+    } else {
+      blocks[i] = memb_alloc(m);
+      if(blocks[i] == NULL) {
+        printf("test failed: memb_alloc() returns NULL with %d/%u used\n",
+               filled, m->num);
+        return -1;
+      }
+      filled++;
+    }
+    if(memb_numfree(m) != m->num - filled) {
+      printf("test failed: memb_numfree() returns %d, which should be %d\n",
+             memb_numfree(m), m->num - filled);
+      return -1;
+    }
+  }
+  elapsed = now_ns() - start;
+
+  printf("- pool of %4u blocks: %6.1f ns per alloc/free\n",
+         m->num, (double)elapsed / ITERATIONS);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+  srand(1);
+
+  if(run(&pool_8) || run(&pool_64) || run(&pool_256) || run(&pool_1000)) {
+    return -1;
+  }
+  return 0;
+}
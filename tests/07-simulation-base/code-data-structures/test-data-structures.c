@@ -36,6 +36,7 @@
 #include "lib/circular-list.h"
 #include "lib/dbl-list.h"
 #include "lib/dbl-circ-list.h"
+#include "lib/hash-index.h"
 #include "lib/random.h"
 #include "services/unit-test/unit-test.h"
 
@@ -1024,6 +1025,85 @@ UNIT_TEST(test_cdll)
   UNIT_TEST_END();
 }
 /*---------------------------------------------------------------------------*/
+/* Keys of the hash index test. Their hash is the key divided by four,
+   so that keys collide in groups of four. */
+static uint32_t hash_keys[ELEMENT_COUNT];
+
+static uint32_t
+hash_key(uint32_t key)
+{
+  return key / 4;
+}
+static uint32_t
+hash_entry(uint16_t pos)
+{
+  return hash_key(hash_keys[pos]);
+}
+static int
+hash_match(uint16_t pos, const void *key)
+{
+  return hash_keys[pos] == *(const uint32_t *)key;
+}
+static int
+hash_find(struct hash_index *hi, uint32_t key)
+{
+  return hash_index_lookup(hi, hash_key(key), hash_match, &key);
+}
+HASH_INDEX(hash_index, ELEMENT_COUNT, hash_entry);
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_hash_index, "Hash index");
+UNIT_TEST(test_hash_index)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(HASH_INDEX_SLOTS(1) == 4);
+  UNIT_TEST_ASSERT(HASH_INDEX_SLOTS(8) == 16);
+  UNIT_TEST_ASSERT(HASH_INDEX_SLOTS(ELEMENT_COUNT) == 32);
+  UNIT_TEST_ASSERT(HASH_INDEX_SLOTS(600) == 2048);
+
+  hash_index_clear(&hash_index);
+  for(i = 0; i < ELEMENT_COUNT; i++) {
+    hash_keys[i] = 100 + i;
+    UNIT_TEST_ASSERT(hash_find(&hash_index, hash_keys[i]) == -1);
+    hash_index_add(&hash_index, hash_entry(i), i);
+  }
+  for(i = 0; i < ELEMENT_COUNT; i++) {
+    UNIT_TEST_ASSERT(hash_find(&hash_index, 100 + i) == i);
+  }
+  UNIT_TEST_ASSERT(hash_find(&hash_index, 100 + ELEMENT_COUNT) == -1);
+
+  /* Remove entries at the start and in the middle of a probe sequence:
+     the entries after them must still be found */
+  hash_index_remove(&hash_index, hash_entry(0), 0);
+  hash_index_remove(&hash_index, hash_entry(5), 5);
+  UNIT_TEST_ASSERT(hash_find(&hash_index, 100) == -1);
+  UNIT_TEST_ASSERT(hash_find(&hash_index, 105) == -1);
+  for(i = 0; i < ELEMENT_COUNT; i++) {
+    if(i != 0 && i != 5) {
+      UNIT_TEST_ASSERT(hash_find(&hash_index, 100 + i) == i);
+    }
+  }
+
+  /* Removing an entry twice does nothing */
+  hash_index_remove(&hash_index, hash_entry(5), 5);
+  UNIT_TEST_ASSERT(hash_find(&hash_index, 106) == 6);
+
+  /* Reuse a position */
+  hash_keys[5] = 200;
+  hash_index_add(&hash_index, hash_entry(5), 5);
+  UNIT_TEST_ASSERT(hash_find(&hash_index, 200) == 5);
+  UNIT_TEST_ASSERT(hash_find(&hash_index, 105) == -1);
+
+  hash_index_clear(&hash_index);
+  for(i = 0; i < ELEMENT_COUNT; i++) {
+    UNIT_TEST_ASSERT(hash_find(&hash_index, hash_keys[i]) == -1);
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
 PROCESS_THREAD(data_structure_test_process, ev, data)
 {
   PROCESS_BEGIN();
@@ -1039,6 +1119,7 @@ PROCESS_THREAD(data_structure_test_process, ev, data)
   UNIT_TEST_RUN(test_csll);
   UNIT_TEST_RUN(test_dll);
   UNIT_TEST_RUN(test_cdll);
+  UNIT_TEST_RUN(test_hash_index);
 
   printf("=check-me= DONE\n");
 
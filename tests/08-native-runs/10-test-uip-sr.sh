@@ -0,0 +1,46 @@
+#!/bin/bash
+source ../utils.sh
+
+# Contiki directory
+CONTIKI=$1
+
+# Example code directory
+CODE_DIR=code-uip-sr
+CODE=test-uip-sr
+
+FAILED=0
+
+# Run the test with and without the hash index
+for DEFINES in UIP_SR_CONF_WITH_HASH_INDEX=0 UIP_SR_CONF_WITH_HASH_INDEX=1
+do
+  echo "Building $CODE with $DEFINES"
+  make -C $CODE_DIR TARGET=native clean > /dev/null
+  make -C $CODE_DIR TARGET=native DEFINES=$DEFINES > make.log 2> make.err
+  echo "Starting native node"
+  timeout 60 $CODE_DIR/$CODE.native >> $CODE.log 2>> $CODE.err
+  if [ $? -ne 0 ] || ! grep -q "=check-me= DONE" $CODE.log ; then
+    FAILED=1
+  fi
+done
+make -C $CODE_DIR TARGET=native clean > /dev/null
+
+if [ $FAILED -ne 0 ] || grep -q "=check-me= FAILED" $CODE.log ; then
+  echo "==== make.log ====" ; cat make.log;
+  echo "==== make.err ====" ; cat make.err;
+  echo "==== $CODE.log ====" ; cat $CODE.log;
+  echo "==== $CODE.err ====" ; cat $CODE.err;
+
+  printf "%-32s TEST FAIL\n" "$CODE" | tee $CODE.testlog;
+else
+  cp $CODE.log $CODE.testlog
+  printf "%-32s TEST OK\n" "$CODE" | tee $CODE.testlog;
+fi
+
+rm make.log
+rm make.err
+rm $CODE.log
+rm $CODE.err
+
+# We do not want Make to stop -> Return 0
+# The Makefile will check if a log contains FAIL at the end
+exit 0
@@ -0,0 +1,62 @@
+#!/bin/bash
+source ../utils.sh
+
+# Contiki directory
+CONTIKI=$1
+
+# Example code directory
+CODE_DIR=code-tsch-log
+CODE=test-tsch-log
+DECODER_DIR=$CONTIKI/tools/tsch-log
+DECODER=tsch-log-decode
+
+FAILED=0
+
+make -C $DECODER_DIR > make.log 2> make.err || FAILED=1
+
+# Run the test with text and with binary logs
+for BINARY in 0 1
+do
+  echo "Building $CODE with TSCH_LOG_CONF_BINARY=$BINARY"
+  make -C $CODE_DIR TARGET=native clean > /dev/null
+  make -C $CODE_DIR TARGET=native DEFINES=TSCH_LOG_CONF_BINARY=$BINARY >> make.log 2>> make.err
+  echo "Starting native node"
+  timeout 120 $CODE_DIR/$CODE.native > $CODE.$BINARY.out 2>> $CODE.err
+  if [ $? -ne 0 ] || ! grep -a -q "=check-me= DONE" $CODE.$BINARY.out ; then
+    FAILED=1
+  fi
+done
+make -C $CODE_DIR TARGET=native clean > /dev/null
+
+# The decoded binary logs must match the text logs
+$DECODER_DIR/$DECODER $CODE.1.out > $CODE.log
+grep -a "TSCH-LOG" $CODE.0.out > $CODE.text
+grep -a "TSCH-LOG" $CODE.log > $CODE.decoded
+if [ ! -s $CODE.text ] || ! cmp $CODE.text $CODE.decoded ; then
+  echo "Decoded binary logs differ from text logs"
+  FAILED=1
+fi
+echo "Text output: $(wc -c < $CODE.0.out) bytes, binary output: $(wc -c < $CODE.1.out) bytes" >> $CODE.log
+make -C $DECODER_DIR clean > /dev/null
+
+if [ $FAILED -ne 0 ] || grep -q "=check-me= FAILED" $CODE.log ; then
+  echo "==== make.log ====" ; cat make.log;
+  echo "==== make.err ====" ; cat make.err;
+  echo "==== $CODE.log ====" ; cat $CODE.log;
+  echo "==== $CODE.err ====" ; cat $CODE.err;
+
+  printf "%-32s TEST FAIL\n" "$CODE" | tee $CODE.testlog;
+else
+  cp $CODE.log $CODE.testlog
+  printf "%-32s TEST OK\n" "$CODE" | tee $CODE.testlog;
+fi
+
+rm make.log
+rm make.err
+rm $CODE.log
+rm $CODE.err
+rm $CODE.0.out $CODE.1.out $CODE.text $CODE.decoded
+
+# We do not want Make to stop -> Return 0
+# The Makefile will check if a log contains FAIL at the end
+exit 0
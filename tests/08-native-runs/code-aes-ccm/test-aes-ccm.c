@@ -0,0 +1,305 @@
+
+/*
+ * Test and benchmark of AES-128 and CCM*. The AES_128 and CCM_STAR
+ * drivers selected by the build are checked against the FIPS-197 and
+ * NIST SP 800-38A block vectors, and against RFC 3610 packet vector #1
+ * and further CCM* vectors computed with an independent implementation
+ * of RFC 3610: MIC only, encryption only, and both, with several MIC
+ * lengths. The time per block and per frame is then measured.
+ */
+
+#include "contiki.h"
+#include "lib/aes-128.h"
+#include "lib/ccm-star.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_aes_ccm_process, "AES-128 and CCM* test");
+AUTOSTART_PROCESSES(&test_aes_ccm_process);
+/*---------------------------------------------------------------------------*/
+#define BENCH_BLOCKS     1000000
+#define BENCH_FRAMES     100000
+/* An 802.15.4 data frame: header and payload */
+#define BENCH_A_LEN      21
+#define BENCH_M_LEN      90
+#define BENCH_MIC_LEN    8
+
+struct block_vector {
+  const char *key;
+  const char *plaintext;
+  const char *ciphertext;
+};
+
+/* FIPS-197 Appendix C.1, then NIST SP 800-38A F.1.1 (ECB-AES128) */
+static const struct block_vector block_vectors[] = {
+  { "000102030405060708090a0b0c0d0e0f", "00112233445566778899aabbccddeeff",
+    "69c4e0d86a7b0430d8cdb78070b4c55a" },
+  { "2b7e151628aed2a6abf7158809cf4f3c", "6bc1bee22e409f96e93d7e117393172a",
+    "3ad77bb40d7a3660a89ecaf32466ef97" },
+  { "2b7e151628aed2a6abf7158809cf4f3c", "ae2d8a571e03ac9c9eb76fac45af8e51",
+    "f5d3d58503b9699de785895a96fdbaaf" },
+  { "2b7e151628aed2a6abf7158809cf4f3c", "30c81c46a35ce411e5fbc1191a0a52ef",
+    "43b1cd7f598ece23881b00e3ed030688" },
+  { "2b7e151628aed2a6abf7158809cf4f3c", "f69f2445df4f9b17ad2b417be66c3710",
+    "7b0c785e27e8ad3f8223207104725dd4" },
+};
+
+struct ccm_vector {
+  const uint8_t *key;
+  const uint8_t *nonce;
+  const uint8_t *a;
+  uint8_t a_len;
+  const uint8_t *m;
+  const uint8_t *c;
+  uint8_t m_len;
+  const uint8_t *mic;
+  uint8_t mic_len;
+};
+
+static const uint8_t rfc3610_1_key[] = {
+  0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb,
+  0xcc, 0xcd, 0xce, 0xcf
+};
+static const uint8_t rfc3610_1_nonce[] = {
+  0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0, 0xa1, 0xa2, 0xa3, 0xa4,
+  0xa5
+};
+static const uint8_t rfc3610_1_a[] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07
+};
+static const uint8_t rfc3610_1_m[] = {
+  0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13,
+  0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e
+};
+static const uint8_t rfc3610_1_c[] = {
+  0x58, 0x8c, 0x97, 0x9a, 0x61, 0xc6, 0x63, 0xd2, 0xf0, 0x66, 0xd0, 0xc2,
+  0xc0, 0xf9, 0x89, 0x80, 0x6d, 0x5f, 0x6b, 0x61, 0xda, 0xc3, 0x84
+};
+static const uint8_t rfc3610_1_mic[] = {
+  0x17, 0xe8, 0xd1, 0x2c, 0xfd, 0xf9, 0x26, 0xe0
+};
+static const uint8_t gen_key[] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+  0x0c, 0x0d, 0x0e, 0x0f
+};
+static const uint8_t gen_nonce[] = {
+  0xac, 0xde, 0x48, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x05,
+  0x05
+};
+static const uint8_t gen1_a[] = {
+  0x01, 0x08, 0x0f, 0x16, 0x1d, 0x24, 0x2b, 0x32, 0x39, 0x40, 0x47, 0x4e,
+  0x55, 0x5c, 0x63, 0x6a, 0x71, 0x78, 0x7f, 0x86, 0x8d, 0x94, 0x9b, 0xa2,
+  0xa9, 0xb0
+};
+static const uint8_t gen1_mic[] = {
+  0x27, 0x2e, 0xdb, 0xa1, 0x3f, 0xe7, 0x0c, 0xff
+};
+static const uint8_t gen2_a[] = {
+  0x01, 0x08, 0x0f, 0x16, 0x1d, 0x24, 0x2b, 0x32, 0x39, 0x40, 0x47, 0x4e,
+  0x55, 0x5c, 0x63, 0x6a, 0x71, 0x78, 0x7f, 0x86, 0x8d
+};
+static const uint8_t gen2_m[] = {
+  0x05, 0x12, 0x1f, 0x2c, 0x39, 0x46, 0x53, 0x60, 0x6d, 0x7a, 0x87, 0x94,
+  0xa1, 0xae, 0xbb, 0xc8, 0xd5, 0xe2, 0xef, 0xfc, 0x09, 0x16, 0x23, 0x30,
+  0x3d, 0x4a, 0x57, 0x64, 0x71, 0x7e, 0x8b, 0x98, 0xa5, 0xb2, 0xbf, 0xcc,
+  0xd9, 0xe6, 0xf3, 0x00, 0x0d, 0x1a, 0x27, 0x34, 0x41, 0x4e, 0x5b, 0x68,
+  0x75, 0x82, 0x8f, 0x9c, 0xa9, 0xb6, 0xc3, 0xd0, 0xdd, 0xea, 0xf7, 0x04,
+  0x11, 0x1e, 0x2b, 0x38, 0x45, 0x52, 0x5f, 0x6c, 0x79, 0x86, 0x93, 0xa0,
+  0xad, 0xba, 0xc7, 0xd4, 0xe1, 0xee, 0xfb, 0x08, 0x15, 0x22, 0x2f, 0x3c,
+  0x49, 0x56, 0x63, 0x70, 0x7d, 0x8a, 0x97, 0xa4, 0xb1, 0xbe, 0xcb, 0xd8,
+  0xe5, 0xf2, 0xff, 0x0c
+};
+static const uint8_t gen2_c[] = {
+  0x64, 0xfe, 0xa7, 0xf3, 0xcf, 0xa5, 0x8b, 0xc3, 0x87, 0x5f, 0xee, 0x9f,
+  0x23, 0xca, 0xd4, 0xf1, 0xfc, 0x25, 0x93, 0x5a, 0x86, 0x02, 0xd3, 0x51,
+  0x2d, 0x77, 0x3c, 0xe9, 0x20, 0x2b, 0x77, 0x4f, 0x6a, 0xa9, 0xe0, 0x75,
+  0x1e, 0x8e, 0x48, 0x7d, 0x8b, 0x36, 0x3a, 0x44, 0x5a, 0x3c, 0x7c, 0xf3,
+  0x66, 0xb4, 0xbc, 0x19, 0xa5, 0x86, 0x61, 0xc6, 0x13, 0x68, 0x0b, 0x23,
+  0x75, 0x33, 0x1d, 0xc4, 0x3b, 0x38, 0x3c, 0xd3, 0x75, 0x77, 0xfa, 0xd8,
+  0x52, 0x58, 0xe2, 0x31, 0x01, 0x8b, 0xcc, 0x5a, 0x18, 0x47, 0x42, 0x84,
+  0x78, 0x24, 0x17, 0xb6, 0x63, 0x57, 0xb6, 0x76, 0x60, 0x36, 0xdf, 0x73,
+  0xd2, 0x92, 0xff, 0xcd
+};
+static const uint8_t gen2_mic[] = {
+  0xa7, 0x20, 0x70, 0xae, 0xd6, 0x8f, 0x59, 0xe3, 0x6e, 0xf1, 0x03, 0xe5,
+  0x79, 0xc8, 0x8c, 0xbf
+};
+static const uint8_t gen3_m[] = {
+  0x05, 0x12, 0x1f, 0x2c, 0x39, 0x46, 0x53, 0x60, 0x6d, 0x7a, 0x87, 0x94,
+  0xa1, 0xae, 0xbb, 0xc8, 0xd5, 0xe2, 0xef, 0xfc, 0x09, 0x16, 0x23, 0x30,
+  0x3d, 0x4a, 0x57, 0x64, 0x71, 0x7e, 0x8b, 0x98, 0xa5
+};
+static const uint8_t gen3_c[] = {
+  0x64, 0xfe, 0xa7, 0xf3, 0xcf, 0xa5, 0x8b, 0xc3, 0x87, 0x5f, 0xee, 0x9f,
+  0x23, 0xca, 0xd4, 0xf1, 0xfc, 0x25, 0x93, 0x5a, 0x86, 0x02, 0xd3, 0x51,
+  0x2d, 0x77, 0x3c, 0xe9, 0x20, 0x2b, 0x77, 0x4f, 0x6a
+};
+static const uint8_t gen3_mic[] = {
+  0x99, 0x20, 0x99, 0x2d
+};
+static const uint8_t gen4_a[] = {
+  0x01, 0x08, 0x0f, 0x16, 0x1d, 0x24, 0x2b, 0x32, 0x39, 0x40
+};
+static const uint8_t gen4_m[] = {
+  0x05, 0x12, 0x1f, 0x2c, 0x39, 0x46, 0x53, 0x60, 0x6d, 0x7a, 0x87, 0x94,
+  0xa1, 0xae, 0xbb, 0xc8, 0xd5, 0xe2, 0xef, 0xfc
+};
+static const uint8_t gen4_c[] = {
+  0x64, 0xfe, 0xa7, 0xf3, 0xcf, 0xa5, 0x8b, 0xc3, 0x87, 0x5f, 0xee, 0x9f,
+  0x23, 0xca, 0xd4, 0xf1, 0xfc, 0x25, 0x93, 0x5a
+};
+
+static const struct ccm_vector ccm_vectors[] = {
+  { rfc3610_1_key, rfc3610_1_nonce, rfc3610_1_a, 8, rfc3610_1_m, rfc3610_1_c, 23, rfc3610_1_mic, 8 },
+  { gen_key, gen_nonce, gen1_a, 26, NULL, NULL, 0, gen1_mic, 8 },
+  { gen_key, gen_nonce, gen2_a, 21, gen2_m, gen2_c, 100, gen2_mic, 16 },
+  { gen_key, gen_nonce, NULL, 0, gen3_m, gen3_c, 33, gen3_mic, 4 },
+  { gen_key, gen_nonce, gen4_a, 10, gen4_m, gen4_c, 20, NULL, 0 },
+};
+
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+static void
+from_hex(uint8_t *out, const char *hex, size_t len)
+{
+  unsigned byte;
+  size_t i;
+
+  for(i = 0; i < len; i++) {
+    sscanf(hex + 2 * i, "%2x", &byte);
+    out[i] = byte;
+  }
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_aes_vectors, "AES-128 test vectors");
+UNIT_TEST(test_aes_vectors)
+{
+  uint8_t key[AES_128_KEY_LENGTH];
+  uint8_t block[AES_128_BLOCK_SIZE];
+  uint8_t expected[AES_128_BLOCK_SIZE];
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < sizeof(block_vectors) / sizeof(block_vectors[0]); i++) {
+    from_hex(key, block_vectors[i].key, sizeof(key));
+    from_hex(block, block_vectors[i].plaintext, sizeof(block));
+    from_hex(expected, block_vectors[i].ciphertext, sizeof(expected));
+    AES_128.set_key(key);
+    AES_128.encrypt(block);
+    UNIT_TEST_ASSERT(memcmp(block, expected, sizeof(block)) == 0);
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_ccm_vectors, "CCM* test vectors");
+UNIT_TEST(test_ccm_vectors)
+{
+  const struct ccm_vector *v;
+  uint8_t m[128];
+  uint8_t mic[AES_128_BLOCK_SIZE];
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < sizeof(ccm_vectors) / sizeof(ccm_vectors[0]); i++) {
+    v = &ccm_vectors[i];
+    CCM_STAR.set_key(v->key);
+
+    /* Forward: MIC of the plaintext, then encryption */
+    memcpy(m, v->m, v->m_len);
+    memset(mic, 0, sizeof(mic));
+    CCM_STAR.aead(v->nonce, m, v->m_len, v->a, v->a_len,
+                  mic, v->mic_len, 1);
+    UNIT_TEST_ASSERT(v->m_len == 0 || memcmp(m, v->c, v->m_len) == 0);
+    UNIT_TEST_ASSERT(v->mic_len == 0 || memcmp(mic, v->mic, v->mic_len) == 0);
+
+    /* Inverse: decryption, then MIC of the plaintext */
+    memset(mic, 0, sizeof(mic));
+    CCM_STAR.aead(v->nonce, m, v->m_len, v->a, v->a_len,
+                  mic, v->mic_len, 0);
+    UNIT_TEST_ASSERT(v->m_len == 0 || memcmp(m, v->m, v->m_len) == 0);
+    UNIT_TEST_ASSERT(v->mic_len == 0 || memcmp(mic, v->mic, v->mic_len) == 0);
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  static uint8_t frame[BENCH_A_LEN + BENCH_M_LEN];
+  uint8_t block[AES_128_BLOCK_SIZE];
+  uint8_t mic[BENCH_MIC_LEN];
+  uint64_t start;
+  uint64_t ns;
+  int i;
+
+  memset(block, 0, sizeof(block));
+  AES_128.set_key(gen_key);
+  start = now_ns();
+  for(i = 0; i < BENCH_BLOCKS; i++) {
+    AES_128.encrypt(block);
+  }
+  ns = now_ns() - start;
+  printf("AES-128: %.1f ns per block, %.1f MB/s\n",
+         (double)ns / BENCH_BLOCKS,
+         (double)BENCH_BLOCKS * AES_128_BLOCK_SIZE * 1000 / ns);
+
+  memset(frame, 0x5a, sizeof(frame));
+  CCM_STAR.set_key(gen_key);
+  start = now_ns();
+  for(i = 0; i < BENCH_FRAMES; i++) {
+    CCM_STAR.aead(gen_nonce, frame + BENCH_A_LEN, BENCH_M_LEN,
+                  frame, BENCH_A_LEN, mic, BENCH_MIC_LEN, i & 1);
+  }
+  ns = now_ns() - start;
+  printf("CCM* on %u-byte frames: %.1f ns per frame, %.1f MB/s\n",
+         (unsigned)sizeof(frame), (double)ns / BENCH_FRAMES,
+         (double)BENCH_FRAMES * sizeof(frame) * 1000 / ns);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_aes_ccm_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(test_aes_vectors);
+  UNIT_TEST_RUN(test_ccm_vectors);
+
+  benchmark();
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
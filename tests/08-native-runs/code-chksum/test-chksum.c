@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Fuzz test and benchmark of the Internet checksum. uip_chksum() and the
+ * upper-layer checksums are checked against a reference 16-bit loop for
+ * random buffers of random length and alignment, and the time per call
+ * is measured for payload sizes from 8 to 1280 bytes.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uip-arch.h"
+#include "lib/random.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_chksum_process, "Checksum test");
+AUTOSTART_PROCESSES(&test_chksum_process);
+/*---------------------------------------------------------------------------*/
+#ifndef UIP_ARCH_CHKSUM_DATA
+#define UIP_ARCH_CHKSUM_DATA 0
+#endif
+
+#define MAX_LEN          1280
+#define MAX_OFFSET       8
+#define FUZZ_ROUNDS      200000
+#define BENCH_BYTES      200000000
+
+static uint8_t buf[MAX_LEN + MAX_OFFSET];
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* Reference checksum: the original byte-oriented loop of uip6.c */
+static uint16_t
+ref_chksum(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+  uint16_t t;
+  const uint8_t *dataptr;
+  const uint8_t *last_byte;
+
+  dataptr = data;
+  last_byte = data + len - 1;
+
+  while(dataptr < last_byte) {
+    t = (dataptr[0] << 8) + dataptr[1];
+    sum += t;
+    if(sum < t) {
+      sum++;
+    }
+    dataptr += 2;
+  }
+
+  if(dataptr == last_byte) {
+    t = (dataptr[0] << 8) + 0;
+    sum += t;
+    if(sum < t) {
+      sum++;
+    }
+  }
+
+  return sum;
+}
+/*---------------------------------------------------------------------------*/
+/* Random bytes, biased towards 0x00 and 0xff to exercise the carries */
+static void
+fill_random(uint8_t *p, uint16_t len)
+{
+  uint16_t i;
+  uint8_t mode = random_rand() % 4;
+
+  for(i = 0; i < len; i++) {
+    switch(mode) {
+    case 0:
+      p[i] = 0xff;
+      break;
+    case 1:
+      p[i] = (random_rand() % 8) == 0 ? 0 : 0xff;
+      break;
+    default:
+      p[i] = random_rand();
+      break;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_buffer, "uip_chksum against reference");
+UNIT_TEST(test_buffer)
+{
+  uint16_t len;
+  uint8_t *p;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < FUZZ_ROUNDS; i++) {
+    len = random_rand() % (MAX_LEN + 1);
+    p = buf + random_rand() % MAX_OFFSET;
+    fill_random(p, len);
+    UNIT_TEST_ASSERT(uip_chksum((uint16_t *)p, len) ==
+                     uip_htons(ref_chksum(0, p, len)));
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_upper_layer, "Upper-layer checksums against reference");
+UNIT_TEST(test_upper_layer)
+{
+  uint16_t payload_len;
+  uint16_t sum;
+  uint8_t proto;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < FUZZ_ROUNDS / 10; i++) {
+    payload_len = UIP_UDPH_LEN +
+      random_rand() % (UIP_BUFSIZE - UIP_IPUDPH_LEN + 1);
+    proto = (i & 1) ? UIP_PROTO_UDP : UIP_PROTO_ICMP6;
+    fill_random(uip_buf, UIP_IPH_LEN + payload_len);
+    UIP_IP_BUF->vtc = 0x60;
+    UIP_IP_BUF->proto = proto;
+    uipbuf_set_len_field(UIP_IP_BUF, payload_len);
+    uip_ext_len = 0;
+
+    sum = payload_len + proto;
+    sum = ref_chksum(sum, (uint8_t *)&UIP_IP_BUF->srcipaddr,
+                     2 * sizeof(uip_ipaddr_t));
+    sum = ref_chksum(sum, UIP_IP_PAYLOAD(0), payload_len);
+    sum = (sum == 0) ? 0xffff : uip_htons(sum);
+
+    if(proto == UIP_PROTO_UDP) {
+      UNIT_TEST_ASSERT(uip_udpchksum() == sum);
+    } else {
+      UNIT_TEST_ASSERT(uip_icmp6chksum() == sum);
+    }
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  static const uint16_t sizes[] = { 8, 16, 32, 64, 128, 256, 512, 1024, 1280 };
+  volatile uint16_t result;
+  uint64_t start;
+  uint64_t ref_ns;
+  uint64_t ns;
+  unsigned i;
+  long n;
+  long rounds;
+
+  fill_random(buf, sizeof(buf));
+  for(i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    rounds = BENCH_BYTES / sizes[i] / 4;
+
+    start = now_ns();
+    for(n = 0; n < rounds; n++) {
+      result = ref_chksum(0, buf + (n & 1), sizes[i]);
+    }
+    ref_ns = now_ns() - start;
+
+    start = now_ns();
+    for(n = 0; n < rounds; n++) {
+      result = uip_chksum((uint16_t *)(buf + (n & 1)), sizes[i]);
+    }
+    ns = now_ns() - start;
+
+    printf("Checksum %4u bytes: %7.1f ns (reference %7.1f ns), %.2fx\n",
+           sizes[i], (double)ns / rounds, (double)ref_ns / rounds,
+           (double)ref_ns / ns);
+  }
+  (void)result;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_chksum_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with arch checksum %u, wide checksum %u\n",
+         UIP_ARCH_CHKSUM_DATA, UIP_CHKSUM_WIDE);
+  printf("---\n");
+
+  UNIT_TEST_RUN(test_buffer);
+  UNIT_TEST_RUN(test_upper_layer);
+
+  benchmark();
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
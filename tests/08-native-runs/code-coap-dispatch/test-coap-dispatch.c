@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the CoAP resource dispatch. Five hundred
+ * resources with LwM2M style paths are activated next to a few parent
+ * resources, and requests are fed to coap_receive() to check that each
+ * one reaches the resource the list walk would pick. The cost of a
+ * request is printed.
+ */
+
+#include "contiki.h"
+#include "coap-engine.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_coap_dispatch_process, "CoAP dispatch test");
+AUTOSTART_PROCESSES(&test_coap_dispatch_process);
+/*---------------------------------------------------------------------------*/
+#define NUM_OBJECTS      10
+#define NUM_INSTANCES    5
+#define NUM_RESOURCES    10
+#define NUM_BULK         (NUM_OBJECTS * NUM_INSTANCES * NUM_RESOURCES)
+#define PATH_LEN         16
+#define REQUEST_LEN      64
+#define BENCH_ROUNDS     200
+
+static int failures;
+static int last_handler;
+static uint16_t mid;
+static coap_endpoint_t client;
+
+static coap_resource_t bulk[NUM_BULK];
+static char bulk_paths[NUM_BULK][PATH_LEN];
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* Each handler records its number, which tells which resource was picked */
+#define HANDLER(n)                                                      \
+  static void                                                           \
+  handler_##n(coap_message_t *request, coap_message_t *response,        \
+              uint8_t *buffer, uint16_t preferred_size, int32_t *offset) \
+  {                                                                     \
+    last_handler = n;                                                   \
+  }
+
+HANDLER(0)
+HANDLER(1)
+HANDLER(2)
+HANDLER(3)
+HANDLER(4)
+HANDLER(5)
+HANDLER(6)
+HANDLER(7)
+
+static const coap_resource_handler_t handlers[] = {
+  handler_0, handler_1, handler_2, handler_3,
+  handler_4, handler_5, handler_6, handler_7
+};
+
+RESOURCE(res_plain_a, "", handler_2, NULL, NULL, NULL);
+RESOURCE(res_plain_b, "", handler_3, NULL, NULL, NULL);
+RESOURCE(res_plain_c, "", handler_7, NULL, NULL, NULL);
+PARENT_RESOURCE(res_parent_a, "", handler_0, NULL, NULL, NULL);
+PARENT_RESOURCE(res_parent_b, "", handler_1, NULL, NULL, NULL);
+PARENT_RESOURCE(res_parent_c, "", handler_4, NULL, NULL, NULL);
+PARENT_RESOURCE(res_parent_d, "", handler_5, NULL, NULL, NULL);
+PARENT_RESOURCE(res_parent_e, "", handler_6, NULL, NULL, NULL);
+PARENT_RESOURCE(res_parent_f, "", handler_6, NULL, NULL, NULL);
+PARENT_RESOURCE(res_parent_g, "", handler_5, NULL, NULL, NULL);
+PARENT_RESOURCE(res_parent_h, "", handler_0, NULL, NULL, NULL);
+/*---------------------------------------------------------------------------*/
+static int
+serialize_request(uint8_t *buf, const char *path)
+{
+  static coap_message_t request[1];
+
+  coap_init_message(request, COAP_TYPE_NON, COAP_GET, mid++);
+  coap_set_header_uri_path(request, path);
+  return coap_serialize_message(request, buf);
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the number of the handler that served the request, or -1 */
+static int
+request(const char *path)
+{
+  uint8_t buf[REQUEST_LEN];
+
+  last_handler = -1;
+  coap_receive(&client, buf, serialize_request(buf, path));
+  return last_handler;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_bulk, "Resources with distinct paths");
+UNIT_TEST(test_bulk)
+{
+  char path[2 * PATH_LEN];
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < NUM_BULK; i++) {
+    UNIT_TEST_ASSERT(request(bulk_paths[i]) == i % 8);
+  }
+  for(i = 0; i < NUM_BULK; i++) {
+    /* Not a parent, so nothing below it */
+    snprintf(path, sizeof(path), "%s/1", bulk_paths[i]);
+    UNIT_TEST_ASSERT(request(path) == -1);
+  }
+  UNIT_TEST_ASSERT(request("3300/0") == -1);
+  UNIT_TEST_ASSERT(request("3300/0/570") == -1);
+  UNIT_TEST_ASSERT(request("3300/0/57000") == -1);
+  UNIT_TEST_ASSERT(request("") == -1);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_sub_resources, "Sub-resources");
+UNIT_TEST(test_sub_resources)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(request("sub") == 0);
+  UNIT_TEST_ASSERT(request("sub/x") == 0);
+  UNIT_TEST_ASSERT(request("sub/x/y") == 0);
+  UNIT_TEST_ASSERT(request("subx") == -1);
+  UNIT_TEST_ASSERT(request("su") == -1);
+
+  /* The resource that was activated first wins */
+  UNIT_TEST_ASSERT(request("p/q") == 1);
+  UNIT_TEST_ASSERT(request("p/r") == 1);
+  UNIT_TEST_ASSERT(request("r/s") == 3);
+  UNIT_TEST_ASSERT(request("r/t") == 4);
+  UNIT_TEST_ASSERT(request("r/s/t") == 4);
+  UNIT_TEST_ASSERT(request("n/m/k") == 5);
+  UNIT_TEST_ASSERT(request("n/k") == 6);
+  UNIT_TEST_ASSERT(request("w/v/k") == 6);
+  UNIT_TEST_ASSERT(request("w/v") == 6);
+
+  /* Same path twice, only the second one has sub-resources */
+  UNIT_TEST_ASSERT(request("dup") == 7);
+  UNIT_TEST_ASSERT(request("dup/x") == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_reactivation, "Reactivation");
+UNIT_TEST(test_reactivation)
+{
+  UNIT_TEST_BEGIN();
+
+  /* Moves to a new path at the end of the list */
+  coap_activate_resource(&res_plain_a, "z/q");
+  UNIT_TEST_ASSERT(request("z/q") == 2);
+  UNIT_TEST_ASSERT(request("p/q") == 1);
+
+  coap_activate_resource(&bulk[1], "moved");
+  UNIT_TEST_ASSERT(request("moved") == 1);
+  UNIT_TEST_ASSERT(request(bulk_paths[1]) == -1);
+  UNIT_TEST_ASSERT(request(bulk_paths[0]) == 0);
+  UNIT_TEST_ASSERT(request(bulk_paths[2]) == 2);
+
+  coap_activate_resource(&bulk[1], bulk_paths[1]);
+  UNIT_TEST_ASSERT(request(bulk_paths[1]) == 1);
+  UNIT_TEST_ASSERT(request("moved") == -1);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  static uint8_t requests[NUM_BULK][REQUEST_LEN];
+  static int request_len[NUM_BULK];
+  uint8_t buf[REQUEST_LEN];
+  uint8_t miss[REQUEST_LEN];
+  int miss_len;
+  uint64_t t;
+  int found;
+  int r;
+  int i;
+
+  for(i = 0; i < NUM_BULK; i++) {
+    request_len[i] = serialize_request(requests[i], bulk_paths[i]);
+  }
+  miss_len = serialize_request(miss, "3399/0/5799");
+
+  found = 0;
+  t = now_ns();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    for(i = 0; i < NUM_BULK; i++) {
+      memcpy(buf, requests[i], request_len[i]);
+      last_handler = -1;
+      coap_receive(&client, buf, request_len[i]);
+      found += last_handler >= 0;
+    }
+  }
+  t = now_ns() - t;
+
+  printf("Bench: %d resources, %d found: %.1f ns per request\n", NUM_BULK,
+         found / BENCH_ROUNDS, (double)t / BENCH_ROUNDS / NUM_BULK);
+
+  t = now_ns();
+  for(r = 0; r < BENCH_ROUNDS * 10; r++) {
+    memcpy(buf, miss, miss_len);
+    coap_receive(&client, buf, miss_len);
+  }
+  t = now_ns() - t;
+
+  printf("Bench: unknown path: %.1f ns per request\n",
+         (double)t / BENCH_ROUNDS / 10);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_coap_dispatch_process, ev, data)
+{
+  int i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with resource index %u\n", COAP_WITH_RESOURCE_INDEX);
+  printf("---\n");
+
+  coap_engine_init();
+
+  uip_ip6addr(&client.ipaddr, 0xfd00, 0, 0, 0, 0, 0, 0, 2);
+  client.port = UIP_HTONS(COAP_DEFAULT_PORT);
+
+  coap_activate_resource(&res_parent_a, "sub");
+  coap_activate_resource(&res_parent_b, "p");
+  coap_activate_resource(&res_plain_a, "p/q");
+  coap_activate_resource(&res_plain_b, "r/s");
+  coap_activate_resource(&res_parent_c, "r");
+  coap_activate_resource(&res_parent_d, "n/m");
+  coap_activate_resource(&res_parent_e, "n");
+  coap_activate_resource(&res_parent_f, "w");
+  coap_activate_resource(&res_parent_g, "w/v");
+  coap_activate_resource(&res_plain_c, "dup");
+  coap_activate_resource(&res_parent_h, "dup");
+
+  for(i = 0; i < NUM_BULK; i++) {
+    snprintf(bulk_paths[i], PATH_LEN, "%u/%u/%u",
+             3300 + i / (NUM_INSTANCES * NUM_RESOURCES),
+             i / NUM_RESOURCES % NUM_INSTANCES,
+             5700 + i % NUM_RESOURCES);
+    bulk[i].get_handler = handlers[i % 8];
+    coap_activate_resource(&bulk[i], bulk_paths[i]);
+  }
+
+  UNIT_TEST_RUN(test_bulk);
+  UNIT_TEST_RUN(test_sub_resources);
+  UNIT_TEST_RUN(test_reactivation);
+
+  benchmark();
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
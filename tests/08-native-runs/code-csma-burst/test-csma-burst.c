@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test of CSMA burst transmission. Unicast frames queued for one neighbor
+ * go through a test radio that records them and acknowledges them, and the
+ * frame pending bit of each frame on air is checked. Frames with and
+ * without the bit are then fed to CSMA as if received, and requests to
+ * turn the MAC off must be deferred until the burst ends or times out.
+ * With CSMA_CONF_BURST_MAX_LEN 0, the bit must be neither sent nor acted
+ * upon.
+ */
+
+#include "contiki.h"
+#include "net/mac/csma/csma.h"
+#include "net/mac/framer/frame802154.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_csma_burst_process, "CSMA burst test");
+AUTOSTART_PROCESSES(&test_csma_burst_process);
+/*---------------------------------------------------------------------------*/
+#define MAX_FRAME        127
+#define MAX_CAPTURED     16
+#define NUM_UNICAST      4
+#define NUM_BROADCAST    2
+#define FCF_PENDING      0x10
+
+struct frame {
+  uint8_t len;
+  uint8_t data[MAX_FRAME];
+};
+
+static struct frame prepared;
+static struct frame captured[MAX_CAPTURED];
+static int num_captured;
+static uint8_t ack_pending;
+static uint8_t radio_is_on;
+static int sent_ok;
+static int sent_failed;
+static uint8_t rx_seqno;
+static linkaddr_t peer_addr;
+static uint8_t timeout_deferred;
+static struct etimer et;
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* A radio that keeps the frames sent and acknowledges unicast frames */
+static int
+init(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+prepare(const void *payload, unsigned short payload_len)
+{
+  if(payload_len > MAX_FRAME) {
+    return 1;
+  }
+  prepared.len = payload_len;
+  memcpy(prepared.data, payload, payload_len);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+transmit(unsigned short transmit_len)
+{
+  if(num_captured < MAX_CAPTURED) {
+    captured[num_captured++] = prepared;
+  }
+  /* Broadcast frames have the ack request bit cleared */
+  ack_pending = (prepared.data[0] & 0x20) != 0;
+  return RADIO_TX_OK;
+}
+/*---------------------------------------------------------------------------*/
+static int
+send(const void *payload, unsigned short payload_len)
+{
+  prepare(payload, payload_len);
+  return transmit(payload_len);
+}
+/*---------------------------------------------------------------------------*/
+static int
+radio_read(void *buf, unsigned short buf_len)
+{
+  uint8_t *ack = buf;
+
+  if(!ack_pending || buf_len < CSMA_ACK_LEN) {
+    return 0;
+  }
+  ack_pending = 0;
+  ack[0] = FRAME802154_ACKFRAME;
+  ack[1] = 0;
+  ack[2] = prepared.data[2];
+  return CSMA_ACK_LEN;
+}
+/*---------------------------------------------------------------------------*/
+static int
+channel_clear(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+receiving_packet(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+pending_packet(void)
+{
+  return ack_pending;
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  radio_is_on = 1;
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(void)
+{
+  radio_is_on = 0;
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+get_value(radio_param_t param, radio_value_t *value)
+{
+  if(!value) {
+    return RADIO_RESULT_INVALID_VALUE;
+  }
+
+  switch(param) {
+  case RADIO_CONST_MAX_PAYLOAD_LEN:
+    *value = MAX_FRAME - 2;
+    return RADIO_RESULT_OK;
+  default:
+    return RADIO_RESULT_NOT_SUPPORTED;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+set_value(radio_param_t param, radio_value_t value)
+{
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+get_object(radio_param_t param, void *dest, size_t size)
+{
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+set_object(radio_param_t param, const void *src, size_t size)
+{
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*---------------------------------------------------------------------------*/
+const struct radio_driver test_radio_driver = {
+  init,
+  prepare,
+  transmit,
+  send,
+  radio_read,
+  channel_clear,
+  receiving_packet,
+  pending_packet,
+  on,
+  off,
+  get_value,
+  set_value,
+  get_object,
+  set_object
+};
+/*---------------------------------------------------------------------------*/
+static void
+packet_sent(void *ptr, int status, int transmissions)
+{
+  if(status == MAC_TX_OK) {
+    sent_ok++;
+  } else {
+    sent_failed++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Queue a frame whose first payload byte is its id */
+static void
+queue_frame(uint8_t id, const linkaddr_t *dest)
+{
+  uint8_t payload[20];
+
+  memset(payload, id, sizeof(payload));
+  packetbuf_clear();
+  packetbuf_copyfrom(payload, sizeof(payload));
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, dest);
+  NETSTACK_MAC.send(packet_sent, NULL);
+}
+/*---------------------------------------------------------------------------*/
+/* Feed CSMA a frame from the peer, with or without the frame pending bit */
+static int
+deliver_frame(int broadcast, int pending)
+{
+  uint8_t frame[MAX_FRAME];
+  uint8_t payload[8] = { 0 };
+  int len;
+
+  packetbuf_clear();
+  packetbuf_copyfrom(payload, sizeof(payload));
+  packetbuf_set_attr(PACKETBUF_ATTR_FRAME_TYPE, FRAME802154_DATAFRAME);
+  packetbuf_set_attr(PACKETBUF_ATTR_MAC_SEQNO, ++rx_seqno);
+  packetbuf_set_attr(PACKETBUF_ATTR_MAC_ACK, !broadcast);
+  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &peer_addr);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER,
+                     broadcast ? &linkaddr_null : &linkaddr_node_addr);
+  if(NETSTACK_FRAMER.create() < 0) {
+    return 0;
+  }
+  len = packetbuf_totlen();
+  memcpy(frame, packetbuf_hdrptr(), len);
+  if(pending) {
+    frame[0] |= FCF_PENDING;
+  }
+
+  packetbuf_clear();
+  memcpy(packetbuf_dataptr(), frame, len);
+  packetbuf_set_datalen(len);
+  NETSTACK_MAC.input();
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+frame_pending(int i)
+{
+  return (captured[i].data[0] & FCF_PENDING) != 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+frame_id(int i)
+{
+  return captured[i].data[captured[i].len - 1];
+}
+/*---------------------------------------------------------------------------*/
+static int
+frame_is_broadcast(int i)
+{
+  return (captured[i].data[0] & 0x20) == 0;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_burst_tx, "Burst transmission");
+UNIT_TEST(test_burst_tx)
+{
+  int unicast = 0;
+  int broadcast = 0;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(sent_ok == NUM_UNICAST + NUM_BROADCAST);
+  UNIT_TEST_ASSERT(sent_failed == 0);
+  UNIT_TEST_ASSERT(num_captured == NUM_UNICAST + NUM_BROADCAST);
+
+  for(i = 0; i < num_captured; i++) {
+    if(frame_is_broadcast(i)) {
+      UNIT_TEST_ASSERT(frame_id(i) == NUM_UNICAST + broadcast);
+      UNIT_TEST_ASSERT(!frame_pending(i));
+      broadcast++;
+    } else {
+      /* Sent in order. With bursts of three frames, the first two have
+         the pending bit set, the third ends the burst, and the fourth
+         comes after a new backoff and is the last one queued */
+      UNIT_TEST_ASSERT(frame_id(i) == unicast);
+      UNIT_TEST_ASSERT(frame_pending(i) ==
+                       (CSMA_BURST_MAX_LEN >= 3 && unicast < 2));
+      unicast++;
+    }
+  }
+  UNIT_TEST_ASSERT(unicast == NUM_UNICAST);
+  UNIT_TEST_ASSERT(broadcast == NUM_BROADCAST);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_burst_rx, "Burst reception defers off()");
+UNIT_TEST(test_burst_rx)
+{
+  UNIT_TEST_BEGIN();
+
+  /* The radio goes off at the end of the burst */
+  NETSTACK_MAC.on();
+  UNIT_TEST_ASSERT(deliver_frame(0, 1));
+  NETSTACK_MAC.off();
+  UNIT_TEST_ASSERT(radio_is_on == (CSMA_BURST_MAX_LEN > 0));
+  UNIT_TEST_ASSERT(deliver_frame(0, 1));
+  UNIT_TEST_ASSERT(radio_is_on == (CSMA_BURST_MAX_LEN > 0));
+  UNIT_TEST_ASSERT(deliver_frame(0, 0));
+  UNIT_TEST_ASSERT(!radio_is_on);
+
+  /* Turning the MAC on again cancels the deferred request */
+  NETSTACK_MAC.on();
+  UNIT_TEST_ASSERT(deliver_frame(0, 1));
+  NETSTACK_MAC.off();
+  NETSTACK_MAC.on();
+  UNIT_TEST_ASSERT(deliver_frame(0, 0));
+  UNIT_TEST_ASSERT(radio_is_on);
+
+  /* Not after a broadcast frame */
+  UNIT_TEST_ASSERT(deliver_frame(1, 1));
+  NETSTACK_MAC.off();
+  UNIT_TEST_ASSERT(!radio_is_on);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_burst_rx_timeout, "Burst reception timeout");
+UNIT_TEST(test_burst_rx_timeout)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(timeout_deferred == (CSMA_BURST_MAX_LEN > 0));
+  UNIT_TEST_ASSERT(!radio_is_on);
+
+  /* The burst has ended: off() is no longer deferred */
+  NETSTACK_MAC.on();
+  NETSTACK_MAC.off();
+  UNIT_TEST_ASSERT(!radio_is_on);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_csma_burst_process, ev, data)
+{
+  static int i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with bursts of up to %u frames\n",
+         CSMA_BURST_MAX_LEN);
+  printf("---\n");
+
+  memset(&peer_addr, 0xaa, sizeof(peer_addr));
+
+  /* Queue frames for the peer and broadcast frames, and let CSMA send
+     them */
+  for(i = 0; i < NUM_UNICAST; i++) {
+    queue_frame(i, &peer_addr);
+  }
+  for(i = 0; i < NUM_BROADCAST; i++) {
+    queue_frame(NUM_UNICAST + i, &linkaddr_null);
+  }
+  etimer_set(&et, CLOCK_SECOND);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+
+  UNIT_TEST_RUN(test_burst_tx);
+  UNIT_TEST_RUN(test_burst_rx);
+
+  /* A burst whose last frame never arrives */
+  NETSTACK_MAC.on();
+  deliver_frame(0, 1);
+  NETSTACK_MAC.off();
+  timeout_deferred = radio_is_on;
+  etimer_set(&et, 2 * CSMA_BURST_RX_TIMEOUT);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+
+  UNIT_TEST_RUN(test_burst_rx_timeout);
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
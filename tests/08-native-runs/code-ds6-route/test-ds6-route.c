@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the IPv6 routing table with a large number of
+ * routes. Route lookups are checked against a reference longest-prefix
+ * match over all routes while routes are added and removed, and the
+ * lookup time is measured for a synthetic stream of destinations, as
+ * seen by a storing-mode root forwarding downward traffic.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-nbr.h"
+#include "net/ipv6/uip-ds6-route.h"
+#include "lib/random.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_ds6_route_process, "Routing table test");
+AUTOSTART_PROCESSES(&test_ds6_route_process);
+/*---------------------------------------------------------------------------*/
+#define NUM_NEXTHOPS     8
+#define NUM_HOSTS        (UIP_DS6_ROUTE_NB - 16)
+#define NUM_PREFIXES     16
+#define CHURN_ROUNDS     20000
+#define BENCH_PACKETS    1000000
+
+static uip_ipaddr_t nexthops[NUM_NEXTHOPS];
+static uip_ipaddr_t hosts[NUM_HOSTS];
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* Reference lookup: longest prefix match over the whole table */
+static uip_ds6_route_t *
+linear_lookup(const uip_ipaddr_t *addr)
+{
+  uip_ds6_route_t *r;
+  uip_ds6_route_t *found = NULL;
+
+  for(r = uip_ds6_route_head(); r != NULL; r = uip_ds6_route_next(r)) {
+    if((found == NULL || r->length > found->length) &&
+       uip_ipaddr_prefixcmp(addr, &r->ipaddr, r->length)) {
+      found = r;
+    }
+  }
+  return found;
+}
+/*---------------------------------------------------------------------------*/
+static void
+random_host(uip_ipaddr_t *addr)
+{
+  /* Hosts are spread over a few /64 prefixes */
+  uip_ip6addr(addr, 0xfd00, 0, 0, 1 + random_rand() % (NUM_PREFIXES / 2),
+              0x0212, 0x7400, random_rand(), random_rand());
+}
+/*---------------------------------------------------------------------------*/
+static void
+random_addr(uip_ipaddr_t *addr)
+{
+  /* Anywhere in the /53 that holds the prefixes */
+  uip_ip6addr(addr, 0xfd00, 0, 0, random_rand() % 0x800,
+              random_rand(), random_rand(), random_rand(), random_rand());
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_add_lookup, "Add and look up routes");
+UNIT_TEST(test_add_lookup)
+{
+  uip_ipaddr_t prefix;
+  uip_ds6_route_t *r;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < NUM_HOSTS; i++) {
+    random_host(&hosts[i]);
+    r = uip_ds6_route_add(&hosts[i], 128, &nexthops[i % NUM_NEXTHOPS]);
+    UNIT_TEST_ASSERT(r != NULL);
+  }
+  /* Prefix routes of different lengths: a /64 per host prefix, a /56
+     covering them and other /56s without hosts. They are added after
+     the more specific routes, as uip_ds6_route_add() replaces any
+     matching route that has another next hop. */
+  for(i = 0; i < NUM_PREFIXES / 2; i++) {
+    uip_ip6addr(&prefix, 0xfd00, 0, 0, i + 1, 0, 0, 0, 0);
+    r = uip_ds6_route_add(&prefix, 64, &nexthops[i % NUM_NEXTHOPS]);
+    UNIT_TEST_ASSERT(r != NULL);
+  }
+  for(i = 0; i < NUM_PREFIXES / 2; i++) {
+    uip_ip6addr(&prefix, 0xfd00, 0, 0, i << 8, 0, 0, 0, 0);
+    r = uip_ds6_route_add(&prefix, 56, &nexthops[(i + 1) % NUM_NEXTHOPS]);
+    UNIT_TEST_ASSERT(r != NULL);
+  }
+  UNIT_TEST_ASSERT(uip_ds6_route_num_routes() == NUM_HOSTS + NUM_PREFIXES);
+
+  for(i = 0; i < NUM_HOSTS; i++) {
+    r = uip_ds6_route_lookup(&hosts[i]);
+    UNIT_TEST_ASSERT(r != NULL);
+    UNIT_TEST_ASSERT(r->length == 128);
+    UNIT_TEST_ASSERT(uip_ipaddr_cmp(&r->ipaddr, &hosts[i]));
+    /* The route is moved first in the list */
+    UNIT_TEST_ASSERT(uip_ds6_route_head() == r);
+    UNIT_TEST_ASSERT(uip_ipaddr_cmp(uip_ds6_route_nexthop(r),
+                                    &nexthops[i % NUM_NEXTHOPS]));
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_churn, "Random add/remove/lookup");
+UNIT_TEST(test_churn)
+{
+  uip_ipaddr_t addr;
+  uip_ds6_route_t *r;
+  int i;
+  int n;
+
+  UNIT_TEST_BEGIN();
+
+  for(n = 0; n < CHURN_ROUNDS; n++) {
+    i = random_rand() % NUM_HOSTS;
+    switch(random_rand() % 4) {
+    case 0:
+      /* Remove a host route */
+      r = uip_ds6_route_lookup(&hosts[i]);
+      if(r != NULL && r->length == 128) {
+        uip_ds6_route_rm(r);
+      }
+      UNIT_TEST_ASSERT(uip_ds6_route_lookup(&hosts[i]) == linear_lookup(&hosts[i]));
+      break;
+    case 1:
+      /* Add a host route, which fails if the table is full */
+      random_host(&hosts[i]);
+      r = uip_ds6_route_add(&hosts[i], 128, &nexthops[n % NUM_NEXTHOPS]);
+      if(r == NULL) {
+        UNIT_TEST_ASSERT(uip_ds6_route_num_routes() == UIP_DS6_ROUTE_NB);
+      } else {
+        UNIT_TEST_ASSERT(uip_ds6_route_lookup(&hosts[i]) == r);
+      }
+      break;
+    default:
+      /* Look up a random address, known or not */
+      if(random_rand() % 2) {
+        uip_ipaddr_copy(&addr, &hosts[i]);
+      } else {
+        random_addr(&addr);
+      }
+      UNIT_TEST_ASSERT(uip_ds6_route_lookup(&addr) == linear_lookup(&addr));
+      break;
+    }
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  uip_ds6_route_t *r;
+  uint64_t start;
+  unsigned long found;
+  int i;
+
+  /* Fill the table with host routes */
+  while(uip_ds6_route_head() != NULL) {
+    uip_ds6_route_rm(uip_ds6_route_head());
+  }
+  for(i = 0; i < NUM_HOSTS; i++) {
+    random_host(&hosts[i]);
+    uip_ds6_route_add(&hosts[i], 128, &nexthops[i % NUM_NEXTHOPS]);
+  }
+
+  found = 0;
+  start = now_ns();
+  for(i = 0; i < BENCH_PACKETS; i++) {
+    r = uip_ds6_route_lookup(&hosts[random_rand() % NUM_HOSTS]);
+    found += r != NULL;
+  }
+  printf("Lookup with %d routes: %.1f ns per packet (%lu found)\n",
+         uip_ds6_route_num_routes(),
+         (double)(now_ns() - start) / BENCH_PACKETS, found);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_ds6_route_process, ev, data)
+{
+  uip_lladdr_t lladdr;
+  int i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with %u routes, hash index %u\n",
+         UIP_DS6_ROUTE_NB, UIP_DS6_ROUTE_WITH_HASH_INDEX);
+  printf("---\n");
+
+  for(i = 0; i < NUM_NEXTHOPS; i++) {
+    memset(&lladdr, 0, sizeof(lladdr));
+    lladdr.addr[0] = 0x02;
+    lladdr.addr[sizeof(lladdr) - 1] = i + 1;
+    uip_ip6addr(&nexthops[i], 0xfe80, 0, 0, 0, 0, 0, 0, i + 1);
+    uip_ds6_nbr_add(&nexthops[i], &lladdr, 1, NBR_REACHABLE,
+                    NBR_TABLE_REASON_UNDEFINED, NULL);
+  }
+
+  UNIT_TEST_RUN(test_add_lookup);
+  UNIT_TEST_RUN(test_churn);
+
+  benchmark();
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the event timer library with a large number
+ * of simultaneously running timers. Checks that the timers expire in
+ * order, that stopped timers do not expire, and reports the time
+ * spent setting and stopping timers.
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+#define NUM_TIMERS     2000
+#define MAX_INTERVAL   (2 * CLOCK_SECOND)
+/*---------------------------------------------------------------------------*/
+PROCESS(test_etimer_process, "Event timer test");
+AUTOSTART_PROCESSES(&test_etimer_process);
+/*---------------------------------------------------------------------------*/
+static struct etimer timers[NUM_TIMERS];
+static struct etimer timeout;
+static int failures;
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+static void
+check(int cond, const char *descr)
+{
+  printf("=check-me= %s - %s\n", cond ? "SUCCEEDED" : "FAILED", descr);
+  if(!cond) {
+    failures++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* The native clock does not wrap, so expiration times can be compared
+   directly. */
+static int
+next_expiration_is_min(void)
+{
+  int i;
+  int found = 0;
+  clock_time_t min = 0;
+
+  for(i = 0; i < NUM_TIMERS; i++) {
+    if(!etimer_expired(&timers[i]) &&
+       (!found || etimer_expiration_time(&timers[i]) < min)) {
+      min = etimer_expiration_time(&timers[i]);
+      found = 1;
+    }
+  }
+  return found && etimer_next_expiration_time() == min;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_etimer_process, ev, data)
+{
+  static int i;
+  static int expected;
+  static int fired;
+  static int out_of_order;
+  static int stopped_fired;
+  static clock_time_t last;
+  static uint64_t start;
+  struct etimer *et;
+
+  PROCESS_BEGIN();
+
+  printf("Run etimer test with %u timers\n", NUM_TIMERS);
+  printf("---\n");
+
+  start = now_ns();
+  for(i = 0; i < NUM_TIMERS; i++) {
+    etimer_set(&timers[i], 1 + random_rand() % MAX_INTERVAL);
+  }
+  printf("etimer_set: %lu ns per timer\n",
+         (unsigned long)((now_ns() - start) / NUM_TIMERS));
+  check(next_expiration_is_min(), "next expiration after set");
+
+  /* Re-arm every third timer with a new interval. */
+  start = now_ns();
+  for(i = 0; i < NUM_TIMERS; i += 3) {
+    etimer_reset_with_new_interval(&timers[i], 1 + random_rand() % MAX_INTERVAL);
+  }
+  printf("etimer_reset: %lu ns per timer\n",
+         (unsigned long)((now_ns() - start) / (NUM_TIMERS / 3 + 1)));
+  check(next_expiration_is_min(), "next expiration after reset");
+
+  /* Stop every fourth timer. */
+  expected = NUM_TIMERS;
+  start = now_ns();
+  for(i = 0; i < NUM_TIMERS; i += 4) {
+    etimer_stop(&timers[i]);
+    expected--;
+  }
+  printf("etimer_stop: %lu ns per timer\n",
+         (unsigned long)((now_ns() - start) / (NUM_TIMERS / 4)));
+  check(next_expiration_is_min(), "next expiration after stop");
+
+  start = now_ns();
+  for(i = 0; i < 100000; i++) {
+    last = etimer_next_expiration_time();
+  }
+  printf("etimer_next_expiration_time: %lu ns per call\n",
+         (unsigned long)((now_ns() - start) / 100000));
+
+  etimer_set(&timeout, MAX_INTERVAL + 2 * CLOCK_SECOND);
+  fired = 0;
+  last = 0;
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER);
+    et = data;
+    if(et == &timeout) {
+      break;
+    }
+    if(et >= timers && et < timers + NUM_TIMERS) {
+      if((et - timers) % 4 == 0) {
+        stopped_fired++;
+      }
+      if(fired > 0 && etimer_expiration_time(et) < last) {
+        out_of_order++;
+      }
+      last = etimer_expiration_time(et);
+      fired++;
+    }
+  }
+
+  check(fired == expected, "all running timers expired");
+  check(stopped_fired == 0, "no stopped timer expired");
+  check(out_of_order == 0, "timers expired in order");
+  check(!etimer_pending(), "no timer pending");
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,477 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the 802.15.4 frame parser. Every frame control
+ * field, followed by random bytes, is parsed by frame802154_parse() and
+ * by a reference parser that evaluates the PAN ID rules field by field,
+ * as the parser used to do. The two must agree, and frame802154_peek()
+ * must return the same addressing fields. The packets of the
+ * tests/20-packet-parsing corpus are then parsed raw, as fuzzing input,
+ * and as payloads of frames with various header layouts. The time to
+ * parse the corpus frames is measured last.
+ */
+
+#include "contiki.h"
+#include "net/mac/framer/frame802154.h"
+#include "net/mac/llsec802154.h"
+#include "lib/random.h"
+#include "services/unit-test/unit-test.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_frame802154_process, "802.15.4 frame parser test");
+AUTOSTART_PROCESSES(&test_frame802154_process);
+/*---------------------------------------------------------------------------*/
+#define CORPUS_DIR       "../20-packet-parsing/packet-injector"
+#define MAX_FRAME        127
+#define MAX_CORPUS       128
+#define MIN_CORPUS       50
+#define BODIES_PER_FCF   4
+#define BENCH_ROUNDS     20000
+
+struct header_layout {
+  uint8_t version;
+  uint8_t dest_mode;
+  uint8_t src_mode;
+  uint8_t seqno_suppression;
+  uint8_t panid_compression;
+  uint16_t dest_pid;
+  uint16_t src_pid;
+};
+
+/* Layouts used to wrap the corpus packets. The PAN ID compression bit
+   is only taken from here for frame version 2015. */
+static const struct header_layout layouts[] = {
+  { FRAME802154_IEEE802154_2006, FRAME802154_LONGADDRMODE,
+    FRAME802154_LONGADDRMODE, 0, 0, 0xabcd, 0xabcd },
+  { FRAME802154_IEEE802154_2006, FRAME802154_SHORTADDRMODE,
+    FRAME802154_LONGADDRMODE, 0, 0, 0xffff, 0xabcd },
+  { FRAME802154_IEEE802154_2006, FRAME802154_SHORTADDRMODE,
+    FRAME802154_SHORTADDRMODE, 0, 0, 0x1234, 0x5678 },
+  { FRAME802154_IEEE802154_2015, FRAME802154_LONGADDRMODE,
+    FRAME802154_LONGADDRMODE, 0, 1, 0xabcd, 0xabcd },
+  { FRAME802154_IEEE802154_2015, FRAME802154_NOADDR,
+    FRAME802154_LONGADDRMODE, 1, 0, 0xabcd, 0xabcd },
+  { FRAME802154_IEEE802154_2015, FRAME802154_SHORTADDRMODE,
+    FRAME802154_LONGADDRMODE, 1, 0, 0xabcd, 0xabcd },
+};
+#define NUM_LAYOUTS (sizeof(layouts) / sizeof(layouts[0]))
+
+struct corpus_frame {
+  uint8_t data[MAX_FRAME];
+  uint8_t len;
+  uint8_t hdr_len;
+};
+
+static struct corpus_frame corpus[MAX_CORPUS * NUM_LAYOUTS];
+static int corpus_frames;
+static int corpus_files;
+static int failures;
+static volatile unsigned bench_sink;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+static void
+reference_addr(uint8_t *addr, const uint8_t *p, uint8_t mode)
+{
+  int c;
+
+  linkaddr_copy((linkaddr_t *)addr, &linkaddr_null);
+  if(mode == FRAME802154_SHORTADDRMODE) {
+    addr[0] = p[1];
+    addr[1] = p[0];
+  } else if(mode == FRAME802154_LONGADDRMODE) {
+    for(c = 0; c < 8; c++) {
+      addr[c] = p[7 - c];
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Field-by-field parser, checked against the frame802154_parse() output */
+static int
+reference_parse(uint8_t *data, int len, frame802154_t *pf)
+{
+  uint8_t *p;
+  int has_src_panid;
+  int has_dest_panid;
+  int c;
+
+  if(len < 2) {
+    return 0;
+  }
+
+  frame802154_parse_fcf(data, &pf->fcf);
+  p = data + 2;
+
+  if(pf->fcf.sequence_number_suppression == 0) {
+    pf->seq = *p++;
+  }
+
+  frame802154_has_panid(&pf->fcf, &has_src_panid, &has_dest_panid);
+
+  pf->dest_pid = 0;
+  if(pf->fcf.dest_addr_mode) {
+    if(has_dest_panid) {
+      pf->dest_pid = p[0] + (p[1] << 8);
+      p += 2;
+    }
+    reference_addr(pf->dest_addr, p, pf->fcf.dest_addr_mode);
+    p += pf->fcf.dest_addr_mode == FRAME802154_LONGADDRMODE ? 8 :
+      pf->fcf.dest_addr_mode == FRAME802154_SHORTADDRMODE ? 2 : 0;
+  } else {
+    reference_addr(pf->dest_addr, p, FRAME802154_NOADDR);
+  }
+
+  pf->src_pid = 0;
+  if(pf->fcf.src_addr_mode) {
+    if(has_src_panid) {
+      pf->src_pid = p[0] + (p[1] << 8);
+      p += 2;
+      if(!has_dest_panid) {
+        pf->dest_pid = pf->src_pid;
+      }
+    } else {
+      pf->src_pid = pf->dest_pid;
+    }
+    reference_addr(pf->src_addr, p, pf->fcf.src_addr_mode);
+    p += pf->fcf.src_addr_mode == FRAME802154_LONGADDRMODE ? 8 :
+      pf->fcf.src_addr_mode == FRAME802154_SHORTADDRMODE ? 2 : 0;
+  } else {
+    reference_addr(pf->src_addr, p, FRAME802154_NOADDR);
+  }
+
+#if LLSEC802154_USES_AUX_HEADER
+  if(pf->fcf.security_enabled) {
+    pf->aux_hdr.security_control.security_level = p[0] & 7;
+#if LLSEC802154_USES_EXPLICIT_KEYS
+    pf->aux_hdr.security_control.key_id_mode = (p[0] >> 3) & 3;
+#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
+    pf->aux_hdr.security_control.frame_counter_suppression = p[0] >> 5;
+    pf->aux_hdr.security_control.frame_counter_size = p[0] >> 6;
+    p++;
+    if(pf->aux_hdr.security_control.frame_counter_suppression == 0) {
+      memcpy(pf->aux_hdr.frame_counter.u8, p, 4);
+      p += 4 + (pf->aux_hdr.security_control.frame_counter_size == 1);
+    }
+#if LLSEC802154_USES_EXPLICIT_KEYS
+    if(pf->aux_hdr.security_control.key_id_mode) {
+      c = (pf->aux_hdr.security_control.key_id_mode - 1) * 4;
+      memcpy(pf->aux_hdr.key_source.u8, p, c);
+      p += c;
+      pf->aux_hdr.key_index = *p++;
+    }
+#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
+  }
+#endif /* LLSEC802154_USES_AUX_HEADER */
+
+  c = p - data;
+  pf->payload_len = len - c;
+  pf->payload = p;
+  return c > len ? 0 : c;
+}
+/*---------------------------------------------------------------------------*/
+static int
+same_addressing(const frame802154_t *a, const frame802154_t *b)
+{
+  return memcmp(&a->fcf, &b->fcf, sizeof(a->fcf)) == 0 &&
+    (a->fcf.sequence_number_suppression || a->seq == b->seq) &&
+    a->dest_pid == b->dest_pid && a->src_pid == b->src_pid &&
+    memcmp(a->dest_addr, b->dest_addr, sizeof(a->dest_addr)) == 0 &&
+    memcmp(a->src_addr, b->src_addr, sizeof(a->src_addr)) == 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Parses a frame with both parsers and with frame802154_peek(), and
+   returns 1 when they all agree */
+static int
+check_frame(uint8_t *data, int len)
+{
+  frame802154_t frame;
+  frame802154_t reference;
+  frame802154_t peeked;
+  int ret;
+  int ref_ret;
+  int peek_ret;
+
+  memset(&frame, 0, sizeof(frame));
+  memset(&reference, 0, sizeof(reference));
+  memset(&peeked, 0, sizeof(peeked));
+
+  ret = frame802154_parse(data, len, &frame);
+  ref_ret = reference_parse(data, len, &reference);
+  peek_ret = frame802154_peek(data, len, &peeked);
+
+  if(ret != ref_ret) {
+    printf("FCF %02x%02x len %d: parse %d, reference %d\n",
+           data[0], data[1], len, ret, ref_ret);
+    return 0;
+  }
+  if(ret == 0) {
+    return 1;
+  }
+  if(!same_addressing(&frame, &reference) ||
+     memcmp(&frame.aux_hdr, &reference.aux_hdr, sizeof(frame.aux_hdr)) ||
+     frame.payload != reference.payload ||
+     frame.payload_len != reference.payload_len) {
+    printf("FCF %02x%02x len %d: fields differ from the reference\n",
+           data[0], data[1], len);
+    return 0;
+  }
+  if(peek_ret == 0 || peek_ret > ret || !same_addressing(&peeked, &frame)) {
+    printf("FCF %02x%02x len %d: peek differs from parse\n",
+           data[0], data[1], len);
+    return 0;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+load_corpus(const char *dirname)
+{
+  struct dirent *entry;
+  char path[512];
+  uint8_t packet[MAX_FRAME];
+  frame802154_t frame;
+  struct corpus_frame *cf;
+  FILE *f;
+  DIR *dir;
+  int payload_len;
+  int len;
+  int i;
+
+  dir = opendir(dirname);
+  if(dir == NULL) {
+    printf("cannot open %s\n", dirname);
+    return 0;
+  }
+
+  while((entry = readdir(dir)) != NULL && corpus_files < MAX_CORPUS) {
+    if(entry->d_name[0] == '.') {
+      continue;
+    }
+    snprintf(path, sizeof(path), "%s/%s", dirname, entry->d_name);
+    f = fopen(path, "rb");
+    if(f == NULL) {
+      continue;
+    }
+    len = fread(packet, 1, sizeof(packet), f);
+    fclose(f);
+    corpus_files++;
+
+    /* The raw packet, as fuzzing input */
+    if(!check_frame(packet, len)) {
+      closedir(dir);
+      return 0;
+    }
+
+    /* The packet as the payload of frames with each header layout */
+    for(i = 0; i < NUM_LAYOUTS; i++) {
+      cf = &corpus[corpus_frames++];
+      memset(&frame, 0, sizeof(frame));
+      frame.fcf.frame_type = FRAME802154_DATAFRAME;
+      frame.fcf.frame_version = layouts[i].version;
+      frame.fcf.dest_addr_mode = layouts[i].dest_mode;
+      frame.fcf.src_addr_mode = layouts[i].src_mode;
+      frame.fcf.sequence_number_suppression = layouts[i].seqno_suppression;
+      frame.fcf.panid_compression = layouts[i].panid_compression;
+      frame.seq = corpus_frames;
+      frame.dest_pid = layouts[i].dest_pid;
+      frame.src_pid = layouts[i].src_pid;
+      memset(frame.dest_addr, 0xff, sizeof(frame.dest_addr));
+      random_init(corpus_frames);
+      for(payload_len = 0; payload_len < 8; payload_len++) {
+        frame.dest_addr[payload_len] = random_rand();
+        frame.src_addr[payload_len] = random_rand();
+      }
+#if LLSEC802154_USES_AUX_HEADER
+      frame.fcf.security_enabled = i & 1;
+      frame.aux_hdr.security_control.security_level =
+        FRAME802154_SECURITY_LEVEL_ENC_MIC_32;
+      frame.aux_hdr.frame_counter.u32 = random_rand();
+#if LLSEC802154_USES_EXPLICIT_KEYS
+      frame.aux_hdr.security_control.key_id_mode = i % 4;
+      frame.aux_hdr.key_index = i;
+#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
+#endif /* LLSEC802154_USES_AUX_HEADER */
+
+      cf->hdr_len = frame802154_create(&frame, cf->data);
+      payload_len = MIN(len, MAX_FRAME - cf->hdr_len);
+      memcpy(cf->data + cf->hdr_len, packet, payload_len);
+      cf->len = cf->hdr_len + payload_len;
+
+      if(!check_frame(cf->data, cf->len)) {
+        closedir(dir);
+        return 0;
+      }
+    }
+  }
+
+  closedir(dir);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_all_fcf, "Parse every frame control field");
+UNIT_TEST(test_all_fcf)
+{
+  uint8_t buf[MAX_FRAME];
+  uint32_t fcf;
+  int body;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  random_init(1);
+  for(fcf = 0; fcf <= 0xffff; fcf++) {
+    for(body = 0; body < BODIES_PER_FCF; body++) {
+      buf[0] = fcf & 0xff;
+      buf[1] = fcf >> 8;
+      for(i = 2; i < sizeof(buf); i++) {
+        buf[i] = random_rand();
+      }
+      /* Full length, and lengths around the end of the addressing fields */
+      UNIT_TEST_ASSERT(check_frame(buf, sizeof(buf)));
+      UNIT_TEST_ASSERT(check_frame(buf, body * 7));
+    }
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_corpus, "Parse the packet corpus");
+UNIT_TEST(test_corpus)
+{
+  frame802154_t frame;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(load_corpus(CORPUS_DIR "/sicslowpan-data"));
+  UNIT_TEST_ASSERT(load_corpus(CORPUS_DIR "/uip-data"));
+  printf("%d corpus packets, %d frames\n", corpus_files, corpus_frames);
+  UNIT_TEST_ASSERT(corpus_files >= MIN_CORPUS);
+
+  /* The header lengths returned by parse and create must agree */
+  for(i = 0; i < corpus_frames; i++) {
+    UNIT_TEST_ASSERT(frame802154_parse(corpus[i].data, corpus[i].len,
+                                       &frame) == corpus[i].hdr_len);
+    UNIT_TEST_ASSERT(frame.payload_len == corpus[i].len - corpus[i].hdr_len);
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  frame802154_t frame;
+  uint64_t start;
+  uint64_t ns;
+  unsigned sum;
+  int round;
+  int i;
+
+  if(corpus_frames == 0) {
+    return;
+  }
+
+  sum = 0;
+  start = now_ns();
+  for(round = 0; round < BENCH_ROUNDS; round++) {
+    for(i = 0; i < corpus_frames; i++) {
+      sum += frame802154_parse(corpus[i].data, corpus[i].len, &frame);
+    }
+  }
+  ns = now_ns() - start;
+  printf("frame802154_parse: %.1f ns per frame\n",
+         (double)ns / BENCH_ROUNDS / corpus_frames);
+
+  start = now_ns();
+  for(round = 0; round < BENCH_ROUNDS; round++) {
+    for(i = 0; i < corpus_frames; i++) {
+      sum += frame802154_peek(corpus[i].data, corpus[i].len, &frame);
+    }
+  }
+  ns = now_ns() - start;
+  printf("frame802154_peek: %.1f ns per frame\n",
+         (double)ns / BENCH_ROUNDS / corpus_frames);
+
+  start = now_ns();
+  for(round = 0; round < BENCH_ROUNDS; round++) {
+    for(i = 0; i < corpus_frames; i++) {
+      sum += reference_parse(corpus[i].data, corpus[i].len, &frame);
+    }
+  }
+  ns = now_ns() - start;
+  printf("reference parser: %.1f ns per frame\n",
+         (double)ns / BENCH_ROUNDS / corpus_frames);
+  bench_sink = sum;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_frame802154_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(test_all_fcf);
+  UNIT_TEST_RUN(test_corpus);
+
+  benchmark();
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
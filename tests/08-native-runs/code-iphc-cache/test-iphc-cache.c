@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the IPHC compression cache. UDP datagrams of
+ * several flows, with varying hop limits, are compressed by sicslowpan
+ * output and fed back to sicslowpan input through a loopback MAC. Every
+ * datagram must reach the UDP socket with its headers intact. The time
+ * per compression is then measured for flows that fit the cache.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/simple-udp.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/sicslowpan.h"
+#include "net/mac/mac.h"
+#include "net/packetbuf.h"
+#include "lib/random.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_iphc_cache_process, "IPHC cache test");
+AUTOSTART_PROCESSES(&test_iphc_cache_process);
+/*---------------------------------------------------------------------------*/
+/* One port compresses to 4 bits together with 0xf0bX source ports, the
+   other one is not compressible */
+#define UDP_PORT_A       0xf0b0
+#define UDP_PORT_B       5678
+#define NUM_FLOWS        8
+#define BENCH_FLOWS      4
+#define PAYLOAD_LEN      32
+#define FUZZ_ROUNDS      5000
+#define BENCH_ROUNDS     1000000
+#define MAX_FRAME        127
+
+struct flow {
+  uip_ipaddr_t src;
+  uip_ipaddr_t dst;
+  uint16_t srcport;
+  uint16_t destport;
+  uint8_t tc;
+};
+
+static struct flow flows[NUM_FLOWS];
+static struct simple_udp_connection conn_a;
+static struct simple_udp_connection conn_b;
+static uint8_t frame[MAX_FRAME];
+static uint16_t frame_len;
+static int received;
+static int corrupted;
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* A MAC layer that keeps the last frame sent */
+static void
+init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static void
+send(mac_callback_t sent, void *ptr)
+{
+  frame_len = packetbuf_datalen();
+  memcpy(frame, packetbuf_dataptr(), frame_len);
+  mac_call_sent_callback(sent, ptr, MAC_TX_OK, 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+input(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+max_payload(void)
+{
+  return MAX_FRAME - 2 - 21;
+}
+/*---------------------------------------------------------------------------*/
+const struct mac_driver test_mac_driver = {
+  "Test MAC",
+  init,
+  send,
+  input,
+  on,
+  off,
+  max_payload,
+};
+/*---------------------------------------------------------------------------*/
+static void
+udp_rx_callback(struct simple_udp_connection *c,
+                const uip_ipaddr_t *sender_addr,
+                uint16_t sender_port,
+                const uip_ipaddr_t *receiver_addr,
+                uint16_t receiver_port,
+                const uint8_t *data,
+                uint16_t datalen)
+{
+  struct flow *f;
+  uint16_t i;
+
+  received++;
+  if(datalen != PAYLOAD_LEN || data[0] >= NUM_FLOWS) {
+    corrupted++;
+    return;
+  }
+  f = &flows[data[0]];
+  if(!uip_ipaddr_cmp(sender_addr, &f->src) ||
+     !uip_ipaddr_cmp(receiver_addr, &f->dst) ||
+     sender_port != f->srcport || receiver_port != f->destport ||
+     UIP_IP_BUF->ttl != data[3] ||
+     ((UIP_IP_BUF->vtc & 0x0f) << 4 | UIP_IP_BUF->tcflow >> 4) != f->tc) {
+    corrupted++;
+    return;
+  }
+  for(i = 4; i < datalen; i++) {
+    if(data[i] != (uint8_t)(data[1] + data[2] + i)) {
+      corrupted++;
+      return;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+init_flows(void)
+{
+  const uip_ipaddr_t *lladdr = &uip_ds6_get_link_local(-1)->ipaddr;
+  uip_ipaddr_t global;
+  struct flow *f;
+  int i;
+
+  uip_ip6addr(&global, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&global, &uip_lladdr);
+  uip_ds6_addr_add(&global, 0, ADDR_AUTOCONF);
+
+  for(i = 0; i < NUM_FLOWS; i++) {
+    f = &flows[i];
+    /* Source IIDs derived from our link-layer address, or inline, with
+       and without a context for the prefix */
+    if(i % 4 == 0) {
+      uip_ipaddr_copy(&f->src, lladdr);
+    } else if(i % 2 == 1) {
+      uip_ip6addr(&f->src, 0xfe80, 0, 0, 0, 0, 0, 0, i + 1);
+    } else {
+      uip_ip6addr(&f->src, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, i + 1);
+    }
+    uip_ipaddr_copy(&f->dst, i % 3 == 0 ? &global : lladdr);
+    switch(i % 4) {
+    case 0:
+      f->srcport = 0xf0b1 + i;
+      f->destport = UDP_PORT_A;
+      break;
+    case 1:
+      f->srcport = 1000 + i;
+      f->destport = UDP_PORT_A;
+      break;
+    case 2:
+      f->srcport = 0xf010 + i;
+      f->destport = UDP_PORT_B;
+      break;
+    default:
+      f->srcport = 1000 + i;
+      f->destport = UDP_PORT_B;
+      break;
+    }
+    f->tc = i % 2 ? 0 : 0x20 + i;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Build a datagram of flow i in uip_buf, as uip6.c would send it */
+static void
+make_datagram(uint8_t i, uint16_t seq, uint8_t ttl)
+{
+  struct flow *f = &flows[i];
+  uint8_t *payload = uip_buf + UIP_IPUDPH_LEN;
+  uint16_t n;
+
+  uipbuf_clear();
+  memset(uip_buf, 0, UIP_IPUDPH_LEN);
+  UIP_IP_BUF->vtc = 0x60 | (f->tc >> 4);
+  UIP_IP_BUF->tcflow = f->tc << 4;
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = ttl;
+  uipbuf_set_len_field(UIP_IP_BUF, UIP_UDPH_LEN + PAYLOAD_LEN);
+  uip_ipaddr_copy(&UIP_IP_BUF->srcipaddr, &f->src);
+  uip_ipaddr_copy(&UIP_IP_BUF->destipaddr, &f->dst);
+  UIP_UDP_BUF->srcport = UIP_HTONS(f->srcport);
+  UIP_UDP_BUF->destport = UIP_HTONS(f->destport);
+  UIP_UDP_BUF->udplen = UIP_HTONS(UIP_UDPH_LEN + PAYLOAD_LEN);
+  payload[0] = i;
+  payload[1] = seq >> 8;
+  payload[2] = seq & 0xff;
+  payload[3] = ttl;
+  for(n = 4; n < PAYLOAD_LEN; n++) {
+    payload[n] = (uint8_t)(payload[1] + payload[2] + n);
+  }
+  uip_len = UIP_IPUDPH_LEN + PAYLOAD_LEN;
+  uip_ext_len = 0;
+  UIP_UDP_BUF->udpchksum = ~(uip_udpchksum());
+  if(UIP_UDP_BUF->udpchksum == 0) {
+    UIP_UDP_BUF->udpchksum = 0xffff;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+random_ttl(uint8_t i)
+{
+  static const uint8_t ttls[] = { 1, 64, 255, 17, 200 };
+
+  return ttls[(random_rand() + i) % sizeof(ttls)];
+}
+/*---------------------------------------------------------------------------*/
+static void
+loopback(void)
+{
+  packetbuf_clear();
+  packetbuf_copyfrom(frame, frame_len);
+  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &linkaddr_node_addr);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &linkaddr_node_addr);
+  sicslowpan_driver.input();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_roundtrip, "Compressed headers of cached flows");
+UNIT_TEST(test_roundtrip)
+{
+  const struct sicslowpan_iphc_cache_stats *stats;
+  uint8_t i;
+  int round;
+
+  UNIT_TEST_BEGIN();
+
+  sicslowpan_iphc_cache_flush();
+  received = 0;
+  corrupted = 0;
+  for(round = 0; round < FUZZ_ROUNDS; round++) {
+    i = random_rand() % NUM_FLOWS;
+    make_datagram(i, round, random_ttl(i));
+    frame_len = 0;
+    UNIT_TEST_ASSERT(sicslowpan_driver.output(&linkaddr_node_addr) != 0);
+    UNIT_TEST_ASSERT(frame_len > 0);
+    loopback();
+  }
+  UNIT_TEST_ASSERT(received == FUZZ_ROUNDS);
+  UNIT_TEST_ASSERT(corrupted == 0);
+
+  stats = sicslowpan_iphc_cache_get_stats();
+  printf("Cache hits %lu, misses %lu\n",
+         (unsigned long)stats->hits, (unsigned long)stats->misses);
+  if(SICSLOWPAN_CONF_IPHC_CACHE_SIZE > 0) {
+    UNIT_TEST_ASSERT(stats->hits + stats->misses == FUZZ_ROUNDS);
+    UNIT_TEST_ASSERT(stats->hits > 0);
+  } else {
+    UNIT_TEST_ASSERT(stats->hits == 0);
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  static uint8_t packets[BENCH_FLOWS][UIP_IPUDPH_LEN + PAYLOAD_LEN];
+  const struct sicslowpan_iphc_cache_stats *stats;
+  uint64_t start;
+  uint64_t ns;
+  int round;
+  int i;
+
+  for(i = 0; i < BENCH_FLOWS; i++) {
+    make_datagram(i, 0, 64);
+    memcpy(packets[i], uip_buf, sizeof(packets[i]));
+  }
+
+  sicslowpan_iphc_cache_flush();
+  start = now_ns();
+  for(round = 0; round < BENCH_ROUNDS; round++) {
+    i = round % BENCH_FLOWS;
+    memcpy(uip_buf, packets[i], sizeof(packets[i]));
+    uip_len = sizeof(packets[i]);
+    sicslowpan_driver.output(&linkaddr_node_addr);
+  }
+  ns = now_ns() - start;
+
+  stats = sicslowpan_iphc_cache_get_stats();
+  printf("Compression of %d flows: %.1f ns per packet (hits %lu, misses %lu)\n",
+         BENCH_FLOWS, (double)ns / BENCH_ROUNDS,
+         (unsigned long)stats->hits, (unsigned long)stats->misses);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_iphc_cache_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with IPHC cache size %u\n",
+         SICSLOWPAN_CONF_IPHC_CACHE_SIZE);
+  printf("---\n");
+
+  sicslowpan_driver.init();
+  init_flows();
+  simple_udp_register(&conn_a, UDP_PORT_A, NULL, 0, udp_rx_callback);
+  simple_udp_register(&conn_b, UDP_PORT_B, NULL, 0, udp_rx_callback);
+
+  UNIT_TEST_RUN(test_roundtrip);
+
+  benchmark();
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the multicast routing table and duplicate filter.
+ * Routes for a few hundred groups are added, looked up and removed, the
+ * duplicate filter is checked for false positives, and duplicates are fed
+ * to the ROLL TM engine. The lookup cost and the hit rates are printed.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/multicast/uip-mcast6.h"
+#include "net/ipv6/multicast/uip-mcast6-route.h"
+#include "net/ipv6/multicast/uip-mcast6-stats.h"
+#include "net/ipv6/multicast/uip-mcast6-dup.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_mcast6_fastpath_process, "Multicast fast path test");
+AUTOSTART_PROCESSES(&test_mcast6_fastpath_process);
+/*---------------------------------------------------------------------------*/
+#define NUM_GROUPS       200
+#define BENCH_ROUNDS     2000
+#define HBHO_LEN         8
+#define UDP_LEN          12
+
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+static void
+group_addr(uip_ipaddr_t *addr, int i)
+{
+  uip_ip6addr(addr, 0xff05, 0, 0, 0, 0, 0, i >> 8, 0x1000 + (i & 0xff));
+}
+/*---------------------------------------------------------------------------*/
+/* Build a ROLL TM data message to ff03::fc with the seed as source */
+static void
+prepare_packet(uint16_t seed, uint16_t seq)
+{
+  uint8_t *hbho;
+  uint8_t *udp;
+
+  memset(uip_buf, 0, UIP_IPH_LEN + HBHO_LEN + UDP_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->proto = UIP_PROTO_HBHO;
+  UIP_IP_BUF->ttl = 64;
+  uip_ip6addr(&UIP_IP_BUF->srcipaddr, 0xfe80, 0, 0, 0, 0x0212, 0x7400, 0, seed);
+  uip_ip6addr(&UIP_IP_BUF->destipaddr, 0xff03, 0, 0, 0, 0, 0, 0, 0xfc);
+  uipbuf_set_len_field(UIP_IP_BUF, HBHO_LEN + UDP_LEN);
+
+  hbho = uip_buf + UIP_IPH_LEN;
+  hbho[0] = UIP_PROTO_UDP;
+  hbho[1] = 0;
+  hbho[2] = 0x0c; /* Trickle option */
+  hbho[3] = 2;
+  hbho[4] = 0x80 | (seq >> 8); /* M=1 */
+  hbho[5] = seq & 0xff;
+  hbho[6] = 1; /* PadN */
+  hbho[7] = 0;
+
+  udp = hbho + HBHO_LEN;
+  udp[1] = 1;
+  udp[3] = 2;
+  udp[5] = UDP_LEN;
+
+  uip_len = UIP_IPH_LEN + HBHO_LEN + UDP_LEN;
+  uip_ext_len = 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+inject(uint16_t seed, uint16_t seq)
+{
+  prepare_packet(seed, seq);
+  return UIP_MCAST6.in();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_routes, "Multicast routes");
+UNIT_TEST(test_routes)
+{
+  uip_ipaddr_t group;
+  uip_mcast6_route_t *r;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  uip_mcast6_route_init();
+  for(i = 0; i < NUM_GROUPS; i++) {
+    group_addr(&group, i);
+    r = uip_mcast6_route_add(&group);
+    UNIT_TEST_ASSERT(r != NULL);
+    UNIT_TEST_ASSERT(uip_ipaddr_cmp(&r->group, &group));
+    /* Adding it again returns the same route */
+    UNIT_TEST_ASSERT(uip_mcast6_route_add(&group) == r);
+  }
+  UNIT_TEST_ASSERT(uip_mcast6_route_count() == NUM_GROUPS);
+
+  for(i = 0; i < NUM_GROUPS; i++) {
+    group_addr(&group, i);
+    r = uip_mcast6_route_lookup(&group);
+    UNIT_TEST_ASSERT(r != NULL && uip_ipaddr_cmp(&r->group, &group));
+  }
+  group_addr(&group, NUM_GROUPS);
+  UNIT_TEST_ASSERT(uip_mcast6_route_lookup(&group) == NULL);
+
+  /* Remove every third group, the others must still be found */
+  for(i = 0; i < NUM_GROUPS; i += 3) {
+    group_addr(&group, i);
+    uip_mcast6_route_rm(uip_mcast6_route_lookup(&group));
+  }
+  for(i = 0; i < NUM_GROUPS; i++) {
+    group_addr(&group, i);
+    r = uip_mcast6_route_lookup(&group);
+    UNIT_TEST_ASSERT((i % 3 == 0) == (r == NULL));
+  }
+
+  /* And added again */
+  for(i = 0; i < NUM_GROUPS; i += 3) {
+    group_addr(&group, i);
+    UNIT_TEST_ASSERT(uip_mcast6_route_add(&group) != NULL);
+  }
+  for(i = 0; i < NUM_GROUPS; i++) {
+    group_addr(&group, i);
+    r = uip_mcast6_route_lookup(&group);
+    UNIT_TEST_ASSERT(r != NULL && uip_ipaddr_cmp(&r->group, &group));
+  }
+  UNIT_TEST_ASSERT(uip_mcast6_route_count() == NUM_GROUPS);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_dup_filter, "Duplicate filter");
+UNIT_TEST(test_dup_filter)
+{
+#if UIP_MCAST6_DUP_FILTER
+  static uint8_t origins[4];
+  int hits;
+  int o;
+  int seq;
+#endif /* UIP_MCAST6_DUP_FILTER */
+
+  UNIT_TEST_BEGIN();
+
+#if UIP_MCAST6_DUP_FILTER
+  uip_mcast6_dup_init();
+  UNIT_TEST_ASSERT(!uip_mcast6_dup_check(&origins[0], 1));
+
+  /* As many pairs as entries, most of which are remembered */
+  hits = 0;
+  for(seq = 0; seq < UIP_MCAST6_DUP_FILTER_ENTRIES / 4; seq++) {
+    for(o = 0; o < 4; o++) {
+      uip_mcast6_dup_add(&origins[o], seq);
+    }
+  }
+  for(seq = 0; seq < UIP_MCAST6_DUP_FILTER_ENTRIES / 4; seq++) {
+    for(o = 0; o < 4; o++) {
+      hits += uip_mcast6_dup_check(&origins[o], seq);
+      /* Never a pair that was not added */
+      UNIT_TEST_ASSERT(!uip_mcast6_dup_check(&origins[o], seq + 1000));
+    }
+  }
+  printf("Filter: %d of %d pairs remembered\n", hits,
+         UIP_MCAST6_DUP_FILTER_ENTRIES);
+  UNIT_TEST_ASSERT(hits >= UIP_MCAST6_DUP_FILTER_ENTRIES / 2);
+
+  /* Removed pairs are forgotten, and the last added one is always known */
+  for(seq = 0; seq < UIP_MCAST6_DUP_FILTER_ENTRIES / 4; seq++) {
+    uip_mcast6_dup_remove(&origins[1], seq);
+    UNIT_TEST_ASSERT(!uip_mcast6_dup_check(&origins[1], seq));
+  }
+  for(seq = 0; seq < 10 * UIP_MCAST6_DUP_FILTER_ENTRIES; seq++) {
+    uip_mcast6_dup_add(&origins[2], seq);
+    UNIT_TEST_ASSERT(uip_mcast6_dup_check(&origins[2], seq));
+  }
+  for(seq = 0; seq < UIP_MCAST6_DUP_FILTER_ENTRIES / 4; seq++) {
+    UNIT_TEST_ASSERT(!uip_mcast6_dup_check(&origins[1], seq));
+  }
+  uip_mcast6_dup_init();
+#endif /* UIP_MCAST6_DUP_FILTER */
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_roll_tm, "ROLL TM duplicates");
+UNIT_TEST(test_roll_tm)
+{
+  UIP_MCAST6_STATS_DATATYPE dup_hits;
+  uip_ipaddr_t group;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  uip_ip6addr(&group, 0xff03, 0, 0, 0, 0, 0, 0, 0xfc);
+  UNIT_TEST_ASSERT(uip_ds6_maddr_add(&group) != NULL);
+  dup_hits = UIP_MCAST6_STATS_GET(dup_hits);
+
+  UNIT_TEST_ASSERT(inject(1, 1) == UIP_MCAST6_ACCEPT);
+  UNIT_TEST_ASSERT(inject(1, 2) == UIP_MCAST6_ACCEPT);
+  UNIT_TEST_ASSERT(inject(1, 3) == UIP_MCAST6_ACCEPT);
+  UNIT_TEST_ASSERT(inject(2, 10) == UIP_MCAST6_ACCEPT);
+  UNIT_TEST_ASSERT(inject(2, 11) == UIP_MCAST6_ACCEPT);
+
+  for(i = 0; i < 10; i++) {
+    UNIT_TEST_ASSERT(inject(1, 2) == UIP_MCAST6_DROP);
+    UNIT_TEST_ASSERT(inject(2, 10) == UIP_MCAST6_DROP);
+  }
+  /* Older than the lower bound of the window */
+  UNIT_TEST_ASSERT(inject(1, 0) == UIP_MCAST6_DROP);
+  UNIT_TEST_ASSERT(inject(2, 12) == UIP_MCAST6_ACCEPT);
+
+  /* The filter knows every buffered message */
+  UNIT_TEST_ASSERT(UIP_MCAST6_STATS_GET(dup_hits) - dup_hits ==
+                   (UIP_MCAST6_DUP_FILTER ? 20 : 0));
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  static uip_ipaddr_t groups[NUM_GROUPS];
+  uint64_t t;
+  int found;
+  int r;
+  int i;
+
+  for(i = 0; i < NUM_GROUPS; i++) {
+    group_addr(&groups[i], i);
+  }
+
+  found = 0;
+  t = now_ns();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    for(i = 0; i < NUM_GROUPS; i++) {
+      found += uip_mcast6_route_lookup(&groups[i]) != NULL;
+    }
+  }
+  t = now_ns() - t;
+
+  printf("Bench: %d groups, %d found: %.1f ns per lookup\n", NUM_GROUPS,
+         found / BENCH_ROUNDS, (double)t / BENCH_ROUNDS / NUM_GROUPS);
+
+  t = now_ns();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    inject(1, 1 + r % 3);
+  }
+  t = now_ns() - t;
+
+  printf("Bench: ROLL TM duplicates: %.1f ns per packet\n",
+         (double)t / BENCH_ROUNDS);
+}
+/*---------------------------------------------------------------------------*/
+static void
+print_hit_rates(void)
+{
+  printf("Routes: %lu lookups, %lu hits\n",
+         (unsigned long)UIP_MCAST6_STATS_GET(route_lookups),
+         (unsigned long)UIP_MCAST6_STATS_GET(route_hits));
+  printf("Duplicate filter: %lu lookups, %lu hits\n",
+         (unsigned long)UIP_MCAST6_STATS_GET(dup_lookups),
+         (unsigned long)UIP_MCAST6_STATS_GET(dup_hits));
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_mcast6_fastpath_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with route hash index %u, duplicate filter %u\n",
+         UIP_MCAST6_ROUTE_CONF_WITH_HASH_INDEX, UIP_MCAST6_DUP_FILTER);
+  printf("---\n");
+
+  UNIT_TEST_RUN(test_routes);
+  UNIT_TEST_RUN(test_dup_filter);
+  UNIT_TEST_RUN(test_roll_tm);
+
+  benchmark();
+  print_hit_rates();
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
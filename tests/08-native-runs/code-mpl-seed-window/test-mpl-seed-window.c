@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the MPL seed sets. Data messages from a few seeds
+ * are fed to the engine, the accept and drop decisions and the seed info
+ * of the control messages it sends are checked, including after buffered
+ * messages are reclaimed, and the cost of dropping duplicates is measured.
+ */
+
+#include "contiki.h"
+#include "net/netstack.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uip-icmp6.h"
+#include "net/ipv6/multicast/uip-mcast6.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_mpl_seed_window_process, "MPL seed window test");
+AUTOSTART_PROCESSES(&test_mpl_seed_window_process);
+/*---------------------------------------------------------------------------*/
+#define SEED_A           1
+#define SEED_B           2
+#define STREAM_SEEDS     3
+#define STREAM_LEN       3000
+#define STREAM_MAX_SEQ   240
+#define BENCH_ROUNDS     200000
+#define HBHO_LEN         8
+#define UDP_LEN          12
+#define CTRL_MAX_LEN     512
+
+static int failures;
+static uint8_t ctrl[CTRL_MAX_LEN];
+static uint16_t ctrl_len;
+static unsigned ctrl_count;
+static uint32_t digest;
+static uint32_t rand_state = 1;
+/* Sequence numbers sent by each seed of the stream, in order */
+static uint8_t history[STREAM_SEEDS][STREAM_MAX_SEQ];
+static int history_len[STREAM_SEEDS];
+static int history_full[STREAM_SEEDS];
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+next_rand(void)
+{
+  rand_state = rand_state * 1103515245 + 12345;
+  return rand_state >> 16;
+}
+/*---------------------------------------------------------------------------*/
+static void
+digest_add(uint8_t b)
+{
+  digest = (digest ^ b) * 16777619;
+}
+/*---------------------------------------------------------------------------*/
+/* Keep the payload of the control messages sent, and drop all packets */
+static enum netstack_ip_action
+capture_output(const linkaddr_t *localdest)
+{
+  if(UIP_IP_BUF->proto == UIP_PROTO_ICMP6
+     && UIP_ICMP_BUF->type == ICMP6_MPL
+     && uip_len - UIP_IPH_LEN - UIP_ICMPH_LEN <= CTRL_MAX_LEN) {
+    ctrl_len = uip_len - UIP_IPH_LEN - UIP_ICMPH_LEN;
+    memcpy(ctrl, UIP_ICMP_PAYLOAD, ctrl_len);
+    ctrl_count++;
+  }
+  return NETSTACK_IP_DROP;
+}
+static struct netstack_ip_packet_processor capture = {
+  .process_output = capture_output
+};
+/*---------------------------------------------------------------------------*/
+/* Build a data message to ff03::fc from a seed with a 16-bit seed id */
+static void
+prepare_packet(uint16_t seed, uint8_t seq)
+{
+  uint8_t *hbho;
+  uint8_t *udp;
+
+  memset(uip_buf, 0, UIP_IPH_LEN + HBHO_LEN + UDP_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->proto = UIP_PROTO_HBHO;
+  UIP_IP_BUF->ttl = 64;
+  uip_ip6addr(&UIP_IP_BUF->srcipaddr, 0xfe80, 0, 0, 0, 0x0212, 0x7400, 0, seed);
+  uip_ip6addr(&UIP_IP_BUF->destipaddr, 0xff03, 0, 0, 0, 0, 0, 0, 0xfc);
+  uipbuf_set_len_field(UIP_IP_BUF, HBHO_LEN + UDP_LEN);
+
+  hbho = uip_buf + UIP_IPH_LEN;
+  hbho[0] = UIP_PROTO_UDP;
+  hbho[1] = 0;
+  hbho[2] = 0x6d; /* MPL option */
+  hbho[3] = 4;
+  hbho[4] = 0x40; /* S=1 */
+  hbho[5] = seq;
+  hbho[6] = seed >> 8;
+  hbho[7] = seed & 0xff;
+
+  udp = hbho + HBHO_LEN;
+  udp[1] = 1;
+  udp[3] = 2;
+  udp[5] = UDP_LEN;
+  udp[8] = seq;
+  udp[9] = seed;
+
+  uip_len = UIP_IPH_LEN + HBHO_LEN + UDP_LEN;
+  uip_ext_len = 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+inject(uint16_t seed, uint8_t seq)
+{
+  prepare_packet(seed, seq);
+  return UIP_MCAST6.in();
+}
+/*---------------------------------------------------------------------------*/
+/* Find the seed info of a seed in the last control message, which must
+ * carry the given minimum sequence number and bit vector */
+static int
+check_seed_info(uint16_t seed, uint8_t min_seqno,
+                const uint8_t *vector, uint8_t vector_len)
+{
+  uint16_t i;
+  uint8_t len;
+
+  for(i = 0; i + 4 <= ctrl_len; i += 4 + len) {
+    len = ctrl[i + 1] >> 2;
+    if((ctrl[i + 1] & 0x03) != 1) {
+      /* Only seeds with 16-bit ids in this test */
+      return 0;
+    }
+    if(ctrl[i + 2] == (seed >> 8) && ctrl[i + 3] == (seed & 0xff)) {
+      return ctrl[i] == min_seqno && len == vector_len
+             && i + 4 + len <= ctrl_len
+             && memcmp(&ctrl[i + 4], vector, len) == 0;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_accept, "Accept new messages, drop old ones");
+UNIT_TEST(test_accept)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(inject(SEED_A, 10) == UIP_MCAST6_ACCEPT);
+  UNIT_TEST_ASSERT(inject(SEED_A, 11) == UIP_MCAST6_ACCEPT);
+  UNIT_TEST_ASSERT(inject(SEED_A, 13) == UIP_MCAST6_ACCEPT);
+  UNIT_TEST_ASSERT(inject(SEED_A, 17) == UIP_MCAST6_ACCEPT);
+  UNIT_TEST_ASSERT(inject(SEED_B, 200) == UIP_MCAST6_ACCEPT);
+  UNIT_TEST_ASSERT(inject(SEED_B, 202) == UIP_MCAST6_ACCEPT);
+
+  /* Duplicates and messages older than the minimum */
+  UNIT_TEST_ASSERT(inject(SEED_A, 11) == UIP_MCAST6_DROP);
+  UNIT_TEST_ASSERT(inject(SEED_A, 17) == UIP_MCAST6_DROP);
+  UNIT_TEST_ASSERT(inject(SEED_A, 5) == UIP_MCAST6_DROP);
+  UNIT_TEST_ASSERT(inject(SEED_B, 202) == UIP_MCAST6_DROP);
+  UNIT_TEST_ASSERT(inject(SEED_B, 199) == UIP_MCAST6_DROP);
+
+  /* A gap is not a duplicate */
+  UNIT_TEST_ASSERT(inject(SEED_B, 201) == UIP_MCAST6_ACCEPT);
+  UNIT_TEST_ASSERT(inject(SEED_B, 201) == UIP_MCAST6_DROP);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_ctrl, "Seed info of control messages");
+UNIT_TEST(test_ctrl)
+{
+  static const uint8_t vector_a[] = { 0xd1 };
+  static const uint8_t vector_b[] = { 0xe0 };
+
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(ctrl_count > 0);
+  UNIT_TEST_ASSERT(ctrl_len == 2 * (4 + 1));
+  UNIT_TEST_ASSERT(check_seed_info(SEED_A, 10, vector_a, sizeof(vector_a)));
+  UNIT_TEST_ASSERT(check_seed_info(SEED_B, 200, vector_b, sizeof(vector_b)));
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_reclaim, "Reclaim buffered messages");
+UNIT_TEST(test_reclaim)
+{
+  int seq;
+
+  UNIT_TEST_BEGIN();
+
+  /* 7 messages are buffered, fill the remaining 9 buffers */
+  for(seq = 18; seq < 27; seq++) {
+    UNIT_TEST_ASSERT(inject(SEED_A, seq) == UIP_MCAST6_ACCEPT);
+  }
+  /* Seed A has the largest set, its oldest two messages get reclaimed */
+  UNIT_TEST_ASSERT(inject(SEED_A, 27) == UIP_MCAST6_ACCEPT);
+  UNIT_TEST_ASSERT(inject(SEED_A, 28) == UIP_MCAST6_ACCEPT);
+
+  UNIT_TEST_ASSERT(inject(SEED_A, 10) == UIP_MCAST6_DROP);
+  UNIT_TEST_ASSERT(inject(SEED_A, 11) == UIP_MCAST6_DROP);
+  UNIT_TEST_ASSERT(inject(SEED_A, 13) == UIP_MCAST6_DROP);
+  UNIT_TEST_ASSERT(inject(SEED_A, 28) == UIP_MCAST6_DROP);
+  UNIT_TEST_ASSERT(inject(SEED_B, 201) == UIP_MCAST6_DROP);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_ctrl_reclaim, "Seed info after reclaim");
+UNIT_TEST(test_ctrl_reclaim)
+{
+  /* Seed A has 13 and 17 to 28 left, seed B is unchanged */
+  static const uint8_t vector_a[] = { 0x8f, 0xff };
+  static const uint8_t vector_b[] = { 0xe0 };
+
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(ctrl_count > 0);
+  UNIT_TEST_ASSERT(check_seed_info(SEED_A, 13, vector_a, sizeof(vector_a)));
+  UNIT_TEST_ASSERT(check_seed_info(SEED_B, 200, vector_b, sizeof(vector_b)));
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+/* A stream of new messages and replays from a few more seeds. Sequence
+ * numbers of each seed only grow, replays are of messages sent before and
+ * are either still buffered or too old. The digest of the decisions and of
+ * the final control message must not depend on the configuration. */
+static void
+stream(void)
+{
+  int i;
+  int s;
+  int n;
+  uint8_t seq;
+  uint8_t last;
+
+  for(i = 0; i < STREAM_LEN; i++) {
+    s = next_rand() % STREAM_SEEDS;
+    n = history_len[s];
+    if(n > 0 && (history_full[s] || next_rand() % 2)) {
+      seq = history[s][n - 1 - next_rand() % (n < 24 ? n : 24)];
+    } else {
+      last = n > 0 ? history[s][n - 1] : 0;
+      seq = last + 1 + next_rand() % 3;
+      if(seq >= STREAM_MAX_SEQ) {
+        history_full[s] = 1;
+        continue;
+      }
+      history[s][history_len[s]++] = seq;
+    }
+    digest_add(inject(SEED_B + 1 + s, seq));
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Replays of the messages buffered for seeds A and B, all of which are
+ * duplicates */
+static void
+benchmark(void)
+{
+  static const uint8_t seq_a[] = { 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28 };
+  static const uint8_t seq_b[] = { 200, 201, 202 };
+  uint64_t setup_ns;
+  uint64_t total_ns;
+  uint64_t t;
+  int drops;
+  int r;
+
+  t = now_ns();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    if(r % 4) {
+      prepare_packet(SEED_A, seq_a[r % sizeof(seq_a)]);
+    } else {
+      prepare_packet(SEED_B, seq_b[r % sizeof(seq_b)]);
+    }
+  }
+  setup_ns = now_ns() - t;
+
+  drops = 0;
+  t = now_ns();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    if(r % 4) {
+      drops += inject(SEED_A, seq_a[r % sizeof(seq_a)]) == UIP_MCAST6_DROP;
+    } else {
+      drops += inject(SEED_B, seq_b[r % sizeof(seq_b)]) == UIP_MCAST6_DROP;
+    }
+  }
+  total_ns = now_ns() - t;
+
+  printf("Bench: %d duplicates, %d dropped: %.1f ns per packet\n",
+         BENCH_ROUNDS, drops, (double)(total_ns - setup_ns) / BENCH_ROUNDS);
+  if(drops != BENCH_ROUNDS) {
+    printf("=check-me= FAILED   - duplicates accepted\n");
+    failures++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_mpl_seed_window_process, ev, data)
+{
+  static struct etimer et;
+  uint16_t i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with seed window %u\n", MPL_WITH_SEED_WINDOW);
+  printf("---\n");
+
+  netstack_ip_packet_processor_add(&capture);
+
+  UNIT_TEST_RUN(test_accept);
+  /* Let the control message timer of the domain expire a few times */
+  ctrl_count = 0;
+  etimer_set(&et, CLOCK_SECOND / 4);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  UNIT_TEST_RUN(test_ctrl);
+
+  UNIT_TEST_RUN(test_reclaim);
+  ctrl_count = 0;
+  etimer_set(&et, CLOCK_SECOND / 4);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  UNIT_TEST_RUN(test_ctrl_reclaim);
+
+  benchmark();
+
+  stream();
+  ctrl_count = 0;
+  etimer_set(&et, CLOCK_SECOND / 4);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  if(ctrl_count == 0) {
+    printf("=check-me= FAILED   - no control message after the stream\n");
+    failures++;
+  }
+  for(i = 0; i < ctrl_len; i++) {
+    digest_add(ctrl[i]);
+  }
+  printf("Digest: %08lx\n", (unsigned long)digest);
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
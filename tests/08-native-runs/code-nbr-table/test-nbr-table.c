@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the neighbor table. The lookups by link-layer
+ * address are checked against a linear search over the table while
+ * neighbors are added, removed and evicted, so that the test covers
+ * both the plain and the hash-indexed lookup.
+ */
+
+#include "contiki.h"
+#include "net/nbr-table.h"
+#include "lib/random.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_nbr_table_process, "Neighbor table test");
+AUTOSTART_PROCESSES(&test_nbr_table_process);
+/*---------------------------------------------------------------------------*/
+#define NUM_ADDRS        (4 * NBR_TABLE_MAX_NEIGHBORS)
+#define CHURN_ROUNDS     20000
+#define BENCH_LOOKUPS    1000000
+
+typedef struct {
+  uint16_t id;
+} test_item_t;
+
+NBR_TABLE(test_item_t, table_a);
+NBR_TABLE(test_item_t, table_b);
+
+static linkaddr_t addrs[NUM_ADDRS];
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* Reference lookup: walk the whole table */
+static test_item_t *
+linear_lookup(nbr_table_t *table, const linkaddr_t *lladdr)
+{
+  test_item_t *item;
+
+  for(item = nbr_table_head(table); item != NULL;
+      item = nbr_table_next(table, item)) {
+    if(linkaddr_cmp(nbr_table_get_lladdr(table, item), lladdr)) {
+      return item;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static int
+lookups_consistent(void)
+{
+  int i;
+
+  for(i = 0; i < NUM_ADDRS; i++) {
+    if(nbr_table_get_from_lladdr(table_a, &addrs[i]) !=
+       linear_lookup(table_a, &addrs[i]) ||
+       nbr_table_get_from_lladdr(table_b, &addrs[i]) !=
+       linear_lookup(table_b, &addrs[i])) {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_add_get, "Add and get neighbors");
+UNIT_TEST(test_add_get)
+{
+  test_item_t *item;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i++) {
+    item = nbr_table_add_lladdr(table_a, &addrs[i],
+                                NBR_TABLE_REASON_UNDEFINED, NULL);
+    UNIT_TEST_ASSERT(item != NULL);
+    item->id = i;
+  }
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i++) {
+    item = nbr_table_get_from_lladdr(table_a, &addrs[i]);
+    UNIT_TEST_ASSERT(item != NULL);
+    UNIT_TEST_ASSERT(item->id == i);
+    UNIT_TEST_ASSERT(linkaddr_cmp(nbr_table_get_lladdr(table_a, item),
+                                  &addrs[i]));
+    UNIT_TEST_ASSERT(nbr_table_get_from_lladdr(table_b, &addrs[i]) == NULL);
+  }
+  for(i = NBR_TABLE_MAX_NEIGHBORS; i < NUM_ADDRS; i++) {
+    UNIT_TEST_ASSERT(nbr_table_get_from_lladdr(table_a, &addrs[i]) == NULL);
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_remove, "Remove neighbors");
+UNIT_TEST(test_remove)
+{
+  test_item_t *item;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i += 2) {
+    item = nbr_table_get_from_lladdr(table_a, &addrs[i]);
+    UNIT_TEST_ASSERT(nbr_table_remove(table_a, item));
+  }
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i++) {
+    item = nbr_table_get_from_lladdr(table_a, &addrs[i]);
+    UNIT_TEST_ASSERT((item == NULL) == (i % 2 == 0));
+  }
+  UNIT_TEST_ASSERT(lookups_consistent());
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_evict, "Evict neighbors");
+UNIT_TEST(test_evict)
+{
+  test_item_t *item;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* Lock all neighbors still in table A. The table is full, so adding
+     new neighbors must evict the unused ones. */
+  for(i = 1; i < NBR_TABLE_MAX_NEIGHBORS; i += 2) {
+    item = nbr_table_get_from_lladdr(table_a, &addrs[i]);
+    UNIT_TEST_ASSERT(nbr_table_lock(table_a, item));
+  }
+  for(i = NBR_TABLE_MAX_NEIGHBORS; i < NBR_TABLE_MAX_NEIGHBORS * 3 / 2; i++) {
+    UNIT_TEST_ASSERT(nbr_table_add_lladdr(table_b, &addrs[i],
+                                          NBR_TABLE_REASON_UNDEFINED,
+                                          NULL) != NULL);
+  }
+  /* Only the neighbors of table B are unlocked, the oldest one is
+     evicted */
+  UNIT_TEST_ASSERT(nbr_table_add_lladdr(table_b, &addrs[NUM_ADDRS - 1],
+                                        NBR_TABLE_REASON_UNDEFINED,
+                                        NULL) != NULL);
+  UNIT_TEST_ASSERT(nbr_table_get_from_lladdr(table_b,
+                                             &addrs[NBR_TABLE_MAX_NEIGHBORS]) == NULL);
+  /* Lock table B too, no unlocked neighbor is left */
+  for(item = nbr_table_head(table_b); item != NULL;
+      item = nbr_table_next(table_b, item)) {
+    UNIT_TEST_ASSERT(nbr_table_lock(table_b, item));
+  }
+  UNIT_TEST_ASSERT(nbr_table_add_lladdr(table_b, &addrs[NUM_ADDRS - 2],
+                                        NBR_TABLE_REASON_UNDEFINED,
+                                        NULL) == NULL);
+  for(item = nbr_table_head(table_b); item != NULL;
+      item = nbr_table_next(table_b, item)) {
+    UNIT_TEST_ASSERT(nbr_table_unlock(table_b, item));
+  }
+  for(i = 1; i < NBR_TABLE_MAX_NEIGHBORS; i += 2) {
+    item = nbr_table_get_from_lladdr(table_a, &addrs[i]);
+    UNIT_TEST_ASSERT(item != NULL && item->id == i);
+    UNIT_TEST_ASSERT(nbr_table_unlock(table_a, item));
+  }
+  UNIT_TEST_ASSERT(lookups_consistent());
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_churn, "Random add/remove/evict");
+UNIT_TEST(test_churn)
+{
+  nbr_table_t *table;
+  test_item_t *item;
+  int i;
+  int n;
+
+  UNIT_TEST_BEGIN();
+
+  for(n = 0; n < CHURN_ROUNDS; n++) {
+    i = random_rand() % NUM_ADDRS;
+    table = random_rand() % 2 ? table_a : table_b;
+    item = nbr_table_get_from_lladdr(table, &addrs[i]);
+    UNIT_TEST_ASSERT(item == linear_lookup(table, &addrs[i]));
+    if(item != NULL) {
+      nbr_table_remove(table, item);
+    } else {
+      nbr_table_add_lladdr(table, &addrs[i], NBR_TABLE_REASON_UNDEFINED, NULL);
+    }
+    if(n % 100 == 0) {
+      UNIT_TEST_ASSERT(lookups_consistent());
+    }
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  uint64_t start;
+  unsigned long found;
+  int i;
+
+  /* Empty both tables and fill table A with the first neighbors */
+  for(i = 0; i < NUM_ADDRS; i++) {
+    nbr_table_remove(table_a, nbr_table_get_from_lladdr(table_a, &addrs[i]));
+    nbr_table_remove(table_b, nbr_table_get_from_lladdr(table_b, &addrs[i]));
+  }
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i++) {
+    nbr_table_add_lladdr(table_a, &addrs[i], NBR_TABLE_REASON_UNDEFINED, NULL);
+  }
+
+  found = 0;
+  start = now_ns();
+  for(i = 0; i < BENCH_LOOKUPS; i++) {
+    found += nbr_table_get_from_lladdr(table_a,
+                                       &addrs[i % NBR_TABLE_MAX_NEIGHBORS]) != NULL;
+  }
+  printf("Lookup of present neighbors: %.1f ns (%lu found)\n",
+         (double)(now_ns() - start) / BENCH_LOOKUPS, found);
+
+  found = 0;
+  start = now_ns();
+  for(i = 0; i < BENCH_LOOKUPS; i++) {
+    found += nbr_table_get_from_lladdr(table_a,
+                                       &addrs[NBR_TABLE_MAX_NEIGHBORS +
+                                              i % NBR_TABLE_MAX_NEIGHBORS]) != NULL;
+  }
+  printf("Lookup of absent neighbors: %.1f ns (%lu found)\n",
+         (double)(now_ns() - start) / BENCH_LOOKUPS, found);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_nbr_table_process, ev, data)
+{
+  int i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with %u neighbors, hash index %u\n",
+         NBR_TABLE_MAX_NEIGHBORS, NBR_TABLE_WITH_HASH_INDEX);
+  printf("---\n");
+
+  /* Addresses that differ in the last bytes only, as in most
+     deployments */
+  for(i = 0; i < NUM_ADDRS; i++) {
+    memset(&addrs[i], 0, sizeof(linkaddr_t));
+    addrs[i].u8[0] = 0x02;
+    addrs[i].u8[LINKADDR_SIZE - 2] = i >> 8;
+    addrs[i].u8[LINKADDR_SIZE - 1] = i & 0xff;
+  }
+
+  nbr_table_register(table_a, NULL);
+  nbr_table_register(table_b, NULL);
+
+  UNIT_TEST_RUN(test_add_get);
+  UNIT_TEST_RUN(test_remove);
+  UNIT_TEST_RUN(test_evict);
+  UNIT_TEST_RUN(test_churn);
+
+  benchmark();
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test of the event queues of the process scheduler. Events are posted
+ * to processes of normal and high priority, and the order in which they
+ * are delivered, the number of events delivered by each call to
+ * process_run(), and the event queue statistics are checked. Without
+ * PROCESS_CONF_EVENT_PRIORITIES, all events must be delivered in the
+ * order they were posted.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/tcpip.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_process_events_process, "Process events test");
+PROCESS(normal_a_process, "Normal priority A");
+PROCESS(normal_b_process, "Normal priority B");
+PROCESS(high_process, "High priority");
+PROCESS(poll_process, "Poll");
+AUTOSTART_PROCESSES(&test_process_events_process);
+PROCESS_NAME(ctimer_process);
+/*---------------------------------------------------------------------------*/
+#define MAX_LOG          32
+/* Event that makes the receiver poll poll_process */
+#define EVENT_POLL_ME    0x10
+
+/* A delivered event: the receiving process and the event number */
+struct delivery {
+  struct process *p;
+  process_event_t ev;
+};
+
+static struct delivery delivered[MAX_LOG];
+static int num_delivered;
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+record(struct process *p, process_event_t ev)
+{
+  if(num_delivered < MAX_LOG) {
+    delivered[num_delivered].p = p;
+    delivered[num_delivered].ev = ev;
+    num_delivered++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+handle_event(struct process *p, process_event_t ev)
+{
+  if(ev < PROCESS_EVENT_NONE) {
+    record(p, ev);
+    if(ev == EVENT_POLL_ME) {
+      process_poll(&poll_process);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(normal_a_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_YIELD();
+    handle_event(&normal_a_process, ev);
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(normal_b_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_YIELD();
+    handle_event(&normal_b_process, ev);
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(high_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_YIELD();
+    handle_event(&high_process, ev);
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(poll_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_YIELD();
+    if(ev == PROCESS_EVENT_POLL) {
+      record(&poll_process, ev);
+    }
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+/* Deliver all events waiting and start a new log and new statistics */
+static void
+reset(void)
+{
+  while(process_run() > 0);
+  num_delivered = 0;
+  process_maxevents = 0;
+  memset(process_queue_stats, 0, sizeof(process_queue_stats));
+}
+/*---------------------------------------------------------------------------*/
+static int
+delivered_is(int i, struct process *p, process_event_t ev)
+{
+  return i < num_delivered && delivered[i].p == p && delivered[i].ev == ev;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_priority_order, "Delivery order");
+UNIT_TEST(test_priority_order)
+{
+  UNIT_TEST_BEGIN();
+
+#if PROCESS_EVENT_PRIORITIES
+  UNIT_TEST_ASSERT(tcpip_process.priority == PROCESS_PRIORITY_HIGH);
+  UNIT_TEST_ASSERT(ctimer_process.priority == PROCESS_PRIORITY_HIGH);
+  UNIT_TEST_ASSERT(normal_a_process.priority == PROCESS_PRIORITY_NORMAL);
+#endif /* PROCESS_EVENT_PRIORITIES */
+
+  reset();
+  UNIT_TEST_ASSERT(process_post(&normal_a_process, 1, NULL) == PROCESS_ERR_OK);
+  UNIT_TEST_ASSERT(process_post(&normal_a_process, 2, NULL) == PROCESS_ERR_OK);
+  UNIT_TEST_ASSERT(process_post(&high_process, 3, NULL) == PROCESS_ERR_OK);
+  UNIT_TEST_ASSERT(process_post(&normal_b_process, 4, NULL) == PROCESS_ERR_OK);
+  UNIT_TEST_ASSERT(process_post(&high_process, 5, NULL) == PROCESS_ERR_OK);
+  UNIT_TEST_ASSERT(process_nevents() == 5);
+  while(process_run() > 0);
+
+  UNIT_TEST_ASSERT(num_delivered == 5);
+#if PROCESS_EVENT_PRIORITIES
+  /* High priority events first, each priority in posting order */
+  UNIT_TEST_ASSERT(delivered_is(0, &high_process, 3));
+  UNIT_TEST_ASSERT(delivered_is(1, &high_process, 5));
+  UNIT_TEST_ASSERT(delivered_is(2, &normal_a_process, 1));
+  UNIT_TEST_ASSERT(delivered_is(3, &normal_a_process, 2));
+  UNIT_TEST_ASSERT(delivered_is(4, &normal_b_process, 4));
+#else /* PROCESS_EVENT_PRIORITIES */
+  UNIT_TEST_ASSERT(delivered_is(0, &normal_a_process, 1));
+  UNIT_TEST_ASSERT(delivered_is(1, &normal_a_process, 2));
+  UNIT_TEST_ASSERT(delivered_is(2, &high_process, 3));
+  UNIT_TEST_ASSERT(delivered_is(3, &normal_b_process, 4));
+  UNIT_TEST_ASSERT(delivered_is(4, &high_process, 5));
+#endif /* PROCESS_EVENT_PRIORITIES */
+
+  /* An event posted to a high priority process while normal events are
+     waiting is delivered next */
+  reset();
+  process_post(&normal_a_process, 1, NULL);
+  process_post(&normal_a_process, 2, NULL);
+  process_run();
+  process_post(&high_process, 3, NULL);
+  while(process_run() > 0);
+
+  UNIT_TEST_ASSERT(num_delivered == 3);
+  UNIT_TEST_ASSERT(delivered_is(0, &normal_a_process, 1));
+  if(PROCESS_EVENT_PRIORITIES && PROCESS_EVENT_BATCH == 1) {
+    UNIT_TEST_ASSERT(delivered_is(1, &high_process, 3));
+    UNIT_TEST_ASSERT(delivered_is(2, &normal_a_process, 2));
+  } else {
+    UNIT_TEST_ASSERT(delivered_is(1, &normal_a_process, 2));
+    UNIT_TEST_ASSERT(delivered_is(2, &high_process, 3));
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_batch, "Events per process_run()");
+UNIT_TEST(test_batch)
+{
+  int i;
+  int expected;
+  int remaining;
+
+  UNIT_TEST_BEGIN();
+
+  reset();
+  for(i = 1; i <= 6; i++) {
+    process_post(&normal_a_process, i, NULL);
+  }
+
+  /* Up to PROCESS_EVENT_BATCH events per call, in order */
+  expected = 0;
+  remaining = 6;
+  while(remaining > 0) {
+    expected += MIN(remaining, PROCESS_EVENT_BATCH);
+    remaining -= MIN(remaining, PROCESS_EVENT_BATCH);
+    UNIT_TEST_ASSERT(process_run() == remaining);
+    UNIT_TEST_ASSERT(num_delivered == expected);
+  }
+  for(i = 0; i < 6; i++) {
+    UNIT_TEST_ASSERT(delivered_is(i, &normal_a_process, i + 1));
+  }
+
+  /* Poll handlers are called between the events of a batch */
+  reset();
+  process_post(&normal_a_process, EVENT_POLL_ME, NULL);
+  process_post(&normal_a_process, 1, NULL);
+  while(process_run() > 0);
+
+  UNIT_TEST_ASSERT(num_delivered == 3);
+  UNIT_TEST_ASSERT(delivered_is(0, &normal_a_process, EVENT_POLL_ME));
+  UNIT_TEST_ASSERT(delivered_is(1, &poll_process, PROCESS_EVENT_POLL));
+  UNIT_TEST_ASSERT(delivered_is(2, &normal_a_process, 1));
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_full_queue, "Full queues and statistics");
+UNIT_TEST(test_full_queue)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  reset();
+  for(i = 0; i < PROCESS_CONF_NUMEVENTS; i++) {
+    UNIT_TEST_ASSERT(process_post(&normal_a_process, i, NULL) ==
+                     PROCESS_ERR_OK);
+  }
+  UNIT_TEST_ASSERT(process_post(&normal_a_process, 0, NULL) ==
+                   PROCESS_ERR_FULL);
+  UNIT_TEST_ASSERT(process_post(PROCESS_BROADCAST, 0, NULL) ==
+                   PROCESS_ERR_FULL);
+
+#if PROCESS_EVENT_PRIORITIES
+  /* The high priority queue is not affected by the normal one */
+  for(i = 0; i < PROCESS_CONF_NUMEVENTS_HIGH; i++) {
+    UNIT_TEST_ASSERT(process_post(&high_process, i, NULL) == PROCESS_ERR_OK);
+  }
+  UNIT_TEST_ASSERT(process_post(&high_process, 0, NULL) == PROCESS_ERR_FULL);
+
+  UNIT_TEST_ASSERT(process_nevents() ==
+                   PROCESS_CONF_NUMEVENTS + PROCESS_CONF_NUMEVENTS_HIGH);
+  UNIT_TEST_ASSERT(process_maxevents ==
+                   PROCESS_CONF_NUMEVENTS + PROCESS_CONF_NUMEVENTS_HIGH);
+  UNIT_TEST_ASSERT(process_queue_stats[PROCESS_PRIORITY_HIGH].max_events ==
+                   PROCESS_CONF_NUMEVENTS_HIGH);
+  UNIT_TEST_ASSERT(process_queue_stats[PROCESS_PRIORITY_HIGH].dropped == 1);
+#else /* PROCESS_EVENT_PRIORITIES */
+  UNIT_TEST_ASSERT(process_post(&high_process, 0, NULL) == PROCESS_ERR_FULL);
+
+  UNIT_TEST_ASSERT(process_nevents() == PROCESS_CONF_NUMEVENTS);
+  UNIT_TEST_ASSERT(process_maxevents == PROCESS_CONF_NUMEVENTS);
+#endif /* PROCESS_EVENT_PRIORITIES */
+  UNIT_TEST_ASSERT(process_queue_stats[PROCESS_PRIORITY_NORMAL].max_events ==
+                   PROCESS_CONF_NUMEVENTS);
+  UNIT_TEST_ASSERT(process_queue_stats[PROCESS_PRIORITY_NORMAL].dropped ==
+                   (PROCESS_EVENT_PRIORITIES ? 2 : 3));
+
+  /* Everything that was queued is delivered */
+  while(process_run() > 0);
+  UNIT_TEST_ASSERT(num_delivered == PROCESS_CONF_NUMEVENTS +
+                   (PROCESS_EVENT_PRIORITIES ? PROCESS_CONF_NUMEVENTS_HIGH : 0));
+  UNIT_TEST_ASSERT(process_nevents() == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process_events_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with event priorities %u, up to %u events per run\n",
+         PROCESS_EVENT_PRIORITIES, PROCESS_EVENT_BATCH);
+  printf("---\n");
+
+  process_start(&normal_a_process, NULL);
+  process_start(&normal_b_process, NULL);
+  process_start(&poll_process, NULL);
+  process_set_priority(&high_process, PROCESS_PRIORITY_HIGH);
+  process_start(&high_process, NULL);
+
+  UNIT_TEST_RUN(test_priority_order);
+  UNIT_TEST_RUN(test_batch);
+  UNIT_TEST_RUN(test_full_queue);
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of RPL Lite parent selection. The selected parent is
+ * checked against a scan of the whole neighbor table while neighbor ranks,
+ * link statistics, reachability and instance parameters change, and the
+ * cost of a link update followed by a selection is measured.
+ */
+
+#include "contiki.h"
+#include "net/routing/routing.h"
+#include "net/routing/rpl-lite/rpl.h"
+#include "net/ipv6/uip-ds6-nbr.h"
+#include "net/link-stats.h"
+#include "net/mac/mac.h"
+#include "lib/random.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_rpl_parent_process, "RPL parent selection test");
+AUTOSTART_PROCESSES(&test_rpl_parent_process);
+/*---------------------------------------------------------------------------*/
+#define POOL_SIZE        (NBR_TABLE_MAX_NEIGHBORS + NBR_TABLE_MAX_NEIGHBORS / 2)
+#define CHURN_ROUNDS     20000
+#define BENCH_UPDATES    10000
+#define TIME_THRESHOLD   (10 * 60 * CLOCK_SECOND)
+
+extern rpl_of_t rpl_of0, rpl_mrhof;
+
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+static void
+nbr_lladdr(uip_lladdr_t *lladdr, int i)
+{
+  memset(lladdr, 0, sizeof(*lladdr));
+  lladdr->addr[0] = 0x02;
+  lladdr->addr[1] = 0x12;
+  lladdr->addr[sizeof(*lladdr) - 2] = i >> 8;
+  lladdr->addr[sizeof(*lladdr) - 1] = i & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+/* Update neighbor i as upon reception of a DIO */
+static rpl_nbr_t *
+receive_dio(int i, rpl_rank_t rank)
+{
+  uip_lladdr_t lladdr;
+  uip_ipaddr_t ipaddr;
+  rpl_nbr_t *nbr;
+
+  nbr_lladdr(&lladdr, i);
+  uip_ip6addr(&ipaddr, 0xfe80, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&ipaddr, &lladdr);
+
+  if(uip_ds6_nbr_lookup(&ipaddr) == NULL
+     && uip_ds6_nbr_add(&ipaddr, &lladdr, 1, NBR_REACHABLE,
+                        NBR_TABLE_REASON_IPV6_ND_AUTOFILL, NULL) == NULL) {
+    return NULL;
+  }
+  link_stats_input_callback((linkaddr_t *)&lladdr);
+
+  nbr = rpl_neighbor_get_from_lladdr(&lladdr);
+  if(nbr == NULL) {
+    nbr = nbr_table_add_lladdr(rpl_neighbors, (linkaddr_t *)&lladdr,
+                               NBR_TABLE_REASON_RPL_DIO, NULL);
+    if(nbr == NULL) {
+      return NULL;
+    }
+  }
+  nbr->rank = rank;
+  rpl_neighbor_update(nbr);
+  return nbr;
+}
+/*---------------------------------------------------------------------------*/
+/* Report a unicast transmission to neighbor i */
+static void
+packet_sent(int i, int status, int numtx)
+{
+  uip_lladdr_t lladdr;
+
+  nbr_lladdr(&lladdr, i);
+  link_stats_packet_sent((linkaddr_t *)&lladdr, status, numtx);
+  NETSTACK_ROUTING.link_callback((linkaddr_t *)&lladdr, status, numtx);
+}
+/*---------------------------------------------------------------------------*/
+static rpl_rank_t
+random_rank(void)
+{
+  switch(random_rand() % 8) {
+  case 0:
+    return RPL_INFINITE_RANK;
+  case 1:
+    return curr_instance.min_hoprankinc * (1 + random_rand() % 6)
+      + random_rand() % curr_instance.min_hoprankinc;
+  default:
+    /* Coarse ranks, to get plenty of ties */
+    return curr_instance.min_hoprankinc * (1 + random_rand() % 6);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Parent selection as done by a scan of the whole neighbor table */
+static int
+ref_acceptable_rank(rpl_rank_t rank)
+{
+  rpl_rank_t max_rank = RPL_INFINITE_RANK;
+
+  if(curr_instance.max_rankinc != 0) {
+    max_rank = MIN((uint32_t)curr_instance.dag.lowest_rank
+                   + curr_instance.max_rankinc, RPL_INFINITE_RANK);
+  }
+  return rank != RPL_INFINITE_RANK && rank >= ROOT_RANK && rank <= max_rank;
+}
+/*---------------------------------------------------------------------------*/
+static rpl_nbr_t *
+ref_best_parent(int fresh_only)
+{
+  rpl_nbr_t *nbr;
+  rpl_nbr_t *best = NULL;
+
+  for(nbr = nbr_table_head(rpl_neighbors); nbr != NULL;
+      nbr = nbr_table_next(rpl_neighbors, nbr)) {
+    if(!ref_acceptable_rank(rpl_neighbor_rank_via_nbr(nbr))
+       || !curr_instance.of->nbr_is_acceptable_parent(nbr)) {
+      continue;
+    }
+    if(fresh_only && !rpl_neighbor_is_fresh(nbr)) {
+      continue;
+    }
+#if UIP_ND6_SEND_NS
+    {
+      uip_ds6_nbr_t *ds6_nbr = uip_ds6_nbr_ll_lookup(
+          (const uip_lladdr_t *)rpl_neighbor_get_lladdr(nbr));
+      if(ds6_nbr == NULL || ds6_nbr->state != NBR_REACHABLE) {
+        continue;
+      }
+    }
+#endif /* UIP_ND6_SEND_NS */
+    best = curr_instance.of->best_parent(best, nbr);
+  }
+  return best;
+}
+/*---------------------------------------------------------------------------*/
+/* rpl_neighbor_select_best() on top of the scan, without side effects */
+static rpl_nbr_t *
+ref_select_best(void)
+{
+  rpl_nbr_t *best = ref_best_parent(0);
+#if RPL_WITH_PROBING
+  rpl_nbr_t *best_fresh;
+
+  if(best == NULL || rpl_neighbor_is_fresh(best)
+     || best == curr_instance.dag.preferred_parent) {
+    return best;
+  }
+  best_fresh = ref_best_parent(1);
+  if(best_fresh == NULL) {
+    return curr_instance.dag.preferred_parent == NULL ? NULL : best;
+  }
+  return best_fresh;
+#else /* RPL_WITH_PROBING */
+  return best;
+#endif /* RPL_WITH_PROBING */
+}
+/*---------------------------------------------------------------------------*/
+static void
+start_instance(rpl_of_t *of)
+{
+  uip_ipaddr_t dag_id;
+
+  uip_ip6addr(&dag_id, 0xfd00, 0, 0, 0, 0, 0, 0, 1);
+  curr_instance.instance_id = RPL_DEFAULT_INSTANCE;
+  curr_instance.of = of;
+  curr_instance.used = 1;
+  curr_instance.mop = RPL_MOP_DEFAULT;
+  curr_instance.max_rankinc = RPL_MAX_RANKINC;
+  curr_instance.min_hoprankinc = RPL_MIN_HOPRANKINC;
+  curr_instance.dio_intdoubl = RPL_DIO_INTERVAL_DOUBLINGS;
+  curr_instance.dio_intmin = RPL_DIO_INTERVAL_MIN;
+  curr_instance.dio_redundancy = RPL_DIO_REDUNDANCY;
+  curr_instance.default_lifetime = RPL_DEFAULT_LIFETIME;
+  curr_instance.lifetime_unit = RPL_DEFAULT_LIFETIME_UNIT;
+  curr_instance.dag.rank = RPL_INFINITE_RANK;
+  curr_instance.dag.last_advertised_rank = RPL_INFINITE_RANK;
+  curr_instance.dag.lowest_rank = RPL_INFINITE_RANK;
+  curr_instance.dag.state = DAG_INITIALIZED;
+  uip_ipaddr_copy(&curr_instance.dag.dag_id, &dag_id);
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_churn, "Select parents under neighbor churn");
+UNIT_TEST(test_churn)
+{
+  unsigned long mismatches = 0;
+  unsigned long selected = 0;
+  unsigned long evicted = 0;
+  rpl_nbr_t *nbr;
+  int round;
+  int count;
+
+  UNIT_TEST_BEGIN();
+
+  for(round = 0; round < CHURN_ROUNDS; round++) {
+    int op = random_rand() % 1000;
+    int i = 1 + random_rand() % POOL_SIZE;
+
+    count = rpl_neighbor_count();
+    if(op < 300) {
+      uip_lladdr_t lladdr;
+
+      nbr_lladdr(&lladdr, i);
+      if(rpl_neighbor_get_from_lladdr(&lladdr) != NULL) {
+        receive_dio(i, random_rank());
+      } else if(receive_dio(i, random_rank()) != NULL
+                && rpl_neighbor_count() <= count) {
+        /* Another neighbor was evicted to make room */
+        evicted++;
+      }
+    } else if(op < 700) {
+      packet_sent(i, random_rand() % 4 ? MAC_TX_OK : MAC_TX_NOACK,
+                  1 + random_rand() % 4);
+    } else if(op < 800) {
+      rpl_dag_update_state();
+    } else if(op < 850) {
+      nbr = rpl_neighbor_get_from_index(random_rand() % (count + 1));
+      if(nbr != NULL) {
+        /* Make the neighbor either recent or old enough to pass the
+         * MRHOF time hysteresis */
+        nbr->better_parent_since = clock_time()
+          - (random_rand() % 2 ? 0 : TIME_THRESHOLD + 1);
+      }
+    } else if(op < 900) {
+      nbr = rpl_neighbor_get_from_index(random_rand() % (count + 1));
+      if(nbr != NULL) {
+        uip_ds6_nbr_t *ds6_nbr = uip_ds6_nbr_ll_lookup(
+            (const uip_lladdr_t *)rpl_neighbor_get_lladdr(nbr));
+        if(ds6_nbr != NULL) {
+          ds6_nbr->state = random_rand() % 3 ? NBR_REACHABLE : NBR_STALE;
+        }
+      }
+    } else if(op < 950) {
+      curr_instance.dag.lowest_rank = random_rank();
+      curr_instance.max_rankinc = random_rand() % 2 ? RPL_MAX_RANKINC : 0;
+    } else if(op < 980) {
+      curr_instance.min_hoprankinc = random_rand() % 2 ? 128 : 256;
+    } else if(op < 999) {
+      curr_instance.of = random_rand() % 2 ? &rpl_of0 : &rpl_mrhof;
+    } else {
+      rpl_neighbor_remove_all();
+    }
+
+    nbr = ref_select_best();
+    if(rpl_neighbor_select_best() != nbr) {
+      mismatches++;
+    }
+    if(nbr != NULL) {
+      selected++;
+    }
+  }
+
+  printf("%d rounds, %lu with a parent, %lu evictions, %lu mismatches\n",
+         CHURN_ROUNDS, selected, evicted, mismatches);
+  UNIT_TEST_ASSERT(mismatches == 0);
+  UNIT_TEST_ASSERT(selected > CHURN_ROUNDS / 4);
+  UNIT_TEST_ASSERT(evicted > 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(rpl_of_t *of, int n)
+{
+  rpl_nbr_t *nbr;
+  uint64_t start;
+  uint64_t total;
+  int i;
+
+  rpl_neighbor_remove_all();
+  curr_instance.of = of;
+  curr_instance.min_hoprankinc = RPL_MIN_HOPRANKINC;
+  curr_instance.max_rankinc = RPL_MAX_RANKINC;
+  curr_instance.dag.state = DAG_INITIALIZED;
+  for(i = 1; i <= n; i++) {
+    receive_dio(i, RPL_MIN_HOPRANKINC * (1 + random_rand() % 4)
+                + random_rand() % RPL_MIN_HOPRANKINC);
+    packet_sent(i, MAC_TX_OK, 1 + random_rand() % 3);
+  }
+  for(nbr = nbr_table_head(rpl_neighbors); nbr != NULL;
+      nbr = nbr_table_next(rpl_neighbors, nbr)) {
+    uip_ds6_nbr_t *ds6_nbr = uip_ds6_nbr_ll_lookup(
+        (const uip_lladdr_t *)rpl_neighbor_get_lladdr(nbr));
+    ds6_nbr->state = NBR_REACHABLE;
+    nbr->better_parent_since = 0;
+  }
+  rpl_dag_update_state();
+
+  /* Time the selection following each link update, as done by
+   * rpl_dag_update_state() */
+  total = 0;
+  for(i = 0; i < BENCH_UPDATES; i++) {
+    packet_sent(1 + random_rand() % n, MAC_TX_OK, 1 + random_rand() % 3);
+    start = now_ns();
+    rpl_neighbor_select_best();
+    total += now_ns() - start;
+  }
+  printf("%s with %d neighbors: %.1f ns per selection\n",
+         of == &rpl_of0 ? "OF0" : "MRHOF", n, (double)total / BENCH_UPDATES);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_rpl_parent_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with %u neighbors, parent cache %u, hash index %u\n",
+         NBR_TABLE_MAX_NEIGHBORS, RPL_WITH_PARENT_CACHE,
+         NBR_TABLE_WITH_HASH_INDEX);
+  printf("---\n");
+
+  start_instance(&rpl_mrhof);
+
+  UNIT_TEST_RUN(test_churn);
+
+  benchmark(&rpl_mrhof, 20);
+  benchmark(&rpl_mrhof, 60);
+  benchmark(&rpl_of0, 60);
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
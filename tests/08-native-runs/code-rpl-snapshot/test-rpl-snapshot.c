@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the RPL Lite root snapshot. The DAG version and
+ * the non-storing links are saved, the root is restarted and the snapshot
+ * restored, and damaged or foreign snapshots are checked to be ignored.
+ */
+
+#include "contiki.h"
+#include "net/routing/routing.h"
+#include "net/routing/rpl-lite/rpl.h"
+#include "net/ipv6/uip-sr.h"
+#include "cfs/cfs.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_rpl_snapshot_process, "RPL root snapshot test");
+AUTOSTART_PROCESSES(&test_rpl_snapshot_process);
+/*---------------------------------------------------------------------------*/
+#define NUM_LINKS        (UIP_SR_LINK_NUM - 2)
+#define FANOUT           4
+#define BENCH_ROUNDS     100
+#define LINK_LIFETIME    (30 * 60)
+
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* Address of node i, node 0 being the root */
+static void
+node_addr(uip_ipaddr_t *addr, int i)
+{
+  if(i == 0) {
+    uip_ipaddr_copy(addr, &curr_instance.dag.dag_id);
+  } else {
+    uip_ip6addr(addr, 0xfd00, 0, 0, 0, 0x0212, 0x7400, i >> 8, i & 0xff);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+node_parent(int i)
+{
+  return (i - 1) / FANOUT;
+}
+/*---------------------------------------------------------------------------*/
+static int
+add_links(int count)
+{
+  uip_ipaddr_t child;
+  uip_ipaddr_t parent;
+  int i;
+
+  for(i = 1; i <= count; i++) {
+    node_addr(&child, i);
+    node_addr(&parent, node_parent(i));
+    if(uip_sr_update_node(NULL, &child, &parent, LINK_LIFETIME) == NULL) {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Check that links 1..count are present with the expected parent */
+static int
+check_links(int count, uint32_t lifetime)
+{
+  uip_ipaddr_t addr;
+  uip_sr_node_t *child;
+  uip_sr_node_t *parent;
+  int i;
+
+  for(i = 1; i <= count; i++) {
+    node_addr(&addr, i);
+    child = uip_sr_get_node(NULL, &addr);
+    node_addr(&addr, node_parent(i));
+    parent = uip_sr_get_node(NULL, &addr);
+    if(child == NULL || parent == NULL || child->parent != parent
+       || child->lifetime != lifetime) {
+      return 0;
+    }
+    node_addr(&addr, i);
+    if(!uip_sr_is_addr_reachable(NULL, &addr)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+restart_root(void)
+{
+  uip_ipaddr_t root_ipaddr;
+
+  /* Leaving the DAG removes the root address, which a reboot would set
+   * again */
+  uip_ipaddr_copy(&root_ipaddr, rpl_get_global_address());
+  rpl_dag_leave();
+  if(uip_ds6_addr_lookup(&root_ipaddr) == NULL) {
+    uip_ds6_addr_add(&root_ipaddr, 0, ADDR_AUTOCONF);
+  }
+  NETSTACK_ROUTING.root_start();
+}
+/*---------------------------------------------------------------------------*/
+static int
+read_snapshot(uint8_t *buf, int len)
+{
+  int fd;
+
+  fd = cfs_open(RPL_ROOT_SNAPSHOT_FILE, CFS_READ);
+  if(fd < 0) {
+    return -1;
+  }
+  len = cfs_read(fd, buf, len);
+  cfs_close(fd);
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+static int
+write_snapshot(const uint8_t *buf, int len)
+{
+  int fd;
+
+  fd = cfs_open(RPL_ROOT_SNAPSHOT_FILE, CFS_WRITE);
+  if(fd < 0) {
+    return -1;
+  }
+  len = cfs_write(fd, buf, len);
+  cfs_close(fd);
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_restore, "Save and restore the root state");
+UNIT_TEST(test_restore)
+{
+  uint8_t version;
+  uint8_t dtsn;
+  uip_ipaddr_t addr;
+
+  UNIT_TEST_BEGIN();
+
+  cfs_remove(RPL_ROOT_SNAPSHOT_FILE);
+  restart_root();
+  UNIT_TEST_ASSERT(rpl_dag_root_is_root());
+  UNIT_TEST_ASSERT(rpl_dag_root_load_snapshot() == -1);
+
+  /* Move to a later version than the initial one */
+  rpl_global_repair("test");
+  rpl_global_repair("test");
+  version = curr_instance.dag.version;
+  dtsn = curr_instance.dtsn_out;
+
+  UNIT_TEST_ASSERT(add_links(NUM_LINKS));
+  /* Links pending removal after a No-Path DAO are not saved */
+  node_addr(&addr, NUM_LINKS + 1);
+  UNIT_TEST_ASSERT(uip_sr_update_node(NULL, &addr, &curr_instance.dag.dag_id,
+                                      LINK_LIFETIME) != NULL);
+  uip_sr_expire_parent(NULL, &addr, &curr_instance.dag.dag_id);
+
+  UNIT_TEST_ASSERT(rpl_dag_root_save_snapshot() == 1);
+  UNIT_TEST_ASSERT(rpl_dag_root_save_snapshot() == 0);
+
+  restart_root();
+  UNIT_TEST_ASSERT(uip_sr_num_nodes() == 0);
+  UNIT_TEST_ASSERT(curr_instance.dag.version != version);
+
+  UNIT_TEST_ASSERT(rpl_dag_root_load_snapshot() == NUM_LINKS);
+  UNIT_TEST_ASSERT(curr_instance.dag.version == version);
+  RPL_LOLLIPOP_INCREMENT(dtsn);
+  UNIT_TEST_ASSERT(curr_instance.dtsn_out == dtsn);
+  UNIT_TEST_ASSERT(check_links(NUM_LINKS, RPL_ROOT_SNAPSHOT_LIFETIME));
+  node_addr(&addr, NUM_LINKS + 1);
+  UNIT_TEST_ASSERT(uip_sr_get_node(NULL, &addr) == NULL);
+  /* Links plus the root */
+  UNIT_TEST_ASSERT(uip_sr_num_nodes() == NUM_LINKS + 1);
+
+  /* A change in the graph or DTSN is written again */
+  UNIT_TEST_ASSERT(rpl_dag_root_save_snapshot() == 1);
+  UNIT_TEST_ASSERT(rpl_dag_root_save_snapshot() == 0);
+  node_addr(&addr, 1);
+  uip_sr_expire_parent(NULL, &addr, &curr_instance.dag.dag_id);
+  UNIT_TEST_ASSERT(rpl_dag_root_save_snapshot() == 1);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_reject, "Ignore damaged or foreign snapshots");
+UNIT_TEST(test_reject)
+{
+  static uint8_t buf[24 + 16 * UIP_SR_LINK_NUM + 2];
+  int len;
+  int i;
+  /* Magic, instance ID, a link and the CRC */
+  const int offsets[] = { 0, 3, 24 + 16 * 5 + 9, -1 };
+
+  UNIT_TEST_BEGIN();
+
+  restart_root();
+  uip_sr_free_all();
+  UNIT_TEST_ASSERT(add_links(NUM_LINKS));
+  UNIT_TEST_ASSERT(rpl_dag_root_save_snapshot() == 1);
+  len = read_snapshot(buf, sizeof(buf));
+  UNIT_TEST_ASSERT(len == 24 + 16 * NUM_LINKS + 2);
+
+  for(i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+    int offset = offsets[i] >= 0 ? offsets[i] : len - 1;
+    buf[offset] ^= 0x40;
+    UNIT_TEST_ASSERT(write_snapshot(buf, len) == len);
+    buf[offset] ^= 0x40;
+    restart_root();
+    UNIT_TEST_ASSERT(rpl_dag_root_load_snapshot() == -1);
+    UNIT_TEST_ASSERT(uip_sr_num_nodes() == 0);
+  }
+
+  /* Truncated file */
+  UNIT_TEST_ASSERT(write_snapshot(buf, len - 16) == len - 16);
+  restart_root();
+  UNIT_TEST_ASSERT(rpl_dag_root_load_snapshot() == -1);
+  UNIT_TEST_ASSERT(uip_sr_num_nodes() == 0);
+
+  /* Snapshot of another DAG */
+  UNIT_TEST_ASSERT(write_snapshot(buf, len) == len);
+  restart_root();
+  curr_instance.dag.dag_id.u8[15] ^= 1;
+  UNIT_TEST_ASSERT(rpl_dag_root_load_snapshot() == -1);
+  curr_instance.dag.dag_id.u8[15] ^= 1;
+  UNIT_TEST_ASSERT(uip_sr_num_nodes() == 0);
+
+  /* The intact file is still accepted */
+  UNIT_TEST_ASSERT(rpl_dag_root_load_snapshot() == NUM_LINKS);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  uint64_t save_ns = 0;
+  uint64_t check_ns = 0;
+  uint64_t load_ns = 0;
+  uint64_t t;
+  int i;
+
+  for(i = 0; i < BENCH_ROUNDS; i++) {
+    restart_root();
+    uip_sr_free_all();
+    add_links(NUM_LINKS);
+    t = now_ns();
+    rpl_dag_root_save_snapshot();
+    save_ns += now_ns() - t;
+    t = now_ns();
+    rpl_dag_root_save_snapshot();
+    check_ns += now_ns() - t;
+    restart_root();
+    t = now_ns();
+    rpl_dag_root_load_snapshot();
+    load_ns += now_ns() - t;
+  }
+
+  printf("Bench: %u links, %u bytes: save %.1f us, unchanged %.1f us, "
+         "restore %.1f us\n", NUM_LINKS, 24 + 16 * NUM_LINKS + 2,
+         save_ns / 1000.0 / BENCH_ROUNDS, check_ns / 1000.0 / BENCH_ROUNDS,
+         load_ns / 1000.0 / BENCH_ROUNDS);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_rpl_snapshot_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with %u links, hash index %u\n",
+         NUM_LINKS, UIP_SR_WITH_HASH_INDEX);
+  printf("---\n");
+
+  UNIT_TEST_RUN(test_restore);
+  UNIT_TEST_RUN(test_reject);
+
+  benchmark();
+  cfs_remove(RPL_ROOT_SNAPSHOT_FILE);
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
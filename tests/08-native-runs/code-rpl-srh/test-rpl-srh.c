@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the source routing header insertion at a RPL Lite
+ * root. The inserted headers are decoded and checked against the expected
+ * paths, including after topology changes, and the cost of the insertion
+ * is measured for 1000 destinations at depth 8.
+ */
+
+#include "contiki.h"
+#include "net/routing/routing.h"
+#include "net/routing/rpl-lite/rpl.h"
+#include "net/ipv6/uip-sr.h"
+#include "net/ipv6/uipbuf.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_rpl_srh_process, "RPL SRH test");
+AUTOSTART_PROCESSES(&test_rpl_srh_process);
+/*---------------------------------------------------------------------------*/
+/* Chains of nodes at depth 1 to CHAIN_LEN, each ending with LEAVES leaves
+ * at depth CHAIN_LEN + 1 */
+#define NUM_CHAINS       125
+#define CHAIN_LEN        7
+#define LEAVES           8
+#define FIRST_LEAF       (1 + NUM_CHAINS * CHAIN_LEN)
+#define NUM_NODES        (FIRST_LEAF + NUM_CHAINS * LEAVES)
+#define PAYLOAD_LEN      64
+#define BENCH_ROUNDS     200
+#define LINK_LIFETIME    (30 * 60)
+
+static int failures;
+static int parent[NUM_NODES];
+static uint8_t payload[PAYLOAD_LEN];
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* Address of node i, node 0 being the root. The IIDs vary in their last
+ * three bytes so that paths get different compression. */
+static void
+node_addr(uip_ipaddr_t *addr, int i)
+{
+  if(i == 0) {
+    uip_ipaddr_copy(addr, &curr_instance.dag.dag_id);
+  } else {
+    uip_ip6addr(addr, 0xfd00, 0, 0, 0, 0x0212, 0x7400 | (i % 3),
+                i >> 8, i & 0xff);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+set_parent(int i, int p)
+{
+  uip_ipaddr_t child;
+  uip_ipaddr_t parent_addr;
+
+  parent[i] = p;
+  node_addr(&child, i);
+  node_addr(&parent_addr, p);
+  return uip_sr_update_node(NULL, &child, &parent_addr, LINK_LIFETIME) != NULL;
+}
+/*---------------------------------------------------------------------------*/
+static int
+build_graph(void)
+{
+  int c;
+  int l;
+  int k;
+
+  for(c = 0; c < NUM_CHAINS; c++) {
+    for(l = 0; l < CHAIN_LEN; l++) {
+      if(!set_parent(1 + c * CHAIN_LEN + l, l == 0 ? 0 : c * CHAIN_LEN + l)) {
+        return 0;
+      }
+    }
+    for(k = 0; k < LEAVES; k++) {
+      if(!set_parent(FIRST_LEAF + c * LEAVES + k, (c + 1) * CHAIN_LEN)) {
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+prepare_packet(int dest)
+{
+  uipbuf_clear();
+  memset(UIP_IP_BUF, 0, UIP_IPH_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = 64;
+  uip_ipaddr_copy(&UIP_IP_BUF->srcipaddr, &curr_instance.dag.dag_id);
+  node_addr(&UIP_IP_BUF->destipaddr, dest);
+  memcpy(UIP_IP_PAYLOAD(0), payload, PAYLOAD_LEN);
+  uip_len = UIP_IPH_LEN + PAYLOAD_LEN;
+  uipbuf_set_len_field(UIP_IP_BUF, PAYLOAD_LEN);
+}
+/*---------------------------------------------------------------------------*/
+/* Decode the SRH of the packet to dest and check it against the path */
+static int
+check_srh(int dest)
+{
+  struct uip_routing_hdr *rh = (struct uip_routing_hdr *)UIP_IP_PAYLOAD(0);
+  struct uip_rpl_srh_hdr *srh = (struct uip_rpl_srh_hdr *)(rh + 1);
+  int path[NUM_NODES];
+  int path_len;
+  uint8_t cmpri;
+  uint8_t cmpre;
+  uint8_t *ptr;
+  uip_ipaddr_t expected;
+  uip_ipaddr_t addr;
+  int ext_len;
+  int i;
+
+  /* Path from dest up to the first hop */
+  path_len = 0;
+  for(i = dest; i != 0; i = parent[i]) {
+    path[path_len++] = i;
+  }
+
+  node_addr(&expected, path[path_len - 1]);
+  if(UIP_IP_BUF->proto != UIP_PROTO_ROUTING
+     || rh->routing_type != RPL_RH_TYPE_SRH
+     || rh->next != UIP_PROTO_UDP
+     || rh->seg_left != path_len - 1
+     || !uip_ipaddr_cmp(&UIP_IP_BUF->destipaddr, &expected)) {
+    return 0;
+  }
+
+  ext_len = rh->len * 8 + 8;
+  cmpri = srh->cmpr >> 4;
+  cmpre = srh->cmpr & 0x0f;
+  ptr = (uint8_t *)(srh + 1);
+  /* Addresses from the hop after the first one to dest */
+  for(i = path_len - 2; i >= 0; i--) {
+    uint8_t cmpr = i == 0 ? cmpre : cmpri;
+    memcpy(&addr, &UIP_IP_BUF->destipaddr, cmpr);
+    memcpy(&addr.u8[cmpr], ptr, 16 - cmpr);
+    ptr += 16 - cmpr;
+    node_addr(&expected, path[i]);
+    if(!uip_ipaddr_cmp(&addr, &expected)) {
+      return 0;
+    }
+  }
+  if(ptr + (srh->pad >> 4) != (uint8_t *)rh + ext_len) {
+    return 0;
+  }
+
+  return uip_len == UIP_IPH_LEN + ext_len + PAYLOAD_LEN
+    && uip_ext_len == ext_len
+    && ((UIP_IP_BUF->len[0] << 8) | UIP_IP_BUF->len[1]) == ext_len + PAYLOAD_LEN
+    && memcmp(UIP_IP_PAYLOAD(ext_len), payload, PAYLOAD_LEN) == 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+check_all(void)
+{
+  int i;
+
+  for(i = 1; i < NUM_NODES; i++) {
+    prepare_packet(i);
+    if(!rpl_ext_header_update() || !check_srh(i)) {
+      printf("Wrong SRH to node %d\n", i);
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_srh, "SRH insertion");
+UNIT_TEST(test_srh)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(check_all());
+  /* Again, from the cache if enabled */
+  UNIT_TEST_ASSERT(check_all());
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_topology_change, "SRH after topology changes");
+UNIT_TEST(test_topology_change)
+{
+  uip_ipaddr_t addr;
+  uip_ipaddr_t parent_addr;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* Move the lower half of every other chain under the next chain */
+  for(i = 0; i + 1 < NUM_CHAINS; i += 2) {
+    UNIT_TEST_ASSERT(set_parent(1 + i * CHAIN_LEN + 3,
+                                1 + (i + 1) * CHAIN_LEN + 2));
+  }
+  /* Move a leaf closer to the root */
+  UNIT_TEST_ASSERT(set_parent(FIRST_LEAF, 1));
+  UNIT_TEST_ASSERT(check_all());
+  UNIT_TEST_ASSERT(check_all());
+
+  /* Remove a leaf, as after a No-Path DAO */
+  node_addr(&addr, NUM_NODES - 1);
+  node_addr(&parent_addr, parent[NUM_NODES - 1]);
+  uip_sr_expire_parent(NULL, &addr, &parent_addr);
+  uip_sr_periodic(UIP_SR_REMOVAL_DELAY);
+  uip_sr_periodic(UIP_SR_REMOVAL_DELAY);
+  UNIT_TEST_ASSERT(uip_sr_get_node(NULL, &addr) == NULL);
+  prepare_packet(NUM_NODES - 1);
+  UNIT_TEST_ASSERT(rpl_ext_header_update());
+  UNIT_TEST_ASSERT(UIP_IP_BUF->proto == UIP_PROTO_UDP);
+  UNIT_TEST_ASSERT(uip_len == UIP_IPH_LEN + PAYLOAD_LEN);
+
+  /* And add it back */
+  UNIT_TEST_ASSERT(set_parent(NUM_NODES - 1, parent[NUM_NODES - 1]));
+  UNIT_TEST_ASSERT(check_all());
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  uint64_t setup_ns;
+  uint64_t total_ns;
+  uint64_t t;
+  int r;
+  int i;
+
+  /* Packet preparation alone, subtracted from the total */
+  t = now_ns();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    for(i = FIRST_LEAF; i < NUM_NODES; i++) {
+      prepare_packet(i);
+    }
+  }
+  setup_ns = now_ns() - t;
+
+  t = now_ns();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    for(i = FIRST_LEAF; i < NUM_NODES; i++) {
+      prepare_packet(i);
+      rpl_ext_header_update();
+    }
+  }
+  total_ns = now_ns() - t;
+
+  printf("Bench: %d destinations at depth %d, %u nodes: %.1f ns per packet\n",
+         NUM_NODES - FIRST_LEAF, CHAIN_LEN + 1, uip_sr_num_nodes(),
+         (double)(total_ns - setup_ns) / BENCH_ROUNDS / (NUM_NODES - FIRST_LEAF));
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_rpl_srh_process, ev, data)
+{
+  int i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with SRH cache %u, hash index %u\n",
+         RPL_WITH_SRH_CACHE, UIP_SR_WITH_HASH_INDEX);
+  printf("---\n");
+
+  for(i = 0; i < PAYLOAD_LEN; i++) {
+    payload[i] = i * 7;
+  }
+
+  NETSTACK_ROUTING.root_start();
+  if(!rpl_dag_root_is_root() || !build_graph()) {
+    printf("=check-me= FAILED   - could not build the graph\n");
+    exit(1);
+  }
+
+  UNIT_TEST_RUN(test_srh);
+  benchmark();
+  UNIT_TEST_RUN(test_topology_change);
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
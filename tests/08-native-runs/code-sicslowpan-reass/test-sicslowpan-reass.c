@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Fuzz test and benchmark of 6LoWPAN reassembly. UDP datagrams from
+ * many senders are fragmented, and their fragments are delivered to
+ * sicslowpan interleaved across senders and out of order within each
+ * datagram, mixed with stray fragments. Every datagram must reach the
+ * UDP socket intact. The time per fragment is then measured with all
+ * contexts reassembling 1280-byte packets at once. The native platform
+ * uses tun6 as its network layer, so frames are fed to sicslowpan
+ * directly, as the packet injector of tests/20-packet-parsing does.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/simple-udp.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/sicslowpan.h"
+#include "net/packetbuf.h"
+#include "lib/random.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_sicslowpan_reass_process, "6LoWPAN reassembly test");
+AUTOSTART_PROCESSES(&test_sicslowpan_reass_process);
+/*---------------------------------------------------------------------------*/
+#ifndef SICSLOWPAN_CONF_REASS_WITH_INDEX
+#define SICSLOWPAN_CONF_REASS_WITH_INDEX 0
+#endif
+#ifndef SICSLOWPAN_CONF_REASS_DIRECT
+#define SICSLOWPAN_CONF_REASS_DIRECT 0
+#endif
+
+#define UDP_PORT         5678
+#define NUM_SENDERS      SICSLOWPAN_CONF_REASS_CONTEXTS
+#define MAX_FRAGS        16
+#define MAX_FRAME        (5 + 104)
+#define FRAG1_PAYLOAD    64     /* After the 40-byte IPv6 header */
+#define FRAGN_PAYLOAD    104
+#define FUZZ_ROUNDS      2000
+#define BENCH_ROUNDS     5000
+
+struct frame {
+  uint8_t len;
+  uint8_t data[MAX_FRAME];
+};
+
+/* The fragments of one datagram */
+struct datagram {
+  linkaddr_t sender;
+  uint16_t seq;
+  uint8_t num_frags;
+  uint8_t next_frag;
+  struct frame frags[MAX_FRAGS];
+};
+
+static struct datagram datagrams[NUM_SENDERS];
+static struct simple_udp_connection conn;
+static uint8_t ip_packet[UIP_BUFSIZE];
+static int received;
+static int corrupted;
+static int verify;
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* Payload byte i of datagram seq from sender id */
+static uint8_t
+payload_byte(uint8_t id, uint16_t seq, uint16_t i)
+{
+  return (uint8_t)(id * 37 + seq * 11 + i * 7 + (i >> 8));
+}
+/*---------------------------------------------------------------------------*/
+static void
+udp_rx_callback(struct simple_udp_connection *c,
+                const uip_ipaddr_t *sender_addr,
+                uint16_t sender_port,
+                const uip_ipaddr_t *receiver_addr,
+                uint16_t receiver_port,
+                const uint8_t *data,
+                uint16_t datalen)
+{
+  uint8_t id;
+  uint16_t seq;
+  uint16_t i;
+
+  received++;
+  if(!verify) {
+    return;
+  }
+  if(datalen < 3) {
+    corrupted++;
+    return;
+  }
+  id = data[0];
+  seq = (data[1] << 8) | data[2];
+  if(id >= NUM_SENDERS || datagrams[id].seq != seq ||
+     packetbuf_addr(PACKETBUF_ADDR_SENDER)->u8[0] != id + 1) {
+    corrupted++;
+    return;
+  }
+  for(i = 3; i < datalen; i++) {
+    if(data[i] != payload_byte(id, seq, i)) {
+      corrupted++;
+      return;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Build an IPv6/UDP packet of the given total length from sender id,
+   and split it into uncompressed 6LoWPAN fragments */
+static void
+make_datagram(uint8_t id, uint16_t seq, uint16_t tag, uint16_t len)
+{
+  struct datagram *d = &datagrams[id];
+  const uip_ipaddr_t *addr = &uip_ds6_get_link_local(-1)->ipaddr;
+  struct uip_ip_hdr *ip = (struct uip_ip_hdr *)ip_packet;
+  struct uip_udp_hdr *udp = (struct uip_udp_hdr *)(ip_packet + UIP_IPH_LEN);
+  uint8_t *payload = ip_packet + UIP_IPUDPH_LEN;
+  uint16_t payload_len = len - UIP_IPUDPH_LEN;
+  uint16_t offset;
+  uint16_t chunk;
+  struct frame *f;
+  uint16_t i;
+
+  memset(ip_packet, 0, UIP_IPUDPH_LEN);
+  ip->vtc = 0x60;
+  ip->proto = UIP_PROTO_UDP;
+  ip->ttl = 64;
+  ip->len[0] = (len - UIP_IPH_LEN) >> 8;
+  ip->len[1] = (len - UIP_IPH_LEN) & 0xff;
+  uip_ip6addr(&ip->srcipaddr, 0xfe80, 0, 0, 0, 0, 0, 0, id + 1);
+  uip_ipaddr_copy(&ip->destipaddr, addr);
+  udp->srcport = UIP_HTONS(UDP_PORT + 1);
+  udp->destport = UIP_HTONS(UDP_PORT);
+  udp->udplen = UIP_HTONS(len - UIP_IPH_LEN);
+  payload[0] = id;
+  payload[1] = seq >> 8;
+  payload[2] = seq & 0xff;
+  for(i = 3; i < payload_len; i++) {
+    payload[i] = payload_byte(id, seq, i);
+  }
+
+  /* Compute the UDP checksum in uip_buf, as uip6.c does */
+  memcpy(uip_buf, ip_packet, len);
+  uip_ext_len = 0;
+  UIP_UDP_BUF->udpchksum = ~(uip_udpchksum());
+  if(UIP_UDP_BUF->udpchksum == 0) {
+    UIP_UDP_BUF->udpchksum = 0xffff;
+  }
+  udp->udpchksum = UIP_UDP_BUF->udpchksum;
+  uipbuf_clear();
+
+  memset(&d->sender, 0, sizeof(d->sender));
+  d->sender.u8[0] = id + 1;
+  d->seq = seq;
+  d->next_frag = 0;
+
+  /* FRAG1: dispatch and size, tag, IPv6 dispatch, header and payload */
+  f = &d->frags[0];
+  f->data[0] = 0xc0 | (len >> 8);
+  f->data[1] = len & 0xff;
+  f->data[2] = tag >> 8;
+  f->data[3] = tag & 0xff;
+  f->data[4] = 0x41;
+  chunk = UIP_IPH_LEN + FRAG1_PAYLOAD;
+  memcpy(&f->data[5], ip_packet, chunk);
+  f->len = 5 + chunk;
+  d->num_frags = 1;
+
+  /* FRAGN: dispatch and size, tag, offset in 8-byte units, payload */
+  for(offset = chunk; offset < len; offset += chunk) {
+    chunk = MIN(FRAGN_PAYLOAD, len - offset);
+    f = &d->frags[d->num_frags++];
+    f->data[0] = 0xe0 | (len >> 8);
+    f->data[1] = len & 0xff;
+    f->data[2] = tag >> 8;
+    f->data[3] = tag & 0xff;
+    f->data[4] = offset >> 3;
+    memcpy(&f->data[5], ip_packet + offset, chunk);
+    f->len = 5 + chunk;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+shuffle_fragn(struct datagram *d)
+{
+  struct frame tmp;
+  int i, j;
+
+  for(i = d->num_frags - 1; i > 1; i--) {
+    j = 1 + random_rand() % i;
+    tmp = d->frags[i];
+    d->frags[i] = d->frags[j];
+    d->frags[j] = tmp;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+deliver_frame(const linkaddr_t *sender, const uint8_t *data, uint8_t len)
+{
+  packetbuf_clear();
+  packetbuf_copyfrom(data, len);
+  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, sender);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &linkaddr_node_addr);
+  sicslowpan_driver.input();
+}
+/*---------------------------------------------------------------------------*/
+/* A FRAGN from an unknown sender, with random tag and contents */
+static void
+deliver_stray_frame(void)
+{
+  linkaddr_t sender;
+  uint8_t data[MAX_FRAME];
+  uint8_t len;
+  int i;
+
+  memset(&sender, 0, sizeof(sender));
+  sender.u8[0] = 0xf0;
+  len = 6 + random_rand() % (MAX_FRAME - 6);
+  for(i = 0; i < len; i++) {
+    data[i] = random_rand();
+  }
+  data[0] = 0xe0 | (data[0] & 0x07);
+  /* A zero offset would open a context, held until it times out */
+  data[4] |= 0x01;
+  deliver_frame(&sender, data, len);
+}
+/*---------------------------------------------------------------------------*/
+/* Deliver the fragments of the first n datagrams, picking the sender of
+   each next fragment at random, or in turn if round_robin is set */
+static void
+deliver_interleaved(int n, int round_robin, int stray)
+{
+  struct datagram *d;
+  int remaining;
+  int i;
+
+  remaining = n;
+  i = 0;
+  while(remaining > 0) {
+    i = round_robin ? (i + 1) % n : random_rand() % n;
+    d = &datagrams[i];
+    if(d->next_frag == d->num_frags) {
+      continue;
+    }
+    deliver_frame(&d->sender, d->frags[d->next_frag].data,
+                  d->frags[d->next_frag].len);
+    if(++d->next_frag == d->num_frags) {
+      remaining--;
+    }
+    if(stray && random_rand() % 8 == 0) {
+      deliver_stray_frame();
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_interleaved, "Interleaved reassembly");
+UNIT_TEST(test_interleaved)
+{
+  uint16_t seq;
+  uint16_t len;
+  int round;
+  int expected;
+  int n;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  verify = 1;
+  seq = 0;
+  expected = 0;
+  received = 0;
+  corrupted = 0;
+  for(round = 0; round < FUZZ_ROUNDS; round++) {
+    n = 1 + random_rand() % NUM_SENDERS;
+    for(i = 0; i < n; i++) {
+      len = UIP_IPUDPH_LEN + FRAG1_PAYLOAD + 1 +
+        random_rand() % (UIP_BUFSIZE - UIP_IPUDPH_LEN - FRAG1_PAYLOAD);
+      make_datagram(i, seq++, random_rand(), len);
+      shuffle_fragn(&datagrams[i]);
+    }
+    deliver_interleaved(n, 0, 1);
+    expected += n;
+    UNIT_TEST_ASSERT(received == expected);
+  }
+  UNIT_TEST_ASSERT(corrupted == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_restart, "Reassembly restarts on a new first fragment");
+UNIT_TEST(test_restart)
+{
+  struct datagram *d = &datagrams[0];
+
+  UNIT_TEST_BEGIN();
+
+  received = 0;
+  corrupted = 0;
+
+  /* Half a datagram, then the same one again with the same tag */
+  make_datagram(0, 1, 0x1234, UIP_BUFSIZE);
+  for(d->next_frag = 0; d->next_frag < d->num_frags / 2; d->next_frag++) {
+    deliver_frame(&d->sender, d->frags[d->next_frag].data,
+                  d->frags[d->next_frag].len);
+  }
+  make_datagram(0, 2, 0x1234, UIP_BUFSIZE);
+  deliver_interleaved(1, 1, 0);
+
+  UNIT_TEST_ASSERT(received == 1);
+  UNIT_TEST_ASSERT(corrupted == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+/* A first fragment, or a FRAGN at offset zero, with the given datagram
+   size from sender 0xf1 */
+static void
+deliver_short_first_frame(uint8_t dispatch, uint16_t size, uint16_t tag)
+{
+  linkaddr_t sender;
+  uint8_t data[5 + UIP_IPH_LEN];
+
+  memset(&sender, 0, sizeof(sender));
+  sender.u8[0] = 0xf1;
+  memset(data, 0, sizeof(data));
+  data[0] = dispatch | (size >> 8);
+  data[1] = size & 0xff;
+  data[2] = tag >> 8;
+  data[3] = tag & 0xff;
+  data[4] = 0x41;
+  deliver_frame(&sender, data, sizeof(data));
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_short_datagrams, "Datagrams shorter than a header");
+UNIT_TEST(test_short_datagrams)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* Many more than there are contexts, with a zero or too short size,
+     from the same sender and tag and from different tags */
+  for(i = 0; i < 4 * SICSLOWPAN_CONF_REASS_CONTEXTS; i++) {
+    deliver_short_first_frame(0xc0, 0, 0x4321);
+    deliver_short_first_frame(0xc0, 0, i);
+    deliver_short_first_frame(0xc0, UIP_IPH_LEN - 1, i);
+    deliver_short_first_frame(0xe0, 0, i);
+  }
+
+  /* No context is held, and reassembly still works for everybody */
+  received = 0;
+  corrupted = 0;
+  for(i = 0; i < NUM_SENDERS; i++) {
+    make_datagram(i, 3, 0x4321, UIP_BUFSIZE);
+  }
+  deliver_interleaved(NUM_SENDERS, 1, 0);
+  UNIT_TEST_ASSERT(received == NUM_SENDERS);
+  UNIT_TEST_ASSERT(corrupted == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  uint64_t start;
+  uint64_t ns;
+  long frags;
+  int round;
+  int i;
+
+  for(i = 0; i < NUM_SENDERS; i++) {
+    make_datagram(i, 0, i, UIP_BUFSIZE);
+  }
+
+  verify = 0;
+  received = 0;
+  frags = 0;
+  ns = 0;
+  for(round = 0; round < BENCH_ROUNDS; round++) {
+    for(i = 0; i < NUM_SENDERS; i++) {
+      datagrams[i].next_frag = 0;
+      frags += datagrams[i].num_frags;
+    }
+    start = now_ns();
+    deliver_interleaved(NUM_SENDERS, 1, 0);
+    ns += now_ns() - start;
+  }
+
+  printf("Reassembly of %d x %u bytes: %.1f ns per fragment (%d received)\n",
+         NUM_SENDERS, UIP_BUFSIZE, (double)ns / frags, received);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_sicslowpan_reass_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with %u contexts, %u buffers, index %u, direct %u\n",
+         SICSLOWPAN_CONF_REASS_CONTEXTS, SICSLOWPAN_CONF_FRAGMENT_BUFFERS,
+         SICSLOWPAN_CONF_REASS_WITH_INDEX, SICSLOWPAN_CONF_REASS_DIRECT);
+  printf("---\n");
+
+  sicslowpan_driver.init();
+  simple_udp_register(&conn, UDP_PORT, NULL, UDP_PORT + 1, udp_rx_callback);
+
+  UNIT_TEST_RUN(test_interleaved);
+  UNIT_TEST_RUN(test_restart);
+  UNIT_TEST_RUN(test_short_datagrams);
+
+  benchmark();
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,611 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test of 6LoWPAN fragment forwarding. Fragmented UDP datagrams for a
+ * remote destination are fed to sicslowpan as if they came from a
+ * neighbor, and the frames relayed to the next hop are captured. The
+ * relayed frames are then fed back with the destination address added
+ * to this node, so that the datagram is reassembled and checked at the
+ * UDP socket. Datagrams that must take the full IPv6 path instead, and
+ * datagrams dropped by the RPL hop-by-hop checks or by an IP packet
+ * processor, must not be relayed. Neither must datagrams whose routing
+ * header update changes their size; these must still be forwarded once
+ * reassembled.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/simple-udp.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-nbr.h"
+#include "net/ipv6/uip-ds6-route.h"
+#include "net/ipv6/sicslowpan.h"
+#include "net/mac/mac.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "net/routing/routing.h"
+#include "net/routing/rpl-lite/rpl.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_sicslowpan_vrb_process, "6LoWPAN fragment forwarding test");
+AUTOSTART_PROCESSES(&test_sicslowpan_vrb_process);
+/*---------------------------------------------------------------------------*/
+#ifndef SICSLOWPAN_CONF_REASS_WITH_INDEX
+#define SICSLOWPAN_CONF_REASS_WITH_INDEX 0
+#endif
+
+#define UDP_PORT         5678
+#define MAX_FRAGS        16
+#define MAX_FRAME        127
+#define FRAG1_PAYLOAD    64     /* After the 40-byte IPv6 header */
+#define FRAGN_PAYLOAD    96
+#define DATAGRAM_LEN     600
+#define MAX_CAPTURED     32
+#define TTL              30
+
+struct frame {
+  uint8_t len;
+  uint8_t data[MAX_FRAME];
+};
+
+/* The fragments of one datagram */
+struct datagram {
+  linkaddr_t sender;
+  uint8_t num_frags;
+  struct frame frags[MAX_FRAGS];
+};
+
+static struct datagram datagrams[2];
+static struct frame captured[MAX_CAPTURED];
+static linkaddr_t captured_receiver[MAX_CAPTURED];
+static int num_captured;
+static struct simple_udp_connection conn;
+static uint8_t ip_packet[UIP_BUFSIZE];
+static uip_ipaddr_t src_addr;
+static uip_ipaddr_t dst_addr;
+static uip_ipaddr_t nexthop_addr;
+static uip_lladdr_t nexthop_lladdr;
+static int received;
+static int corrupted;
+static int ip_inputs;
+static int ip_outputs;
+static int drop_input;
+static int grow_header;
+static int failures;
+
+/* Hop-by-hop headers before the UDP header: one with padding only, one
+   with a RPL option of instance 0x1e, which this node does not know */
+static const uint8_t hbh_padn[] = { UIP_PROTO_UDP, 0, 0x01, 4, 0, 0, 0, 0 };
+static const uint8_t hbh_rpl[] = { UIP_PROTO_UDP, 0, 0x63, 4, 0, 0x1e, 1, 0 };
+/* Padding, then a type 3 routing header with one address left */
+static const uint8_t hbh_srh[] = {
+  UIP_PROTO_HBHO, 0, 0x01, 4, 0, 0, 0, 0,
+  UIP_PROTO_ROUTING, 0, 0x01, 4, 0, 0, 0, 0,
+  UIP_PROTO_UDP, 2, 3, 1, 0xe0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* A MAC layer that keeps the frames sent */
+static void
+init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static void
+send(mac_callback_t sent, void *ptr)
+{
+  if(num_captured < MAX_CAPTURED) {
+    captured[num_captured].len = packetbuf_datalen();
+    memcpy(captured[num_captured].data, packetbuf_dataptr(),
+           packetbuf_datalen());
+    linkaddr_copy(&captured_receiver[num_captured],
+                  packetbuf_addr(PACKETBUF_ADDR_RECEIVER));
+    num_captured++;
+  }
+  mac_call_sent_callback(sent, ptr, MAC_TX_OK, 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+input(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+max_payload(void)
+{
+  return MAX_FRAME - 2 - 21;
+}
+/*---------------------------------------------------------------------------*/
+const struct mac_driver test_mac_driver = {
+  "Test MAC",
+  init,
+  send,
+  input,
+  on,
+  off,
+  max_payload,
+};
+/*---------------------------------------------------------------------------*/
+/* RPL Lite, with a routing header update that can insert a hop-by-hop
+   header with padding only, as RPL does at the source of a datagram */
+extern const struct routing_driver rpl_lite_driver;
+
+static void
+routing_init(void)
+{
+  rpl_lite_driver.init();
+}
+/*---------------------------------------------------------------------------*/
+static int
+get_sr_node_ipaddr(uip_ipaddr_t *addr, const uip_sr_node_t *node)
+{
+  return rpl_lite_driver.get_sr_node_ipaddr(addr, node);
+}
+/*---------------------------------------------------------------------------*/
+static int
+node_has_joined(void)
+{
+  return rpl_lite_driver.node_has_joined();
+}
+/*---------------------------------------------------------------------------*/
+static int
+ext_header_update(void)
+{
+  if(!grow_header) {
+    return rpl_ext_header_update();
+  }
+  if(uip_len + sizeof(hbh_padn) > UIP_BUFSIZE) {
+    return 0;
+  }
+  memmove(UIP_IP_PAYLOAD(sizeof(hbh_padn)), UIP_IP_PAYLOAD(0),
+          uip_len - UIP_IPH_LEN);
+  memcpy(UIP_IP_PAYLOAD(0), hbh_padn, sizeof(hbh_padn));
+  UIP_IP_PAYLOAD(0)[0] = UIP_IP_BUF->proto;
+  UIP_IP_BUF->proto = UIP_PROTO_HBHO;
+  uipbuf_add_ext_hdr(sizeof(hbh_padn));
+  uipbuf_set_len_field(UIP_IP_BUF, uip_len - UIP_IPH_LEN);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+neighbor_state_changed(uip_ds6_nbr_t *nbr)
+{
+  rpl_lite_driver.neighbor_state_changed(nbr);
+}
+/*---------------------------------------------------------------------------*/
+static void
+drop_route(uip_ds6_route_t *route)
+{
+  rpl_lite_driver.drop_route(route);
+}
+/*---------------------------------------------------------------------------*/
+const struct routing_driver test_routing_driver = {
+  "Test routing",
+  routing_init,
+  rpl_dag_root_set_prefix,
+  rpl_dag_root_start,
+  rpl_dag_root_is_root,
+  rpl_dag_get_root_ipaddr,
+  get_sr_node_ipaddr,
+  rpl_dag_poison_and_leave,
+  node_has_joined,
+  rpl_is_reachable,
+  rpl_global_repair,
+  rpl_local_repair,
+  rpl_ext_header_remove,
+  ext_header_update,
+  rpl_ext_header_hbh_update,
+  rpl_ext_header_srh_update,
+  rpl_ext_header_srh_get_next_hop,
+  rpl_link_callback,
+  neighbor_state_changed,
+  drop_route,
+  rpl_get_leaf_only,
+};
+/*---------------------------------------------------------------------------*/
+static enum netstack_ip_action
+ip_input(void)
+{
+  ip_inputs++;
+  return drop_input ? NETSTACK_IP_DROP : NETSTACK_IP_PROCESS;
+}
+/*---------------------------------------------------------------------------*/
+static enum netstack_ip_action
+ip_output(const linkaddr_t *localdest)
+{
+  ip_outputs++;
+  return NETSTACK_IP_PROCESS;
+}
+/*---------------------------------------------------------------------------*/
+static struct netstack_ip_packet_processor packet_processor = {
+  .process_input = ip_input,
+  .process_output = ip_output
+};
+/*---------------------------------------------------------------------------*/
+static uint8_t
+payload_byte(uint8_t id, uint16_t i)
+{
+  return (uint8_t)(id * 37 + i * 7 + (i >> 8));
+}
+/*---------------------------------------------------------------------------*/
+static void
+udp_rx_callback(struct simple_udp_connection *c,
+                const uip_ipaddr_t *sender_addr,
+                uint16_t sender_port,
+                const uip_ipaddr_t *receiver_addr,
+                uint16_t receiver_port,
+                const uint8_t *data,
+                uint16_t datalen)
+{
+  uint16_t i;
+
+  received++;
+  /* One hop was taken on the way */
+  if(datalen < 1 || data[0] > 1 || UIP_IP_BUF->ttl != TTL - 1 ||
+     !uip_ipaddr_cmp(sender_addr, &src_addr) ||
+     !uip_ipaddr_cmp(receiver_addr, &dst_addr)) {
+    corrupted++;
+    return;
+  }
+  for(i = 1; i < datalen; i++) {
+    if(data[i] != payload_byte(data[0], i)) {
+      corrupted++;
+      return;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Build an IPv6/UDP packet of the given total length with the given
+   extension headers, and split it into uncompressed 6LoWPAN fragments */
+static void
+make_datagram(uint8_t id, uint16_t tag, const uint8_t *ext, uint8_t ext_len,
+              uint8_t ttl)
+{
+  struct datagram *d = &datagrams[id];
+  struct uip_ip_hdr *ip = (struct uip_ip_hdr *)ip_packet;
+  struct uip_udp_hdr *udp;
+  uint8_t *payload;
+  uint16_t len = DATAGRAM_LEN;
+  uint16_t payload_len;
+  uint16_t offset;
+  uint16_t chunk;
+  struct frame *f;
+  uint16_t i;
+
+  memset(ip_packet, 0, UIP_IPH_LEN + ext_len + UIP_UDPH_LEN);
+  ip->vtc = 0x60;
+  ip->proto = ext_len > 0 ? UIP_PROTO_HBHO : UIP_PROTO_UDP;
+  ip->ttl = ttl;
+  ip->len[0] = (len - UIP_IPH_LEN) >> 8;
+  ip->len[1] = (len - UIP_IPH_LEN) & 0xff;
+  uip_ipaddr_copy(&ip->srcipaddr, &src_addr);
+  uip_ipaddr_copy(&ip->destipaddr, &dst_addr);
+  memcpy(ip_packet + UIP_IPH_LEN, ext, ext_len);
+  udp = (struct uip_udp_hdr *)(ip_packet + UIP_IPH_LEN + ext_len);
+  udp->srcport = UIP_HTONS(UDP_PORT + 1);
+  udp->destport = UIP_HTONS(UDP_PORT);
+  udp->udplen = UIP_HTONS(len - UIP_IPH_LEN - ext_len);
+  payload = (uint8_t *)udp + UIP_UDPH_LEN;
+  payload_len = len - UIP_IPH_LEN - ext_len - UIP_UDPH_LEN;
+  payload[0] = id;
+  for(i = 1; i < payload_len; i++) {
+    payload[i] = payload_byte(id, i);
+  }
+
+  /* Compute the UDP checksum in uip_buf, as uip6.c does */
+  memcpy(uip_buf, ip_packet, len);
+  uip_len = len;
+  uip_ext_len = ext_len;
+  UIP_UDP_BUF->udpchksum = ~(uip_udpchksum());
+  if(UIP_UDP_BUF->udpchksum == 0) {
+    UIP_UDP_BUF->udpchksum = 0xffff;
+  }
+  udp->udpchksum = UIP_UDP_BUF->udpchksum;
+  uipbuf_clear();
+
+  memset(&d->sender, 0, sizeof(d->sender));
+  d->sender.u8[0] = id + 1;
+
+  /* FRAG1: dispatch and size, tag, IPv6 dispatch, header and payload */
+  f = &d->frags[0];
+  f->data[0] = 0xc0 | (len >> 8);
+  f->data[1] = len & 0xff;
+  f->data[2] = tag >> 8;
+  f->data[3] = tag & 0xff;
+  f->data[4] = 0x41;
+  chunk = UIP_IPH_LEN + FRAG1_PAYLOAD;
+  memcpy(&f->data[5], ip_packet, chunk);
+  f->len = 5 + chunk;
+  d->num_frags = 1;
+
+  /* FRAGN: dispatch and size, tag, offset in 8-byte units, payload */
+  for(offset = chunk; offset < len; offset += chunk) {
+    chunk = MIN(FRAGN_PAYLOAD, len - offset);
+    f = &d->frags[d->num_frags++];
+    f->data[0] = 0xe0 | (len >> 8);
+    f->data[1] = len & 0xff;
+    f->data[2] = tag >> 8;
+    f->data[3] = tag & 0xff;
+    f->data[4] = offset >> 3;
+    memcpy(&f->data[5], ip_packet + offset, chunk);
+    f->len = 5 + chunk;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+deliver_frame(const linkaddr_t *sender, const linkaddr_t *receiver,
+              const uint8_t *data, uint8_t len)
+{
+  packetbuf_clear();
+  packetbuf_copyfrom(data, len);
+  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, sender);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, receiver);
+  sicslowpan_driver.input();
+}
+/*---------------------------------------------------------------------------*/
+/* Deliver the fragments of the first n datagrams, in turn */
+static void
+deliver(int n)
+{
+  int f;
+  int i;
+
+  num_captured = 0;
+  for(f = 0; f < MAX_FRAGS; f++) {
+    for(i = 0; i < n; i++) {
+      if(f < datagrams[i].num_frags) {
+        deliver_frame(&datagrams[i].sender, &linkaddr_node_addr,
+                      datagrams[i].frags[f].data, datagrams[i].frags[f].len);
+      }
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Check that the captured frames relay n datagrams to the next hop under
+   distinct tags, and feed them back as if this node were the destination.
+   Returns the number of datagrams received intact. */
+static int
+check_relayed(int n)
+{
+  uint16_t tags[2];
+  int num_tags;
+  uint16_t tag;
+  int i;
+  int t;
+
+  num_tags = 0;
+  for(i = 0; i < num_captured; i++) {
+    if(!linkaddr_cmp(&captured_receiver[i],
+                     (const linkaddr_t *)&nexthop_lladdr) ||
+       ((captured[i].data[0] << 8 | captured[i].data[1]) & 0x07ff) !=
+       DATAGRAM_LEN) {
+      return -1;
+    }
+    tag = captured[i].data[2] << 8 | captured[i].data[3];
+    for(t = 0; t < num_tags && tags[t] != tag; t++);
+    if(t == num_tags) {
+      if(num_tags == n || (captured[i].data[0] & 0xf8) != 0xc0) {
+        /* A datagram too many, or one that does not start with FRAG1 */
+        return -1;
+      }
+      tags[num_tags++] = tag;
+    }
+  }
+  if(num_tags != n) {
+    return -1;
+  }
+
+  received = 0;
+  corrupted = 0;
+  uip_ds6_addr_add(&dst_addr, 0, ADDR_MANUAL);
+  for(i = 0; i < num_captured; i++) {
+    deliver_frame(&linkaddr_node_addr, (const linkaddr_t *)&nexthop_lladdr,
+                  captured[i].data, captured[i].len);
+  }
+  uip_ds6_addr_rm(uip_ds6_addr_lookup(&dst_addr));
+  return corrupted == 0 ? received : -1;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_forward, "Forwarding");
+UNIT_TEST(test_forward)
+{
+  uip_stats_t forwarded;
+
+  UNIT_TEST_BEGIN();
+
+  forwarded = uip_stat.ip.forwarded;
+  ip_inputs = 0;
+  ip_outputs = 0;
+  make_datagram(0, 0x100, NULL, 0, TTL);
+  deliver(1);
+  UNIT_TEST_ASSERT(num_captured >= datagrams[0].num_frags);
+  UNIT_TEST_ASSERT(uip_stat.ip.forwarded == forwarded + 1);
+  UNIT_TEST_ASSERT(ip_inputs == 1);
+  UNIT_TEST_ASSERT(ip_outputs == 1);
+  UNIT_TEST_ASSERT(check_relayed(1) == 1);
+
+  /* With a hop-by-hop header, and two datagrams at once */
+  make_datagram(0, 0x101, hbh_padn, sizeof(hbh_padn), TTL);
+  make_datagram(1, 0x101, NULL, 0, TTL);
+  deliver(2);
+  UNIT_TEST_ASSERT(uip_stat.ip.forwarded == forwarded + 3);
+  UNIT_TEST_ASSERT(check_relayed(2) == 2);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_dropped, "Dropped datagrams");
+UNIT_TEST(test_dropped)
+{
+  uip_stats_t drop;
+
+  UNIT_TEST_BEGIN();
+
+  /* RPL rejects the option of an unknown instance */
+  drop = uip_stat.ip.drop;
+  make_datagram(0, 0x200, hbh_rpl, sizeof(hbh_rpl), TTL);
+  deliver(1);
+  UNIT_TEST_ASSERT(num_captured == 0);
+  UNIT_TEST_ASSERT(uip_stat.ip.drop == drop + 1);
+
+  /* And so does an IP packet processor */
+  drop_input = 1;
+  ip_inputs = 0;
+  make_datagram(0, 0x201, NULL, 0, TTL);
+  deliver(1);
+  drop_input = 0;
+  UNIT_TEST_ASSERT(num_captured == 0);
+  UNIT_TEST_ASSERT(ip_inputs == 1);
+  UNIT_TEST_ASSERT(uip_stat.ip.drop == drop + 2);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_reassembled, "Datagrams for the IPv6 path");
+UNIT_TEST(test_reassembled)
+{
+  uip_ds6_nbr_t *nbr;
+  uip_stats_t forwarded;
+  uip_stats_t drop;
+
+  UNIT_TEST_BEGIN();
+
+  /* Each of these is reassembled and handed to the IPv6 layer, which
+     sends whatever it forwards through tun6, not through sicslowpan */
+  forwarded = uip_stat.ip.forwarded;
+
+  /* A routing header after a hop-by-hop header */
+  ip_inputs = 0;
+  make_datagram(0, 0x300, hbh_srh, sizeof(hbh_srh), TTL);
+  deliver(1);
+  UNIT_TEST_ASSERT(num_captured == 0);
+  UNIT_TEST_ASSERT(ip_inputs == 1);
+
+  /* A hop limit that expires here */
+  ip_inputs = 0;
+  make_datagram(0, 0x301, NULL, 0, 1);
+  deliver(1);
+  UNIT_TEST_ASSERT(num_captured == 0);
+  UNIT_TEST_ASSERT(ip_inputs == 1);
+
+  /* No link-layer address for the next hop */
+  nbr = uip_ds6_nbr_lookup(&nexthop_addr);
+  uip_ds6_nbr_rm(nbr);
+  ip_inputs = 0;
+  make_datagram(0, 0x302, NULL, 0, TTL);
+  deliver(1);
+  UNIT_TEST_ASSERT(num_captured == 0);
+  UNIT_TEST_ASSERT(ip_inputs == 1);
+  UNIT_TEST_ASSERT(uip_ds6_nbr_add(&nexthop_addr, &nexthop_lladdr, 1,
+                                   NBR_REACHABLE, NBR_TABLE_REASON_UNDEFINED,
+                                   NULL) != NULL);
+
+  /* A routing header update that inserts a header. The datagram is
+     forwarded on the IPv6 path once reassembled, not dropped. */
+  drop = uip_stat.ip.drop;
+  forwarded = uip_stat.ip.forwarded;
+  grow_header = 1;
+  make_datagram(0, 0x303, NULL, 0, TTL);
+  deliver(1);
+  grow_header = 0;
+  UNIT_TEST_ASSERT(num_captured == 0);
+  UNIT_TEST_ASSERT(uip_stat.ip.drop == drop);
+  UNIT_TEST_ASSERT(uip_stat.ip.forwarded == forwarded + 1);
+  forwarded = uip_stat.ip.forwarded;
+
+  /* Then forwarding carries on */
+  make_datagram(0, 0x304, NULL, 0, TTL);
+  deliver(1);
+  UNIT_TEST_ASSERT(check_relayed(1) == 1);
+  UNIT_TEST_ASSERT(uip_stat.ip.forwarded > forwarded);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_sicslowpan_vrb_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with reassembly index %u\n",
+         SICSLOWPAN_CONF_REASS_WITH_INDEX);
+  printf("---\n");
+
+  sicslowpan_driver.init();
+  simple_udp_register(&conn, UDP_PORT, NULL, UDP_PORT + 1, udp_rx_callback);
+  netstack_ip_packet_processor_add(&packet_processor);
+
+  /* A remote source and destination, reached through a default router */
+  uip_ip6addr(&src_addr, 0x2001, 0xdb8, 1, 0, 0, 0, 0, 1);
+  uip_ip6addr(&dst_addr, 0x2001, 0xdb8, 2, 0, 0, 0, 0, 1);
+  uip_ip6addr(&nexthop_addr, 0xfe80, 0, 0, 0, 0, 0, 0, 0x99);
+  memset(&nexthop_lladdr, 0, sizeof(nexthop_lladdr));
+  nexthop_lladdr.addr[0] = 0x99;
+  uip_ds6_nbr_add(&nexthop_addr, &nexthop_lladdr, 1, NBR_REACHABLE,
+                  NBR_TABLE_REASON_UNDEFINED, NULL);
+  uip_ds6_defrt_add(&nexthop_addr, 0);
+
+  UNIT_TEST_RUN(test_forward);
+  UNIT_TEST_RUN(test_dropped);
+  UNIT_TEST_RUN(test_reassembled);
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the TSCH per-slot log. A sequence of tx, rx and
+ * message logs, with and without link, and with queue overflows, is
+ * added and drained. The test script runs it with text and with binary
+ * output, decodes the binary output with tools/tsch-log and checks that
+ * both traces are identical. The sampling of each log type is checked,
+ * and the cost of adding and of draining logs is measured.
+ */
+
+#include "contiki.h"
+#include "net/mac/tsch/tsch.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_tsch_log_process, "TSCH log test");
+AUTOSTART_PROCESSES(&test_tsch_log_process);
+/*---------------------------------------------------------------------------*/
+#define TRACE_EVENTS     300
+#define SAMPLED_EVENTS   400
+#define BENCH_EVENTS     1000000
+#define BENCH_DRAINS     100000
+
+static int failures;
+static int logged;
+/*---------------------------------------------------------------------------*/
+/* The parts of TSCH used by the log */
+PROCESS(tsch_pending_events_process, "pending events process");
+PROCESS_THREAD(tsch_pending_events_process, ev, data)
+{
+  PROCESS_BEGIN();
+  PROCESS_END();
+}
+struct tsch_asn_t tsch_current_asn;
+struct tsch_link *current_link;
+int tsch_current_burst_count;
+uint8_t tsch_current_channel;
+static struct tsch_slotframe slotframe;
+/*---------------------------------------------------------------------------*/
+struct tsch_slotframe *
+tsch_schedule_get_slotframe_by_handle(uint16_t handle)
+{
+  return handle == slotframe.handle ? &slotframe : NULL;
+}
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* Sets up the slot of event i and adds a log for it. The values are
+   picked to include SLIP special characters */
+static void
+add_event(int i)
+{
+  static struct tsch_link links[3];
+  linkaddr_t addr;
+  int j;
+
+  slotframe.handle = 1;
+  slotframe.size.val = 397;
+  for(j = 0; j < 3; j++) {
+    links[j].slotframe_handle = j;
+    links[j].timeslot = 0xc0 + j * 100;
+    links[j].channel_offset = j;
+  }
+
+  tsch_current_asn.ms1b = i >> 7;
+  tsch_current_asn.ls4b = 0xc0dbc0db + i * 0x10101;
+  current_link = i % 5 == 0 ? NULL : &links[i % 3];
+  tsch_current_burst_count = i % 2;
+  tsch_current_channel = 11 + i % 16;
+  for(j = 0; j < LINKADDR_SIZE; j++) {
+    addr.u8[j] = i % 7 == 0 ? 0 : 0xc0 + (i + j) % 32;
+  }
+
+  switch(i % 3) {
+  case 0:
+    TSCH_LOG_ADD(tsch_log_tx,
+        log->tx.mac_tx_status = i % 4;
+        log->tx.dest = addr;
+        log->tx.num_tx = 1 + i % 8;
+        log->tx.datalen = i % 128;
+        log->tx.is_data = i % 2;
+        log->tx.sec_level = i % 8;
+        log->tx.drift = -i;
+        log->tx.drift_used = i % 4 == 0;
+        log->tx.seqno = i;
+        logged++;
+    );
+    break;
+  case 1:
+    TSCH_LOG_ADD(tsch_log_rx,
+        log->rx.src = addr;
+        log->rx.is_unicast = i % 2;
+        log->rx.datalen = i % 128;
+        log->rx.drift = i;
+        log->rx.drift_used = i % 5 == 0;
+        log->rx.is_data = i % 4 == 1;
+        log->rx.sec_level = i % 8;
+        log->rx.estimated_drift = -2 * i;
+        log->rx.seqno = i;
+        logged++;
+    );
+    break;
+  default:
+    TSCH_LOG_ADD(tsch_log_message,
+        snprintf(log->message, sizeof(log->message),
+            "event %d \xc0\xdb %u", i, (unsigned)i * 7);
+        logged++;
+    );
+    break;
+  }
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_trace, "Trace of tx, rx and message logs");
+UNIT_TEST(test_trace)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  logged = 0;
+  for(i = 0; i < TRACE_EVENTS; i++) {
+    add_event(i);
+    /* Drain regularly, except for a while to overflow the queue */
+    if(i % 4 == 3 && (i < 100 || i > 130)) {
+      tsch_log_process_pending();
+    }
+  }
+  tsch_log_process_pending();
+  fflush(stdout);
+
+  UNIT_TEST_ASSERT(logged < TRACE_EVENTS);
+  UNIT_TEST_ASSERT(logged > TRACE_EVENTS - 30);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_sampling, "Sampling of each log type");
+UNIT_TEST(test_sampling)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* One tx log out of 4, no rx log, one message out of 10 */
+  tsch_log_set_sampling(tsch_log_tx, 4);
+  tsch_log_set_sampling(tsch_log_rx, 0);
+  tsch_log_set_sampling(tsch_log_message, 10);
+
+  logged = 0;
+  for(i = 0; i < SAMPLED_EVENTS * 3; i++) {
+    add_event(i);
+    tsch_log_process_pending();
+  }
+  fflush(stdout);
+  UNIT_TEST_ASSERT(logged == SAMPLED_EVENTS / 4 + SAMPLED_EVENTS / 10);
+
+  tsch_log_set_sampling(tsch_log_tx, 1);
+  tsch_log_set_sampling(tsch_log_rx, 1);
+  tsch_log_set_sampling(tsch_log_message, 1);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  uint64_t start;
+  uint64_t ns_skip;
+  uint64_t ns_add;
+  uint64_t ns_drain;
+  int saved_stdout;
+  int i;
+
+  /* Logs are drained to /dev/null during the benchmark */
+  fflush(stdout);
+  saved_stdout = dup(STDOUT_FILENO);
+  dup2(open("/dev/null", O_WRONLY), STDOUT_FILENO);
+
+  tsch_log_set_sampling(tsch_log_tx, 0);
+  start = now_ns();
+  for(i = 0; i < BENCH_EVENTS; i++) {
+    TSCH_LOG_ADD(tsch_log_tx, log->tx.seqno = i);
+  }
+  ns_skip = now_ns() - start;
+  tsch_log_set_sampling(tsch_log_tx, 1);
+
+  ns_add = 0;
+  ns_drain = 0;
+  for(i = 0; i < BENCH_DRAINS; i++) {
+    start = now_ns();
+    add_event(i * 3);
+    add_event(i * 3 + 1);
+    ns_add += now_ns() - start;
+    start = now_ns();
+    tsch_log_process_pending();
+    ns_drain += now_ns() - start;
+  }
+
+  fflush(stdout);
+  dup2(saved_stdout, STDOUT_FILENO);
+  close(saved_stdout);
+
+  printf("Log skipped by sampling: %.1f ns\n", (double)ns_skip / BENCH_EVENTS);
+  printf("Log added: %.1f ns, drained: %.1f ns\n",
+         (double)ns_add / BENCH_DRAINS / 2, (double)ns_drain / BENCH_DRAINS / 2);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_tsch_log_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  linkaddr_node_addr.u8[LINKADDR_SIZE - 2] = 0xc0;
+  linkaddr_node_addr.u8[LINKADDR_SIZE - 1] = 0x01;
+  tsch_log_init();
+
+  UNIT_TEST_RUN(test_trace);
+  UNIT_TEST_RUN(test_sampling);
+
+  benchmark();
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
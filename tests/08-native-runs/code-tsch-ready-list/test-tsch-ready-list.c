@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test of the neighbor selection for shared cells. Packets are queued
+ * for several neighbors, and the neighbor served by
+ * tsch_queue_get_unicast_packet_for_any() in a shared cell is checked
+ * as transmissions succeed, backoffs expire, notifications of the ready
+ * list overflow and Tx links are removed. With the ready list, neighbors
+ * are served round-robin; without it, from the head of the neighbor list.
+ */
+
+#include "contiki.h"
+#include "net/mac/tsch/tsch.h"
+#include "net/packetbuf.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_tsch_ready_list_process, "TSCH ready list test");
+AUTOSTART_PROCESSES(&test_tsch_ready_list_process);
+/*---------------------------------------------------------------------------*/
+/* More neighbors than the ready list can take notifications for */
+#define NUM_MANY_NBRS    20
+
+static struct tsch_link shared_link;
+static int failures;
+/*---------------------------------------------------------------------------*/
+/* The parts of TSCH used by the queue and the schedule */
+const linkaddr_t tsch_broadcast_address = { { 0xff, 0xff, 0xff, 0xff,
+                                              0xff, 0xff, 0xff, 0xff } };
+const linkaddr_t tsch_eb_address = { { 0, 0, 0, 0, 0, 0, 0, 0 } };
+int tsch_is_coordinator;
+struct tsch_link *current_link;
+/*---------------------------------------------------------------------------*/
+int
+tsch_is_locked(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+tsch_get_lock(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_release_lock(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_set_ka_timeout(uint32_t timeout)
+{
+}
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static const linkaddr_t *
+nbr_addr(uint8_t id)
+{
+  static linkaddr_t addr;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.u8[0] = 0x10;
+  addr.u8[LINKADDR_SIZE - 1] = id;
+  return &addr;
+}
+/*---------------------------------------------------------------------------*/
+static struct tsch_neighbor *
+nbr(uint8_t id)
+{
+  return tsch_queue_get_nbr(nbr_addr(id));
+}
+/*---------------------------------------------------------------------------*/
+static int
+queue_packets(uint8_t id, int count)
+{
+  int i;
+
+  for(i = 0; i < count; i++) {
+    packetbuf_clear();
+    packetbuf_copyfrom(&id, 1);
+    if(tsch_queue_add_packet(nbr_addr(id), 1, NULL, NULL) == NULL) {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Transmit in the shared cell, successfully. Returns the id of the
+   neighbor served, or 0 if none */
+static uint8_t
+serve(void)
+{
+  struct tsch_neighbor *n = NULL;
+  struct tsch_packet *p;
+  uint8_t id;
+
+  p = tsch_queue_get_unicast_packet_for_any(&n, &shared_link);
+  if(p == NULL || n == NULL) {
+    return 0;
+  }
+  id = n->addr.u8[LINKADDR_SIZE - 1];
+  if(!tsch_queue_packet_sent(n, p, &shared_link, MAC_TX_OK)) {
+    tsch_queue_free_packet(p);
+  }
+  return id;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_round_robin, "Service order");
+UNIT_TEST(test_round_robin)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(queue_packets(1, 3));
+  UNIT_TEST_ASSERT(queue_packets(2, 3));
+  UNIT_TEST_ASSERT(queue_packets(3, 3));
+
+  for(i = 0; i < 9; i++) {
+#if TSCH_QUEUE_WITH_READY_LIST
+    UNIT_TEST_ASSERT(serve() == 1 + i % 3);
+#else /* TSCH_QUEUE_WITH_READY_LIST */
+    UNIT_TEST_ASSERT(serve() == 1 + i / 3);
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
+  }
+  UNIT_TEST_ASSERT(serve() == 0);
+
+  /* A neighbor in backoff is skipped until its backoff expires */
+  UNIT_TEST_ASSERT(queue_packets(1, 2));
+  UNIT_TEST_ASSERT(queue_packets(2, 2));
+  nbr(1)->backoff_window = 2;
+  UNIT_TEST_ASSERT(serve() == 2);
+  UNIT_TEST_ASSERT(serve() == 2);
+  UNIT_TEST_ASSERT(serve() == 0);
+  tsch_queue_update_all_backoff_windows(&tsch_broadcast_address);
+  UNIT_TEST_ASSERT(serve() == 0);
+  tsch_queue_update_all_backoff_windows(&tsch_broadcast_address);
+  UNIT_TEST_ASSERT(serve() == 1);
+  UNIT_TEST_ASSERT(serve() == 1);
+  UNIT_TEST_ASSERT(serve() == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_many_nbrs, "More neighbors than notifications");
+UNIT_TEST(test_many_nbrs)
+{
+  uint8_t served[NUM_MANY_NBRS + 1];
+  uint8_t id;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* Every neighbor is served once, even though not all of them could be
+     notified to the ready list */
+  for(i = 1; i <= NUM_MANY_NBRS; i++) {
+    UNIT_TEST_ASSERT(queue_packets(i, 1));
+  }
+  memset(served, 0, sizeof(served));
+  for(i = 0; i < NUM_MANY_NBRS; i++) {
+    id = serve();
+    UNIT_TEST_ASSERT(id >= 1 && id <= NUM_MANY_NBRS);
+    UNIT_TEST_ASSERT(!served[id]);
+    served[id] = 1;
+  }
+  UNIT_TEST_ASSERT(serve() == 0);
+
+  /* The ready list keeps working once rebuilt */
+  UNIT_TEST_ASSERT(queue_packets(5, 2));
+  UNIT_TEST_ASSERT(queue_packets(4, 2));
+#if TSCH_QUEUE_WITH_READY_LIST
+  UNIT_TEST_ASSERT(serve() == 5);
+  UNIT_TEST_ASSERT(serve() == 4);
+  UNIT_TEST_ASSERT(serve() == 5);
+  UNIT_TEST_ASSERT(serve() == 4);
+#else /* TSCH_QUEUE_WITH_READY_LIST */
+  UNIT_TEST_ASSERT(serve() == 4);
+  UNIT_TEST_ASSERT(serve() == 4);
+  UNIT_TEST_ASSERT(serve() == 5);
+  UNIT_TEST_ASSERT(serve() == 5);
+#endif /* TSCH_QUEUE_WITH_READY_LIST */
+  UNIT_TEST_ASSERT(serve() == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_tx_link_removal, "Removal of the last Tx link");
+UNIT_TEST(test_tx_link_removal)
+{
+  struct tsch_slotframe *sf;
+  struct tsch_link *l1;
+  struct tsch_link *l2;
+
+  UNIT_TEST_BEGIN();
+
+  /* A neighbor with Tx links is not served in shared cells */
+  sf = tsch_schedule_add_slotframe(1, 7);
+  UNIT_TEST_ASSERT(sf != NULL);
+  l1 = tsch_schedule_add_link(sf, LINK_OPTION_TX, LINK_TYPE_NORMAL,
+                              nbr_addr(30), 1, 0);
+  l2 = tsch_schedule_add_link(sf, LINK_OPTION_TX, LINK_TYPE_NORMAL,
+                              nbr_addr(30), 2, 0);
+  UNIT_TEST_ASSERT(l1 != NULL && l2 != NULL);
+  UNIT_TEST_ASSERT(nbr(30)->tx_links_count == 2);
+  UNIT_TEST_ASSERT(queue_packets(30, 2));
+  UNIT_TEST_ASSERT(serve() == 0);
+
+  /* Nor once one of them is removed */
+  UNIT_TEST_ASSERT(tsch_schedule_remove_link(sf, l1));
+  UNIT_TEST_ASSERT(serve() == 0);
+
+  /* Its packets go in shared cells after the last one is removed */
+  UNIT_TEST_ASSERT(tsch_schedule_remove_link(sf, l2));
+  UNIT_TEST_ASSERT(nbr(30)->tx_links_count == 0);
+  UNIT_TEST_ASSERT(serve() == 30);
+  UNIT_TEST_ASSERT(serve() == 30);
+  UNIT_TEST_ASSERT(serve() == 0);
+
+  UNIT_TEST_ASSERT(tsch_schedule_remove_slotframe(sf));
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_tsch_ready_list_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with ready list %u\n", TSCH_QUEUE_WITH_READY_LIST);
+  printf("---\n");
+
+  tsch_queue_init();
+  tsch_schedule_init();
+  shared_link.link_options = LINK_OPTION_TX | LINK_OPTION_RX |
+    LINK_OPTION_SHARED;
+  shared_link.link_type = LINK_TYPE_ADVERTISING;
+  linkaddr_copy(&shared_link.addr, &tsch_broadcast_address);
+
+  UNIT_TEST_RUN(test_round_robin);
+  UNIT_TEST_RUN(test_many_nbrs);
+  UNIT_TEST_RUN(test_tx_link_removal);
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
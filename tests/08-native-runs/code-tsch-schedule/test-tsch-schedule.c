@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the TSCH next active link lookup. Random
+ * schedules are built and the link returned for random ASNs is checked
+ * against a scan of all links, as done by the scheduler before the link
+ * index. The lookup time is then measured against the number of links.
+ */
+
+#include "contiki.h"
+#include "net/mac/tsch/tsch.h"
+#include "lib/random.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_tsch_schedule_process, "TSCH schedule test");
+AUTOSTART_PROCESSES(&test_tsch_schedule_process);
+/*---------------------------------------------------------------------------*/
+#define FUZZ_SCHEDULES   50
+#define FUZZ_LOOKUPS     2000
+#define BENCH_SF_SIZE    1021
+#define BENCH_SAMPLES    64
+#define BENCH_REPS       200
+
+static const uint16_t fuzz_sf_sizes[] = { 7, 31, 101, 397 };
+static const uint16_t bench_link_counts[] = { 8, 32, 128, 512 };
+
+static int failures;
+/*---------------------------------------------------------------------------*/
+/* The parts of TSCH used by the schedule */
+const linkaddr_t tsch_broadcast_address = { { 0xff, 0xff, 0xff, 0xff,
+                                              0xff, 0xff, 0xff, 0xff } };
+struct tsch_link *current_link;
+static struct tsch_neighbor nbr;
+/*---------------------------------------------------------------------------*/
+int
+tsch_is_locked(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+tsch_get_lock(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_release_lock(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+struct tsch_neighbor *
+tsch_queue_add_nbr(const linkaddr_t *addr)
+{
+  return &nbr;
+}
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* Next active link, found by scanning every link of every slotframe */
+static struct tsch_link *
+reference_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset,
+                           struct tsch_link **backup_link)
+{
+  uint16_t time_to_curr_best = 0;
+  struct tsch_link *curr_best = NULL;
+  struct tsch_link *curr_backup = NULL;
+  struct tsch_slotframe *sf;
+  struct tsch_link *l;
+
+  for(sf = tsch_schedule_slotframe_head(); sf != NULL;
+      sf = tsch_schedule_slotframe_next(sf)) {
+    uint16_t timeslot = TSCH_ASN_MOD(*asn, sf->size);
+    for(l = list_head(sf->links_list); l != NULL; l = list_item_next(l)) {
+      uint16_t time_to_timeslot =
+        l->timeslot > timeslot ?
+        l->timeslot - timeslot :
+        sf->size.val + l->timeslot - timeslot;
+      if(curr_best == NULL || time_to_timeslot < time_to_curr_best) {
+        time_to_curr_best = time_to_timeslot;
+        curr_best = l;
+        curr_backup = NULL;
+      } else if(time_to_timeslot == time_to_curr_best) {
+        struct tsch_link *new_best = NULL;
+        if((curr_best->link_options & LINK_OPTION_TX) ==
+           (l->link_options & LINK_OPTION_TX)) {
+          if(l->slotframe_handle < curr_best->slotframe_handle) {
+            new_best = l;
+          }
+        } else if(l->link_options & LINK_OPTION_TX) {
+          new_best = l;
+        }
+        if(curr_backup == NULL) {
+          if(new_best != l && (l->link_options & LINK_OPTION_RX)) {
+            curr_backup = l;
+          }
+          if(new_best != curr_best &&
+             (curr_best->link_options & LINK_OPTION_RX)) {
+            curr_backup = curr_best;
+          }
+        }
+        if(new_best != NULL) {
+          curr_best = new_best;
+        }
+      }
+    }
+  }
+  *time_offset = time_to_curr_best;
+  *backup_link = curr_backup;
+  return curr_best;
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+random_link_options(void)
+{
+  static const uint8_t options[] = {
+    LINK_OPTION_TX, LINK_OPTION_RX, LINK_OPTION_TX | LINK_OPTION_RX,
+    LINK_OPTION_TX | LINK_OPTION_RX | LINK_OPTION_SHARED,
+  };
+
+  return options[random_rand() % sizeof(options)];
+}
+/*---------------------------------------------------------------------------*/
+static void
+random_asn(struct tsch_asn_t *asn)
+{
+  asn->ls4b = ((uint32_t)random_rand() << 16) | random_rand();
+  asn->ms1b = random_rand() % 4;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_next_active_link, "Next active link");
+UNIT_TEST(test_next_active_link)
+{
+  struct tsch_slotframe *sf;
+  struct tsch_link *l;
+  struct tsch_link *expected;
+  struct tsch_link *backup;
+  struct tsch_link *expected_backup;
+  struct tsch_asn_t asn;
+  uint16_t offset;
+  uint16_t expected_offset;
+  uint16_t ts;
+  int schedule;
+  int i;
+  int n;
+
+  UNIT_TEST_BEGIN();
+
+  for(schedule = 0; schedule < FUZZ_SCHEDULES; schedule++) {
+    tsch_schedule_remove_all_slotframes();
+    /* Slotframes of various sizes, not sorted by handle */
+    n = 1 + schedule % 4;
+    for(i = 0; i < n; i++) {
+      UNIT_TEST_ASSERT(tsch_schedule_add_slotframe((i + schedule) % n,
+                                                   fuzz_sf_sizes[(i + schedule) % 4]) != NULL);
+    }
+    /* Random links, including overwrites of timeslots */
+    for(i = 0; i < 4 * schedule; i++) {
+      sf = tsch_schedule_get_slotframe_by_handle(random_rand() % n);
+      ts = random_rand() % sf->size.val;
+      UNIT_TEST_ASSERT(tsch_schedule_add_link(sf, random_link_options(),
+                                              LINK_TYPE_NORMAL, NULL,
+                                              ts, 0) != NULL);
+      UNIT_TEST_ASSERT(tsch_schedule_get_link_by_timeslot(sf, ts) != NULL);
+    }
+    /* And removals */
+    for(i = 0; i < schedule; i++) {
+      sf = tsch_schedule_get_slotframe_by_handle(random_rand() % n);
+      ts = random_rand() % sf->size.val;
+      tsch_schedule_remove_link_by_timeslot(sf, ts);
+      UNIT_TEST_ASSERT(tsch_schedule_get_link_by_timeslot(sf, ts) == NULL);
+    }
+
+    for(i = 0; i < FUZZ_LOOKUPS; i++) {
+      random_asn(&asn);
+      expected = reference_next_active_link(&asn, &expected_offset,
+                                            &expected_backup);
+      l = tsch_schedule_get_next_active_link(&asn, &offset, &backup);
+      UNIT_TEST_ASSERT(l == expected);
+      UNIT_TEST_ASSERT(l == NULL || offset == expected_offset);
+      UNIT_TEST_ASSERT(backup == expected_backup);
+    }
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(uint16_t num_links)
+{
+  struct tsch_slotframe *sf;
+  struct tsch_link *backup;
+  struct tsch_asn_t asn;
+  uint64_t start;
+  uint64_t ns;
+  uint64_t total_ns;
+  uint64_t max_ns;
+  uint16_t offset;
+  int sample;
+  int rep;
+
+  tsch_schedule_remove_all_slotframes();
+  /* A 6TiSCH minimal slotframe, and a large slotframe for the other links */
+  tsch_schedule_create_minimal();
+  sf = tsch_schedule_add_slotframe(1, BENCH_SF_SIZE);
+  while(list_length(sf->links_list) < num_links - 1) {
+    tsch_schedule_add_link(sf, random_link_options(), LINK_TYPE_NORMAL,
+                           NULL, random_rand() % BENCH_SF_SIZE, 0);
+  }
+
+  total_ns = 0;
+  max_ns = 0;
+  TSCH_ASN_INIT(asn, 0, 0);
+  for(sample = 0; sample < BENCH_SAMPLES; sample++) {
+    asn.ls4b = (uint32_t)sample * BENCH_SF_SIZE / BENCH_SAMPLES;
+    start = now_ns();
+    for(rep = 0; rep < BENCH_REPS; rep++) {
+      tsch_schedule_get_next_active_link(&asn, &offset, &backup);
+    }
+    ns = now_ns() - start;
+    total_ns += ns;
+    if(ns > max_ns) {
+      max_ns = ns;
+    }
+  }
+
+  printf("Next active link with %3u links: %.1f ns average, %.1f ns worst\n",
+         num_links, (double)total_ns / (BENCH_SAMPLES * BENCH_REPS),
+         (double)max_ns / BENCH_REPS);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_tsch_schedule_process, ev, data)
+{
+  int i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with link index %u\n",
+         TSCH_SCHEDULE_CONF_WITH_LINK_INDEX);
+  printf("---\n");
+
+  tsch_schedule_init();
+
+  UNIT_TEST_RUN(test_next_active_link);
+
+  for(i = 0; i < sizeof(bench_link_counts) / sizeof(bench_link_counts[0]);
+      i++) {
+    benchmark(bench_link_counts[i]);
+  }
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Benchmark of packet input through the tun interface of the native
+ * platform. A child process sends UDP datagrams to the node from the
+ * host side of the tun interface, and the node measures the rate at
+ * which they reach its UDP socket.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/simple-udp.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uiplib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_tun6_process, "Tun input benchmark");
+AUTOSTART_PROCESSES(&test_tun6_process);
+/*---------------------------------------------------------------------------*/
+#define UDP_PORT         5678
+#define NUM_PACKETS      100000
+#define PAYLOAD_LEN      64
+#ifndef TUN6_NET_CONF_BATCH
+#define TUN6_NET_CONF_BATCH 1
+#endif
+
+/* The tun interface opened by the native platform */
+#define TUN_DEVICE       "tun0"
+
+static struct simple_udp_connection conn;
+static unsigned long received;
+static uint64_t first_ns;
+static uint64_t last_ns;
+static uint64_t first_cpu_ns;
+static uint64_t last_cpu_ns;
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+cpu_ns(void)
+{
+  struct rusage ru;
+
+  getrusage(RUSAGE_SELF, &ru);
+  return ((uint64_t)ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000000 +
+    ((uint64_t)ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1000;
+}
+/*---------------------------------------------------------------------------*/
+static void
+udp_rx_callback(struct simple_udp_connection *c,
+                const uip_ipaddr_t *sender_addr,
+                uint16_t sender_port,
+                const uip_ipaddr_t *receiver_addr,
+                uint16_t receiver_port,
+                const uint8_t *data,
+                uint16_t datalen)
+{
+  last_ns = now_ns();
+  last_cpu_ns = cpu_ns();
+  if(received++ == 0) {
+    first_ns = last_ns;
+    first_cpu_ns = last_cpu_ns;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Runs in the child process: send datagrams to the link-local address
+   of the node through the host side of the tun interface, so that host
+   routes do not matter */
+static void
+send_packets(const uip_ipaddr_t *addr)
+{
+  struct sockaddr_in6 dest;
+  char payload[PAYLOAD_LEN];
+  int sock;
+  int i;
+
+  memset(&dest, 0, sizeof(dest));
+  dest.sin6_family = AF_INET6;
+  dest.sin6_port = htons(UDP_PORT);
+  dest.sin6_scope_id = if_nametoindex(TUN_DEVICE);
+  memcpy(&dest.sin6_addr, addr, sizeof(dest.sin6_addr));
+  memset(payload, 0x5a, sizeof(payload));
+
+  sock = socket(AF_INET6, SOCK_DGRAM, 0);
+  if(sock < 0) {
+    _exit(1);
+  }
+  for(i = 0; i < NUM_PACKETS; i++) {
+    if(sendto(sock, payload, sizeof(payload), 0,
+              (struct sockaddr *)&dest, sizeof(dest)) < 0) {
+      /* The tun queue is full, let the node catch up */
+      usleep(100);
+    }
+  }
+  close(sock);
+  _exit(0);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_tun6_process, ev, data)
+{
+  static struct etimer et;
+  static uip_ds6_addr_t *addr;
+  static pid_t pid;
+  static int tries;
+  int status;
+
+  PROCESS_BEGIN();
+
+  printf("Run tun input benchmark, batch %u\n", TUN6_NET_CONF_BATCH);
+
+  simple_udp_register(&conn, UDP_PORT, NULL, 0, udp_rx_callback);
+
+  /* Wait for the link-local address to be usable */
+  for(tries = 0; tries < 50; tries++) {
+    addr = uip_ds6_get_link_local(ADDR_PREFERRED);
+    if(addr != NULL) {
+      break;
+    }
+    etimer_set(&et, CLOCK_SECOND / 10);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  }
+  if(addr == NULL) {
+    printf("=check-me= FAILED   - no link-local address\n");
+    exit(1);
+  }
+
+  pid = fork();
+  if(pid == 0) {
+    send_packets(&addr->ipaddr);
+  } else if(pid < 0) {
+    printf("=check-me= FAILED   - fork\n");
+    exit(1);
+  }
+
+  /* Wait for the sender to finish, and the tun queue to drain */
+  do {
+    etimer_set(&et, CLOCK_SECOND / 100);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  } while(waitpid(pid, &status, WNOHANG) == 0);
+  etimer_set(&et, CLOCK_SECOND / 5);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+
+  if(received > 1) {
+    printf("Tun input: %lu of %u packets, %.0f pps, %.2f us CPU per packet\n",
+           received, NUM_PACKETS,
+           received * 1e9 / (last_ns - first_ns),
+           (last_cpu_ns - first_cpu_ns) / 1e3 / received);
+    printf("=check-me= SUCCEEDED - packets received\n");
+  } else {
+    printf("=check-me= FAILED   - packets received\n");
+  }
+
+  printf("=check-me= DONE\n");
+  exit(received <= 1);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
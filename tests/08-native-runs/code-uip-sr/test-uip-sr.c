@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test and benchmark of the source routing graph kept by a non-storing
+ * RPL root. Node lookups and reachability are checked against a walk of
+ * the parent pointers while the graph changes, and the time to insert a
+ * source routing header is measured for DODAGs of increasing size.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip-sr.h"
+#include "net/ipv6/uipbuf.h"
+#include "net/routing/routing.h"
+#include "net/routing/rpl-lite/rpl.h"
+#include "lib/random.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_uip_sr_process, "Source routing graph test");
+AUTOSTART_PROCESSES(&test_uip_sr_process);
+/*---------------------------------------------------------------------------*/
+#define NUM_NODES        (UIP_SR_LINK_NUM - 1)
+#define ARITY            4
+#define LIFETIME         UIP_SR_INFINITE_LIFETIME
+#define CHURN_ROUNDS     5000
+#define BENCH_PACKETS    200000
+#define PAYLOAD_LEN      32
+
+static uip_ipaddr_t root_addr;
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* Address of node i, node 0 being the root */
+static void
+node_addr(uip_ipaddr_t *addr, int i)
+{
+  if(i == 0) {
+    uip_ipaddr_copy(addr, &root_addr);
+  } else {
+    memcpy(addr, &root_addr, 8);
+    uip_ip6addr_u8(addr, addr->u8[0], addr->u8[1], addr->u8[2], addr->u8[3],
+                   addr->u8[4], addr->u8[5], addr->u8[6], addr->u8[7],
+                   0x02, 0x12, 0x74, 0x00, 0x00, 0x00, i >> 8, i & 0xff);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uip_sr_node_t *
+get_node(int i)
+{
+  uip_ipaddr_t addr;
+
+  node_addr(&addr, i);
+  return uip_sr_get_node(NULL, &addr);
+}
+/*---------------------------------------------------------------------------*/
+static uip_sr_node_t *
+update_node(int child, int parent)
+{
+  uip_ipaddr_t child_addr;
+  uip_ipaddr_t parent_addr;
+
+  node_addr(&child_addr, child);
+  node_addr(&parent_addr, parent);
+  return uip_sr_update_node(NULL, &child_addr, &parent_addr, LIFETIME);
+}
+/*---------------------------------------------------------------------------*/
+/* A tree of n nodes below the root, with ARITY children per node */
+static void
+build_graph(int n)
+{
+  int i;
+
+  uip_sr_free_all();
+  for(i = 1; i <= n; i++) {
+    update_node(i, (i - 1) / ARITY);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Reference reachability: walk the parent pointers up to the root */
+static int
+ref_reachable(uip_sr_node_t *node)
+{
+  uip_sr_node_t *root_node = get_node(0);
+  int depth;
+
+  for(depth = 0; node != NULL && node != root_node && depth < NUM_NODES;
+      depth++) {
+    node = node->parent;
+  }
+  return node != NULL && node == root_node;
+}
+/*---------------------------------------------------------------------------*/
+static int
+has_children(uip_sr_node_t *node)
+{
+  uip_sr_node_t *l;
+
+  for(l = uip_sr_node_head(); l != NULL; l = uip_sr_node_next(l)) {
+    if(l->parent == node) {
+      return 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_lookup, "Look up nodes");
+UNIT_TEST(test_lookup)
+{
+  uip_ipaddr_t addr;
+  uip_sr_node_t *node;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  build_graph(NUM_NODES);
+  UNIT_TEST_ASSERT(uip_sr_num_nodes() == NUM_NODES + 1);
+
+  for(i = 0; i <= NUM_NODES; i++) {
+    node = get_node(i);
+    UNIT_TEST_ASSERT(node != NULL);
+    UNIT_TEST_ASSERT(i == 0 || node->parent == get_node((i - 1) / ARITY));
+    node_addr(&addr, i);
+    UNIT_TEST_ASSERT(uip_sr_is_addr_reachable(NULL, &addr));
+  }
+
+  /* Unknown node, and a known link identifier with another prefix */
+  node_addr(&addr, NUM_NODES + 1);
+  UNIT_TEST_ASSERT(uip_sr_get_node(NULL, &addr) == NULL);
+  UNIT_TEST_ASSERT(!uip_sr_is_addr_reachable(NULL, &addr));
+  node_addr(&addr, 1);
+  addr.u8[0] ^= 0x01;
+  UNIT_TEST_ASSERT(uip_sr_get_node(NULL, &addr) == NULL);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_update, "Reparent and expire nodes");
+UNIT_TEST(test_update)
+{
+  uip_ipaddr_t addr;
+  uip_ipaddr_t parent_addr;
+  uip_sr_node_t *node;
+  int child;
+  int parent;
+  int n;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  build_graph(NUM_NODES);
+
+  /* A parent below the node would create a loop, and is not taken */
+  node = update_node(1, 1 * ARITY + 1);
+  UNIT_TEST_ASSERT(node == get_node(1));
+  UNIT_TEST_ASSERT(node->parent == get_node(0));
+  node_addr(&addr, 1 * ARITY + 1);
+  UNIT_TEST_ASSERT(uip_sr_is_addr_reachable(NULL, &addr));
+
+  for(n = 0; n < CHURN_ROUNDS; n++) {
+    child = 1 + random_rand() % NUM_NODES;
+    node = get_node(child);
+    if(random_rand() % 8 == 0) {
+      /* Expire the link of a leaf, or add it back */
+      if(node == NULL) {
+        update_node(child, 0);
+      } else if(!has_children(node)) {
+        node_addr(&addr, child);
+        node_addr(&parent_addr, 0);
+        for(parent = 0; parent <= NUM_NODES; parent++) {
+          if(get_node(parent) == node->parent) {
+            break;
+          }
+        }
+        node_addr(&parent_addr, parent);
+        uip_sr_expire_parent(NULL, &addr, &parent_addr);
+        UNIT_TEST_ASSERT(node->lifetime == UIP_SR_REMOVAL_DELAY);
+        uip_sr_periodic(UIP_SR_REMOVAL_DELAY);
+        uip_sr_periodic(1);
+        UNIT_TEST_ASSERT(get_node(child) == NULL);
+        UNIT_TEST_ASSERT(!uip_sr_is_addr_reachable(NULL, &addr));
+      }
+    } else {
+      /* Move the node to another parent */
+      parent = random_rand() % (NUM_NODES + 1);
+      if(parent != child && get_node(parent) != NULL) {
+        update_node(child, parent);
+      }
+    }
+
+    /* Every few rounds, check all nodes against the reference */
+    if(n % 64 == 0) {
+      for(i = 0; i <= NUM_NODES; i++) {
+        node = get_node(i);
+        node_addr(&addr, i);
+        UNIT_TEST_ASSERT(uip_sr_is_addr_reachable(NULL, &addr) ==
+                         (node != NULL && ref_reachable(node)));
+      }
+    }
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+prepare_packet(int dest)
+{
+  uipbuf_clear();
+  memset(UIP_IP_BUF, 0, UIP_IPH_LEN + PAYLOAD_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = uip_ds6_if.cur_hop_limit;
+  uip_ipaddr_copy(&UIP_IP_BUF->srcipaddr, &root_addr);
+  node_addr(&UIP_IP_BUF->destipaddr, dest);
+  uip_len = UIP_IPH_LEN + PAYLOAD_LEN;
+  uipbuf_set_len_field(UIP_IP_BUF, uip_len - UIP_IPH_LEN);
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(int n)
+{
+  uint64_t start;
+  unsigned long inserted;
+  int i;
+
+  build_graph(n);
+
+  inserted = 0;
+  start = now_ns();
+  for(i = 0; i < BENCH_PACKETS; i++) {
+    prepare_packet(1 + random_rand() % n);
+    if(NETSTACK_ROUTING.ext_header_update()
+       && UIP_IP_BUF->proto == UIP_PROTO_ROUTING) {
+      inserted++;
+    }
+  }
+  printf("SRH insertion with %d nodes: %.1f ns per packet (%lu inserted)\n",
+         n, (double)(now_ns() - start) / BENCH_PACKETS, inserted);
+  if(inserted != BENCH_PACKETS) {
+    printf("=check-me= FAILED   - SRH insertion with %d nodes\n", n);
+    failures++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_uip_sr_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with %u nodes, hash index %u\n",
+         UIP_SR_LINK_NUM, UIP_SR_WITH_HASH_INDEX);
+  printf("---\n");
+
+  rpl_dag_root_start();
+  if(!NETSTACK_ROUTING.node_is_root()
+     || !NETSTACK_ROUTING.get_root_ipaddr(&root_addr)) {
+    printf("=check-me= FAILED   - could not start as DAG root\n");
+    exit(1);
+  }
+
+  UNIT_TEST_RUN(test_lookup);
+  UNIT_TEST_RUN(test_update);
+
+  benchmark(50);
+  benchmark(100);
+  benchmark(250);
+  benchmark(NUM_NODES);
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
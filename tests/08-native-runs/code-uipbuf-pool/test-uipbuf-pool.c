@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test of the uipbuf packet descriptor pool and of the input queue of
+ * the TCP/IP process. UDP datagrams are built in uip_buf with different
+ * link-layer senders and radio attributes and queued with
+ * tcpip_input_enqueue(), and must reach the UDP socket in order, each
+ * with its own packetbuf attributes, while packetbuf is left as it was. The cost of the two copies each
+ * queued packet takes is printed for reference.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/simple-udp.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uipbuf.h"
+#include "net/packetbuf.h"
+#include "services/unit-test/unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+PROCESS(test_uipbuf_pool_process, "uipbuf pool test");
+AUTOSTART_PROCESSES(&test_uipbuf_pool_process);
+/*---------------------------------------------------------------------------*/
+#define UDP_PORT         5678
+#define PAYLOAD_LEN      16
+#define NUM_PACKETS      (2 * UIPBUF_POOL_SIZE)
+#define BENCH_ROUNDS     10000
+
+static struct simple_udp_connection conn;
+static uint8_t rx_seq[NUM_PACKETS];
+static uint8_t rx_sender[NUM_PACKETS];
+static uint16_t rx_rssi[NUM_PACKETS];
+static uint16_t rx_lqi[NUM_PACKETS];
+static int received;
+static int failures;
+/*---------------------------------------------------------------------------*/
+void
+print_test_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+    failures++;
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+static void
+udp_rx_callback(struct simple_udp_connection *c,
+                const uip_ipaddr_t *sender_addr,
+                uint16_t sender_port,
+                const uip_ipaddr_t *receiver_addr,
+                uint16_t receiver_port,
+                const uint8_t *data,
+                uint16_t datalen)
+{
+  if(received < NUM_PACKETS) {
+    rx_seq[received] = data[0];
+    rx_sender[received] = packetbuf_addr(PACKETBUF_ADDR_SENDER)->u8[0];
+    rx_rssi[received] = packetbuf_attr(PACKETBUF_ATTR_RSSI);
+    rx_lqi[received] = packetbuf_attr(PACKETBUF_ATTR_LINK_QUALITY);
+    received++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Build a UDP datagram to ourselves in uip_buf, as received from the
+   link-layer sender given, with an RSSI and an LQI derived from it */
+static void
+prepare_packet(uint8_t seq, uint8_t sender)
+{
+  const uip_ipaddr_t *addr = &uip_ds6_get_link_local(-1)->ipaddr;
+  linkaddr_t lladdr;
+
+  uipbuf_clear();
+  memset(uip_buf, 0, UIP_IPUDPH_LEN + PAYLOAD_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = 64;
+  uip_ipaddr_copy(&UIP_IP_BUF->srcipaddr, addr);
+  uip_ipaddr_copy(&UIP_IP_BUF->destipaddr, addr);
+  uip_len = UIP_IPUDPH_LEN + PAYLOAD_LEN;
+  uipbuf_set_len_field(UIP_IP_BUF, uip_len - UIP_IPH_LEN);
+  UIP_UDP_BUF->srcport = UIP_HTONS(UDP_PORT + 1);
+  UIP_UDP_BUF->destport = UIP_HTONS(UDP_PORT);
+  UIP_UDP_BUF->udplen = UIP_HTONS(UIP_UDPH_LEN + PAYLOAD_LEN);
+  memset(uip_buf + UIP_IPUDPH_LEN, seq, PAYLOAD_LEN);
+  UIP_UDP_BUF->udpchksum = ~(uip_udpchksum());
+  if(UIP_UDP_BUF->udpchksum == 0) {
+    UIP_UDP_BUF->udpchksum = 0xffff;
+  }
+
+  packetbuf_clear();
+  memset(&lladdr, 0, sizeof(lladdr));
+  lladdr.u8[0] = sender;
+  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &lladdr);
+  packetbuf_set_attr(PACKETBUF_ATTR_RSSI, 0x100 + sender);
+  packetbuf_set_attr(PACKETBUF_ATTR_LINK_QUALITY, 0x200 + sender);
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_save_restore, "Save and restore packets");
+UNIT_TEST(test_save_restore)
+{
+  uipbuf_desc_t *desc[UIPBUF_POOL_SIZE];
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(uipbuf_pool_numfree() == UIPBUF_POOL_SIZE);
+  for(i = 0; i < UIPBUF_POOL_SIZE; i++) {
+    prepare_packet(i, 0x10 + i);
+    uipbuf_set_attr(UIPBUF_ATTR_MAX_MAC_TRANSMISSIONS, i);
+    desc[i] = uipbuf_pool_save();
+    UNIT_TEST_ASSERT(desc[i] != NULL);
+  }
+  UNIT_TEST_ASSERT(uipbuf_pool_numfree() == 0);
+  UNIT_TEST_ASSERT(uipbuf_pool_save() == NULL);
+
+  /* Restore in reverse order */
+  for(i = UIPBUF_POOL_SIZE - 1; i >= 0; i--) {
+    prepare_packet(0xff, 0xff);
+    uipbuf_pool_restore(desc[i]);
+    UNIT_TEST_ASSERT(uip_len == UIP_IPUDPH_LEN + PAYLOAD_LEN);
+    UNIT_TEST_ASSERT(uip_buf[UIP_IPUDPH_LEN] == i);
+    UNIT_TEST_ASSERT(uipbuf_get_attr(UIPBUF_ATTR_MAX_MAC_TRANSMISSIONS) == i);
+    /* packetbuf is not touched until asked for */
+    UNIT_TEST_ASSERT(packetbuf_addr(PACKETBUF_ADDR_SENDER)->u8[0] == 0xff);
+    uipbuf_pool_restore_packetbuf_attrs(desc[i]);
+    UNIT_TEST_ASSERT(packetbuf_addr(PACKETBUF_ADDR_SENDER)->u8[0] == 0x10 + i);
+    UNIT_TEST_ASSERT(packetbuf_attr(PACKETBUF_ATTR_RSSI) == 0x110 + i);
+    UNIT_TEST_ASSERT(packetbuf_attr(PACKETBUF_ATTR_LINK_QUALITY) == 0x210 + i);
+    uipbuf_pool_free(desc[i]);
+  }
+  UNIT_TEST_ASSERT(uipbuf_pool_numfree() == UIPBUF_POOL_SIZE);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_input_queue, "Queued input in order");
+UNIT_TEST(test_input_queue)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* All packets reach the socket, in order, with their own sender and
+     attributes */
+  for(i = 0; i < UIPBUF_POOL_SIZE; i++) {
+    prepare_packet(i, 0x20 + i);
+    tcpip_input_enqueue();
+  }
+  UNIT_TEST_ASSERT(received == 0);
+  UNIT_TEST_ASSERT(uipbuf_pool_numfree() == 0);
+
+  /* Processing the queue leaves packetbuf as it was */
+  prepare_packet(0xff, 0xee);
+  packetbuf_set_attr(PACKETBUF_ATTR_RSSI, 0x1234);
+  while(process_run() > 0);
+
+  UNIT_TEST_ASSERT(received == UIPBUF_POOL_SIZE);
+  for(i = 0; i < UIPBUF_POOL_SIZE; i++) {
+    UNIT_TEST_ASSERT(rx_seq[i] == i);
+    UNIT_TEST_ASSERT(rx_sender[i] == 0x20 + i);
+    UNIT_TEST_ASSERT(rx_rssi[i] == 0x120 + i);
+    UNIT_TEST_ASSERT(rx_lqi[i] == 0x220 + i);
+  }
+  UNIT_TEST_ASSERT(packetbuf_addr(PACKETBUF_ADDR_SENDER)->u8[0] == 0xee);
+  UNIT_TEST_ASSERT(packetbuf_attr(PACKETBUF_ATTR_RSSI) == 0x1234);
+  UNIT_TEST_ASSERT(uipbuf_pool_numfree() == UIPBUF_POOL_SIZE);
+
+  /* Packets beyond the pool size are dropped */
+  received = 0;
+  for(i = 0; i < NUM_PACKETS; i++) {
+    prepare_packet(i, 0x30 + i);
+    tcpip_input_enqueue();
+  }
+  while(process_run() > 0);
+
+  UNIT_TEST_ASSERT(received == UIPBUF_POOL_SIZE);
+  for(i = 0; i < UIPBUF_POOL_SIZE; i++) {
+    UNIT_TEST_ASSERT(rx_seq[i] == i);
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+benchmark(void)
+{
+  uipbuf_desc_t *desc;
+  uint64_t t;
+  int r;
+
+  /* A packet of the size of uip_buf: the worst case of both copies */
+  prepare_packet(0, 0x40);
+  uip_len = UIP_BUFSIZE;
+
+  t = now_ns();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    desc = uipbuf_pool_save();
+    uipbuf_pool_restore(desc);
+    uipbuf_pool_free(desc);
+  }
+  t = now_ns() - t;
+
+  printf("Bench: save and restore of %u bytes: %.1f ns per packet\n",
+         UIP_BUFSIZE, (double)t / BENCH_ROUNDS);
+  uipbuf_clear();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_uipbuf_pool_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test with %u packet descriptors\n", UIPBUF_POOL_SIZE);
+  printf("---\n");
+
+  simple_udp_register(&conn, UDP_PORT, NULL, UDP_PORT + 1, udp_rx_callback);
+
+  UNIT_TEST_RUN(test_save_restore);
+  UNIT_TEST_RUN(test_input_queue);
+  benchmark();
+
+  printf("=check-me= DONE\n");
+  exit(failures != 0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Sends large UDP datagrams from the far end of a line of nodes
+ *         to the RPL root, so that every datagram is fragmented and
+ *         crosses several hops. The test script measures the
+ *         end-to-end latency from the send and receive log lines.
+ */
+
+#include "contiki.h"
+#include "net/routing/routing.h"
+#include "net/ipv6/simple-udp.h"
+#include "sys/node-id.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define UDP_PORT 8765
+
+/* The root collects, the node with SENDER_ID sends */
+#define ROOT_ID 1
+#define SENDER_ID 6
+
+#define DATAGRAM_LEN 512
+#define SEND_INTERVAL (4 * CLOCK_SECOND)
+
+static struct simple_udp_connection udp_conn;
+static uint8_t buf[DATAGRAM_LEN];
+
+PROCESS(node_process, "Node");
+AUTOSTART_PROCESSES(&node_process);
+/*---------------------------------------------------------------------------*/
+static void
+fill(uint16_t seq)
+{
+  uint16_t i;
+
+  buf[0] = seq >> 8;
+  buf[1] = seq & 0xff;
+  for(i = 2; i < DATAGRAM_LEN; i++) {
+    buf[i] = (uint8_t)(i + seq);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+udp_rx_callback(struct simple_udp_connection *c,
+                const uip_ipaddr_t *sender_addr,
+                uint16_t sender_port,
+                const uip_ipaddr_t *receiver_addr,
+                uint16_t receiver_port,
+                const uint8_t *data,
+                uint16_t datalen)
+{
+  uint16_t seq;
+
+  if(datalen != DATAGRAM_LEN) {
+    printf("Corrupted datagram, len %u\n", datalen);
+    return;
+  }
+  seq = (data[0] << 8) | data[1];
+  fill(seq);
+  if(memcmp(buf, data, DATAGRAM_LEN) != 0) {
+    printf("Corrupted datagram, seq %u\n", seq);
+    return;
+  }
+  printf("Received seq %u\n", seq);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(node_process, ev, data)
+{
+  static struct etimer et;
+  static uint16_t seq;
+  uip_ipaddr_t root_ipaddr;
+
+  PROCESS_BEGIN();
+
+  if(node_id == ROOT_ID) {
+    NETSTACK_ROUTING.root_start();
+  }
+
+  simple_udp_register(&udp_conn, UDP_PORT, NULL, UDP_PORT, udp_rx_callback);
+
+  etimer_set(&et, SEND_INTERVAL);
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    if(node_id == SENDER_ID && NETSTACK_ROUTING.node_is_reachable() &&
+       NETSTACK_ROUTING.get_root_ipaddr(&root_ipaddr)) {
+      fill(++seq);
+      printf("Sending seq %u\n", seq);
+      simple_udp_sendto(&udp_conn, buf, DATAGRAM_LEN, &root_ipaddr);
+    }
+    etimer_reset(&et);
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
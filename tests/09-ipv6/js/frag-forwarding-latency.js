@@ -0,0 +1,35 @@
+TIMEOUT(600000, log.testFailed());
+
+/* Number of datagrams to average the end-to-end latency over */
+expected = 10;
+sent = {};
+received = 0;
+total_latency = 0;
+
+while(1) {
+  YIELD();
+  log.log(time + " " + id + " "+ msg + "\n");
+
+  if(msg.contains("Corrupted")) {
+    log.testFailed();
+  }
+
+  if(msg.startsWith("Sending seq ")) {
+    sent[msg.split(" ")[2]] = time;
+  }
+
+  if(msg.startsWith("Received seq ")) {
+    seq = msg.split(" ")[2];
+    if(sent[seq] != undefined) {
+      /* time is in microseconds */
+      total_latency += time - sent[seq];
+      received += 1;
+      log.log("Datagram " + seq + " latency " + (time - sent[seq]) / 1000 + " ms\n");
+    }
+  }
+
+  if(received == expected) {
+    log.log("Average end-to-end latency: " + total_latency / received / 1000 + " ms\n");
+    log.testOK();
+  }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Many-to-one load over the TSCH minimal schedule. All nodes send to the
+ * root faster than the single shared cell can carry, and the root echoes
+ * every packet back. The root thus keeps packets queued for every node,
+ * which it sends in shared cells. Each node checks that it keeps getting
+ * echoes, i.e., that none of the root's neighbor queues is starved.
+ */
+
+#include "contiki.h"
+#include "net/netstack.h"
+#include "net/nullnet/nullnet.h"
+#include "net/mac/tsch/tsch.h"
+#include "sys/node-id.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define ROOT_ID          1
+#define SEND_INTERVAL    (CLOCK_SECOND / 2)
+#define NUM_SEND         120
+/* Minimum number of echoes each node must receive */
+#define MIN_ECHOES       (NUM_SEND / 10)
+
+static linkaddr_t root_addr = {{ ROOT_ID, 0x00, 0x00, 0x00,
+                                 0x00, 0x00, 0x00, 0x00 }};
+static uint16_t seqno;
+static uint16_t echo;
+static unsigned num_echoes;
+/*---------------------------------------------------------------------------*/
+PROCESS(test_process, "TSCH ready list test");
+AUTOSTART_PROCESSES(&test_process);
+/*---------------------------------------------------------------------------*/
+static void
+input_callback(const void *data, uint16_t len,
+               const linkaddr_t *src, const linkaddr_t *dest)
+{
+  if(len != sizeof(uint16_t) || !linkaddr_cmp(dest, &linkaddr_node_addr)) {
+    return;
+  }
+  if(node_id == ROOT_ID) {
+    /* Echo the packet back to its sender */
+    memcpy(&echo, data, sizeof(echo));
+    nullnet_buf = (uint8_t *)&echo;
+    nullnet_len = sizeof(echo);
+    NETSTACK_NETWORK.output(src);
+  } else {
+    num_echoes++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  static struct etimer et;
+
+  PROCESS_BEGIN();
+
+  tsch_set_coordinator(node_id == ROOT_ID);
+  nullnet_set_input_callback(input_callback);
+  NETSTACK_MAC.on();
+
+  if(node_id == ROOT_ID) {
+    PROCESS_EXIT();
+  }
+
+  /* Wait for association */
+  etimer_set(&et, CLOCK_SECOND);
+  while(!tsch_is_associated) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    etimer_reset(&et);
+  }
+
+  etimer_set(&et, SEND_INTERVAL);
+  for(seqno = 0; seqno < NUM_SEND; seqno++) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    etimer_reset(&et);
+    nullnet_buf = (uint8_t *)&seqno;
+    nullnet_len = sizeof(seqno);
+    NETSTACK_NETWORK.output(&root_addr);
+  }
+
+  /* Let the root drain its queues */
+  etimer_set(&et, 10 * CLOCK_SECOND);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+
+  printf("Echoes %u/%u\n", num_echoes, NUM_SEND);
+  if(num_echoes >= MIN_ECHOES) {
+    printf("=check-me= DONE\n");
+  } else {
+    printf("=check-me= FAILED\n");
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
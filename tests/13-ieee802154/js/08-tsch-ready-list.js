@@ -0,0 +1,25 @@
+TIMEOUT(300000, log.testFailed());
+
+var failed = false;
+var done = 0;
+
+/* All motes but the root report their result */
+while(done < sim.getMotes().length - 1) {
+    YIELD();
+
+    log.log(time + " " + "node-" + id + " "+ msg + "\n");
+
+    if(msg.contains("=check-me=") == false) {
+        continue;
+    }
+
+    if(msg.contains("FAILED")) {
+        failed = true;
+    }
+
+    done++;
+}
+if(failed) {
+    log.testFailed();
+}
+log.testOK();
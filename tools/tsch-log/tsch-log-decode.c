@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2026, Contiki-NG.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Decoder for the binary TSCH per-slot logs (TSCH_LOG_CONF_BINARY). It
+ * reads the serial output of a node from a file or from the standard
+ * input, and prints the logs in the same text format as the node would
+ * with TSCH_LOG_CONF_BINARY disabled. Anything that is not a log record,
+ * such as the output of the other log modules, is passed through.
+ *
+ * Usage: tsch-log-decode [file]
+ *
+ * For instance, after setting up the serial port with stty:
+ *   tsch-log-decode < /dev/ttyUSB0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+/* Must match os/net/mac/tsch/tsch-log.h */
+#define TSCH_LOG_BINARY_MAGIC      0xa5
+#define TSCH_LOG_BINARY_HAS_LINK   0x80
+#define TSCH_LOG_BINARY_HDR_LEN    17
+
+#define LOG_TX                     0
+#define LOG_RX                     1
+#define LOG_MESSAGE                2
+#define LOG_DROPPED                3
+#define LOG_NODE                   4
+
+#define SLIP_END     0300
+#define SLIP_ESC     0333
+#define SLIP_ESC_END 0334
+#define SLIP_ESC_ESC 0335
+
+#define MAX_ADDR_LEN 8
+#define MAX_RECORD   128
+/*---------------------------------------------------------------------------*/
+static uint8_t node_addr[MAX_ADDR_LEN];
+static int node_addr_len;
+/*---------------------------------------------------------------------------*/
+static uint16_t
+get_u16(const uint8_t *p)
+{
+  return p[0] | (p[1] << 8);
+}
+/*---------------------------------------------------------------------------*/
+static int
+is_null_addr(const uint8_t *addr, int len)
+{
+  int i;
+
+  for(i = 0; i < len; i++) {
+    if(addr[i] != 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Prints an address like log_lladdr_compact() does */
+static void
+print_addr(const uint8_t *addr, int len)
+{
+  if(is_null_addr(addr, len)) {
+    printf("LL-NULL");
+  } else {
+    printf("LL-%04x", (addr[len - 2] << 8) | addr[len - 1]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Checks that an address of a valid size is within the record */
+static int
+addr_ok(const uint8_t *rec, int len, int fixed_len)
+{
+  int addr_len = rec[TSCH_LOG_BINARY_HDR_LEN];
+
+  return (addr_len == 2 || addr_len == 8) &&
+         len == TSCH_LOG_BINARY_HDR_LEN + 1 + addr_len + fixed_len;
+}
+/*---------------------------------------------------------------------------*/
+static void
+print_header(const uint8_t *rec)
+{
+  uint32_t asn_ls4b = get_u16(rec + 3) | ((uint32_t)get_u16(rec + 5) << 16);
+
+  if(!(rec[1] & TSCH_LOG_BINARY_HAS_LINK)) {
+    printf("[INFO: TSCH-LOG  ] {asn %02x.%08lx link-NULL} ",
+           rec[2], (unsigned long)asn_ls4b);
+  } else {
+    printf("[INFO: TSCH-LOG  ] {asn %02x.%08lx link %2u %3u %3u %2u %2u ch %2u} ",
+           rec[2], (unsigned long)asn_ls4b,
+           get_u16(rec + 7), get_u16(rec + 9), rec[15],
+           get_u16(rec + 11), get_u16(rec + 13), rec[16]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Decodes and prints a record. Returns 0 if it is not a valid record */
+static int
+decode(const uint8_t *rec, int len)
+{
+  const uint8_t *p;
+  const uint8_t *addr;
+  int addr_len;
+
+  if(len < TSCH_LOG_BINARY_HDR_LEN || rec[0] != TSCH_LOG_BINARY_MAGIC) {
+    return 0;
+  }
+
+  p = rec + TSCH_LOG_BINARY_HDR_LEN;
+  switch(rec[1] & ~TSCH_LOG_BINARY_HAS_LINK) {
+  case LOG_TX:
+    if(!addr_ok(rec, len, 8)) {
+      return 0;
+    }
+    addr_len = *p++;
+    addr = p;
+    p += addr_len;
+    print_header(rec);
+    printf("%s-%u-%u tx ", is_null_addr(addr, addr_len) ? "bc" : "uc",
+           p[3] & 1, p[4]);
+    if(node_addr_len == addr_len) {
+      print_addr(node_addr, node_addr_len);
+    } else {
+      printf("LL-????");
+    }
+    printf("->");
+    print_addr(addr, addr_len);
+    printf(", len %3u, seq %3u, st %d %2d", p[2], p[5], (int8_t)p[0], p[1]);
+    if(p[3] & 2) {
+      printf(", dr %3d", (int16_t)get_u16(p + 6));
+    }
+    printf("\n");
+    return 1;
+  case LOG_RX:
+    if(!addr_ok(rec, len, 8)) {
+      return 0;
+    }
+    addr_len = *p++;
+    addr = p;
+    p += addr_len;
+    print_header(rec);
+    printf("%s-%u-%u rx ", (p[0] & 1) ? "uc" : "bc", (p[0] >> 1) & 1, p[1]);
+    print_addr(addr, addr_len);
+    printf("->");
+    if(!(p[0] & 1)) {
+      printf("LL-NULL");
+    } else if(node_addr_len == addr_len) {
+      print_addr(node_addr, node_addr_len);
+    } else {
+      printf("LL-????");
+    }
+    printf(", len %3u, seq %3u", p[2], p[3]);
+    printf(", edr %3d", (int16_t)get_u16(p + 6));
+    if(p[0] & 4) {
+      printf(", dr %3d\n", (int16_t)get_u16(p + 4));
+    } else {
+      printf("\n");
+    }
+    return 1;
+  case LOG_MESSAGE:
+    print_header(rec);
+    printf("%.*s\n", len - TSCH_LOG_BINARY_HDR_LEN, (const char *)p);
+    return 1;
+  case LOG_DROPPED:
+    if(len != TSCH_LOG_BINARY_HDR_LEN + 2) {
+      return 0;
+    }
+    printf("[WARN: TSCH-LOG  ] logs dropped %u\n", get_u16(p));
+    return 1;
+  case LOG_NODE:
+    if(len != TSCH_LOG_BINARY_HDR_LEN + 1 + p[0] || p[0] > MAX_ADDR_LEN) {
+      return 0;
+    }
+    node_addr_len = p[0];
+    memcpy(node_addr, p + 1, node_addr_len);
+    return 1;
+  default:
+    return 0;
+  }
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  static uint8_t rec[MAX_RECORD];
+  FILE *in;
+  int in_record;
+  int escaped;
+  int len;
+  int c;
+
+  if(argc > 2) {
+    fprintf(stderr, "usage: %s [file]\n", argv[0]);
+    return 1;
+  }
+  in = stdin;
+  if(argc == 2) {
+    in = fopen(argv[1], "rb");
+    if(in == NULL) {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+
+  in_record = 0;
+  escaped = 0;
+  len = 0;
+  while((c = getc(in)) != EOF) {
+    if(c == SLIP_END) {
+      if(!in_record) {
+        in_record = 1;
+      } else if(len == 0) {
+        /* Two frame delimiters in a row, stay in the record */
+      } else if(decode(rec, len)) {
+        in_record = 0;
+      } else {
+        /* Out of sync, e.g. when started in the middle of a record: pass
+           the bytes through and take this delimiter as the start of a
+           record */
+        fwrite(rec, 1, len, stdout);
+      }
+      len = 0;
+      escaped = 0;
+    } else if(!in_record) {
+      putchar(c);
+    } else if(len == MAX_RECORD) {
+      /* Too long to be a record */
+      fwrite(rec, 1, len, stdout);
+      putchar(c);
+      in_record = 0;
+      len = 0;
+    } else if(escaped) {
+      rec[len++] = c == SLIP_ESC_END ? SLIP_END : c == SLIP_ESC_ESC ? SLIP_ESC : c;
+      escaped = 0;
+    } else if(c == SLIP_ESC) {
+      escaped = 1;
+    } else {
+      rec[len++] = c;
+    }
+  }
+  fflush(stdout);
+
+  if(in != stdin) {
+    fclose(in);
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/